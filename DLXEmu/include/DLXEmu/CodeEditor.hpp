@@ -69,6 +69,7 @@ namespace dlxemu
             CurrentLineFill,
             CurrentLineFillInactive,
             CurrentLineEdge,
+            ProfileHeat,
             Max
         };
 
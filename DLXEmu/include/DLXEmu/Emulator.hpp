@@ -2,9 +2,11 @@
 
 #include "CodeEditor.hpp"
 #include "DebugView.hpp"
+#include "ExecutionWorker.hpp"
 #include "MemoryViewer.hpp"
 #include "RegisterViewer.hpp"
 #include "Window.hpp"
+#include <DLX/ExecutionProfile.hpp>
 #include <DLX/InstructionLibrary.hpp>
 #include <DLX/Parser.hpp>
 #include <DLX/Processor.hpp>
@@ -13,6 +15,7 @@
 #include <phi/core/boolean.hpp>
 #include <phi/core/sized_types.hpp>
 #include <phi/core/types.hpp>
+#include <vector>
 
 namespace dlxemu
 {
@@ -66,6 +69,13 @@ namespace dlxemu
         // Note: Return 0 if there is none
         [[nodiscard]] phi::u64 GetExecutingLineNumber() const noexcept;
 
+        // How often the line was executed relative to the hottest line from 0 to 1. Always 0
+        // while the profiler or the heatmap is hidden.
+        [[nodiscard]] float GetLineHeat(phi::u32 line_number) const noexcept;
+
+        // Note: Returns nullptr if the line wasn't executed
+        [[nodiscard]] const dlx::LineProfile* GetLineProfile(phi::u32 line_number) const noexcept;
+
     private:
         void RenderMenuBar() noexcept;
 
@@ -77,14 +87,37 @@ namespace dlxemu
 
         void RenderThirdPartyLicense() noexcept;
 
+        void RenderProfiler() noexcept;
+
         void Update() noexcept;
 
+        // Executes batches of instructions until the run budget of the frame is used up. The
+        // size of the batches is calibrated with the measured cost per instruction.
+        [[nodiscard]] dlx::StopReason RunForFrameBudget() noexcept;
+
+        void UpdateThroughput(phi::size_t step_count) noexcept;
+
+        // Profiling and recording the history slow down every step so they're only enabled
+        // while the profiler is open or recording the history was requested
+        void UpdateProcessorFeatures() noexcept;
+
+        // Collects the hot lines from the profile of the processor when it changed
+        void UpdateProfile() noexcept;
+
         void SetExecutionMode(ExecutionMode mode) noexcept;
 
+        // While the worker runs the processor the UI displays the published state instead
+        [[nodiscard]] phi::boolean IsExecutingInBackground() const noexcept;
+
     private:
         dlx::Processor     m_Processor;
         dlx::ParsedProgram m_DLXProgram;
 
+        // Declared after the processor so it is stopped before the processor is destroyed
+        ExecutionWorker m_ExecutionWorker;
+        // Acquired once per frame so all windows show the same state
+        const ExecutionState* m_ExecutionState{nullptr};
+
         CodeEditor     m_CodeEditor;
         Window         m_Window;
         MemoryViewer   m_MemoryViewer;
@@ -98,6 +131,25 @@ namespace dlxemu
         phi::f64      m_StepThroughDelayMS{0.5};
         phi::boolean  m_DisableEditing{false};
 
+        // Run mode without the worker
+        float  m_RunBudgetMS{8.0f};
+        double m_NanosecondsPerInstruction{10.0};
+
+        // Run mode statistics
+        double      m_ThroughputSampleTime{0.0};
+        phi::size_t m_ThroughputSampleSteps{0u};
+        double      m_InstructionsPerSecond{0.0};
+
+        // Profile of the loaded program, kept while the worker runs the processor
+        std::vector<dlx::LineProfile> m_HotLines;
+        std::vector<float>            m_LineHeat;
+        phi::uint64_t                 m_ProfiledInstructions{0u};
+        phi::boolean                  m_ProfileOutdated{true};
+        bool                          m_ShowHeatmap{true};
+
+        // Allows stepping back at the cost of recording every executed instruction
+        bool m_RecordHistory{false};
+
         // Menu
 #if defined(PHI_DEBUG)
         bool m_ShowDemoWindow{false};
@@ -106,6 +158,7 @@ namespace dlxemu
         bool m_ShowControlPanel{true};
         bool m_ShowMemoryViewer{true};
         bool m_ShowRegisterViewer{true};
+        bool m_ShowProfiler{false};
         bool m_ShowAbout{false};
         bool m_ShowThirdPartyLicense{false};
         bool m_ShowOptionsMenu{false};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <DLX/Processor.hpp>
+#include <phi/compiler_support/compiler.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Emscripten can only create threads when building with pthread support
+#if !defined(DLXEMU_EXECUTION_WORKER_SUPPORTED)
+#    if PHI_COMPILER_IS(EMCC) && !defined(__EMSCRIPTEN_PTHREADS__)
+#        define DLXEMU_EXECUTION_WORKER_SUPPORTED 0
+#    else
+#        define DLXEMU_EXECUTION_WORKER_SUPPORTED 1
+#    endif
+#endif
+
+namespace dlxemu
+{
+    // Copy of everything the viewers display, taken by the worker between two slices
+    struct ExecutionState
+    {
+        std::array<phi::int32_t, 32u> int_registers{};
+        std::array<float, 32u>        float_registers{};
+        phi::boolean                  fpsr{false};
+        phi::uint32_t                 program_counter{0u};
+        phi::size_t                   step_count{0u};
+        phi::boolean                  halted{false};
+        dlx::Exception                last_raised_exception{dlx::Exception::None};
+
+        phi::size_t               memory_starting_address{0u};
+        std::vector<phi::uint8_t> memory;
+
+        // Byte ranges [first, second) of memory which changed since the previously published
+        // state
+        std::vector<std::pair<phi::size_t, phi::size_t>> changed_memory;
+
+        // Incremented for every published state
+        phi::uint64_t sequence{0u};
+    };
+
+    // Runs a processor on a background thread so rendering never waits for the interpreter.
+    // While the worker is running nobody else may access the processor, the current state is
+    // instead published through a triple buffer so neither the worker nor the reader ever block.
+    class ExecutionWorker
+    {
+    public:
+        // Number of instructions executed between checking the stop flag
+        static constexpr const phi::size_t SliceSize{10'000u};
+
+        // Minimum time between two published states, about one frame at 60 fps
+        static constexpr const std::chrono::milliseconds PublishInterval{16};
+
+        ExecutionWorker() noexcept = default;
+
+        ExecutionWorker(const ExecutionWorker&) = delete;
+
+        ExecutionWorker(ExecutionWorker&&) = delete;
+
+        // Stops the worker
+        ~ExecutionWorker() noexcept;
+
+        ExecutionWorker& operator=(const ExecutionWorker&) = delete;
+
+        ExecutionWorker& operator=(ExecutionWorker&&) = delete;
+
+        [[nodiscard]] static constexpr phi::boolean IsSupported() noexcept
+        {
+            return DLXEMU_EXECUTION_WORKER_SUPPORTED;
+        }
+
+        // Runs the processor until it halts, hits a breakpoint or Stop is called. The processor
+        // must outlive the run and must not be accessed until IsRunning returns false.
+        void Start(dlx::Processor& processor) noexcept;
+
+        // Asks the worker to stop after the current slice and waits for it. Does nothing if the
+        // worker isn't running.
+        void Stop() noexcept;
+
+        // False once the processor halted, hit a breakpoint or the worker was stopped
+        [[nodiscard]] phi::boolean IsRunning() const noexcept;
+
+        // Only meaningful once IsRunning returns false
+        [[nodiscard]] dlx::StopReason GetStopReason() const noexcept;
+
+        // Returns the most recently published state. The reference stays valid until the next
+        // call. Must only be called from a single thread.
+        [[nodiscard]] const ExecutionState& AcquireState() noexcept;
+
+    private:
+        void Run(dlx::Processor& processor) noexcept;
+
+        // Only called by the worker thread, or before it is started
+        void Publish(const dlx::Processor& processor) noexcept;
+
+        // The index of the buffer shared between the worker and the reader together with a flag
+        // telling whether it was published since the reader last took it
+        static constexpr const phi::uint8_t IndexMask{0b011u};
+        static constexpr const phi::uint8_t NewStateFlag{0b100u};
+
+        std::array<ExecutionState, 3u> m_States;
+        std::atomic<phi::uint8_t>      m_SharedState{1u};
+        phi::uint8_t                   m_WriteState{0u};
+        phi::uint8_t                   m_ReadState{2u};
+        phi::uint8_t                   m_LastPublishedState{2u};
+        phi::uint64_t                  m_Sequence{0u};
+
+        std::thread                  m_Thread;
+        std::atomic<bool>            m_StopRequested{false};
+        std::atomic<bool>            m_Running{false};
+        std::atomic<dlx::StopReason> m_StopReason{dlx::StopReason::Halted};
+    };
+} // namespace dlxemu
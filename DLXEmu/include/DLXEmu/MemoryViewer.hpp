@@ -3,6 +3,7 @@
 namespace dlxemu
 {
     class Emulator;
+    struct ExecutionState;
 
     class MemoryViewer
     {
@@ -12,6 +13,8 @@ namespace dlxemu
         void Render() noexcept;
 
     private:
+        void RenderExecutionState(const ExecutionState& state) noexcept;
+
         Emulator* m_Emulator;
     };
 } // namespace dlxemu
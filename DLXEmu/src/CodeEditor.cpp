@@ -1555,6 +1555,7 @@ namespace dlxemu
                 0x40000000, // Current line fill
                 0x40808080, // Current line fill (inactive)
                 0x40a0a0a0, // Current line edge
+                0xff0060ff, // Profile heat
         }};
 
         return palette;
@@ -1577,6 +1578,7 @@ namespace dlxemu
                 0x40000000, // Current line fill
                 0x40808080, // Current line fill (inactive)
                 0x40000000, // Current line edge
+                0xff0040e0, // Profile heat
         }};
 
         return palette;
@@ -1599,6 +1601,7 @@ namespace dlxemu
                 0x40000000, // Current line fill
                 0x40808080, // Current line fill (inactive)
                 0x40000000, // Current line edge
+                0xff00c0ff, // Profile heat
         }};
 
         return palette;
@@ -3430,6 +3433,36 @@ namespace dlxemu
                 }
             }
 
+            // Draw the profile heat in the gutter behind the line number
+            const float heat = m_Emulator->GetLineHeat(line_no + 1u);
+            if (heat > 0.0f)
+            {
+                const ImVec2 end = ImVec2(start.x + m_TextStart - space_size,
+                                          line_start_screen_pos.y + m_CharAdvance.y);
+
+                ImVec4 color = ImGui::ColorConvertU32ToFloat4(
+                        GetPaletteForIndex(PaletteIndex::ProfileHeat));
+                color.w *= 0.15f + 0.85f * heat;
+
+                draw_list->AddRectFilled(start, end, ImGui::ColorConvertFloat4ToU32(color));
+
+                const dlx::LineProfile* profile = m_Emulator->GetLineProfile(line_no + 1u);
+                if (profile != nullptr && GImGui->HoveredWindow == ImGui::GetCurrentWindow() &&
+                    ImGui::IsMouseHoveringRect(start, end))
+                {
+                    ImGui::BeginTooltip();
+                    ImGui::Text("Line %u", profile->line);
+                    ImGui::Separator();
+                    ImGui::TextUnformatted(
+                            fmt::format("Executed: {}\nTaken branches: {}\nMemory accesses: {}",
+                                        profile->counters.executed,
+                                        profile->counters.taken_branches,
+                                        profile->counters.memory_accesses)
+                                    .c_str());
+                    ImGui::EndTooltip();
+                }
+            }
+
             // Highlight PC line
             const phi::u64 current_execution_line_number = m_Emulator->GetExecutingLineNumber();
             if (line_no + 1u == current_execution_line_number)
@@ -34,20 +34,23 @@ namespace dlxemu
 
             ImGui::Checkbox("GUI test mode", &m_TestGuiMode);
 
+            // The processor belongs to the worker while it runs
+            const phi::boolean can_dump = !m_Emulator->IsExecutingInBackground();
+
             // Dumps
-            if (ImGui::CollapsingHeader("Processor Dump"))
+            if (ImGui::CollapsingHeader("Processor Dump") && can_dump)
             {
                 const std::string dump = processor.GetProcessorDump();
                 ImGui::TextUnformatted(dump.c_str());
             }
 
-            if (ImGui::CollapsingHeader("Register Dump"))
+            if (ImGui::CollapsingHeader("Register Dump") && can_dump)
             {
                 const std::string dump = processor.GetRegisterDump();
                 ImGui::TextUnformatted(dump.c_str());
             }
 
-            if (ImGui::CollapsingHeader("Memory Dump"))
+            if (ImGui::CollapsingHeader("Memory Dump") && can_dump)
             {
                 const std::string dump = processor.GetMemoryDump();
                 ImGui::TextUnformatted(dump.c_str());
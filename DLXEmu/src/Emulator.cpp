@@ -23,6 +23,10 @@ static int glad_gl_version;
 #include <phi/core/boolean.hpp>
 #include <phi/core/types.hpp>
 #include <phi/text/to_lower_case.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
 
 PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
 
@@ -30,7 +34,12 @@ PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
 
 PHI_GCC_SUPPRESS_WARNING_POP()
 
-static constexpr const phi::size_t MaxExecutionPerFrame{500'000u};
+// Bounds for the number of instructions executed in one batch of the frame budgeted run mode
+static constexpr const phi::size_t MinimumBatchSize{256u};
+static constexpr const phi::size_t MaximumBatchSize{5'000'000u};
+
+// How often the displayed throughput is updated in seconds
+static constexpr const double ThroughputSampleInterval{0.5};
 
 namespace dlxemu
 {
@@ -127,7 +136,9 @@ namespace dlxemu
                            m_CurrentExecutionMode != ExecutionMode::SingleStep;
 
         // Run updates
+        UpdateProcessorFeatures();
         Update();
+        UpdateProfile();
 
         // Add docking space
         const auto* viewport = ImGui::GetWindowViewport();
@@ -149,6 +160,10 @@ namespace dlxemu
         {
             m_RegisterViewer.Render();
         }
+        if (m_ShowProfiler)
+        {
+            RenderProfiler();
+        }
         if (m_ShowOptionsMenu)
         {
             RenderOptionsMenu();
@@ -189,7 +204,16 @@ namespace dlxemu
 
     void Emulator::ParseProgram(phi::string_view source) noexcept
     {
-        m_DLXProgram = dlx::Parser::Parse(source);
+        // The worker must not keep running the program which is about to be replaced
+        if (IsExecutingInBackground())
+        {
+            SetExecutionMode(ExecutionMode::None);
+        }
+
+        // The editor keeps modifying its text so the program needs its own copy
+        m_DLXProgram = dlx::Parser::ParseOwned(
+                std::string(source.data(), source.length().unsafe()));
+        m_ProfileOutdated = true;
 
         if (m_DLXProgram.m_ParseErrors.empty())
         {
@@ -199,7 +223,13 @@ namespace dlxemu
 
     void Emulator::ParseProgram(dlx::TokenStream& tokens) noexcept
     {
-        m_DLXProgram = dlx::Parser::Parse(tokens);
+        if (IsExecutingInBackground())
+        {
+            SetExecutionMode(ExecutionMode::None);
+        }
+
+        m_DLXProgram      = dlx::Parser::Parse(tokens);
+        m_ProfileOutdated = true;
 
         if (m_DLXProgram.m_ParseErrors.empty())
         {
@@ -228,13 +258,17 @@ namespace dlxemu
 
     phi::u64 Emulator::GetExecutingLineNumber() const noexcept
     {
-        if (m_DLXProgram.IsValid() && !m_Processor.IsHalted() &&
-            m_CurrentExecutionMode != ExecutionMode::None)
+        const phi::boolean halted =
+                IsExecutingInBackground() ? m_ExecutionState->halted : m_Processor.IsHalted();
+        const phi::uint32_t program_counter = IsExecutingInBackground() ?
+                                                      m_ExecutionState->program_counter :
+                                                      m_Processor.GetProgramCounter().unsafe();
+
+        if (m_DLXProgram.IsValid() && !halted && m_CurrentExecutionMode != ExecutionMode::None)
         {
-            PHI_ASSERT(m_Processor.GetProgramCounter() < m_DLXProgram.m_Instructions.size());
+            PHI_ASSERT(program_counter < m_DLXProgram.m_Instructions.size());
 
-            const auto& current_instruction =
-                    m_DLXProgram.m_Instructions.at(m_Processor.GetProgramCounter().unsafe());
+            const auto& current_instruction = m_DLXProgram.m_Instructions.at(program_counter);
 
             return current_instruction.GetSourceLine();
         }
@@ -243,6 +277,25 @@ namespace dlxemu
         return 0u;
     }
 
+    float Emulator::GetLineHeat(phi::u32 line_number) const noexcept
+    {
+        if (!m_ShowProfiler || !m_ShowHeatmap || line_number >= m_LineHeat.size())
+        {
+            return 0.0f;
+        }
+
+        return m_LineHeat[line_number.unsafe()];
+    }
+
+    const dlx::LineProfile* Emulator::GetLineProfile(phi::u32 line_number) const noexcept
+    {
+        const auto iterator = std::find_if(
+                m_HotLines.begin(), m_HotLines.end(),
+                [&](const dlx::LineProfile& line) { return line.line == line_number.unsafe(); });
+
+        return iterator != m_HotLines.end() ? &*iterator : nullptr;
+    }
+
     void Emulator::RenderMenuBar() noexcept
     {
         if (ImGui::BeginMainMenuBar())
@@ -323,6 +376,7 @@ namespace dlxemu
                 ImGui::MenuItem("Control Panel", "", &m_ShowControlPanel);
                 ImGui::MenuItem("Memory Viewer", "", &m_ShowMemoryViewer);
                 ImGui::MenuItem("Registry Viewer", "", &m_ShowRegisterViewer);
+                ImGui::MenuItem("Profiler", "", &m_ShowProfiler);
 
 #if defined(PHI_DEBUG)
                 ImGui::Separator();
@@ -357,17 +411,20 @@ namespace dlxemu
 
                 ImGui::Separator();
 
-                if (ImGui::MenuItem("Dump registers to console"))
+                // The processor can't be dumped while the worker is running it
+                const bool can_dump = !IsExecutingInBackground();
+
+                if (ImGui::MenuItem("Dump registers to console", nullptr, false, can_dump))
                 {
                     DLX_TRACE("Register dump:\n" + m_Processor.GetRegisterDump());
                 }
 
-                if (ImGui::MenuItem("Dump memory to console"))
+                if (ImGui::MenuItem("Dump memory to console", nullptr, false, can_dump))
                 {
                     DLX_TRACE("Memory dump:\n" + m_Processor.GetMemoryDump());
                 }
 
-                if (ImGui::MenuItem("Dump processor to console"))
+                if (ImGui::MenuItem("Dump processor to console", nullptr, false, can_dump))
                 {
                     DLX_TRACE("Processor dump:\n" + m_Processor.GetProcessorDump());
                 }
@@ -377,7 +434,7 @@ namespace dlxemu
                     DLX_TRACE("Current program dump:\n" + m_DLXProgram.GetDump());
                 }
 
-                if (ImGui::MenuItem("Full console dump"))
+                if (ImGui::MenuItem("Full console dump", nullptr, false, can_dump))
                 {
                     DLX_TRACE("Register dump:\n" + m_Processor.GetRegisterDump());
                     DLX_TRACE("Memory dump:\n" + m_Processor.GetMemoryDump());
@@ -416,19 +473,60 @@ namespace dlxemu
             ImGui::SameLine();
             if (ImGui::Button("Step"))
             {
+                // Stops the worker first so the processor can be accessed
+                SetExecutionMode(ExecutionMode::SingleStep);
+
                 if (m_Processor.GetCurrentStepCount() == 0u)
                 {
                     DLX_INFO("Loaded program");
                     m_Processor.LoadProgram(m_DLXProgram);
                 }
 
-                SetExecutionMode(ExecutionMode::SingleStep);
-
                 m_Processor.ExecuteStep();
 
                 DLX_INFO("Executed step");
             }
 
+            ImGui::SameLine();
+            ImGui::Checkbox("Record history", &m_RecordHistory);
+
+            // The history can't be accessed while the worker runs the processor
+            const phi::boolean can_step_back =
+                    !IsExecutingInBackground() && m_Processor.GetNumberOfUndoableSteps() != 0u;
+
+            if (!can_step_back)
+            {
+                ImGui::BeginDisabled();
+            }
+
+            ImGui::SameLine();
+            if (ImGui::Button("Step Back"))
+            {
+                SetExecutionMode(ExecutionMode::SingleStep);
+
+                m_Processor.StepBack(1u);
+
+                DLX_INFO("Stepped back");
+            }
+
+            ImGui::SameLine();
+            if (ImGui::Button("Run Backwards to Breakpoint"))
+            {
+                SetExecutionMode(ExecutionMode::SingleStep);
+
+                m_Processor.SetBreakpointsFromSourceLines(m_CodeEditor.GetBreakpoints());
+                if (m_Processor.RunBackwardsUntilBreak(m_Processor.GetNumberOfUndoableSteps()) ==
+                    dlx::StopReason::Breakpoint)
+                {
+                    DLX_INFO("Hit breakpoint");
+                }
+            }
+
+            if (!can_step_back)
+            {
+                ImGui::EndDisabled();
+            }
+
             if (!m_DLXProgram.IsValid())
             {
                 ImGui::EndDisabled();
@@ -442,23 +540,31 @@ namespace dlxemu
             }
 
             // Execution details
+            const phi::boolean  halted          = IsExecutingInBackground() ?
+                                                          m_ExecutionState->halted :
+                                                          m_Processor.IsHalted();
+            const phi::uint32_t program_counter = IsExecutingInBackground() ?
+                                                          m_ExecutionState->program_counter :
+                                                          m_Processor.GetProgramCounter().unsafe();
+            const phi::size_t   step_count      = IsExecutingInBackground() ?
+                                                          m_ExecutionState->step_count :
+                                                          m_Processor.GetCurrentStepCount().unsafe();
+
             ImGui::SameLine();
-            ImGui::Text("Halted: %s,", m_Processor.IsHalted() ? "Yes" : "No");
+            ImGui::Text("Halted: %s,", halted ? "Yes" : "No");
 
             ImGui::SameLine();
-            ImGui::Text("PC: %u,", m_Processor.GetProgramCounter().unsafe());
+            ImGui::Text("PC: %u,", program_counter);
 
             ImGui::SameLine();
-            ImGui::Text("SC: %lu", m_Processor.GetCurrentStepCount().unsafe());
+            ImGui::Text("SC: %lu", step_count);
 
             ImGui::SameLine();
-            if (m_DLXProgram.IsValid() && !m_Processor.IsHalted() &&
-                m_CurrentExecutionMode != ExecutionMode::None)
+            if (m_DLXProgram.IsValid() && !halted && m_CurrentExecutionMode != ExecutionMode::None)
             {
-                PHI_ASSERT(m_Processor.GetProgramCounter() < m_DLXProgram.m_Instructions.size());
+                PHI_ASSERT(program_counter < m_DLXProgram.m_Instructions.size());
 
-                const auto& current_instruction =
-                        m_DLXProgram.m_Instructions.at(m_Processor.GetProgramCounter().unsafe());
+                const auto& current_instruction = m_DLXProgram.m_Instructions.at(program_counter);
 #if PHI_COMPILER_IS(EMCC)
                 ImGui::Text("LN: %llu", current_instruction.GetSourceLine().unsafe());
 #else
@@ -469,6 +575,13 @@ namespace dlxemu
             {
                 ImGui::Text("LN: N/A");
             }
+
+            if (m_CurrentExecutionMode == ExecutionMode::Run)
+            {
+                ImGui::Text("Throughput: %.2f MIPS, Frame time: %.2f ms",
+                            m_InstructionsPerSecond / 1'000'000.0,
+                            static_cast<double>(ImGui::GetIO().DeltaTime) * 1000.0);
+            }
         }
 
         ImGui::End();
@@ -610,6 +723,21 @@ namespace dlxemu
                     ImGui::EndTabItem();
                 }
 
+                if (ImGui::BeginTabItem("Execution"))
+                {
+                    if constexpr (ExecutionWorker::IsSupported())
+                    {
+                        ImGui::TextUnformatted("Run mode executes on a background thread");
+                    }
+                    else
+                    {
+                        ImGui::SliderFloat("Run budget per frame", &m_RunBudgetMS, 1.0f, 30.0f,
+                                           "%.1f ms");
+                    }
+
+                    ImGui::EndTabItem();
+                }
+
                 ImGui::EndTabBar();
             }
         }
@@ -661,6 +789,83 @@ namespace dlxemu
         }
     }
 
+    void Emulator::RenderProfiler() noexcept
+    {
+        if (ImGui::Begin("Profiler", &m_ShowProfiler))
+        {
+            ImGui::Checkbox("Show heatmap", &m_ShowHeatmap);
+
+            // The report is created from the processor which belongs to the worker while running
+            const phi::boolean can_copy = !IsExecutingInBackground() && !m_HotLines.empty();
+
+            ImGui::SameLine();
+            if (!can_copy)
+            {
+                ImGui::BeginDisabled();
+            }
+
+            if (ImGui::Button("Copy report"))
+            {
+                ImGui::SetClipboardText(
+                        m_Processor.GetProfile()
+                                .GetReport(m_DLXProgram, m_DLXProgram.m_Instructions.size())
+                                .c_str());
+            }
+
+            if (!can_copy)
+            {
+                ImGui::EndDisabled();
+            }
+
+            ImGui::TextUnformatted(
+                    fmt::format("Executed instructions: {}", m_ProfiledInstructions).c_str());
+
+            static constexpr const ImGuiTableFlags table_flags =
+                    ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY;
+
+            if (ImGui::BeginTable("##HotLines", 5, table_flags))
+            {
+                ImGui::TableSetupScrollFreeze(0, 1);
+                ImGui::TableSetupColumn("Line");
+                ImGui::TableSetupColumn("Executed");
+                ImGui::TableSetupColumn("Share");
+                ImGui::TableSetupColumn("Taken branches");
+                ImGui::TableSetupColumn("Memory accesses");
+                ImGui::TableHeadersRow();
+
+                // Ordered from the hottest line
+                for (const dlx::LineProfile& line : m_HotLines)
+                {
+                    ImGui::TableNextRow();
+
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(fmt::format("{}", line.line).c_str());
+
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(fmt::format("{}", line.counters.executed).c_str());
+
+                    const double share = 100.0 * static_cast<double>(line.counters.executed) /
+                                         static_cast<double>(m_ProfiledInstructions);
+
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(fmt::format("{:.2f}%", share).c_str());
+
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(
+                            fmt::format("{}", line.counters.taken_branches).c_str());
+
+                    ImGui::TableNextColumn();
+                    ImGui::TextUnformatted(
+                            fmt::format("{}", line.counters.memory_accesses).c_str());
+                }
+
+                ImGui::EndTable();
+            }
+        }
+
+        ImGui::End();
+    }
+
     void Emulator::Update() noexcept
     {
         switch (m_CurrentExecutionMode)
@@ -673,15 +878,50 @@ namespace dlxemu
                 const double current_time = ImGui::GetTime();
                 if (m_LastExecTime + m_StepThroughDelayMS <= current_time)
                 {
+                    m_Processor.SetBreakpointsFromSourceLines(m_CodeEditor.GetBreakpoints());
                     m_Processor.ExecuteStep();
+
+                    if (!m_Processor.IsHalted() &&
+                        m_Processor.HasBreakpoint(m_Processor.GetProgramCounter()))
+                    {
+                        DLX_INFO("Hit breakpoint");
+                        SetExecutionMode(ExecutionMode::SingleStep);
+                    }
                     m_LastExecTime = current_time;
                 }
                 break;
             }
             case ExecutionMode::Run: {
-                for (phi::usize i{0u}; i < MaxExecutionPerFrame; ++i)
+                dlx::StopReason reason{dlx::StopReason::StepLimit};
+
+                if constexpr (ExecutionWorker::IsSupported())
                 {
-                    m_Processor.ExecuteStep();
+                    // The processor belongs to the worker until it stops by itself
+                    if (m_ExecutionWorker.IsRunning())
+                    {
+                        m_ExecutionState = &m_ExecutionWorker.AcquireState();
+                        UpdateThroughput(m_ExecutionState->step_count);
+                        return;
+                    }
+
+                    m_ExecutionWorker.Stop();
+                    m_ExecutionState = nullptr;
+
+                    reason = m_ExecutionWorker.GetStopReason();
+                }
+                else
+                {
+                    m_Processor.SetBreakpointsFromSourceLines(m_CodeEditor.GetBreakpoints());
+                    reason = RunForFrameBudget();
+                }
+
+                UpdateThroughput(m_Processor.GetCurrentStepCount().unsafe());
+
+                // Pause on the instruction with the breakpoint so it can be inspected
+                if (reason == dlx::StopReason::Breakpoint)
+                {
+                    DLX_INFO("Hit breakpoint");
+                    SetExecutionMode(ExecutionMode::SingleStep);
                 }
                 break;
             }
@@ -703,8 +943,27 @@ namespace dlxemu
 
     void Emulator::SetExecutionMode(ExecutionMode mode) noexcept
     {
+        // Every mode change takes the processor back from the worker
+        m_ExecutionWorker.Stop();
+        m_ExecutionState = nullptr;
+
         m_CurrentExecutionMode = mode;
 
+        if (mode == ExecutionMode::Run)
+        {
+            m_ThroughputSampleTime  = ImGui::GetTime();
+            m_ThroughputSampleSteps = m_Processor.GetCurrentStepCount().unsafe();
+            m_InstructionsPerSecond = 0.0;
+        }
+
+        if (mode == ExecutionMode::Run && ExecutionWorker::IsSupported())
+        {
+            // Breakpoints toggled while running only apply to the next run
+            m_Processor.SetBreakpointsFromSourceLines(m_CodeEditor.GetBreakpoints());
+            m_ExecutionWorker.Start(m_Processor);
+            m_ExecutionState = &m_ExecutionWorker.AcquireState();
+        }
+
         if (mode != ExecutionMode::None)
         {
             m_LastExecTime = ImGui::GetTime();
@@ -715,4 +974,176 @@ namespace dlxemu
             m_CodeEditor.SetReadOnly(false);
         }
     }
+
+    dlx::StopReason Emulator::RunForFrameBudget() noexcept
+    {
+        using clock = std::chrono::steady_clock;
+
+        const clock::time_point frame_start = clock::now();
+        const std::chrono::duration<double, std::nano> budget =
+                std::chrono::duration<double, std::milli>(m_RunBudgetMS);
+
+        dlx::StopReason reason      = dlx::StopReason::StepLimit;
+        phi::boolean    first_batch = true;
+
+        while (true)
+        {
+            const clock::time_point batch_start = clock::now();
+            const double            remaining_ns =
+                    budget.count() -
+                    std::chrono::duration<double, std::nano>(batch_start - frame_start).count();
+
+            if (!first_batch)
+            {
+                // Stop once not even the smallest batch fits anymore. The first batch always runs
+                // so the program makes progress with any budget.
+                if (remaining_ns <
+                    static_cast<double>(MinimumBatchSize) * m_NanosecondsPerInstruction)
+                {
+                    break;
+                }
+
+                // RunUntilBreak always executes the first instruction so check for a breakpoint
+                // on it ourselves, except when resuming from one
+                if (!m_Processor.IsHalted() &&
+                    m_Processor.HasBreakpoint(m_Processor.GetProgramCounter()))
+                {
+                    reason = dlx::StopReason::Breakpoint;
+                    break;
+                }
+            }
+            first_batch = false;
+
+            // Only fill half of the remaining time so a too optimistic estimate can't overshoot
+            // the budget by much. The batches shrink until the budget is used up.
+            const phi::size_t batch_size = std::clamp(
+                    static_cast<phi::size_t>(std::max(remaining_ns, 0.0) /
+                                             (2.0 * m_NanosecondsPerInstruction)),
+                    MinimumBatchSize, MaximumBatchSize);
+
+            const phi::size_t steps_before = m_Processor.GetCurrentStepCount().unsafe();
+            reason                         = m_Processor.RunUntilBreak(batch_size);
+            const phi::size_t executed = m_Processor.GetCurrentStepCount().unsafe() - steps_before;
+
+            // Smooth the measured cost since single batches are noisy
+            if (executed >= MinimumBatchSize)
+            {
+                const double measured_ns =
+                        std::chrono::duration<double, std::nano>(clock::now() - batch_start)
+                                .count() /
+                        static_cast<double>(executed);
+
+                m_NanosecondsPerInstruction =
+                        std::max(0.75 * m_NanosecondsPerInstruction + 0.25 * measured_ns, 0.1);
+            }
+
+            if (reason != dlx::StopReason::StepLimit)
+            {
+                break;
+            }
+        }
+
+        return reason;
+    }
+
+    void Emulator::UpdateThroughput(phi::size_t step_count) noexcept
+    {
+        const double current_time = ImGui::GetTime();
+        const double elapsed      = current_time - m_ThroughputSampleTime;
+
+        if (elapsed < ThroughputSampleInterval)
+        {
+            return;
+        }
+
+        if (step_count >= m_ThroughputSampleSteps)
+        {
+            m_InstructionsPerSecond =
+                    static_cast<double>(step_count - m_ThroughputSampleSteps) / elapsed;
+        }
+
+        m_ThroughputSampleTime  = current_time;
+        m_ThroughputSampleSteps = step_count;
+    }
+
+    void Emulator::UpdateProcessorFeatures() noexcept
+    {
+        // The worker owns the processor so changes apply once it stops
+        if (IsExecutingInBackground())
+        {
+            return;
+        }
+
+        const phi::boolean profiling = m_ShowProfiler;
+        if (m_Processor.IsProfilingEnabled() != profiling)
+        {
+            // Counts from an earlier time the profiler was open would be mixed in otherwise
+            m_Processor.ClearProfile();
+            m_Processor.SetProfilingEnabled(profiling);
+            m_ProfileOutdated = true;
+        }
+
+        const phi::boolean record_history = m_RecordHistory;
+        if (m_Processor.IsReverseExecutionEnabled() != record_history)
+        {
+            m_Processor.SetReverseExecutionEnabled(record_history);
+        }
+    }
+
+    void Emulator::UpdateProfile() noexcept
+    {
+        // The worker owns the processor so the last profile is kept until it stops
+        if (IsExecutingInBackground())
+        {
+            return;
+        }
+
+        const dlx::ExecutionProfile& profile = m_Processor.GetProfile();
+
+        // The processor keeps the previous program while the source has errors
+        if (!m_Processor.IsProfilingEnabled() || !m_DLXProgram.IsValid() ||
+            profile.GetInstructions().size() != m_DLXProgram.m_Instructions.size())
+        {
+            m_HotLines.clear();
+            m_LineHeat.clear();
+            m_ProfiledInstructions = 0u;
+            return;
+        }
+
+        if (!m_ProfileOutdated && profile.GetTotalExecuted() == m_ProfiledInstructions)
+        {
+            return;
+        }
+
+        m_HotLines             = profile.GetHotLines(m_DLXProgram);
+        m_ProfiledInstructions = profile.GetTotalExecuted();
+        m_ProfileOutdated      = false;
+
+        m_LineHeat.clear();
+        if (m_HotLines.empty())
+        {
+            return;
+        }
+
+        // Loops quickly dominate the counts so the heat is logarithmic to keep the colder lines
+        // distinguishable
+        const double hottest =
+                std::log1p(static_cast<double>(m_HotLines.front().counters.executed));
+
+        for (const dlx::LineProfile& line : m_HotLines)
+        {
+            if (line.line >= m_LineHeat.size())
+            {
+                m_LineHeat.resize(line.line + 1u, 0.0f);
+            }
+
+            m_LineHeat[line.line] = static_cast<float>(
+                    std::log1p(static_cast<double>(line.counters.executed)) / hottest);
+        }
+    }
+
+    phi::boolean Emulator::IsExecutingInBackground() const noexcept
+    {
+        return m_ExecutionState != nullptr;
+    }
 } // namespace dlxemu
@@ -0,0 +1,185 @@
+#include "DLXEmu/ExecutionWorker.hpp"
+
+#include <DLX/MemoryBlock.hpp>
+#include <DLX/RegisterNames.hpp>
+#include <phi/core/assert.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace dlxemu
+{
+    // Granularity in bytes in which changed memory is reported
+    static constexpr const phi::size_t ChangedMemoryGranularity{64u};
+
+    ExecutionWorker::~ExecutionWorker() noexcept
+    {
+        Stop();
+    }
+
+    void ExecutionWorker::Start(dlx::Processor& processor) noexcept
+    {
+        Stop();
+
+        // The worker isn't running yet so publishing from this thread is fine. This makes the
+        // state available right away.
+        Publish(processor);
+
+        m_StopRequested.store(false, std::memory_order_relaxed);
+        m_Running.store(true, std::memory_order_release);
+
+#if DLXEMU_EXECUTION_WORKER_SUPPORTED
+        m_Thread = std::thread([this, &processor]() { Run(processor); });
+#else
+        PHI_ASSERT_NOT_REACHED();
+#endif
+    }
+
+    void ExecutionWorker::Stop() noexcept
+    {
+        m_StopRequested.store(true, std::memory_order_relaxed);
+
+        if (m_Thread.joinable())
+        {
+            m_Thread.join();
+        }
+    }
+
+    phi::boolean ExecutionWorker::IsRunning() const noexcept
+    {
+        return m_Running.load(std::memory_order_acquire);
+    }
+
+    dlx::StopReason ExecutionWorker::GetStopReason() const noexcept
+    {
+        return m_StopReason.load(std::memory_order_relaxed);
+    }
+
+    const ExecutionState& ExecutionWorker::AcquireState() noexcept
+    {
+        if ((m_SharedState.load(std::memory_order_relaxed) & NewStateFlag) != 0u)
+        {
+            const phi::uint8_t previous =
+                    m_SharedState.exchange(m_ReadState, std::memory_order_acq_rel);
+            m_ReadState = previous & IndexMask;
+        }
+
+        return m_States[m_ReadState];
+    }
+
+    void ExecutionWorker::Run(dlx::Processor& processor) noexcept
+    {
+        using clock = std::chrono::steady_clock;
+
+        clock::time_point last_publish = clock::now();
+        dlx::StopReason   reason       = dlx::StopReason::StepLimit;
+        phi::boolean      first_slice  = true;
+
+        while (!m_StopRequested.load(std::memory_order_relaxed))
+        {
+            // RunUntilBreak always executes the first instruction so check for a breakpoint on it
+            // ourselves, except when resuming from one
+            if (!first_slice && !processor.IsHalted() &&
+                processor.HasBreakpoint(processor.GetProgramCounter()))
+            {
+                reason = dlx::StopReason::Breakpoint;
+                break;
+            }
+            first_slice = false;
+
+            reason = processor.RunUntilBreak(SliceSize);
+            if (reason != dlx::StopReason::StepLimit)
+            {
+                break;
+            }
+
+            const clock::time_point now = clock::now();
+            if (now - last_publish >= PublishInterval)
+            {
+                Publish(processor);
+                last_publish = now;
+            }
+        }
+
+        Publish(processor);
+
+        m_StopReason.store(reason, std::memory_order_relaxed);
+        m_Running.store(false, std::memory_order_release);
+    }
+
+    void ExecutionWorker::Publish(const dlx::Processor& processor) noexcept
+    {
+        ExecutionState& state = m_States[m_WriteState];
+
+        for (phi::uint32_t index{0u}; index < 32u; ++index)
+        {
+            state.int_registers[index] =
+                    processor
+                            .GetIntRegister(static_cast<dlx::IntRegisterID>(
+                                    index + static_cast<phi::uint32_t>(dlx::IntRegisterID::R0)))
+                            .GetSignedValue()
+                            .unsafe();
+            state.float_registers[index] =
+                    processor
+                            .GetFloatRegister(static_cast<dlx::FloatRegisterID>(
+                                    index + static_cast<phi::uint32_t>(dlx::FloatRegisterID::F0)))
+                            .GetValue()
+                            .unsafe();
+        }
+
+        state.fpsr                  = processor.GetFPSRValue();
+        state.program_counter       = processor.GetProgramCounter().unsafe();
+        state.step_count            = processor.GetCurrentStepCount().unsafe();
+        state.halted                = processor.IsHalted();
+        state.last_raised_exception = processor.GetLastRaisedException();
+
+        // Use the const overload so the memory isn't marked as dirty
+        const dlx::MemoryBlock&                           memory = processor.GetMemory();
+        const std::vector<dlx::MemoryBlock::MemoryByte>& values = memory.GetRawMemory();
+
+        state.memory_starting_address = memory.GetStartingAddress().unsafe();
+        state.memory.resize(values.size());
+        if (!values.empty())
+        {
+            std::memcpy(state.memory.data(), &values.front().signed_value, values.size());
+        }
+
+        // Compare against the last published state which the reader may still be using, but
+        // neither of us modify it
+        const ExecutionState& previous = m_States[m_LastPublishedState];
+
+        state.changed_memory.clear();
+        for (phi::size_t begin{0u}; begin < state.memory.size();
+             begin += ChangedMemoryGranularity)
+        {
+            const phi::size_t end = std::min(begin + ChangedMemoryGranularity, state.memory.size());
+
+            const phi::boolean changed =
+                    end > previous.memory.size() ||
+                    previous.memory_starting_address != state.memory_starting_address ||
+                    std::memcmp(state.memory.data() + begin, previous.memory.data() + begin,
+                                end - begin) != 0;
+            if (!changed)
+            {
+                continue;
+            }
+
+            // Merge adjacent changes into a single range
+            if (!state.changed_memory.empty() && state.changed_memory.back().second == begin)
+            {
+                state.changed_memory.back().second = end;
+            }
+            else
+            {
+                state.changed_memory.emplace_back(begin, end);
+            }
+        }
+
+        state.sequence = ++m_Sequence;
+
+        // Hand the buffer over to the reader and take the one it isn't using anymore
+        const phi::uint8_t previous_shared = m_SharedState.exchange(
+                static_cast<phi::uint8_t>(m_WriteState | NewStateFlag), std::memory_order_acq_rel);
+        m_LastPublishedState = m_WriteState;
+        m_WriteState         = previous_shared & IndexMask;
+    }
+} // namespace dlxemu
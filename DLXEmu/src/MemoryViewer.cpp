@@ -5,6 +5,7 @@
 #include "DLXEmu/Emulator.hpp"
 #include <imgui.h>
 #include <phi/core/types.hpp>
+#include <cstring>
 
 namespace dlxemu
 {
@@ -16,6 +17,13 @@ namespace dlxemu
     {
         if (ImGui::Begin("Memory Viewer", &m_Emulator->m_ShowMemoryViewer))
         {
+            if (m_Emulator->IsExecutingInBackground())
+            {
+                RenderExecutionState(*m_Emulator->m_ExecutionState);
+                ImGui::End();
+                return;
+            }
+
             dlx::MemoryBlock& mem = m_Emulator->GetProcessor().GetMemory();
 
             std::vector<dlx::MemoryBlock::MemoryByte>& values = mem.GetRawMemory();
@@ -41,4 +49,40 @@ namespace dlxemu
 
         ImGui::End();
     }
+
+    void MemoryViewer::RenderExecutionState(const ExecutionState& state) noexcept
+    {
+        // Read only since the processor belongs to the worker
+        ImGui::BeginDisabled();
+
+        auto changed_range = state.changed_memory.begin();
+
+        for (phi::size_t index{0}; index + 4u <= state.memory.size(); index += 4)
+        {
+            while (changed_range != state.changed_memory.end() && changed_range->second <= index)
+            {
+                ++changed_range;
+            }
+
+            // Highlight the words modified since the previous state
+            const phi::boolean changed =
+                    changed_range != state.changed_memory.end() && changed_range->first <= index;
+
+            if (changed)
+            {
+                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.8f, 0.0f, 1.0f));
+            }
+
+            phi::int32_t value;
+            std::memcpy(&value, state.memory.data() + index, sizeof(value));
+            ImGui::InputInt(std::to_string(state.memory_starting_address + index).c_str(), &value);
+
+            if (changed)
+            {
+                ImGui::PopStyleColor();
+            }
+        }
+
+        ImGui::EndDisabled();
+    }
 } // namespace dlxemu
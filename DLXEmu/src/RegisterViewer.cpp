@@ -23,6 +23,9 @@ namespace dlxemu
         if (ImGui::Begin("Register Viewer", &m_Emulator->m_ShowRegisterViewer))
         {
             dlx::Processor& proc = m_Emulator->GetProcessor();
+            // While running in the background only the published state may be accessed
+            const ExecutionState* state = m_Emulator->m_ExecutionState;
+
             if (ImGui::BeginTabBar("RegisterTabs"))
             {
                 // Integer Registers
@@ -35,6 +38,13 @@ namespace dlxemu
 
                     for (phi::uint32_t index{1}; index < 32; ++index)
                     {
+                        if (state != nullptr)
+                        {
+                            phi::int32_t value = state->int_registers[index];
+                            ImGui::InputInt(fmt::format("R{}", index).c_str(), &value);
+                            continue;
+                        }
+
                         ImGui::InputInt(fmt::format("R{}", index).c_str(),
                                         reinterpret_cast<phi::int32_t*>(&proc.GetIntRegister(
                                                 static_cast<dlx::IntRegisterID>(
@@ -60,6 +70,13 @@ namespace dlxemu
 
                     for (phi::uint32_t index{0}; index < 32; ++index)
                     {
+                        if (state != nullptr)
+                        {
+                            float value = state->float_registers[index];
+                            ImGui::InputFloat(fmt::format("F{}", index).c_str(), &value);
+                            continue;
+                        }
+
                         ImGui::InputFloat(
                                 fmt::format("F{}", index).c_str(),
                                 reinterpret_cast<float*>(
@@ -68,7 +85,15 @@ namespace dlxemu
                                                                 dlx::FloatRegisterID::F0)))));
                     }
 
-                    ImGui::Checkbox("FPSR", reinterpret_cast<bool*>(&proc.GetFPSR()));
+                    if (state != nullptr)
+                    {
+                        bool fpsr = state->fpsr;
+                        ImGui::Checkbox("FPSR", &fpsr);
+                    }
+                    else
+                    {
+                        ImGui::Checkbox("FPSR", reinterpret_cast<bool*>(&proc.GetFPSR()));
+                    }
 
                     if (m_Emulator->m_DisableEditing)
                     {
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dlx
+{
+    struct BatchJob;
+    struct BatchResult;
+
+    // Consecutive words of memory reported after a run
+    struct MemoryRange
+    {
+        phi::uint32_t address{0u};
+        phi::uint32_t words{1u};
+    };
+
+    enum class BatchStatus
+    {
+        // Executed HALT or ran past the last instruction
+        Halted,
+        // Executed the maximum number of steps of the job
+        StepLimit,
+        // Stopped by an exception other than Halt
+        Exception,
+    };
+
+    [[nodiscard]] BatchStatus GetBatchStatus(const BatchJob&    job,
+                                             const BatchResult& result) noexcept;
+
+    // Applies one assignment of an initial value to the job:
+    //
+    //   R<n> = <integer>            Decimal or 0x prefixed hexadecimal, signed or unsigned
+    //   F<n> = <float>
+    //   D<n> = <double>             Stored in F<n> and F<n+1>, n must be even
+    //   FPSR = <0 or 1>
+    //   M[<address>] = <integer>    32-bit word
+    //   MF[<address>] = <float>
+    //   MD[<address>] = <double>
+    //
+    // Names are case insensitive and whitespace around the parts is ignored. Memory addresses
+    // are absolute and must be aligned within the memory of the job, so its starting address
+    // and size have to be set first. Returns false and describes the problem in error if the
+    // assignment is invalid, in which case the job is left unchanged.
+    [[nodiscard]] phi::boolean ApplyBatchAssignment(BatchJob& job, std::string_view assignment,
+                                                    std::string& error) noexcept;
+
+    // Applies one assignment per line. Empty lines and everything after a '#' are ignored.
+    // Stops at the first invalid line and names it in error.
+    [[nodiscard]] phi::boolean ApplyBatchAssignments(BatchJob& job, std::string_view text,
+                                                     std::string& error) noexcept;
+
+    PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wabi-tag")
+
+    // Status, steps, registers and the given memory ranges, one value per line
+    [[nodiscard]] std::string FormatBatchResult(
+            const BatchJob& job, const BatchResult& result,
+            const std::vector<MemoryRange>& memory_ranges) noexcept;
+
+    // The same as a single line JSON object. The input is included if it isn't empty. Words
+    // outside of the memory and floats which aren't finite are written as null.
+    [[nodiscard]] std::string FormatBatchResultJson(const BatchJob& job, const BatchResult& result,
+                                                    const std::vector<MemoryRange>& memory_ranges,
+                                                    std::string_view input = {}) noexcept;
+
+    // Quotes and escapes the value for use in JSON
+    [[nodiscard]] std::string FormatJsonString(std::string_view value) noexcept;
+
+    PHI_GCC_SUPPRESS_WARNING_POP()
+} // namespace dlx
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "DLX/Processor.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dlx
+{
+    struct ParsedProgram;
+
+    // Initial state of the processor for one execution of the program
+    struct BatchJob
+    {
+        std::array<phi::int32_t, 32u> int_registers{};
+        std::array<float, 32u>        float_registers{};
+        phi::boolean                  fpsr{false};
+
+        phi::usize memory_starting_address{1000u};
+        phi::usize memory_size{1000u};
+
+        // Copied to the start of the memory, the rest of the memory is zeroed
+        std::vector<phi::uint8_t> memory_image;
+
+        // Zero executes the program until it halts
+        phi::usize max_number_of_steps{10'000u};
+    };
+
+    // Final state of the processor after executing a BatchJob
+    struct BatchResult
+    {
+        std::array<phi::int32_t, 32u> int_registers{};
+        std::array<float, 32u>        float_registers{};
+        phi::boolean                  fpsr{false};
+
+        std::vector<phi::uint8_t> memory;
+
+        phi::u32   program_counter{0u};
+        phi::usize step_count{0u};
+        Exception  last_raised_exception{Exception::None};
+    };
+
+    // Whether the memory image fits into the memory of the job
+    [[nodiscard]] phi::boolean IsBatchJobValid(const BatchJob& job) noexcept;
+
+    // Sets up the initial state of the job, executes the program already loaded into the
+    // processor and collects the final state. Invalid jobs aren't executed, their result holds
+    // the initial registers, no memory and the AddressOutOfBounds exception.
+    void ExecuteBatchJob(FastProcessor& processor, const BatchJob& job,
+                         BatchResult& result) noexcept;
+
+    // Executes one program against many initial states on a pool of worker threads. Each worker
+    // owns a FastProcessor which stays loaded with the program for the whole batch. The jobs are
+    // split evenly between the workers and idle workers steal half of the remaining jobs of
+    // another worker.
+    class BatchRunner
+    {
+    public:
+        // Uses one worker per hardware thread when number_of_threads is zero
+        explicit BatchRunner(phi::size_t number_of_threads = 0u) noexcept;
+
+        BatchRunner(const BatchRunner&) = delete;
+
+        BatchRunner(BatchRunner&&) = delete;
+
+        ~BatchRunner() noexcept;
+
+        BatchRunner& operator=(const BatchRunner&) = delete;
+
+        BatchRunner& operator=(BatchRunner&&) = delete;
+
+        // Executes the program once for every job and returns the results in the order of the
+        // jobs. Returns no results if the program has parse errors. The program must not be
+        // modified until the call returns. Concurrent calls are executed one after another.
+        [[nodiscard]] std::vector<BatchResult> Run(const ParsedProgram&         program,
+                                                   const std::vector<BatchJob>& jobs) noexcept;
+
+        [[nodiscard]] phi::size_t GetNumberOfThreads() const noexcept;
+
+    private:
+        struct Worker
+        {
+            // Remaining jobs [begin, end) with begin in the lower and end in the upper 32 bits
+            alignas(64) std::atomic<phi::uint64_t> jobs{0u};
+            FastProcessor processor;
+        };
+
+        void WorkerMain(phi::size_t index) noexcept;
+
+        void ExecuteBatch(Worker& worker, phi::size_t index) noexcept;
+
+        [[nodiscard]] phi::boolean StealJobs(Worker& thief, phi::size_t index) noexcept;
+
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+        std::vector<std::thread>             m_Threads;
+
+        // Held for the whole of Run since the workers execute a single batch at a time
+        std::mutex m_RunMutex;
+
+        std::mutex              m_Mutex;
+        std::condition_variable m_BatchStarted;
+        std::condition_variable m_BatchFinished;
+        phi::size_t             m_Generation{0u};
+        phi::size_t             m_BusyWorkers{0u};
+        phi::boolean            m_Stop{false};
+
+        const ParsedProgram*         m_Program{nullptr};
+        const std::vector<BatchJob>* m_Jobs{nullptr};
+        std::vector<BatchResult>*    m_Results{nullptr};
+    };
+} // namespace dlx
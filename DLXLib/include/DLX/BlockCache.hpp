@@ -0,0 +1,125 @@
+#pragma once
+
+#include "DLX/DecodedProgram.hpp"
+#include "DLX/EnumName.hpp"
+#include "DLX/OpCode.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/types.hpp>
+#include <vector>
+
+namespace dlx
+{
+    // Common instruction sequences which are executed by a single handler. The name lists the
+    // fused instructions in program order.
+#define DLX_ENUM_SUPERINSTRUCTION                                                                  \
+    DLX_ENUM_SUPERINSTRUCTION_IMPL(SLT_BEQZ)                                                       \
+    DLX_ENUM_SUPERINSTRUCTION_IMPL(ADDI_J)                                                         \
+    DLX_ENUM_SUPERINSTRUCTION_IMPL(LW_ADD_SW)
+
+    enum class Superinstruction
+    {
+#define DLX_ENUM_SUPERINSTRUCTION_IMPL(name) name,
+
+        DLX_ENUM_SUPERINSTRUCTION
+
+#undef DLX_ENUM_SUPERINSTRUCTION_IMPL
+
+                NUMBER_OF_ELEMENTS,
+    };
+
+    PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wreturn-type")
+    PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(4702)
+
+    template <>
+    [[nodiscard]] constexpr phi::string_view enum_name<Superinstruction>(
+            Superinstruction value) noexcept
+    {
+        switch (value)
+        {
+#define DLX_ENUM_SUPERINSTRUCTION_IMPL(name)                                                       \
+    case Superinstruction::name:                                                                   \
+        return #name;
+
+            DLX_ENUM_SUPERINSTRUCTION
+
+#undef DLX_ENUM_SUPERINSTRUCTION_IMPL
+
+            default:
+                PHI_ASSERT_NOT_REACHED();
+        }
+    }
+
+    PHI_MSVC_SUPPRESS_WARNING_POP()
+    PHI_GCC_SUPPRESS_WARNING_POP()
+
+    [[nodiscard]] constexpr phi::size_t GetSuperinstructionLength(Superinstruction value) noexcept
+    {
+        return value == Superinstruction::LW_ADD_SW ? 3u : 2u;
+    }
+
+    // Returns the superinstruction starting at the given index if the whole sequence lies within
+    // the straight line block ending at block_end
+    [[nodiscard]] phi::optional<Superinstruction> MatchSuperinstruction(
+            const DecodedProgram& program, phi::size_t index, phi::size_t block_end) noexcept;
+
+    // One entry of a cached block which executes one or more instructions
+    struct BlockOperation
+    {
+        // Handlers are numbered with all opcodes first, followed by all superinstructions and
+        // finally the marker ending every cached block
+        static constexpr const phi::uint32_t FirstSuperinstructionHandler =
+                static_cast<phi::uint32_t>(OpCode::NUMBER_OF_ELEMENTS);
+        static constexpr const phi::uint32_t EndOfBlockHandler =
+                FirstSuperinstructionHandler +
+                static_cast<phi::uint32_t>(Superinstruction::NUMBER_OF_ELEMENTS);
+
+        const DecodedInstruction* instruction{nullptr};
+        phi::uint32_t             index{0u};
+        phi::uint32_t             handler{EndOfBlockHandler};
+    };
+
+    // Lazily discovered straight line blocks of a decoded program with common instruction
+    // sequences fused into superinstructions. Every cached block ends with an operation using the
+    // EndOfBlockHandler.
+    class BlockCache
+    {
+    public:
+        // Drops all cached blocks and prepares for a program with the given number of instructions
+        void Reset(phi::size_t number_of_instructions) noexcept;
+
+        // Returns the first operation of the block starting at the given instruction. The pointer
+        // is invalidated by the next call.
+        [[nodiscard]] const BlockOperation* GetBlock(const DecodedProgram& program,
+                                                     phi::uint32_t         start) noexcept
+        {
+            PHI_ASSERT(m_BlockOffsets.size() == program.m_Instructions.size(),
+                       "BlockCache was not reset for the current program");
+            PHI_ASSERT(start < m_BlockOffsets.size());
+
+            const phi::uint32_t offset = m_BlockOffsets[start];
+            if (offset != NotCached)
+            {
+                return &m_Operations[offset];
+            }
+
+            return CacheBlock(program, start);
+        }
+
+        [[nodiscard]] phi::usize GetNumberOfCachedBlocks() const noexcept;
+
+        [[nodiscard]] phi::usize GetNumberOfFusedOperations() const noexcept;
+
+    private:
+        [[nodiscard]] const BlockOperation* CacheBlock(const DecodedProgram& program,
+                                                       phi::uint32_t         start) noexcept;
+
+        static constexpr const phi::uint32_t NotCached = phi::uint32_t(-1);
+
+        std::vector<BlockOperation> m_Operations;
+        std::vector<phi::uint32_t>  m_BlockOffsets;
+        phi::size_t                 m_NumberOfCachedBlocks{0u};
+        phi::size_t                 m_NumberOfFusedOperations{0u};
+    };
+} // namespace dlx
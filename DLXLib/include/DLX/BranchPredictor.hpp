@@ -0,0 +1,172 @@
+#pragma once
+
+#include "DLX/PipelineModel.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+#include <string>
+#include <vector>
+
+namespace dlx
+{
+    struct DecodedProgram;
+    struct ParsedProgram;
+
+    // How the direction of conditional branches is predicted. Unconditional jumps are always
+    // predicted taken.
+    enum class BranchPredictorType : phi::uint8_t
+    {
+        AlwaysNotTaken,
+        AlwaysTaken,
+        BackwardTaken, // Backward branches taken, forward branches not taken
+        OneBit,        // Last outcome per branch
+        TwoBit,        // Saturating counter per branch
+        GShare,        // Saturating counters indexed by the branch xor the global history
+        Tournament,    // Chooses between TwoBit and GShare per branch
+    };
+
+    struct BranchPredictorConfig
+    {
+        BranchPredictorType type{BranchPredictorType::TwoBit};
+
+        // Each prediction table has 2^table_bits entries indexed by the instruction index
+        phi::uint32_t table_bits{10u};
+
+        // Number of conditional branch outcomes in the global history, at most table_bits
+        phi::uint32_t history_bits{8u};
+
+        // Direct mapped branch target buffer remembering the targets of taken control transfers.
+        // Has to be a power of two, 0 disables it.
+        phi::uint32_t btb_entries{64u};
+
+        // Return address stack predicting the targets of JR R31. 0 disables it.
+        phi::uint32_t ras_entries{8u};
+
+        // Should match the pipeline model so the penalties agree
+        BranchResolution branch_resolution{BranchResolution::Decode};
+
+        static constexpr const phi::uint32_t MaximumTableBits{20u};
+        static constexpr const phi::uint32_t MaximumBTBEntries{1u << 16u};
+        static constexpr const phi::uint32_t MaximumRASEntries{256u};
+
+        [[nodiscard]] phi::boolean IsValid() const noexcept;
+    };
+
+    // Counters of a single control transfer instruction
+    struct BranchProfile
+    {
+        phi::uint64_t executed{0u};
+        phi::uint64_t taken{0u};
+
+        // The direction of a conditional branch was predicted wrong
+        phi::uint64_t mispredictions{0u};
+
+        // The direction was right but the target wasn't known when fetching the next instruction
+        phi::uint64_t misfetches{0u};
+
+        // Cycles lost by fetching the wrong instructions
+        phi::uint64_t penalty_cycles{0u};
+
+        // Share of executions fetching the right next instruction or 0 if never executed
+        [[nodiscard]] double GetAccuracy() const noexcept;
+    };
+
+    // Predicts every executed control transfer instruction when it is fetched and counts the
+    // cycles lost by fetching the wrong instructions. The penalties follow the pipeline model:
+    // targets of jumps to a label are known in the decode stage, directions and register targets
+    // once the branch is resolved.
+    //
+    // Without a branch target buffer hit the fetch stage continues with the next instruction, so
+    // even correctly predicted taken branches lose the cycle until their target is decoded.
+    class BranchPredictor
+    {
+    public:
+        static constexpr const phi::uint32_t InvalidTarget{0xFFFFFFFFu};
+
+        BranchPredictor() noexcept;
+
+        explicit BranchPredictor(const BranchPredictorConfig& config) noexcept;
+
+        // Returns false and keeps the current config if it's invalid. Otherwise all tables and
+        // counters are cleared.
+        phi::boolean SetConfig(const BranchPredictorConfig& config) noexcept;
+
+        [[nodiscard]] const BranchPredictorConfig& GetConfig() const noexcept;
+
+        // Precomputes the control transfer instructions of the program and clears everything
+        void Load(const DecodedProgram& program) noexcept;
+
+        // Clears all tables, the history and counters keeping the loaded program
+        void Clear() noexcept;
+
+        // Predicts the control transfer instruction at index, updates the tables with the actual
+        // outcome and returns the cycles lost. target is the next instruction executed.
+        phi::uint8_t Resolve(phi::uint32_t index, phi::boolean taken,
+                             phi::uint32_t target) noexcept;
+
+        // Totals over all control transfer instructions
+        [[nodiscard]] BranchProfile GetTotals() const noexcept;
+
+        // Indexed by instruction, all zero for instructions which aren't control transfers
+        [[nodiscard]] const std::vector<BranchProfile>& GetBranches() const noexcept;
+
+        PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wabi-tag")
+
+        // Totals followed by the max_branches branches losing the most cycles
+        [[nodiscard]] std::string GetReport(const ParsedProgram& program,
+                                            phi::size_t max_branches = 20u) const noexcept;
+
+        PHI_GCC_SUPPRESS_WARNING_POP()
+
+    private:
+        enum class BranchKind : phi::uint8_t
+        {
+            None,
+            Conditional,
+            Jump,         // J and JAL, the target is known after decoding
+            RegisterJump, // JR and JALR
+            Return,       // JR R31
+        };
+
+        struct BranchInfo
+        {
+            BranchKind    kind{BranchKind::None};
+            phi::boolean  call{false};
+            phi::uint32_t target{InvalidTarget};
+        };
+
+        [[nodiscard]] phi::boolean PredictDirection(phi::uint32_t index,
+                                                    const BranchInfo& info) const noexcept;
+
+        void UpdateDirection(phi::uint32_t index, phi::boolean taken) noexcept;
+
+        [[nodiscard]] phi::uint32_t GShareIndex(phi::uint32_t index) const noexcept;
+
+        BranchPredictorConfig m_Config;
+        phi::uint32_t         m_TableMask{0u};
+        phi::uint32_t         m_HistoryMask{0u};
+
+        std::vector<BranchInfo>    m_Infos;
+        std::vector<BranchProfile> m_Branches;
+
+        // Last outcomes or 2 bit saturating counters per branch, the counters indexed by gshare
+        // and the tournament chooser preferring gshare for values of 2 and 3
+        std::vector<phi::uint8_t> m_LocalCounters;
+        std::vector<phi::uint8_t> m_GlobalCounters;
+        std::vector<phi::uint8_t> m_ChooserCounters;
+        phi::uint32_t             m_History{0u};
+
+        struct BTBEntry
+        {
+            phi::uint32_t index{InvalidTarget};
+            phi::uint32_t target{InvalidTarget};
+        };
+
+        std::vector<BTBEntry> m_BTB;
+
+        // Circular so the oldest return addresses are overwritten on overflow
+        std::vector<phi::uint32_t> m_ReturnStack;
+        phi::uint32_t              m_ReturnTop{0u};
+        phi::uint32_t              m_ReturnDepth{0u};
+    };
+} // namespace dlx
@@ -0,0 +1,269 @@
+#pragma once
+
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dlx
+{
+    struct ParsedProgram;
+
+    enum class CacheReplacementPolicy : phi::uint8_t
+    {
+        LRU,
+        PLRU, // Tree based pseudo LRU
+        Random,
+    };
+
+    enum class CacheWritePolicy : phi::uint8_t
+    {
+        // Writes only mark the line dirty and allocate a line on a miss. Dirty lines are written
+        // to the next level when they are evicted.
+        WriteBack,
+
+        // Writes are passed to the next level and don't allocate a line on a miss
+        WriteThrough,
+    };
+
+    struct CacheConfig
+    {
+        phi::boolean enabled{true};
+
+        // In bytes. All three have to be powers of two.
+        phi::uint32_t size{16384u};
+        phi::uint32_t line_size{32u};
+        phi::uint32_t associativity{4u};
+
+        CacheReplacementPolicy replacement{CacheReplacementPolicy::LRU};
+        CacheWritePolicy       write_policy{CacheWritePolicy::WriteBack};
+
+        static constexpr const phi::uint32_t MinimumLineSize{4u};
+        static constexpr const phi::uint32_t MaximumAssociativity{16u};
+
+        // Whether the sizes are powers of two, lines hold at least 4 bytes, there are at most 16
+        // ways and the cache holds at least one set
+        [[nodiscard]] phi::boolean IsValid() const noexcept;
+    };
+
+    struct CacheHierarchyConfig
+    {
+        CacheConfig instruction;
+        CacheConfig data;
+        CacheConfig unified{true, 262144u, 64u, 8u};
+
+        // Classifies every miss of a cache as compulsory, capacity or conflict miss by
+        // simulating a fully associative LRU cache of the same size next to it. Off by default
+        // since every access then also looks up its line in a hash map of all lines accessed.
+        phi::boolean classify_misses{false};
+
+        phi::uint64_t random_seed{0x9E3779B97F4A7C15u};
+    };
+
+    enum class CacheMissClass : phi::uint8_t
+    {
+        None,
+        Compulsory, // The line was never accessed before
+        Capacity,   // Even a fully associative cache of the same size doesn't hold the line
+        Conflict,   // A fully associative cache of the same size would have hit
+    };
+
+    struct CacheStatistics
+    {
+        phi::uint64_t reads{0u};
+        phi::uint64_t writes{0u};
+        phi::uint64_t read_misses{0u};
+        phi::uint64_t write_misses{0u};
+
+        // Only counted while classifying misses
+        phi::uint64_t compulsory_misses{0u};
+        phi::uint64_t capacity_misses{0u};
+        phi::uint64_t conflict_misses{0u};
+
+        // Dirty lines written to the next level when evicted
+        phi::uint64_t write_backs{0u};
+
+        [[nodiscard]] phi::uint64_t GetAccesses() const noexcept;
+
+        [[nodiscard]] phi::uint64_t GetMisses() const noexcept;
+
+        [[nodiscard]] phi::uint64_t GetHits() const noexcept;
+
+        // Misses per access or 0 without accesses
+        [[nodiscard]] double GetMissRate() const noexcept;
+    };
+
+    struct CacheAccessResult
+    {
+        phi::boolean   hit{false};
+        phi::boolean   allocated{false};
+        CacheMissClass miss_class{CacheMissClass::None};
+
+        // Set when a dirty line was evicted to make room for the accessed one
+        phi::boolean  write_back{false};
+        phi::uint64_t write_back_address{0u};
+    };
+
+    // A single set associative cache. Only the tags are stored, packed into 32 bits each. The
+    // replacement state of a set fits into 64 bits: a stack of 4 bit way indices ordered from the
+    // most to the least recently used way for LRU or the tree bits for PLRU.
+    class Cache
+    {
+    public:
+        // Addresses may use up to 33 bits
+        static constexpr const phi::uint32_t InvalidTag{0xFFFFFFFFu};
+
+        // Expects a valid config. Invalidates all lines and clears the statistics.
+        void Reset(const CacheConfig& config, phi::boolean classify_misses,
+                   phi::uint64_t random_seed) noexcept;
+
+        // Invalidates all lines and clears the statistics keeping the config
+        void Clear() noexcept;
+
+        CacheAccessResult Access(phi::uint64_t address, phi::boolean write) noexcept;
+
+        [[nodiscard]] const CacheConfig& GetConfig() const noexcept;
+
+        [[nodiscard]] const CacheStatistics& GetStatistics() const noexcept;
+
+        [[nodiscard]] phi::uint32_t GetNumberOfSets() const noexcept;
+
+        // Whether the line containing the address is cached
+        [[nodiscard]] phi::boolean Contains(phi::uint64_t address) const noexcept;
+
+    private:
+        [[nodiscard]] phi::uint32_t ChooseVictim(phi::uint32_t set) noexcept;
+
+        void Touch(phi::uint32_t set, phi::uint32_t way) noexcept;
+
+        // Updates the fully associative shadow cache and returns how a miss of the line would be
+        // classified
+        CacheMissClass ClassifyAccess(phi::uint64_t line) noexcept;
+
+        CacheConfig   m_Config;
+        phi::uint32_t m_OffsetBits{0u};
+        phi::uint32_t m_SetBits{0u};
+        phi::uint32_t m_SetMask{0u};
+        phi::uint32_t m_Ways{1u};
+
+        // Ways of a set are stored next to each other
+        std::vector<phi::uint32_t> m_Tags;
+        std::vector<phi::uint64_t> m_ReplacementStates;
+        std::vector<phi::uint16_t> m_DirtyWays;
+
+        phi::uint64_t m_RandomSeed{0u};
+        phi::uint64_t m_RandomState{0u};
+
+        CacheStatistics m_Statistics;
+
+        // Fully associative LRU shadow cache as doubly linked list over a fixed number of nodes.
+        // Lines which were accessed before but aren't resident are mapped to NotResident.
+        struct ShadowNode
+        {
+            phi::uint64_t line;
+            phi::uint32_t previous;
+            phi::uint32_t next;
+        };
+
+        static constexpr const phi::uint32_t NotResident{0xFFFFFFFFu};
+
+        phi::boolean                                     m_ClassifyMisses{false};
+        std::unordered_map<phi::uint64_t, phi::uint32_t> m_ShadowLines;
+        std::vector<ShadowNode>                          m_ShadowNodes;
+        phi::uint32_t                                    m_ShadowHead{NotResident};
+        phi::uint32_t                                    m_ShadowTail{NotResident};
+    };
+
+    enum class CacheLevel : phi::uint8_t
+    {
+        Instruction, // L1 instruction cache
+        Data,        // L1 data cache
+        Unified,     // L2 cache behind both
+    };
+
+    static constexpr const phi::size_t NumberOfCacheLevels{3u};
+
+    // Counters of the accesses caused by an instruction
+    struct InstructionCacheProfile
+    {
+        phi::uint64_t fetch_misses{0u};
+        phi::uint64_t data_accesses{0u};
+        phi::uint64_t data_misses{0u};
+
+        // Misses in the unified cache caused by fetching, loading, storing or writing back
+        phi::uint64_t unified_misses{0u};
+
+        // Classes of the fetch and data misses
+        phi::uint64_t compulsory_misses{0u};
+        phi::uint64_t capacity_misses{0u};
+        phi::uint64_t conflict_misses{0u};
+    };
+
+    // L1 instruction cache, L1 data cache and a unified L2 cache behind them. Instruction i is
+    // fetched from address 4 * i in an address space separate from the data memory so fetches
+    // and data accesses never share a line.
+    class CacheSimulator
+    {
+    public:
+        CacheSimulator() noexcept;
+
+        explicit CacheSimulator(const CacheHierarchyConfig& config) noexcept;
+
+        // Returns false and keeps the current config if one of the enabled caches is invalid.
+        // Otherwise all caches are invalidated and the statistics are cleared.
+        phi::boolean SetConfig(const CacheHierarchyConfig& config) noexcept;
+
+        [[nodiscard]] const CacheHierarchyConfig& GetConfig() const noexcept;
+
+        // Sets the number of instructions, invalidates all lines and clears all counters
+        void Reset(phi::size_t number_of_instructions) noexcept;
+
+        // Invalidates all lines and clears all counters
+        void Clear() noexcept;
+
+        void FetchInstruction(phi::uint32_t index) noexcept;
+
+        // A load or store of size bytes by the instruction at index
+        void AccessData(phi::uint32_t index, phi::uint32_t address, phi::size_t size,
+                        phi::boolean write) noexcept;
+
+        [[nodiscard]] const Cache& GetCache(CacheLevel level) const noexcept;
+
+        [[nodiscard]] const CacheStatistics& GetStatistics(CacheLevel level) const noexcept;
+
+        [[nodiscard]] const std::vector<InstructionCacheProfile>& GetInstructions() const noexcept;
+
+        // Lines read from and written to the memory behind the last enabled cache
+        [[nodiscard]] phi::uint64_t GetMemoryReads() const noexcept;
+
+        [[nodiscard]] phi::uint64_t GetMemoryWrites() const noexcept;
+
+        PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wabi-tag")
+
+        // Statistics of every enabled cache followed by the max_instructions instructions with
+        // the most misses
+        [[nodiscard]] std::string GetReport(const ParsedProgram& program,
+                                            phi::size_t max_instructions = 20u) const noexcept;
+
+        PHI_GCC_SUPPRESS_WARNING_POP()
+
+    private:
+        // Returns whether the access missed in the cache
+        phi::boolean AccessFirstLevel(Cache& cache, phi::uint64_t address, phi::boolean write,
+                                      InstructionCacheProfile& profile) noexcept;
+
+        void AccessUnified(phi::uint64_t address, phi::boolean write,
+                           InstructionCacheProfile& profile) noexcept;
+
+        CacheHierarchyConfig                   m_Config;
+        std::array<Cache, NumberOfCacheLevels> m_Caches;
+
+        std::vector<InstructionCacheProfile> m_Instructions;
+
+        phi::uint64_t m_MemoryReads{0u};
+        phi::uint64_t m_MemoryWrites{0u};
+    };
+} // namespace dlx
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "DLX/InstructionArgument.hpp"
+#include "DLX/InstructionInfo.hpp"
+#include "DLX/OpCode.hpp"
+#include "DLX/RegisterNames.hpp"
+#include <phi/core/assert.hpp>
+#include <phi/core/types.hpp>
+#include <array>
+#include <vector>
+
+namespace dlx
+{
+    class Instruction;
+    struct ParsedProgram;
+
+    // Compact, pre-decoded form of an instruction which can be executed without inspecting the
+    // argument types again. Register operands are stored in argument order, an immediate value or
+    // address displacement is stored sign extended and labels are stored as instruction index.
+    struct DecodedInstruction
+    {
+        InstructionExecutor          executor{nullptr};
+        phi::int32_t                 immediate{0};
+        phi::uint32_t                jump_point{InstructionArgument::Label::UnresolvedJumpPoint};
+        OpCode                       opcode{OpCode::NONE};
+        std::array<phi::uint8_t, 3u> registers{};
+        RegisterAccessType           register_access_type{RegisterAccessType::Ignored};
+
+        [[nodiscard]] constexpr IntRegisterID GetIntRegister(phi::size_t index) const noexcept
+        {
+            PHI_ASSERT(index < registers.size());
+
+            return static_cast<IntRegisterID>(registers[index]);
+        }
+
+        [[nodiscard]] constexpr FloatRegisterID GetFloatRegister(phi::size_t index) const noexcept
+        {
+            PHI_ASSERT(index < registers.size());
+
+            return static_cast<FloatRegisterID>(registers[index]);
+        }
+
+        [[nodiscard]] constexpr phi::i32 GetSignedImmediate() const noexcept
+        {
+            return immediate;
+        }
+
+        [[nodiscard]] constexpr phi::u32 GetUnsignedImmediate() const noexcept
+        {
+            // Immediate values are 16 bit so the unsigned view is zero extended
+            return static_cast<phi::uint32_t>(static_cast<phi::uint16_t>(immediate));
+        }
+    };
+
+    struct DecodedProgram
+    {
+        std::vector<DecodedInstruction> m_Instructions;
+
+        // For every instruction the index of the last instruction of its straight line block. That
+        // is either the next control transfer instruction or the last instruction of the program.
+        std::vector<phi::uint32_t> m_BlockEnds;
+    };
+
+    [[nodiscard]] DecodedInstruction DecodeInstruction(const Instruction& instruction) noexcept;
+
+    [[nodiscard]] DecodedProgram DecodeProgram(const ParsedProgram& program) noexcept;
+} // namespace dlx
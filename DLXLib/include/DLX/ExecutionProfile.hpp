@@ -0,0 +1,79 @@
+#pragma once
+
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+#include <string>
+#include <vector>
+
+namespace dlx
+{
+    struct ParsedProgram;
+
+    struct InstructionProfile
+    {
+        phi::uint64_t executed{0u};
+
+        // Executions which continued somewhere other than the next instruction
+        phi::uint64_t taken_branches{0u};
+
+        phi::uint64_t memory_accesses{0u};
+    };
+
+    // The counters of all instructions on the same source line
+    struct LineProfile
+    {
+        phi::uint32_t      line{0u};
+        InstructionProfile counters;
+    };
+
+    // Execution counters for every instruction of a program, indexed like the instructions
+    class ExecutionProfile
+    {
+    public:
+        // Sets the number of instructions and clears all counters
+        void Reset(phi::size_t number_of_instructions) noexcept;
+
+        void Clear() noexcept;
+
+        void Record(phi::uint32_t index, phi::boolean taken_branch,
+                    phi::boolean memory_access) noexcept
+        {
+            PHI_ASSERT(index < m_Instructions.size());
+
+            InstructionProfile& profile = m_Instructions[index];
+
+            ++profile.executed;
+            profile.taken_branches += taken_branch ? 1u : 0u;
+            profile.memory_accesses += memory_access ? 1u : 0u;
+
+            ++m_TotalExecuted;
+        }
+
+        [[nodiscard]] const std::vector<InstructionProfile>& GetInstructions() const noexcept;
+
+        [[nodiscard]] phi::uint64_t GetTotalExecuted() const noexcept;
+
+        // Instruction indices ordered from the most to the least executed. Instructions which
+        // were never executed are left out.
+        [[nodiscard]] std::vector<phi::uint32_t> GetHotInstructions() const noexcept;
+
+        // The counters summed up per source line of the program, ordered from the most to the
+        // least executed line. Lines which were never executed are left out.
+        [[nodiscard]] std::vector<LineProfile> GetHotLines(
+                const ParsedProgram& program) const noexcept;
+
+        PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wabi-tag")
+
+        // Table of the max_lines hottest lines with their share of all executed instructions
+        [[nodiscard]] std::string GetReport(const ParsedProgram& program,
+                                            phi::size_t          max_lines = 20u) const noexcept;
+
+        PHI_GCC_SUPPRESS_WARNING_POP()
+
+    private:
+        std::vector<InstructionProfile> m_Instructions;
+        phi::uint64_t                   m_TotalExecuted{0u};
+    };
+} // namespace dlx
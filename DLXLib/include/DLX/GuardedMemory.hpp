@@ -0,0 +1,110 @@
+#pragma once
+
+#include <phi/compiler_support/platform.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+
+// Guard page based bounds checking is only implemented for 64-bit Linux
+#if !defined(DLX_GUARDED_MEMORY_SUPPORTED)
+#    if PHI_PLATFORM_IS(LINUX) && (defined(__x86_64__) || defined(__aarch64__))
+#        define DLX_GUARDED_MEMORY_SUPPORTED 1
+#    else
+#        define DLX_GUARDED_MEMORY_SUPPORTED 0
+#    endif
+#endif
+
+#if DLX_GUARDED_MEMORY_SUPPORTED
+#    include <setjmp.h>
+#endif
+
+namespace dlx
+{
+    // A zero initialized block of bytes followed by enough inaccessible address space that any
+    // 32-bit offset from the start of the block, plus the size of the largest value, either lands
+    // inside the block or faults.
+    class GuardedRegion
+    {
+    public:
+        GuardedRegion() noexcept = default;
+
+        // Check IsValid afterwards since reserving the address space may fail
+        explicit GuardedRegion(phi::size_t size) noexcept;
+
+        // Leaves the copy invalid if its region couldn't be reserved, see CopyFrom
+        GuardedRegion(const GuardedRegion& other) noexcept;
+
+        GuardedRegion(GuardedRegion&& other) noexcept;
+
+        ~GuardedRegion() noexcept;
+
+        // Leaves the region invalid if a new region couldn't be reserved, see CopyFrom
+        GuardedRegion& operator=(const GuardedRegion& other) noexcept;
+
+        GuardedRegion& operator=(GuardedRegion&& other) noexcept;
+
+        [[nodiscard]] static constexpr phi::boolean IsSupported() noexcept
+        {
+            return DLX_GUARDED_MEMORY_SUPPORTED;
+        }
+
+        [[nodiscard]] phi::boolean IsValid() const noexcept
+        {
+            return m_Reservation != nullptr;
+        }
+
+        // Copies the content of other into the existing reservation if both have the same size.
+        // Returns false if a new region couldn't be reserved in which case nothing is changed.
+        [[nodiscard]] phi::boolean CopyFrom(const GuardedRegion& other) noexcept;
+
+        // Keeps the content up to the new size. Returns false if the new region couldn't be
+        // reserved in which case nothing is changed.
+        phi::boolean Resize(phi::size_t new_size) noexcept;
+
+        [[nodiscard]] phi::uint8_t* GetData() noexcept
+        {
+            return m_Data;
+        }
+
+        [[nodiscard]] const phi::uint8_t* GetData() const noexcept
+        {
+            return m_Data;
+        }
+
+        [[nodiscard]] phi::size_t GetSize() const noexcept
+        {
+            return m_Size;
+        }
+
+        // Whether the address lies anywhere inside the reservation including the guard area
+        [[nodiscard]] phi::boolean Contains(const void* address) const noexcept;
+
+    private:
+        void Release() noexcept;
+
+        phi::uint8_t* m_Reservation{nullptr};
+        phi::size_t   m_ReservationSize{0u};
+        phi::uint8_t* m_Data{nullptr};
+        phi::size_t   m_Size{0u};
+    };
+
+#if DLX_GUARDED_MEMORY_SUPPORTED
+    // While entered, a fault inside the guard area of the region jumps back to the environment.
+    // Every thread tracks its own innermost execution so processors on different threads don't
+    // interfere with each other.
+    struct GuardedExecution
+    {
+        sigjmp_buf           environment;
+        const GuardedRegion* region{nullptr};
+        GuardedExecution*    previous{nullptr};
+    };
+
+    // Installs the SIGSEGV handler on first use. Faults the handler isn't responsible for are
+    // forwarded to the previously installed handler. The environment must be filled with
+    // sigsetjmp(environment, 0) afterwards and before accessing the region.
+    void EnterGuardedExecution(GuardedExecution& execution, const GuardedRegion& region) noexcept;
+
+    void LeaveGuardedExecution(GuardedExecution& execution) noexcept;
+
+    [[nodiscard]] phi::boolean IsInGuardedExecution(const GuardedRegion& region) noexcept;
+#endif
+} // namespace dlx
@@ -4,6 +4,7 @@
 #include "RegisterNames.hpp"
 #include <phi/compiler_support/warning.hpp>
 #include <phi/core/scope_ptr.hpp>
+#include <limits>
 
 namespace dlx
 {
@@ -37,7 +38,11 @@ namespace dlx
 
         struct Label
         {
+            static constexpr const phi::uint32_t UnresolvedJumpPoint =
+                    std::numeric_limits<phi::uint32_t>::max();
+
             phi::string_view label_name;
+            phi::uint32_t    jump_point{UnresolvedJumpPoint};
         };
 
     public:
@@ -78,6 +83,9 @@ namespace dlx
         friend InstructionArgument ConstructInstructionArgumentLabel(
                 phi::string_view label_name) noexcept;
 
+        friend InstructionArgument ConstructInstructionArgumentLabel(
+                phi::string_view label_name, phi::uint32_t jump_point) noexcept;
+
     private:
         PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(4582) // 'x': constructor is not implicitly called
 
@@ -111,4 +119,7 @@ namespace dlx
             IntRegisterID id, phi::i32 displacement) noexcept;
 
     InstructionArgument ConstructInstructionArgumentLabel(phi::string_view label_name) noexcept;
+
+    InstructionArgument ConstructInstructionArgumentLabel(phi::string_view label_name,
+                                                          phi::uint32_t    jump_point) noexcept;
 } // namespace dlx
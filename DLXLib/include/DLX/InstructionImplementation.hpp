@@ -1,476 +1,477 @@
 #pragma once
 
-#include "DLX/InstructionArgument.hpp"
+#include "DLX/DecodedProgram.hpp"
 #include "DLX/InstructionInfo.hpp"
 #include "DLX/InstructionLibrary.hpp"
+#include "DLX/ProcessorPolicy.hpp"
 
 namespace dlx::impl
 {
     /* Arithmetic */
 
     // Add
-    void ADD(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void ADD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Add immediate
-    void ADDI(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void ADDI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Add unsigned
-    void ADDU(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void ADDU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Add unsigned immediate
-    void ADDUI(Processor& processor, const InstructionArgument& arg1,
-               const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void ADDUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Add float
-    void ADDF(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void ADDF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Add double
-    void ADDD(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void ADDD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Subtract
-    void SUB(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SUB(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Subtract immediate
-    void SUBI(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SUBI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Subtract unsigned
-    void SUBU(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SUBU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Subtract unsigned immediate
-    void SUBUI(Processor& processor, const InstructionArgument& arg1,
-               const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SUBUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Subtract float
-    void SUBF(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SUBF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Subtract double
-    void SUBD(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SUBD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Multiply
-    void MULT(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void MULT(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Multiply immediate
-    void MULTI(Processor& processor, const InstructionArgument& arg1,
-               const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void MULTI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Multiply unsigned
-    void MULTU(Processor& processor, const InstructionArgument& arg1,
-               const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void MULTU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Multiply unsigned immediate
-    void MULTUI(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void MULTUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Multiply float
-    void MULTF(Processor& processor, const InstructionArgument& arg1,
-               const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void MULTF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Multiply double
-    void MULTD(Processor& processor, const InstructionArgument& arg1,
-               const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void MULTD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Divide
-    void DIV(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void DIV(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Divide immediate
-    void DIVI(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void DIVI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Divide unsigned
-    void DIVU(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void DIVU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Divide unsigned immediate
-    void DIVUI(Processor& processor, const InstructionArgument& arg1,
-               const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void DIVUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Divide float
-    void DIVF(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void DIVF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Divide double
-    void DIVD(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void DIVD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Shift left logical
-    void SLL(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SLL(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Shift left logical immediate
-    void SLLI(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SLLI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Shift right logical
-    void SRL(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SRL(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Shift right logical immediate
-    void SRLI(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SRLI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Shift left arithmetic
-    void SLA(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SLA(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Shift left arithmetic immediate
-    void SLAI(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SLAI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Shift right arithmetic
-    void SRA(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SRA(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Shift right arithmetic immediate
-    void SRAI(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SRAI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     /* Logic */
 
     // And
-    void AND(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void AND(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // And immediate
-    void ANDI(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void ANDI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Or
-    void OR(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-            const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void OR(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Or immediate
-    void ORI(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void ORI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // XOR
-    void XOR(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void XOR(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // XOR immediate
-    void XORI(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void XORI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     /* Condition testing */
 
     // Less than
-    void SLT(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SLT(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Less than immediate
-    void SLTI(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SLTI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Less than unsigned
-    void SLTU(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SLTU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Less than unsigned iimmediate
-    void SLTUI(Processor& processor, const InstructionArgument& arg1,
-               const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SLTUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Less than float
-    void LTF(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void LTF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Less than double
-    void LTD(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void LTD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Greater than
-    void SGT(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SGT(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Greater than immediate
-    void SGTI(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SGTI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Greater than unsigned
-    void SGTU(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SGTU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Greater than unsigned immediate
-    void SGTUI(Processor& processor, const InstructionArgument& arg1,
-               const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SGTUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Greater than float
-    void GTF(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void GTF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Greater than double
-    void GTD(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void GTD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Less than or equal
-    void SLE(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SLE(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Less than or equal immediate
-    void SLEI(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SLEI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Less than or equal unsigned
-    void SLEU(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SLEU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Less than or equal unsigned immediate
-    void SLEUI(Processor& processor, const InstructionArgument& arg1,
-               const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SLEUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Less than or equal float
-    void LEF(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void LEF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Less than or equal double
-    void LED(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void LED(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Greater than or equal
-    void SGE(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SGE(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Greater than or equal immediate
-    void SGEI(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SGEI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Greater than or equal unsigned
-    void SGEU(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SGEU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Greater than or equal unsigned immediate
-    void SGEUI(Processor& processor, const InstructionArgument& arg1,
-               const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SGEUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Greater than or equal float
-    void GEF(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void GEF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Greater than or equal double
-    void GED(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void GED(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Equal
-    void SEQ(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SEQ(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Equal immediate
-    void SEQI(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SEQI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Equal unsigned
-    void SEQU(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SEQU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Equal unsigned immediate
-    void SEQUI(Processor& processor, const InstructionArgument& arg1,
-               const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SEQUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Equal float
-    void EQF(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void EQF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Equal double
-    void EQD(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void EQD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Not equal
-    void SNE(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SNE(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Not equal immediate
-    void SNEI(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SNEI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Not equal float
-    void NEF(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void NEF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Not equal double
-    void NED(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void NED(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Not equal unsigned
-    void SNEU(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SNEU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // No equal unsigned immediate
-    void SNEUI(Processor& processor, const InstructionArgument& arg1,
-               const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SNEUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     /* Conditional branching */
 
     // Branch equal zero
-    void BEQZ(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void BEQZ(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Branch not equal zero
-    void BNEZ(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void BNEZ(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Branch floating point true
-    void BFPT(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void BFPT(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Branch floating point false
-    void BFPF(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void BFPF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     /* Unconditional Branching */
 
     // Jump
-    void J(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-           const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void J(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Jump register
-    void JR(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-            const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void JR(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Jump and Link
-    void JAL(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void JAL(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Jump and link register
-    void JALR(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void JALR(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     /* Loading data */
 
     // Load high immediate
-    void LHI(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void LHI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Load byte
-    void LB(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-            const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void LB(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Load unsigned byte
-    void LBU(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void LBU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Load half word (2 bytes)
-    void LH(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-            const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void LH(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Load unsigned half word (2 bytes)
-    void LHU(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void LHU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Load word (4 bytes)
-    void LW(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-            const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void LW(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Load unsigned word (4 bytes)
-    void LWU(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void LWU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Load float (4 bytes)
-    void LF(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-            const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void LF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Load double (8 bytes)
-    void LD(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-            const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void LD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     /* Storing data */
 
     // Store byte
-    void SB(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-            const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SB(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Store unsigned byte
-    void SBU(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SBU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Store half word (2 bytes)
-    void SH(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-            const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SH(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Store unsigned half word (2 bytes)
-    void SHU(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SHU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Store word (4 bytes)
-    void SW(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-            const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SW(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Store unsigned word (4 bytes)
-    void SWU(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SWU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Store float (4 bytes)
-    void SF(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-            const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Store double (8 bytes)
-    void SD(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-            const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void SD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     /* Moving data */
 
     // Move float
-    void MOVF(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void MOVF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Move double
-    void MOVD(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void MOVD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Move float to int
-    void MOVFP2I(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void MOVFP2I(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Move int to float
-    void MOVI2FP(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void MOVI2FP(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     /* Converting data */
 
     // Convert float to double
-    void CVTF2D(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void CVTF2D(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Convert float to int
-    void CVTF2I(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void CVTF2I(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Convert double to float
-    void CVTD2F(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void CVTD2F(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Convert double to int
-    void CVTD2I(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void CVTD2I(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Convert int to float
-    void CVTI2F(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void CVTI2F(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Convert int to double
-    void CVTI2D(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void CVTI2D(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     /* Special */
 
     // Trap
-    void TRAP(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void TRAP(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // Halt
-    void HALT(Processor& processor, const InstructionArgument& arg1,
-              const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void HALT(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 
     // NOPeration
-    void NOP(Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-             const InstructionArgument& arg3) noexcept;
+    template <typename ProcessorT>
+    void NOP(ProcessorT& processor, const DecodedInstruction& instruction) noexcept;
 } // namespace dlx::impl
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DLX/OpCode.hpp"
+#include "DLX/ProcessorPolicy.hpp"
 #include "DLX/StatusRegister.hpp"
 #include <phi/compiler_support/warning.hpp>
 #include <phi/type_traits/to_underlying.hpp>
@@ -14,8 +15,7 @@ PHI_GCC_SUPPRESS_WARNING("-Wstrict-overflow")
 
 namespace dlx
 {
-    class Processor;
-    class InstructionArgument;
+    struct DecodedInstruction;
 
 #define DLX_ENUM_ARGUMENT_TYPE                                                                     \
     DLX_ENUM_ARGUMENT_TYPE_IMPL(Unknown, 0)                                                        \
@@ -131,9 +131,8 @@ namespace dlx
     PHI_MSVC_SUPPRESS_WARNING_POP()
     PHI_CLANG_AND_GCC_SUPPRESS_WARNING_POP()
 
-    using InstructionExecutor = std::add_pointer_t<void(
-            Processor& processor, const InstructionArgument& arg1, const InstructionArgument& arg2,
-            const InstructionArgument& arg3)>;
+    using InstructionExecutor =
+            std::add_pointer_t<void(Processor& processor, const DecodedInstruction& instruction)>;
 
     // Class holding all the data and information about a specific instruction
     class InstructionInfo
@@ -226,9 +225,7 @@ namespace dlx
             return m_Executor;
         }
 
-        void Execute(Processor& processor, const InstructionArgument& arg1,
-                     const InstructionArgument& arg2,
-                     const InstructionArgument& arg3) const noexcept;
+        void Execute(Processor& processor, const DecodedInstruction& instruction) const noexcept;
 
     private:
         OpCode              m_OpCode;
@@ -8,6 +8,9 @@ namespace dlx
 {
     class IntRegister
     {
+        // Compiled code accesses the register values directly
+        friend class JITCompiler;
+
     public:
         IntRegister() noexcept;
 
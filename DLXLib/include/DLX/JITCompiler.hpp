@@ -0,0 +1,92 @@
+#pragma once
+
+#include "DLX/ProcessorPolicy.hpp"
+#include <phi/compiler_support/platform.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+#include <vector>
+
+// Native code generation is only implemented for x86-64 Linux
+#if !defined(DLX_JIT_SUPPORTED)
+#    if PHI_PLATFORM_IS(LINUX) && defined(__x86_64__)
+#        define DLX_JIT_SUPPORTED 1
+#    else
+#        define DLX_JIT_SUPPORTED 0
+#    endif
+#endif
+
+namespace dlx
+{
+    class IntRegister;
+    struct DecodedInstruction;
+    struct DecodedProgram;
+    enum class IntRegisterValueType;
+
+    // Translates straight line blocks of a decoded program into native code. Simple integer
+    // instructions and branches are emitted directly operating on the register file of the
+    // processor, every other instruction calls its executor. A compiled block either runs to its
+    // end and returns the next program counter or stops at the first instruction which halted
+    // the processor.
+    class JITCompiler
+    {
+    public:
+        // Returns the number of executed instructions in the upper and the program counter to
+        // continue from in the lower 32 bits
+        using CompiledBlock = phi::uint64_t (*)(void* processor, IntRegister* int_registers,
+                                                IntRegisterValueType*     int_value_types,
+                                                const DecodedInstruction* instructions);
+
+        JITCompiler() noexcept = default;
+
+        JITCompiler(const JITCompiler&) = delete;
+
+        JITCompiler(JITCompiler&&) = delete;
+
+        ~JITCompiler() noexcept;
+
+        JITCompiler& operator=(const JITCompiler&) = delete;
+
+        JITCompiler& operator=(JITCompiler&&) = delete;
+
+        [[nodiscard]] static constexpr phi::boolean IsSupported() noexcept
+        {
+            return DLX_JIT_SUPPORTED;
+        }
+
+        // Drops all compiled code and prepares for a program with the given number of instructions
+        void Reset(phi::size_t number_of_instructions) noexcept;
+
+        // Returns the compiled block starting at the given instruction, compiling it first if
+        // necessary. Returns nullptr if the block could not be compiled or wasn't compiled before
+        // the compiler was disabled.
+        template <typename ProcessorT>
+        [[nodiscard]] CompiledBlock GetOrCompileBlock(const DecodedProgram& program,
+                                                      phi::uint32_t         start) noexcept;
+
+        [[nodiscard]] phi::usize GetNumberOfCompiledBlocks() const noexcept;
+
+        // Set once the protection of the code pages couldn't be changed. No more blocks are
+        // compiled for the lifetime of the compiler, Reset keeps it disabled.
+        [[nodiscard]] phi::boolean IsDisabled() const noexcept;
+
+    private:
+        struct CodeRegion
+        {
+            phi::uint8_t* data{nullptr};
+            phi::size_t   size{0u};
+            phi::size_t   used{0u};
+        };
+
+        [[nodiscard]] void* Install(const std::vector<phi::uint8_t>& code) noexcept;
+
+        // Drops the region which failed to install code and disables the compiler
+        void DisableAfterFailure() noexcept;
+
+        void ReleaseRegions() noexcept;
+
+        std::vector<CompiledBlock> m_Blocks;
+        std::vector<CodeRegion>    m_Regions;
+        phi::size_t                m_NumberOfCompiledBlocks{0u};
+        phi::boolean               m_Disabled{false};
+    };
+} // namespace dlx
@@ -1,12 +1,30 @@
 #pragma once
 
+#include "DLX/GuardedMemory.hpp"
 #include <phi/core/boolean.hpp>
 #include <phi/core/optional.hpp>
 #include <phi/core/types.hpp>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <type_traits>
 #include <vector>
 
 namespace dlx
 {
+    enum class MemoryAccessResult : phi::uint8_t
+    {
+        Success,
+        OutOfBounds,
+        Misaligned,
+    };
+
+    // By default the memory is one contiguous block of bytes starting at the starting address.
+    // In paged mode the whole 32-bit address space is accessible and 4 KiB pages are only
+    // allocated when first written to. Reading from an untouched page returns zero.
+    // In guarded mode the contiguous memory is surrounded by inaccessible address space so the
+    // instructions don't need to check the bounds, see SetGuarded.
     class MemoryBlock
     {
     public:
@@ -23,8 +41,119 @@ namespace dlx
             };
         };
 
+        // Size of the pages in paged mode and the granularity of the dirty page tracking in bytes
+        static constexpr const phi::size_t PageSize{4096u};
+
         MemoryBlock(phi::usize start_address, phi::usize starting_size) noexcept;
 
+        // Copies of guarded memory fall back to unguarded memory with the same content if the
+        // guarded region couldn't be reserved
+        MemoryBlock(const MemoryBlock& other) noexcept;
+
+        MemoryBlock(MemoryBlock&&) noexcept = default;
+
+        MemoryBlock& operator=(const MemoryBlock& other) noexcept;
+
+        MemoryBlock& operator=(MemoryBlock&&) noexcept = default;
+
+        // Fast path used by the instructions. Loads need to be aligned to the size of the value,
+        // stores don't. The value is left untouched when the access fails.
+        // In guarded mode the address must be 32-bit and out of bounds accesses fault, so they
+        // may only happen while a processor executes.
+        template <typename T>
+        [[nodiscard]] MemoryAccessResult Load(phi::size_t address, T& value) const noexcept
+        {
+            static_assert(std::is_arithmetic_v<T>);
+
+            if (m_Guarded)
+            {
+                const phi::uint32_t offset =
+                        static_cast<phi::uint32_t>(address - m_StartingAddress.unsafe());
+
+                if (offset % sizeof(T) != 0u)
+                {
+                    return MemoryAccessResult::Misaligned;
+                }
+
+                std::memcpy(&value, m_GuardedRegion.GetData() + offset, sizeof(T));
+                return MemoryAccessResult::Success;
+            }
+
+            if (m_Paged)
+            {
+                if (!IsPagedAccessInRange(address, sizeof(T)))
+                {
+                    return MemoryAccessResult::OutOfBounds;
+                }
+
+                if (address % sizeof(T) != 0u)
+                {
+                    return MemoryAccessResult::Misaligned;
+                }
+
+                ReadPaged(address, &value, sizeof(T));
+                return MemoryAccessResult::Success;
+            }
+
+            const phi::size_t offset = address - m_StartingAddress.unsafe();
+
+            if (!IsAccessInRange(offset, sizeof(T)))
+            {
+                return MemoryAccessResult::OutOfBounds;
+            }
+
+            if (offset % sizeof(T) != 0u)
+            {
+                return MemoryAccessResult::Misaligned;
+            }
+
+            std::memcpy(&value, &m_Values[offset].signed_value, sizeof(T));
+            return MemoryAccessResult::Success;
+        }
+
+        template <typename T>
+        [[nodiscard]] MemoryAccessResult Store(phi::size_t address, T value) noexcept
+        {
+            static_assert(std::is_arithmetic_v<T>);
+
+            if (m_Guarded)
+            {
+                const phi::uint32_t offset =
+                        static_cast<phi::uint32_t>(address - m_StartingAddress.unsafe());
+
+                std::memcpy(m_GuardedRegion.GetData() + offset, &value, sizeof(T));
+
+                // Only mark the page once the store is known to not have faulted
+                std::atomic_signal_fence(std::memory_order_seq_cst);
+                MarkDirty(offset, sizeof(T));
+
+                return MemoryAccessResult::Success;
+            }
+
+            if (m_Paged)
+            {
+                if (!IsPagedAccessInRange(address, sizeof(T)))
+                {
+                    return MemoryAccessResult::OutOfBounds;
+                }
+
+                WritePaged(address, &value, sizeof(T));
+                return MemoryAccessResult::Success;
+            }
+
+            const phi::size_t offset = address - m_StartingAddress.unsafe();
+
+            if (!IsAccessInRange(offset, sizeof(T)))
+            {
+                return MemoryAccessResult::OutOfBounds;
+            }
+
+            std::memcpy(&m_Values[offset].signed_value, &value, sizeof(T));
+            MarkDirty(offset, sizeof(T));
+
+            return MemoryAccessResult::Success;
+        }
+
         // Loading
         [[nodiscard]] phi::optional<phi::i8>  LoadByte(phi::usize address) const noexcept;
         [[nodiscard]] phi::optional<phi::u8>  LoadUnsignedByte(phi::usize address) const noexcept;
@@ -52,8 +181,27 @@ namespace dlx
         [[nodiscard]] static phi::boolean IsAddressAlignedCorrectly(phi::usize address,
                                                                     phi::usize size) noexcept;
 
+        // Frees all pages in paged mode
         void Clear() noexcept;
 
+        // Switching the mode clears the memory
+        void SetPaged(phi::boolean paged) noexcept;
+
+        [[nodiscard]] phi::boolean IsPaged() const noexcept;
+
+        // Moves the contiguous memory into a GuardedRegion keeping its content. Requires the
+        // memory to lie within the 32-bit address space and isn't available in paged mode.
+        // Returns whether the mode is now the requested one.
+        phi::boolean SetGuarded(phi::boolean guarded) noexcept;
+
+        [[nodiscard]] phi::boolean IsGuarded() const noexcept;
+
+        [[nodiscard]] const GuardedRegion& GetGuardedRegion() const noexcept;
+
+        // The starting address and size only apply to the contiguous mode. In paged mode the
+        // starting address is always zero and the size is the number of bytes of all allocated
+        // pages.
+
         [[nodiscard]] phi::usize GetStartingAddress() const noexcept;
 
         void SetStartingAddress(phi::usize new_starting_address) noexcept;
@@ -62,12 +210,152 @@ namespace dlx
 
         void Resize(phi::usize new_size) noexcept;
 
+        // Marks the whole memory as dirty since the caller may modify any byte. Always empty in
+        // paged and guarded mode.
         [[nodiscard]] std::vector<MemoryByte>& GetRawMemory() noexcept;
 
         [[nodiscard]] const std::vector<MemoryByte>& GetRawMemory() const noexcept;
 
+        // Dirty page tracking. Every modification of the memory marks the affected pages as dirty.
+
+        // In paged mode only the allocated pages are counted
+        [[nodiscard]] phi::size_t GetNumberOfPages() const noexcept;
+
+        [[nodiscard]] phi::boolean IsPageDirty(phi::size_t page) const noexcept;
+
+        [[nodiscard]] phi::size_t GetNumberOfDirtyPages() const noexcept;
+
+        void ClearDirtyPages() noexcept;
+
+        void MarkAllPagesDirty() noexcept;
+
+        // Copies the dirty pages back from other and clears the dirty pages afterwards. Falls
+        // back to copying everything when the layout of the memory changed since the dirty pages
+        // were last cleared.
+        void RestoreDirtyPages(const MemoryBlock& other) noexcept;
+
     private:
-        std::vector<MemoryByte> m_Values;
-        phi::usize              m_StartingAddress;
+        using Page = std::array<phi::uint8_t, PageSize>;
+
+        // Every page is allocated on its own so allocating a page never moves the others.
+        // Copies are deep and reuse the pages already allocated by the destination.
+        class PageList
+        {
+        public:
+            PageList() noexcept = default;
+
+            PageList(const PageList& other) noexcept;
+
+            PageList(PageList&&) noexcept = default;
+
+            PageList& operator=(const PageList& other) noexcept;
+
+            PageList& operator=(PageList&&) noexcept = default;
+
+            [[nodiscard]] Page& operator[](phi::size_t index) noexcept
+            {
+                return *m_Pages[index];
+            }
+
+            [[nodiscard]] const Page& operator[](phi::size_t index) const noexcept
+            {
+                return *m_Pages[index];
+            }
+
+            [[nodiscard]] phi::size_t size() const noexcept
+            {
+                return m_Pages.size();
+            }
+
+            void clear() noexcept
+            {
+                m_Pages.clear();
+            }
+
+            // Only used to drop the most recently allocated pages
+            void shrink(phi::size_t size) noexcept;
+
+            // Appends a zeroed page
+            void emplace_back() noexcept;
+
+        private:
+            std::vector<std::unique_ptr<Page>> m_Pages;
+        };
+
+        // Size of the 32-bit address space accessible in paged mode
+        static constexpr const phi::uint64_t AddressSpaceSize{phi::uint64_t{1u} << 32u};
+
+        // Number of entries in the page directory and in each page table
+        static constexpr const phi::size_t PageTableSize{1024u};
+
+        // Used by the typed functions which need to check the bounds even in guarded mode
+        template <typename T>
+        [[nodiscard]] MemoryAccessResult CheckedLoad(phi::usize address, T& value) const noexcept;
+
+        template <typename T>
+        [[nodiscard]] MemoryAccessResult CheckedStore(phi::usize address, T value) noexcept;
+
+        [[nodiscard]] phi::size_t GetContiguousSize() const noexcept;
+
+        [[nodiscard]] static phi::boolean FitsGuardedAddressSpace(phi::usize starting_address,
+                                                                  phi::usize size) noexcept;
+
+        // Addresses below the starting address wrap around to offsets larger than any memory so
+        // a single unsigned compare covers both ends
+        [[nodiscard]] phi::boolean IsAccessInRange(phi::size_t offset,
+                                                   phi::size_t size) const noexcept
+        {
+            return offset < m_Values.size() && size <= m_Values.size() - offset;
+        }
+
+        [[nodiscard]] static phi::boolean IsPagedAccessInRange(phi::size_t address,
+                                                               phi::size_t size) noexcept
+        {
+            return static_cast<phi::uint64_t>(address) + size <= AddressSpaceSize;
+        }
+
+        void MarkDirty(phi::size_t index, phi::size_t size) noexcept
+        {
+            const phi::size_t first_page = index / PageSize;
+            const phi::size_t last_page  = (index + size - 1u) / PageSize;
+
+            for (phi::size_t page{first_page}; page <= last_page; ++page)
+            {
+                MarkPageDirty(page);
+            }
+        }
+
+        void MarkPageDirty(phi::size_t page) noexcept
+        {
+            m_DirtyPages[page / 64u] |= phi::uint64_t{1u} << (page % 64u);
+        }
+
+        // Page indices are offset by one so zero means the page is not allocated
+        [[nodiscard]] phi::uint32_t FindPage(phi::uint32_t page_number) const noexcept;
+
+        [[nodiscard]] phi::uint32_t FindOrAllocatePage(phi::uint32_t page_number) noexcept;
+
+        void ReadPaged(phi::size_t address, void* destination, phi::size_t size) const noexcept;
+
+        void WritePaged(phi::size_t address, const void* source, phi::size_t size) noexcept;
+
+        std::vector<MemoryByte>    m_Values;
+        phi::usize                 m_StartingAddress;
+        std::vector<phi::uint64_t> m_DirtyPages;
+        phi::boolean               m_RequiresFullRestore{true};
+
+        // Guarded mode
+        phi::boolean  m_Guarded{false};
+        GuardedRegion m_GuardedRegion;
+
+        // Paged mode
+        phi::boolean                                          m_Paged{false};
+        PageList                                              m_Pages;
+        std::vector<phi::uint32_t>                            m_PageDirectory;
+        std::vector<std::array<phi::uint32_t, PageTableSize>> m_PageTables;
+
+        // Translation of the last used page
+        mutable phi::uint32_t m_TLBPageNumber{~0u};
+        mutable phi::uint32_t m_TLBPage{0u};
     };
 } // namespace dlx
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "DLX/MemoryBlock.hpp"
+#include "DLX/ParsedProgram.hpp"
+#include "DLX/Processor.hpp"
+#include "DLX/RegisterNames.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/types.hpp>
+#include <phi/type_traits/to_underlying.hpp>
+#include <cstring>
+
+namespace dlx
+{
+    // Executes the instructions of a processor while reverse execution, tracing or cache
+    // simulation is enabled. Every write and memory access is reported to the processor before it
+    // is forwarded so the instructions are instantiated a second time for observing and the
+    // processor itself never checks whether its accesses are observed.
+    template <typename ProcessorT>
+    class ObservingProcessor
+    {
+    public:
+        // Tells the load and store instructions to report their accesses
+        static constexpr const bool ObservesAccesses = true;
+
+        explicit ObservingProcessor(ProcessorT& processor) noexcept
+            : m_Processor{processor}
+        {}
+
+        // Registers
+
+        [[nodiscard]] phi::i32 IntRegisterGetSignedValue(IntRegisterID id) const noexcept
+        {
+            return m_Processor.IntRegisterGetSignedValue(id);
+        }
+
+        [[nodiscard]] phi::u32 IntRegisterGetUnsignedValue(IntRegisterID id) const noexcept
+        {
+            return m_Processor.IntRegisterGetUnsignedValue(id);
+        }
+
+        void IntRegisterSetSignedValue(IntRegisterID id, phi::i32 value) noexcept
+        {
+            // Writes to R0 are discarded
+            if (!m_Processor.GetIntRegister(id).IsReadOnly())
+            {
+                m_Processor.ObserveIntRegisterWrite(id, static_cast<phi::uint32_t>(value.unsafe()));
+            }
+
+            m_Processor.IntRegisterSetSignedValue(id, value);
+        }
+
+        void IntRegisterSetUnsignedValue(IntRegisterID id, phi::u32 value) noexcept
+        {
+            if (!m_Processor.GetIntRegister(id).IsReadOnly())
+            {
+                m_Processor.ObserveIntRegisterWrite(id, value.unsafe());
+            }
+
+            m_Processor.IntRegisterSetUnsignedValue(id, value);
+        }
+
+        [[nodiscard]] phi::f32 FloatRegisterGetFloatValue(FloatRegisterID id) const noexcept
+        {
+            return m_Processor.FloatRegisterGetFloatValue(id);
+        }
+
+        [[nodiscard]] phi::f64 FloatRegisterGetDoubleValue(FloatRegisterID id) noexcept
+        {
+            return m_Processor.FloatRegisterGetDoubleValue(id);
+        }
+
+        void FloatRegisterSetFloatValue(FloatRegisterID id, phi::f32 value) noexcept
+        {
+            const float   raw_value = value.unsafe();
+            phi::uint32_t value_bits;
+            std::memcpy(&value_bits, &raw_value, sizeof(value_bits));
+
+            m_Processor.ObserveFloatRegisterWrite(id, value_bits);
+
+            m_Processor.FloatRegisterSetFloatValue(id, value);
+        }
+
+        void FloatRegisterSetDoubleValue(FloatRegisterID id, phi::f64 value) noexcept
+        {
+            // Odd registers raise MisalignedRegisterAccess without being written
+            if (phi::to_underlying(id) % 2 == 0)
+            {
+                const double  raw_value = value.unsafe();
+                phi::uint64_t value_bits;
+                std::memcpy(&value_bits, &raw_value, sizeof(value_bits));
+
+                m_Processor.ObserveDoubleRegisterWrite(id, value_bits);
+            }
+
+            m_Processor.FloatRegisterSetDoubleValue(id, value);
+        }
+
+        [[nodiscard]] phi::boolean GetFPSRValue() const noexcept
+        {
+            return m_Processor.GetFPSRValue();
+        }
+
+        void SetFPSRValue(phi::boolean value) noexcept
+        {
+            m_Processor.ObserveFPSRWrite(value);
+
+            m_Processor.SetFPSRValue(value);
+        }
+
+        //
+
+        [[nodiscard]] phi::observer_ptr<const ParsedProgram> GetCurrentProgram() const noexcept
+        {
+            return m_Processor.GetCurrentProgram();
+        }
+
+        void Raise(Exception exception) noexcept
+        {
+            m_Processor.Raise(exception);
+        }
+
+        [[nodiscard]] MemoryBlock& GetMemory() noexcept
+        {
+            return m_Processor.GetMemory();
+        }
+
+        [[nodiscard]] phi::u32 GetNextProgramCounter() const noexcept
+        {
+            return m_Processor.GetNextProgramCounter();
+        }
+
+        void SetNextProgramCounter(phi::u32 new_npc) noexcept
+        {
+            m_Processor.SetNextProgramCounter(new_npc);
+        }
+
+        // Memory accesses
+
+        // Called before the memory is modified
+        void PrepareMemoryStore(phi::u32 address, phi::size_t size) noexcept
+        {
+            m_Processor.PrepareMemoryStore(address, size);
+        }
+
+        // Called once the store or load succeeded, failed accesses are neither traced nor
+        // simulated
+        void ObserveMemoryStore(phi::u32 address, phi::size_t size,
+                                phi::uint64_t value_bits) noexcept
+        {
+            m_Processor.ObserveMemoryStore(address, size, value_bits);
+        }
+
+        void ObserveMemoryLoad(phi::u32 address, phi::size_t size) noexcept
+        {
+            m_Processor.ObserveMemoryLoad(address, size);
+        }
+
+    private:
+        ProcessorT& m_Processor;
+    };
+} // namespace dlx
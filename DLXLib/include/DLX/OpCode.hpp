@@ -3,6 +3,7 @@
 #include "DLX/EnumName.hpp"
 #include <phi/compiler_support/warning.hpp>
 #include <phi/core/assert.hpp>
+#include <phi/core/boolean.hpp>
 #include <phi/core/types.hpp>
 #include <string>
 
@@ -222,4 +223,41 @@ namespace dlx
     PHI_CLANG_AND_GCC_SUPPRESS_WARNING_POP()
 
     [[nodiscard]] OpCode StringToOpCode(phi::string_view token) noexcept;
+
+    // Returns true for instructions which may continue execution somewhere other than the next
+    // instruction. These end a straight line block of instructions.
+    [[nodiscard]] constexpr phi::boolean IsControlTransferInstruction(OpCode opcode) noexcept
+    {
+        return opcode == OpCode::BEQZ || opcode == OpCode::BNEZ || opcode == OpCode::BFPT ||
+               opcode == OpCode::BFPF || opcode == OpCode::J || opcode == OpCode::JR ||
+               opcode == OpCode::JAL || opcode == OpCode::JALR;
+    }
+
+    // Returns true for the load and store instructions which access memory exactly once
+    [[nodiscard]] constexpr phi::boolean IsMemoryAccessInstruction(OpCode opcode) noexcept
+    {
+        switch (opcode)
+        {
+            case OpCode::LB:
+            case OpCode::LBU:
+            case OpCode::LH:
+            case OpCode::LHU:
+            case OpCode::LW:
+            case OpCode::LWU:
+            case OpCode::LF:
+            case OpCode::LD:
+            case OpCode::SB:
+            case OpCode::SBU:
+            case OpCode::SH:
+            case OpCode::SHU:
+            case OpCode::SW:
+            case OpCode::SWU:
+            case OpCode::SF:
+            case OpCode::SD:
+                return true;
+
+            default:
+                return false;
+        }
+    }
 } // namespace dlx
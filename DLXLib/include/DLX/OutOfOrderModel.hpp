@@ -0,0 +1,241 @@
+#pragma once
+
+#include "DLX/OpCode.hpp"
+#include "DLX/PipelineModel.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+#include <array>
+#include <string>
+#include <vector>
+
+namespace dlx
+{
+    struct DecodedProgram;
+    struct ParsedProgram;
+
+    // Classes of reservation stations and the functional units behind them. Loads and stores wait
+    // in load and store buffers, everything else follows its pipeline unit.
+    enum class OutOfOrderUnit : phi::uint8_t
+    {
+        Integer,
+        IntegerMultiply,
+        IntegerDivide,
+        FloatAdd,
+        FloatMultiply,
+        FloatDivide,
+        Load,
+        Store,
+    };
+
+    static constexpr const phi::size_t NumberOfOutOfOrderUnits{8u};
+
+    [[nodiscard]] constexpr OutOfOrderUnit GetOutOfOrderUnit(OpCode opcode) noexcept
+    {
+        switch (opcode)
+        {
+            case OpCode::LB:
+            case OpCode::LBU:
+            case OpCode::LH:
+            case OpCode::LHU:
+            case OpCode::LW:
+            case OpCode::LWU:
+            case OpCode::LF:
+            case OpCode::LD:
+                return OutOfOrderUnit::Load;
+
+            case OpCode::SB:
+            case OpCode::SBU:
+            case OpCode::SH:
+            case OpCode::SHU:
+            case OpCode::SW:
+            case OpCode::SWU:
+            case OpCode::SF:
+            case OpCode::SD:
+                return OutOfOrderUnit::Store;
+
+            default:
+                return static_cast<OutOfOrderUnit>(GetPipelineUnit(opcode));
+        }
+    }
+
+    struct OutOfOrderUnitConfig
+    {
+        // Reservation stations or load/store buffers holding issued instructions until they
+        // write their result
+        phi::uint8_t stations{2u};
+
+        // Functional units executing the instructions of the stations
+        phi::uint8_t units{1u};
+
+        // Whether a unit accepts a new instruction every cycle or is busy for the whole latency
+        phi::boolean pipelined{true};
+    };
+
+    struct OutOfOrderConfig
+    {
+        std::array<OutOfOrderUnitConfig, NumberOfOutOfOrderUnits> units{{
+                {3u, 1u, true},  // Integer
+                {2u, 1u, true},  // IntegerMultiply
+                {2u, 1u, false}, // IntegerDivide
+                {3u, 1u, true},  // FloatAdd
+                {2u, 1u, true},  // FloatMultiply
+                {2u, 1u, false}, // FloatDivide
+                {3u, 1u, true},  // Load
+                {3u, 1u, true},  // Store
+        }};
+
+        // Execute cycles per instruction. A latency of 0 is treated as 1.
+        PipelineLatencies latencies{GetDefaultPipelineLatencies()};
+
+        // Results broadcast per cycle
+        phi::uint8_t common_data_buses{1u};
+
+        // Number of the most recently issued instructions kept for the timing table
+        phi::uint32_t history{64u};
+
+        static constexpr const phi::uint8_t  MaximumStations{16u};
+        static constexpr const phi::uint8_t  MaximumUnits{16u};
+        static constexpr const phi::uint8_t  MaximumCommonDataBuses{8u};
+        static constexpr const phi::uint32_t MaximumHistory{1u << 16u};
+
+        // Whether every unit has 1 to 16 stations and functional units, there are 1 to 8 buses
+        // and the history isn't too long
+        [[nodiscard]] phi::boolean IsValid() const noexcept;
+    };
+
+    struct OutOfOrderStatistics
+    {
+        phi::uint64_t instructions{0u};
+        phi::uint64_t cycles{0u};
+
+        // Cycles the issue of an instruction was delayed because all stations of its unit were
+        // taken or a preceding control transfer wasn't resolved yet
+        phi::uint64_t station_stalls{0u};
+        phi::uint64_t branch_stalls{0u};
+
+        // Cycles issued instructions waited in their station for operands, preceding memory
+        // accesses, a free functional unit and a free common data bus
+        phi::uint64_t operand_waits{0u};
+        phi::uint64_t memory_order_waits{0u};
+        phi::uint64_t unit_waits{0u};
+        phi::uint64_t bus_waits{0u};
+
+        // Cycles the functional units of a class accepted no new instruction because of the
+        // executed ones, summed over all units of the class
+        std::array<phi::uint64_t, NumberOfOutOfOrderUnits> busy_cycles{};
+
+        // Instructions per cycle or 0 if nothing was executed
+        [[nodiscard]] double GetIPC() const noexcept;
+    };
+
+    // When an instruction passed the three Tomasulo stages. Cycles count from 1, a write cycle of
+    // 0 means the instruction broadcast nothing and wrote no memory.
+    struct OutOfOrderRecord
+    {
+        phi::uint32_t index{0u};
+        phi::uint64_t issue{0u};
+        phi::uint64_t execute_start{0u};
+        phi::uint64_t execute_end{0u};
+        phi::uint64_t write{0u};
+    };
+
+    // Timing model of Tomasulo's algorithm on top of the functional processor which retires the
+    // executed instructions into it in program order. Instructions issue in order, one per cycle,
+    // into a free reservation station of their unit and read available operands from the
+    // register file. Missing operands are renamed to the station producing them through the
+    // register status table and captured from the common data bus. Instructions execute once
+    // their operands and a functional unit are available and broadcast their result in the
+    // following cycle, freeing their station.
+    //
+    // There is no speculation: nothing issues before a preceding control transfer executed.
+    // Loads don't pass preceding stores and stores don't pass preceding loads and stores since
+    // their addresses aren't compared.
+    //
+    // The functional units and buses are reserved per cycle in a ring buffer covering every
+    // cycle an instruction in a station can still use, so the state stays the same size no
+    // matter how many instructions are retired.
+    class OutOfOrderModel
+    {
+    public:
+        OutOfOrderModel() noexcept;
+
+        explicit OutOfOrderModel(const OutOfOrderConfig& config) noexcept;
+
+        // Returns false and keeps the current config if it's invalid. Otherwise it takes effect
+        // with the next Load.
+        phi::boolean SetConfig(const OutOfOrderConfig& config) noexcept;
+
+        [[nodiscard]] const OutOfOrderConfig& GetConfig() const noexcept;
+
+        // Precomputes the instructions of the program and clears the statistics
+        void Load(const DecodedProgram& program) noexcept;
+
+        // Starts a new run of the loaded program with empty stations
+        void Clear() noexcept;
+
+        void Retire(phi::uint32_t index) noexcept;
+
+        // Statistics of all instructions retired since the last Load or Clear
+        [[nodiscard]] const OutOfOrderStatistics& GetStatistics() const noexcept;
+
+        // The most recently retired instructions, oldest first
+        [[nodiscard]] std::vector<OutOfOrderRecord> GetHistory() const noexcept;
+
+        PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wabi-tag")
+
+        // Throughput, stalls and unit utilization followed by the timing table of the last
+        // max_records instructions
+        [[nodiscard]] std::string GetReport(const ParsedProgram& program,
+                                            phi::size_t max_records = 20u) const noexcept;
+
+        PHI_GCC_SUPPRESS_WARNING_POP()
+
+    private:
+        struct PrecomputedInstruction
+        {
+            std::array<phi::uint8_t, 4u> sources{};
+            std::array<phi::uint8_t, 2u> destinations{};
+            phi::uint8_t                 latency{1u};
+            phi::uint8_t                 unit{0u};
+            phi::boolean                 control_transfer{false};
+        };
+
+        // Recycles the slots of all cycles before the given one
+        void AdvanceWindow(phi::uint64_t cycle) noexcept;
+
+        [[nodiscard]] phi::uint8_t& Reservations(phi::uint64_t cycle, phi::size_t column) noexcept;
+
+        OutOfOrderConfig                    m_Config;
+        std::vector<PrecomputedInstruction> m_Instructions;
+
+        // Register status table: per slot the first cycle a dependent instruction can execute
+        std::array<phi::uint64_t, PipelineModel::NumberOfSlots> m_Ready{};
+
+        // Per unit the cycle each station can be issued to again
+        std::array<std::array<phi::uint64_t, OutOfOrderConfig::MaximumStations>,
+                   NumberOfOutOfOrderUnits>
+                m_StationFree{};
+
+        // Per cycle the instructions started by every unit followed by the results broadcast.
+        // Cycle c lives in row c % capacity, rows of cycles before m_WindowStart are free.
+        static constexpr const phi::size_t ReservationColumns{NumberOfOutOfOrderUnits + 1u};
+        static constexpr const phi::size_t BusColumn{NumberOfOutOfOrderUnits};
+
+        std::vector<phi::uint8_t> m_Reservations;
+        phi::uint64_t             m_WindowMask{0u};
+        phi::uint64_t             m_WindowStart{1u};
+
+        phi::uint64_t m_LastIssue{0u};
+        phi::uint64_t m_BranchResolved{0u};
+        phi::uint64_t m_LastMemoryStart{0u};
+        phi::uint64_t m_LastStoreWrite{0u};
+
+        OutOfOrderStatistics m_Statistics;
+
+        // Ring buffer of the last retired instructions
+        std::vector<OutOfOrderRecord> m_History;
+        phi::size_t                   m_HistoryNext{0u};
+        phi::size_t                   m_HistorySize{0u};
+    };
+} // namespace dlx
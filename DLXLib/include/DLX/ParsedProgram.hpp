@@ -6,6 +6,7 @@
 #include "Token.hpp"
 #include <phi/compiler_support/warning.hpp>
 #include <phi/core/boolean.hpp>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -18,6 +19,11 @@ namespace dlx
         std::unordered_map<std::string_view, phi::uint32_t> m_JumpData;
         std::vector<ParseError>                             m_ParseErrors;
         TokenStream                                         m_Tokens;
+        phi::boolean                                        m_HasUnresolvedLabels{false};
+
+        // Source the tokens, labels and parse errors point into. Only set for programs created by
+        // Parser::ParseOwned or Parser::ParseShared, otherwise the caller owns the source.
+        std::shared_ptr<const std::string> m_Source;
 
         void AddParseError(ParseError&& error) noexcept;
 
@@ -29,4 +35,7 @@ namespace dlx
 
         PHI_GCC_SUPPRESS_WARNING_POP()
     };
+
+    // An immutable program which can be loaded into any number of processors at once
+    using SharedParsedProgram = std::shared_ptr<const ParsedProgram>;
 } // namespace dlx
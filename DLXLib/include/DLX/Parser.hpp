@@ -3,6 +3,7 @@
 #include "DLX/ParsedProgram.hpp"
 #include "DLX/Token.hpp"
 #include "DLX/TokenStream.hpp"
+#include <string>
 
 namespace dlx
 {
@@ -12,5 +13,10 @@ namespace dlx
         static ParsedProgram Parse(TokenStream& tokens) noexcept;
 
         static ParsedProgram Parse(phi::string_view source) noexcept;
+
+        // Parses a program which owns its source and stays valid when moved or copied
+        static ParsedProgram ParseOwned(std::string source) noexcept;
+
+        static SharedParsedProgram ParseShared(std::string source) noexcept;
     };
 } // namespace dlx
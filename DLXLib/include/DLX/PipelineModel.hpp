@@ -0,0 +1,365 @@
+#pragma once
+
+#include "DLX/OpCode.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+
+namespace dlx
+{
+    struct DecodedInstruction;
+    struct DecodedProgram;
+
+    // The functional units an instruction spends its execute cycles in
+    enum class PipelineUnit : phi::uint8_t
+    {
+        Integer,
+        IntegerMultiply,
+        IntegerDivide,
+        FloatAdd,
+        FloatMultiply,
+        FloatDivide,
+    };
+
+    static constexpr const phi::size_t NumberOfPipelineUnits{6u};
+
+    // The stage in which conditional branches and register jumps know whether and where they jump
+    enum class BranchResolution : phi::uint8_t
+    {
+        Decode,
+        Execute,
+    };
+
+    [[nodiscard]] constexpr PipelineUnit GetPipelineUnit(OpCode opcode) noexcept
+    {
+        switch (opcode)
+        {
+            case OpCode::MULT:
+            case OpCode::MULTI:
+            case OpCode::MULTU:
+            case OpCode::MULTUI:
+                return PipelineUnit::IntegerMultiply;
+
+            case OpCode::DIV:
+            case OpCode::DIVI:
+            case OpCode::DIVU:
+            case OpCode::DIVUI:
+                return PipelineUnit::IntegerDivide;
+
+            case OpCode::ADDF:
+            case OpCode::ADDD:
+            case OpCode::SUBF:
+            case OpCode::SUBD:
+            case OpCode::LTF:
+            case OpCode::LTD:
+            case OpCode::GTF:
+            case OpCode::GTD:
+            case OpCode::LEF:
+            case OpCode::LED:
+            case OpCode::GEF:
+            case OpCode::GED:
+            case OpCode::EQF:
+            case OpCode::EQD:
+            case OpCode::NEF:
+            case OpCode::NED:
+            case OpCode::CVTF2D:
+            case OpCode::CVTF2I:
+            case OpCode::CVTD2F:
+            case OpCode::CVTD2I:
+            case OpCode::CVTI2F:
+            case OpCode::CVTI2D:
+                return PipelineUnit::FloatAdd;
+
+            case OpCode::MULTF:
+            case OpCode::MULTD:
+                return PipelineUnit::FloatMultiply;
+
+            case OpCode::DIVF:
+            case OpCode::DIVD:
+                return PipelineUnit::FloatDivide;
+
+            default:
+                return PipelineUnit::Integer;
+        }
+    }
+
+    using PipelineLatencies = std::array<phi::uint8_t, NumberOfOpCodes.unsafe()>;
+
+    // Number of execute cycles per instruction modelled after the classic DLX floating point
+    // pipeline: 7 cycles for multiplications, 25 for divisions and 4 for the other floating point
+    // operations. Everything else takes a single cycle.
+    [[nodiscard]] constexpr PipelineLatencies GetDefaultPipelineLatencies() noexcept
+    {
+        PipelineLatencies latencies{};
+
+        for (phi::size_t index{0u}; index < latencies.size(); ++index)
+        {
+            switch (GetPipelineUnit(static_cast<OpCode>(index)))
+            {
+                case PipelineUnit::Integer:
+                    latencies[index] = 1u;
+                    break;
+                case PipelineUnit::IntegerMultiply:
+                case PipelineUnit::FloatMultiply:
+                    latencies[index] = 7u;
+                    break;
+                case PipelineUnit::IntegerDivide:
+                case PipelineUnit::FloatDivide:
+                    latencies[index] = 25u;
+                    break;
+                case PipelineUnit::FloatAdd:
+                    latencies[index] = 4u;
+                    break;
+            }
+        }
+
+        return latencies;
+    }
+
+    struct PipelineConfig
+    {
+        // Results are forwarded to the execute stage as soon as they are computed. Without
+        // forwarding they are read from the register file in the cycle they are written back.
+        phi::boolean forwarding{true};
+
+        // Taken control transfers flush the instructions fetched after them. Jumps to a label are
+        // always redirected from the decode stage.
+        BranchResolution branch_resolution{BranchResolution::Decode};
+
+        // Execute cycles per instruction. A latency of 0 is treated as 1.
+        PipelineLatencies latencies{GetDefaultPipelineLatencies()};
+
+        // Whether a unit accepts a new instruction every cycle or is busy for the whole latency
+        std::array<phi::boolean, NumberOfPipelineUnits> pipelined_units{true, true, false,
+                                                                         true, true, false};
+    };
+
+    struct PipelineStatistics
+    {
+        phi::uint64_t instructions{0u};
+        phi::uint64_t cycles{0u};
+
+        // Waiting for an operand produced by a preceding instruction other than a load
+        phi::uint64_t data_stalls{0u};
+
+        // Waiting for an operand produced by a preceding load
+        phi::uint64_t load_use_stalls{0u};
+
+        // Waiting for a non pipelined unit
+        phi::uint64_t structural_stalls{0u};
+
+        // Waiting to not write back before a preceding instruction with the same destination
+        phi::uint64_t write_after_write_stalls{0u};
+
+        // Cycles lost by flushing after taken or mispredicted control transfers
+        phi::uint64_t control_stalls{0u};
+
+        [[nodiscard]] phi::uint64_t GetTotalStalls() const noexcept;
+
+        // Cycles per instruction or 0 if nothing was executed
+        [[nodiscard]] double GetCPI() const noexcept;
+    };
+
+    // Everything the timing model needs to know about an instruction, precomputed when loading
+    struct PipelineInstruction
+    {
+        // Register slots read by the instruction. Double registers occupy two slots and single
+        // registers repeat their slot. For stores the last two hold the stored register.
+        std::array<phi::uint8_t, 4u> sources{};
+
+        // Register slots written by the instruction
+        std::array<phi::uint8_t, 2u> destinations{};
+
+        phi::uint8_t latency{1u};
+        phi::uint8_t unit{0u};
+
+        // Cycles until the unit accepts the next instruction
+        phi::uint8_t occupancy{1u};
+
+        phi::uint8_t flags{0u};
+
+        // Cycles lost when the instruction transfers control
+        phi::uint8_t taken_penalty{0u};
+
+        static constexpr const phi::uint8_t FlagLoad{1u << 0u};
+        static constexpr const phi::uint8_t FlagStore{1u << 1u};
+
+        // Operands are needed in the decode stage to resolve the branch
+        static constexpr const phi::uint8_t FlagEarlyOperands{1u << 2u};
+    };
+
+    // Register slots, latency, unit and flags of a decoded instruction as seen by the pipeline
+    [[nodiscard]] PipelineInstruction PrecomputePipelineInstruction(
+            const DecodedInstruction& decoded, const PipelineConfig& config) noexcept;
+
+    // Cycle level timing model of the classic 5 stage DLX pipeline (IF, ID, EX, MEM, WB). It
+    // doesn't execute anything itself but is told which instructions the processor retired in
+    // which order and computes the cycle each of them enters the execute stage.
+    //
+    // Instructions issue in order, spend their latency in the execute stage of their unit and may
+    // complete out of order. All state is kept in flat arrays indexed by register slot so retiring
+    // an instruction is a handful of loads and comparisons.
+    class PipelineModel
+    {
+    public:
+        // Slots of the register operands. Integer registers come first, followed by the float
+        // registers and the floating point status register.
+        static constexpr const phi::uint8_t FloatRegisterSlot{32u};
+        static constexpr const phi::uint8_t FPSRSlot{64u};
+        static constexpr const phi::uint8_t NoSlot{65u};
+        static constexpr const phi::size_t  NumberOfSlots{66u};
+
+        PipelineModel() noexcept;
+
+        explicit PipelineModel(const PipelineConfig& config) noexcept;
+
+        // Takes effect with the next Load
+        void SetConfig(const PipelineConfig& config) noexcept;
+
+        [[nodiscard]] const PipelineConfig& GetConfig() const noexcept;
+
+        // Precomputes the instructions of the program and clears the statistics
+        void Load(const DecodedProgram& program) noexcept;
+
+        // Starts a new run of the loaded program with an empty pipeline
+        void Clear() noexcept;
+
+        void Retire(phi::uint32_t index, phi::boolean taken) noexcept
+        {
+            PHI_ASSERT(index < m_Instructions.size());
+
+            RetireWithPenalty(index,
+                              taken ? m_Instructions[index].taken_penalty : phi::uint8_t{0u});
+        }
+
+        // Like Retire but flushing the given number of cycles after the instruction, for example
+        // when a branch predictor fetched the wrong instructions after it
+        void RetireWithPenalty(phi::uint32_t index, phi::uint8_t penalty) noexcept
+        {
+            PHI_ASSERT(index < m_Instructions.size());
+
+            const PipelineInstruction& instruction = m_Instructions[index];
+
+            // In order issue one cycle after the previous instruction unless it flushed the
+            // pipeline
+            phi::uint64_t execute = m_LastExecute + 1u + m_PendingPenalty;
+            m_Statistics.control_stalls += m_PendingPenalty;
+
+            // Ready cycles are stored shifted left by one with the lowest bit set for loaded
+            // values so the latest operand also tells whether a load is waited for
+            phi::uint64_t operands = std::max(m_Ready[instruction.sources[0u]],
+                                              m_Ready[instruction.sources[1u]]);
+            phi::uint64_t stored = std::max(m_Ready[instruction.sources[2u]],
+                                            m_Ready[instruction.sources[3u]]);
+
+            // The stored value is only needed in the memory stage
+            if ((instruction.flags & PipelineInstruction::FlagStore) != 0u && stored >= 2u)
+            {
+                stored -= m_StoreDataRelief;
+            }
+
+            operands = std::max(operands, stored);
+
+            phi::uint64_t operands_ready = operands >> 1u;
+            if ((instruction.flags & PipelineInstruction::FlagEarlyOperands) != 0u)
+            {
+                operands_ready += m_EarlyOperandDelay;
+            }
+
+            if (operands_ready > execute)
+            {
+                if ((operands & 1u) != 0u)
+                {
+                    m_Statistics.load_use_stalls += operands_ready - execute;
+                }
+                else
+                {
+                    m_Statistics.data_stalls += operands_ready - execute;
+                }
+
+                execute = operands_ready;
+            }
+
+            const phi::uint64_t unit_free = m_UnitFree[instruction.unit];
+            if (unit_free > execute)
+            {
+                m_Statistics.structural_stalls += unit_free - execute;
+                execute = unit_free;
+            }
+
+            // Write back strictly after the previous writer of the same register
+            const phi::uint64_t latency = instruction.latency;
+            const phi::uint64_t previous_write_back =
+                    std::max(m_WriteBack[instruction.destinations[0u]],
+                             m_WriteBack[instruction.destinations[1u]]);
+            if (previous_write_back > execute + latency)
+            {
+                m_Statistics.write_after_write_stalls += previous_write_back - execute - latency;
+                execute = previous_write_back - latency;
+            }
+
+            // Memory stage in the cycle after the last execute cycle, write back one later
+            const phi::uint64_t write_back = execute + latency + 1u;
+            const phi::uint64_t is_load =
+                    static_cast<phi::uint64_t>(instruction.flags & PipelineInstruction::FlagLoad);
+            const phi::uint64_t ready =
+                    m_Config.forwarding ? execute + latency + is_load : write_back + 1u;
+
+            if (instruction.destinations[0u] != NoSlot)
+            {
+                m_Ready[instruction.destinations[0u]]     = (ready << 1u) | is_load;
+                m_Ready[instruction.destinations[1u]]     = (ready << 1u) | is_load;
+                m_WriteBack[instruction.destinations[0u]] = write_back;
+                m_WriteBack[instruction.destinations[1u]] = write_back;
+            }
+
+            m_UnitFree[instruction.unit] = execute + instruction.occupancy;
+
+            m_LastExecute    = execute;
+            m_LastWriteBack  = std::max(m_LastWriteBack, write_back);
+            m_PendingPenalty = penalty;
+
+            ++m_Statistics.instructions;
+        }
+
+        // Statistics of all instructions retired since the last Load or Clear
+        [[nodiscard]] PipelineStatistics GetStatistics() const noexcept;
+
+        [[nodiscard]] const std::vector<PipelineInstruction>& GetInstructions() const noexcept;
+
+        PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wabi-tag")
+
+        // Total cycles, CPI and the stall breakdown
+        [[nodiscard]] std::string GetReport() const noexcept;
+
+        PHI_GCC_SUPPRESS_WARNING_POP()
+
+    private:
+        PipelineConfig                   m_Config;
+        std::vector<PipelineInstruction> m_Instructions;
+
+        // Per slot the first cycle a dependent instruction can execute, see Retire
+        std::array<phi::uint64_t, NumberOfSlots> m_Ready{};
+
+        // Per slot the write back cycle of its last writer
+        std::array<phi::uint64_t, NumberOfSlots> m_WriteBack{};
+
+        std::array<phi::uint64_t, NumberOfPipelineUnits> m_UnitFree{};
+
+        phi::uint64_t m_LastExecute{1u};
+        phi::uint64_t m_LastWriteBack{0u};
+        phi::uint64_t m_PendingPenalty{0u};
+
+        // Derived from the config. Subtracted from a shifted ready cycle for stored values and
+        // added to the ready cycle of the operands of branches resolved in the decode stage.
+        phi::uint64_t m_StoreDataRelief{0u};
+        phi::uint64_t m_EarlyOperandDelay{0u};
+
+        PipelineStatistics m_Statistics;
+    };
+} // namespace dlx
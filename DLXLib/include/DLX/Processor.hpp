@@ -1,18 +1,32 @@
 #pragma once
 
+#include "DLX/BlockCache.hpp"
+#include "DLX/BranchPredictor.hpp"
+#include "DLX/CacheSimulator.hpp"
+#include "DLX/DecodedProgram.hpp"
 #include "DLX/EnumName.hpp"
+#include "DLX/ExecutionProfile.hpp"
 #include "DLX/FloatRegister.hpp"
 #include "DLX/Instruction.hpp"
 #include "DLX/InstructionInfo.hpp"
 #include "DLX/IntRegister.hpp"
+#include "DLX/JITCompiler.hpp"
 #include "DLX/MemoryBlock.hpp"
+#include "DLX/OutOfOrderModel.hpp"
+#include "DLX/PipelineModel.hpp"
+#include "DLX/ProcessorPolicy.hpp"
 #include "DLX/RegisterNames.hpp"
 #include "DLX/StatusRegister.hpp"
+#include "DLX/TraceRecorder.hpp"
+#include "DLX/UndoLog.hpp"
 #include <phi/compiler_support/warning.hpp>
 #include <phi/core/boolean.hpp>
 #include <phi/core/observer_ptr.hpp>
 #include <phi/core/scope_ptr.hpp>
 #include <array>
+#include <memory>
+#include <unordered_set>
+#include <vector>
 
 namespace dlx
 {
@@ -80,10 +94,69 @@ namespace dlx
         DoubleHigh,
     };
 
-    class Processor
+    // Execution state of a processor. The loaded program is not part of a snapshot.
+    struct ProcessorSnapshot
+    {
+        std::array<IntRegister, 32u>            int_registers;
+        std::array<IntRegisterValueType, 32u>   int_registers_value_types{};
+        std::array<FloatRegister, 32u>          float_registers;
+        std::array<FloatRegisterValueType, 32u> float_registers_value_types{};
+        StatusRegister                          fpsr;
+
+        MemoryBlock memory{0u, 0u};
+
+        phi::u32     program_counter{0u};
+        phi::u32     next_program_counter{0u};
+        phi::usize   step_count{0u};
+        Exception    last_raised_exception{Exception::None};
+        phi::boolean halted{false};
+
+        // Identifies the snapshot the dirty pages of a processor are tracked against
+        phi::uint64_t id{0u};
+    };
+
+    // Full copy of the state taken periodically while recording the undo log so stepping far
+    // back only needs to replay a few instructions
+    struct UndoCheckpoint
+    {
+        // Number of instructions between two checkpoints
+        static constexpr const phi::size_t Interval{4096u};
+
+        // Older checkpoints are dropped so a processor never keeps more than this many
+        static constexpr const phi::size_t MaximumNumber{16u};
+
+        // The undo log step and position right after the checkpoint was taken
+        phi::uint64_t     step{0u};
+        phi::uint64_t     position{0u};
+        ProcessorSnapshot snapshot;
+    };
+
+    // Why RunUntilBreak or RunBackwardsUntilBreak returned
+    enum class StopReason
+    {
+        Halted,
+        Breakpoint,
+        StepLimit,
+        // RunBackwardsUntilBreak reached the oldest recorded step
+        StartOfHistory,
+    };
+
+    // The policy decides which diagnostics are performed on every register access. Both
+    // instantiations are provided by the library as Processor and FastProcessor.
+    template <typename ProcessorT>
+    class ObservingProcessor;
+
+    template <typename PolicyT>
+    class BasicProcessor
     {
     public:
-        Processor() noexcept;
+        using Policy = PolicyT;
+
+        // The load and store instructions only report their accesses when executed through an
+        // ObservingProcessor
+        static constexpr const bool ObservesAccesses = false;
+
+        BasicProcessor() noexcept;
 
         // Registers
 
@@ -123,16 +196,139 @@ namespace dlx
 
         void ExecuteInstruction(const Instruction& inst) noexcept;
 
-        phi::boolean LoadProgram(ParsedProgram& program) noexcept;
+        void ExecuteInstruction(const DecodedInstruction& inst) noexcept;
+
+        // The program must outlive the processor or the next call to LoadProgram
+        phi::boolean LoadProgram(const ParsedProgram& program) noexcept;
+
+        // Keeps the program alive for as long as it stays loaded
+        phi::boolean LoadProgram(std::shared_ptr<const ParsedProgram> program) noexcept;
 
-        [[nodiscard]] phi::observer_ptr<ParsedProgram> GetCurrentProgram() const noexcept;
+        [[nodiscard]] phi::observer_ptr<const ParsedProgram> GetCurrentProgram() const noexcept;
+
+        [[nodiscard]] const DecodedProgram& GetDecodedProgram() const noexcept;
+
+        [[nodiscard]] const BlockCache& GetBlockCache() const noexcept;
 
         void ExecuteStep() noexcept;
 
         void ExecuteCurrentProgram() noexcept;
 
+        // Breakpoints are set per instruction and cleared when loading a program
+
+        void SetBreakpoint(phi::u32 instruction_index, phi::boolean enabled) noexcept;
+
+        [[nodiscard]] phi::boolean HasBreakpoint(phi::u32 instruction_index) const noexcept;
+
+        // Replaces all breakpoints with one on every instruction of the given source lines
+        void SetBreakpointsFromSourceLines(
+                const std::unordered_set<phi::uint32_t>& source_lines) noexcept;
+
+        void ClearBreakpoints() noexcept;
+
+        // Executes up to max_steps instructions stopping in front of an instruction with a
+        // breakpoint. The instruction at the program counter is always executed so running again
+        // continues past the breakpoint. ExecuteStep and ExecuteCurrentProgram ignore breakpoints.
+        StopReason RunUntilBreak(phi::usize max_steps) noexcept;
+
         void Reset() noexcept;
 
+        // Reverse execution. While enabled ExecuteStep and RunUntilBreak record how to undo every
+        // instruction in a ring buffer of capacity records, usually two per instruction, dropping
+        // the oldest instructions once full. A checkpoint of the full state is taken every
+        // UndoCheckpoint::Interval instructions. LoadProgram, ExecuteCurrentProgram, Reset and
+        // Restore clear the history. Modifications from outside of instructions aren't recorded.
+        void SetReverseExecutionEnabled(phi::boolean enabled,
+                                        phi::usize   capacity = UndoLog::DefaultCapacity) noexcept;
+
+        [[nodiscard]] phi::boolean IsReverseExecutionEnabled() const noexcept;
+
+        [[nodiscard]] phi::usize GetNumberOfUndoableSteps() const noexcept;
+
+        // Returns the number of steps taken back which is smaller than requested when the
+        // history runs out. Undoes one instruction at a time or replays from a checkpoint when
+        // that is shorter.
+        phi::usize StepBack(phi::usize steps) noexcept;
+
+        // Steps back until the program counter points to an instruction with a breakpoint. Always
+        // steps back at least once so running again continues past the breakpoint.
+        StopReason RunBackwardsUntilBreak(phi::usize max_steps) noexcept;
+
+        // Tracing. While enabled ExecuteStep, RunUntilBreak and ExecuteCurrentProgram fill a
+        // record for every executed instruction and append it to the trace writer if one is set.
+        // ExecuteCurrentProgram executes one instruction at a time while tracing. The writer must
+        // stay open until it is unset.
+
+        // Enables tracing if the writer is set and disables it otherwise
+        void SetTraceWriter(phi::observer_ptr<TraceWriter> writer) noexcept;
+
+        [[nodiscard]] phi::observer_ptr<TraceWriter> GetTraceWriter() const noexcept;
+
+        // Enabling without a writer only keeps the last record. Disabling also unsets the writer.
+        void SetTracingEnabled(phi::boolean enabled) noexcept;
+
+        [[nodiscard]] phi::boolean IsTracingEnabled() const noexcept;
+
+        // The record of the most recently executed instruction while tracing was enabled
+        [[nodiscard]] const TraceRecord& GetLastTraceRecord() const noexcept;
+
+        // Profiling. While enabled ExecuteStep, RunUntilBreak and ExecuteCurrentProgram count for
+        // every instruction how often it was executed, continued somewhere other than the next
+        // instruction and accessed memory. ExecuteCurrentProgram executes one instruction at a
+        // time while profiling. LoadProgram and ExecuteCurrentProgram clear the profile while
+        // stepping back keeps the counts of the undone instructions.
+        void SetProfilingEnabled(phi::boolean enabled) noexcept;
+
+        [[nodiscard]] phi::boolean IsProfilingEnabled() const noexcept;
+
+        [[nodiscard]] const ExecutionProfile& GetProfile() const noexcept;
+
+        void ClearProfile() noexcept;
+
+        // Pipeline timing. While a model is set ExecuteStep, RunUntilBreak and
+        // ExecuteCurrentProgram retire every executed instruction in it. ExecuteCurrentProgram
+        // executes one instruction at a time and starts a new run of the model. Setting the model
+        // and LoadProgram load the current program into it. Stepping back keeps the cycles of the
+        // undone instructions. The model must outlive its use by the processor.
+        void SetPipelineModel(phi::observer_ptr<PipelineModel> model) noexcept;
+
+        [[nodiscard]] phi::observer_ptr<PipelineModel> GetPipelineModel() const noexcept;
+
+        // Branch prediction. While a predictor is set ExecuteStep, RunUntilBreak and
+        // ExecuteCurrentProgram let it predict every executed control transfer instruction. The
+        // cycles it loses replace the flush after taken control transfers in the pipeline model.
+        // ExecuteCurrentProgram executes one instruction at a time and clears the predictor.
+        // Setting the predictor and LoadProgram load the current program into it. Stepping back
+        // keeps the predictions of the undone instructions. The predictor must outlive its use by
+        // the processor.
+        void SetBranchPredictor(phi::observer_ptr<BranchPredictor> predictor) noexcept;
+
+        [[nodiscard]] phi::observer_ptr<BranchPredictor> GetBranchPredictor() const noexcept;
+
+        // Out of order timing. While a model is set ExecuteStep, RunUntilBreak and
+        // ExecuteCurrentProgram retire every executed instruction in it. It's loaded, cleared and
+        // kept when stepping back just like the pipeline model and both can be set at once.
+        void SetOutOfOrderModel(phi::observer_ptr<OutOfOrderModel> model) noexcept;
+
+        [[nodiscard]] phi::observer_ptr<OutOfOrderModel> GetOutOfOrderModel() const noexcept;
+
+        // Cache simulation. While a simulator is set ExecuteStep, RunUntilBreak and
+        // ExecuteCurrentProgram fetch every executed instruction through it and pass it every load
+        // and store. ExecuteCurrentProgram executes one instruction at a time and clears the
+        // simulator. Setting the simulator and LoadProgram reset it for the current program.
+        // Stepping back keeps the counters and cache contents of the undone instructions. The
+        // simulator must outlive its use by the processor.
+        void SetCacheSimulator(phi::observer_ptr<CacheSimulator> simulator) noexcept;
+
+        [[nodiscard]] phi::observer_ptr<CacheSimulator> GetCacheSimulator() const noexcept;
+
+        // Captures the current state and starts tracking which memory pages are modified
+        [[nodiscard]] ProcessorSnapshot Snapshot() noexcept;
+
+        // Only copies the memory pages modified since the snapshot was taken or last restored.
+        // Restoring any other snapshot copies the whole memory.
+        void Restore(const ProcessorSnapshot& snapshot) noexcept;
+
         void ClearRegisters() noexcept;
 
         void ClearMemory() noexcept;
@@ -159,6 +355,14 @@ namespace dlx
 
         void SetMaxNumberOfSteps(phi::usize new_max) noexcept;
 
+        // Compile straight line blocks to native code when running the whole program. Has no
+        // effect on platforms without JIT support.
+        void SetJITEnabled(phi::boolean enabled) noexcept;
+
+        [[nodiscard]] phi::boolean IsJITEnabled() const noexcept;
+
+        [[nodiscard]] const JITCompiler& GetJITCompiler() const noexcept;
+
         // Dumping
 
         PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wabi-tag")
@@ -174,7 +378,63 @@ namespace dlx
         PHI_GCC_SUPPRESS_WARNING_POP()
 
     private:
-        phi::observer_ptr<ParsedProgram> m_CurrentProgram;
+        template <typename ProcessorT>
+        friend class ObservingProcessor;
+
+        void ExecuteSingleStep() noexcept;
+
+        // Executes the instruction through an ObservingProcessor which reports every write and
+        // memory access for reverse execution, tracing and cache simulation
+        void ExecuteObservedInstruction(const DecodedInstruction& inst) noexcept;
+
+        void ExecuteThreaded() noexcept;
+
+        // Runs the function so that out of bounds accesses to guarded memory raise
+        // AddressOutOfBounds instead of crashing. Returns false if an access faulted in which
+        // case the function was aborted at the faulting access.
+        template <typename FunctionT>
+        [[nodiscard]] phi::boolean RunGuarded(FunctionT function) noexcept;
+
+        // Rewinds to the faulting load or store executed by ExecuteSingleStep or ExecuteThreaded
+        void HandleGuardedMemoryFault() noexcept;
+
+        void CaptureState(ProcessorSnapshot& snapshot) const noexcept;
+
+        void RestoreState(const ProcessorSnapshot& snapshot) noexcept;
+
+        // Called before the register is modified
+        void ObserveIntRegisterWrite(IntRegisterID id, phi::uint32_t value_bits) noexcept;
+
+        void ObserveFloatRegisterWrite(FloatRegisterID id, phi::uint32_t value_bits) noexcept;
+
+        void ObserveDoubleRegisterWrite(FloatRegisterID id, phi::uint64_t value_bits) noexcept;
+
+        void ObserveFPSRWrite(phi::boolean value) noexcept;
+
+        // Called before the memory is modified
+        void PrepareMemoryStore(phi::u32 address, phi::size_t size) noexcept;
+
+        // Called once the store or load succeeded, failed accesses are neither traced nor
+        // simulated
+        void ObserveMemoryStore(phi::u32 address, phi::size_t size,
+                                phi::uint64_t value_bits) noexcept;
+
+        void ObserveMemoryLoad(phi::u32 address, phi::size_t size) noexcept;
+
+        void RecordMemoryUndo(phi::u32 address, phi::size_t size) noexcept;
+
+        void RecordIntRegisterUndo(IntRegisterID id) noexcept;
+
+        void RecordFloatRegisterUndo(FloatRegisterID id) noexcept;
+
+        void UndoStep() noexcept;
+
+        void ClearUndoHistory() noexcept;
+
+        phi::observer_ptr<const ParsedProgram> m_CurrentProgram;
+        std::shared_ptr<const ParsedProgram>   m_SharedProgram;
+        DecodedProgram                         m_DecodedProgram;
+        BlockCache                             m_BlockCache;
 
         std::array<IntRegister, 32u>          m_IntRegisters;
         std::array<IntRegisterValueType, 32u> m_IntRegistersValueTypes;
@@ -196,5 +456,47 @@ namespace dlx
         phi::boolean m_Halted{false};
 
         RegisterAccessType m_CurrentInstructionAccessType{RegisterAccessType::Ignored};
+
+        JITCompiler  m_JITCompiler;
+        phi::boolean m_JITEnabled{false};
+
+        // One bit per instruction
+        std::vector<phi::uint64_t> m_Breakpoints;
+
+        phi::uint64_t m_SnapshotID{0u};
+
+        // Reverse execution
+        phi::boolean                m_ReverseExecutionEnabled{false};
+        UndoLog                     m_UndoLog;
+        std::vector<UndoCheckpoint> m_UndoCheckpoints;
+
+        // Tracing
+        phi::boolean                   m_TracingEnabled{false};
+        phi::observer_ptr<TraceWriter> m_TraceWriter;
+        TraceRecord                    m_TraceRecord;
+
+        // Profiling
+        phi::boolean     m_ProfilingEnabled{false};
+        ExecutionProfile m_Profile;
+
+        // Pipeline timing
+        phi::observer_ptr<PipelineModel> m_PipelineModel;
+
+        // Branch prediction
+        phi::observer_ptr<BranchPredictor> m_BranchPredictor;
+
+        // Out of order timing
+        phi::observer_ptr<OutOfOrderModel> m_OutOfOrderModel;
+
+        // Cache simulation
+        phi::observer_ptr<CacheSimulator> m_CacheSimulator;
+
+        // Set while ExecuteSingleStep executes an instruction with reverse execution enabled,
+        // tracing enabled or a cache simulator set. Only the exceptions and faulting accesses
+        // check it, everything else is reported through ExecuteObservedInstruction.
+        phi::boolean m_ObservingAccesses{false};
     };
+
+    extern template class BasicProcessor<CheckedPolicy>;
+    extern template class BasicProcessor<FastPolicy>;
 } // namespace dlx
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <phi/core/boolean.hpp>
+
+namespace dlx
+{
+    // Tracks the value type of every register and validates the register accesses of every
+    // instruction to diagnose programs mixing signed, unsigned, float and double values
+    struct CheckedPolicy
+    {
+        static constexpr const bool TrackRegisterValueTypes = true;
+    };
+
+    // Skips all register diagnostics. Produces the same results as CheckedPolicy.
+    struct FastPolicy
+    {
+        static constexpr const bool TrackRegisterValueTypes = false;
+    };
+
+    template <typename PolicyT>
+    class BasicProcessor;
+
+    using Processor     = BasicProcessor<CheckedPolicy>;
+    using FastProcessor = BasicProcessor<FastPolicy>;
+} // namespace dlx
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "DLX/BatchRunner.hpp"
+#include "DLX/ParsedProgram.hpp"
+#include "DLX/Processor.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dlx
+{
+    // Executes independent jobs of any number of programs on a fixed set of worker threads. Each
+    // worker owns a FastProcessor allocated up front and only reloads it when the program
+    // changes between two of its jobs. Jobs wait in a bounded queue, so producers are slowed
+    // down to the speed of the workers instead of queueing without limit.
+    class ProcessorPool
+    {
+    public:
+        // Called on the worker thread once the job finished
+        using Callback = std::function<void(const BatchResult& result)>;
+
+        static constexpr const phi::size_t DefaultQueueCapacity{1024u};
+
+        // Uses one worker per hardware thread when number_of_threads is zero. A queue capacity
+        // of zero is treated as one.
+        explicit ProcessorPool(phi::size_t number_of_threads = 0u,
+                               phi::size_t queue_capacity    = DefaultQueueCapacity) noexcept;
+
+        ProcessorPool(const ProcessorPool&) = delete;
+
+        ProcessorPool(ProcessorPool&&) = delete;
+
+        // Finishes the queued jobs
+        ~ProcessorPool() noexcept;
+
+        ProcessorPool& operator=(const ProcessorPool&) = delete;
+
+        ProcessorPool& operator=(ProcessorPool&&) = delete;
+
+        // Queues the job, blocking while the queue is full. Returns false without running the
+        // job if the program is missing or has parse errors, the job is invalid (see
+        // IsBatchJobValid) or the pool was shut down.
+        phi::boolean Submit(SharedParsedProgram program, BatchJob job, Callback callback) noexcept;
+
+        // Same as Submit but returns false instead of blocking when the queue is full
+        phi::boolean TrySubmit(SharedParsedProgram program, BatchJob job,
+                               Callback callback) noexcept;
+
+        // Stops accepting jobs, finishes the queued ones and waits for the workers. Blocked
+        // calls to Submit return false.
+        void Shutdown() noexcept;
+
+        [[nodiscard]] phi::size_t GetNumberOfThreads() const noexcept;
+
+        [[nodiscard]] phi::size_t GetQueueCapacity() const noexcept;
+
+        // Jobs waiting for a worker
+        [[nodiscard]] phi::size_t GetQueueSize() const noexcept;
+
+    private:
+        struct Job
+        {
+            SharedParsedProgram program;
+            BatchJob            job;
+            Callback            callback;
+        };
+
+        phi::boolean Enqueue(Job&& job, phi::boolean wait) noexcept;
+
+        void WorkerMain(phi::size_t index) noexcept;
+
+        std::vector<std::unique_ptr<FastProcessor>> m_Processors;
+        std::vector<std::thread>                    m_Threads;
+        phi::size_t                                 m_QueueCapacity;
+
+        mutable std::mutex      m_Mutex;
+        std::condition_variable m_JobQueued;
+        std::condition_variable m_JobTaken;
+        std::deque<Job>         m_Queue;
+        phi::boolean            m_Stop{false};
+    };
+} // namespace dlx
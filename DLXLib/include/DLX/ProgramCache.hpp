@@ -0,0 +1,59 @@
+#pragma once
+
+#include "DLX/ParsedProgram.hpp"
+#include <phi/core/types.hpp>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace dlx
+{
+    // Parsed programs keyed by a hash of their source. Once full the least recently used program
+    // is evicted, processors still running it keep it alive. Programs with parse errors are
+    // cached as well so repeated submissions don't parse them again. Safe to use from multiple
+    // threads, the programs are parsed outside of the lock.
+    class ProgramCache
+    {
+    public:
+        static constexpr const phi::size_t DefaultCapacity{256u};
+
+        // A capacity of zero is treated as one
+        explicit ProgramCache(phi::size_t capacity = DefaultCapacity) noexcept;
+
+        // Returns the cached program for the source or parses and caches it
+        [[nodiscard]] SharedParsedProgram Get(std::string_view source) noexcept;
+
+        void Clear() noexcept;
+
+        [[nodiscard]] phi::size_t GetSize() const noexcept;
+
+        [[nodiscard]] phi::size_t GetCapacity() const noexcept;
+
+        // Number of calls to Get which found the source in the cache and which had to parse it
+        [[nodiscard]] phi::uint64_t GetHits() const noexcept;
+
+        [[nodiscard]] phi::uint64_t GetMisses() const noexcept;
+
+    private:
+        struct Entry
+        {
+            phi::size_t         hash;
+            SharedParsedProgram program;
+        };
+
+        // Looks up the source and marks it as most recently used. Requires the lock.
+        [[nodiscard]] SharedParsedProgram Find(phi::size_t hash, std::string_view source) noexcept;
+
+        mutable std::mutex m_Mutex;
+        phi::size_t        m_Capacity;
+
+        // Most recently used first. Sources with equal hashes replace each other.
+        std::list<Entry>                                            m_Entries;
+        std::unordered_map<phi::size_t, std::list<Entry>::iterator> m_Index;
+
+        phi::uint64_t m_Hits{0u};
+        phi::uint64_t m_Misses{0u};
+    };
+} // namespace dlx
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "DLX/TraceRecorder.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dlx
+{
+    struct ParsedProgram;
+
+    // Architectural state rebuilt from trace records, starting with every register and byte of
+    // memory set to zero like a freshly loaded processor. The hash is the sum of a hash of every
+    // location and its value minus the same for the location being zero. It is updated in
+    // constant time per written register or byte and equal states always have equal hashes.
+    class TraceState
+    {
+    public:
+        static constexpr const phi::size_t PageSize{4096u};
+
+        using Page = std::array<phi::uint8_t, PageSize>;
+
+        void Reset() noexcept;
+
+        void Apply(const TraceRecord& record) noexcept;
+
+        [[nodiscard]] phi::uint64_t GetHash() const noexcept;
+
+        // Raw bits of the register
+        [[nodiscard]] phi::uint32_t GetIntRegister(phi::size_t index) const noexcept;
+
+        [[nodiscard]] phi::uint32_t GetFloatRegister(phi::size_t index) const noexcept;
+
+        [[nodiscard]] phi::boolean GetFPSR() const noexcept;
+
+        [[nodiscard]] phi::uint8_t GetMemoryByte(phi::uint32_t address) const noexcept;
+
+        // Only pages which were written to exist, indexed by address / PageSize
+        [[nodiscard]] const std::unordered_map<phi::uint32_t, std::unique_ptr<Page>>& GetPages()
+                const noexcept;
+
+    private:
+        void SetLocation(phi::uint64_t location, phi::uint32_t& storage,
+                         phi::uint32_t value) noexcept;
+
+        void StoreByte(phi::uint32_t address, phi::uint8_t value) noexcept;
+
+        std::array<phi::uint32_t, 32u> m_IntRegisters{};
+        std::array<phi::uint32_t, 32u> m_FloatRegisters{};
+        phi::uint32_t                  m_FPSR{0u};
+
+        std::unordered_map<phi::uint32_t, std::unique_ptr<Page>> m_Pages;
+
+        // Most stores hit the same page as the previous one
+        phi::uint32_t m_LastPageIndex{0u};
+        Page*         m_LastPage{nullptr};
+
+        phi::uint64_t m_Hash{0u};
+    };
+
+    // A register whose value differs between the two states
+    struct RegisterDifference
+    {
+        // IntRegister, FloatRegister or FPSR
+        TraceDestination type{TraceDestination::None};
+        phi::uint8_t     index{0u};
+        phi::uint32_t    value_a{0u};
+        phi::uint32_t    value_b{0u};
+    };
+
+    // A run of consecutive differing bytes
+    struct MemoryDifference
+    {
+        phi::uint32_t             address{0u};
+        std::vector<phi::uint8_t> bytes_a;
+        std::vector<phi::uint8_t> bytes_b;
+    };
+
+    struct TraceDiffResult
+    {
+        // Only the first differing memory ranges are kept
+        static constexpr const phi::size_t MaximumMemoryDifferences{32u};
+
+        phi::boolean diverged{false};
+
+        // The step after which the states first differ
+        phi::uint64_t step{0u};
+
+        // The records of that step for each side which did execute it
+        TraceRecord  record_a;
+        TraceRecord  record_b;
+        phi::boolean has_record_a{false};
+        phi::boolean has_record_b{false};
+
+        // Number of steps each side executed or recorded. When they don't diverge the longer
+        // side may still keep running without changing the state.
+        phi::uint64_t number_of_steps_a{0u};
+        phi::uint64_t number_of_steps_b{0u};
+
+        std::vector<RegisterDifference> registers;
+        std::vector<MemoryDifference>   memory;
+
+        // Including the ranges which were not kept
+        phi::size_t number_of_differing_bytes{0u};
+
+        [[nodiscard]] std::string GetSummary() const noexcept;
+    };
+
+    // Compares two executions step by step and stops at the first step after which the
+    // architectural state differs. Only the hashes are compared while the states are equal so
+    // every step costs a constant amount of work. The states don't include the program counter
+    // unless compare_program_counter is set since different programs may use different code to
+    // compute the same state.
+    class TraceComparer
+    {
+    public:
+        explicit TraceComparer(phi::boolean compare_program_counter = false) noexcept;
+
+        void Reset() noexcept;
+
+        // Either record may be null if that side has already finished. Returns true once the
+        // states diverged after which further steps are ignored.
+        phi::boolean Step(const TraceRecord* record_a, const TraceRecord* record_b) noexcept;
+
+        [[nodiscard]] phi::boolean HasDiverged() const noexcept;
+
+        // Fills in the differences if the states diverged
+        [[nodiscard]] TraceDiffResult GetResult() const noexcept;
+
+    private:
+        TraceState    m_StateA;
+        TraceState    m_StateB;
+        phi::uint64_t m_NumberOfStepsA{0u};
+        phi::uint64_t m_NumberOfStepsB{0u};
+        phi::boolean  m_ComparePC;
+
+        phi::boolean  m_Diverged{false};
+        phi::uint64_t m_DivergedStep{0u};
+        TraceRecord   m_RecordA;
+        TraceRecord   m_RecordB;
+        phi::boolean  m_HasRecordA{false};
+        phi::boolean  m_HasRecordB{false};
+    };
+
+    [[nodiscard]] TraceDiffResult CompareTraces(const std::vector<TraceRecord>& trace_a,
+                                                const std::vector<TraceRecord>& trace_b,
+                                                phi::boolean compare_program_counter = false) noexcept;
+
+    // Runs both programs in lockstep, each on a new processor, for at most max_steps steps
+    [[nodiscard]] TraceDiffResult ComparePrograms(const ParsedProgram& program_a,
+                                                  const ParsedProgram& program_b,
+                                                  phi::usize           max_steps,
+                                                  phi::boolean compare_program_counter = false) noexcept;
+} // namespace dlx
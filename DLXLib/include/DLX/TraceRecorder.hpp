@@ -0,0 +1,180 @@
+#pragma once
+
+#include <phi/compiler_support/platform.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Writing the trace through a memory mapping is only implemented for Linux. Other platforms
+// buffer the records in memory and write them with std::fwrite.
+#if !defined(DLX_TRACE_MMAP_SUPPORTED)
+#    if PHI_PLATFORM_IS(LINUX)
+#        define DLX_TRACE_MMAP_SUPPORTED 1
+#    else
+#        define DLX_TRACE_MMAP_SUPPORTED 0
+#    endif
+#endif
+
+namespace dlx
+{
+    enum class TraceDestination : phi::uint8_t
+    {
+        None,
+        IntRegister,
+        FloatRegister,
+        // Register pair, destination is the lower register
+        DoubleRegister,
+        FPSR,
+        Memory,
+    };
+
+    // One executed instruction. The layout is the on disk format so it must not change without
+    // increasing TraceFileHeader::CurrentVersion.
+    struct TraceRecord
+    {
+        // Number of instructions executed before this one
+        phi::uint64_t step{0u};
+
+        // Bits of the value written to the destination
+        phi::uint64_t value{0u};
+
+        phi::uint32_t program_counter{0u};
+
+        // Address of the last successful load or store, only valid with FlagMemoryAccess
+        phi::uint32_t memory_address{0u};
+
+        // The OpCode of the instruction
+        phi::uint16_t opcode{0u};
+
+        TraceDestination destination_type{TraceDestination::None};
+
+        // Register id or the number of bytes stored to memory
+        phi::uint8_t destination{0u};
+
+        phi::uint8_t flags{0u};
+
+        // The Exception raised by the instruction
+        phi::uint8_t exception{0u};
+
+        phi::uint8_t reserved[2]{};
+
+        static constexpr const phi::uint8_t FlagMemoryAccess{0b01u};
+        static constexpr const phi::uint8_t FlagHalted{0b10u};
+    };
+
+    static_assert(sizeof(TraceRecord) == 32u);
+
+    struct TraceFileHeader
+    {
+        static constexpr const char          Magic[8]{'D', 'L', 'X', 'T', 'R', 'A', 'C', 'E'};
+        static constexpr const phi::uint32_t CurrentVersion{1u};
+
+        char          magic[8]{};
+        phi::uint32_t version{CurrentVersion};
+        phi::uint32_t record_size{sizeof(TraceRecord)};
+
+        // Updated on every flush so a trace survives a crash up to the last flush
+        phi::uint64_t number_of_records{0u};
+
+        phi::uint64_t reserved{0u};
+    };
+
+    static_assert(sizeof(TraceFileHeader) == sizeof(TraceRecord));
+
+    // Append only writer of trace files. Records are collected in a window of buffer_size bytes
+    // which is a shared memory mapping of the file where supported. Once the window is full it
+    // is handed to the operating system and the next part of the file is mapped.
+    class TraceWriter
+    {
+    public:
+        static constexpr const phi::size_t DefaultBufferSize{phi::size_t{4u} << 20u};
+
+        TraceWriter() noexcept = default;
+
+        TraceWriter(const TraceWriter&) = delete;
+
+        TraceWriter(TraceWriter&&) = delete;
+
+        ~TraceWriter() noexcept;
+
+        TraceWriter& operator=(const TraceWriter&) = delete;
+
+        TraceWriter& operator=(TraceWriter&&) = delete;
+
+        [[nodiscard]] static constexpr phi::boolean IsMemoryMapped() noexcept
+        {
+            return DLX_TRACE_MMAP_SUPPORTED;
+        }
+
+        // Truncates an existing file. Closes the previously opened file first.
+        phi::boolean Open(const std::string& path,
+                          phi::size_t        buffer_size = DefaultBufferSize) noexcept;
+
+        void Close() noexcept;
+
+        [[nodiscard]] phi::boolean IsOpen() const noexcept;
+
+        void Append(const TraceRecord& record) noexcept
+        {
+            if (m_Cursor == m_End && !AdvanceWindow())
+            {
+                return;
+            }
+
+            std::memcpy(m_Cursor, &record, sizeof(TraceRecord));
+            m_Cursor += sizeof(TraceRecord);
+        }
+
+        // Hands the records written so far to the operating system without waiting for them to
+        // reach the disk and updates the number of records in the header
+        void Flush() noexcept;
+
+        [[nodiscard]] phi::uint64_t GetNumberOfRecords() const noexcept;
+
+    private:
+        // Makes room for the next record. Returns false if writing failed.
+        phi::boolean AdvanceWindow() noexcept;
+
+        void WriteNumberOfRecords() noexcept;
+
+        // Records in the current window [m_Window, m_Cursor) and free space [m_Cursor, m_End)
+        phi::uint8_t* m_Window{nullptr};
+        phi::uint8_t* m_Cursor{nullptr};
+        phi::uint8_t* m_End{nullptr};
+
+        phi::size_t m_WindowSize{0u};
+
+        // File offset of m_Window or the size of the file once closed
+        phi::uint64_t m_WindowOffset{0u};
+
+#if DLX_TRACE_MMAP_SUPPORTED
+        int m_FileDescriptor{-1};
+#else
+        std::FILE*                m_File{nullptr};
+        std::vector<phi::uint8_t> m_Buffer;
+#endif
+    };
+
+    // Reads a whole trace file into memory
+    class TraceReader
+    {
+    public:
+        TraceReader() noexcept = default;
+
+        // Returns false if the file can't be read or isn't a trace file of the current version.
+        // Records after the last flush of an unfinished trace are ignored.
+        phi::boolean Open(const std::string& path) noexcept;
+
+        [[nodiscard]] phi::size_t GetNumberOfRecords() const noexcept;
+
+        [[nodiscard]] const TraceRecord& GetRecord(phi::size_t index) const noexcept;
+
+        [[nodiscard]] const std::vector<TraceRecord>& GetRecords() const noexcept;
+
+    private:
+        std::vector<TraceRecord> m_Records;
+    };
+} // namespace dlx
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+#include <vector>
+
+namespace dlx
+{
+    enum class UndoRecordType : phi::uint8_t
+    {
+        // Starts the records of a single instruction and holds the state every instruction changes
+        Step,
+        IntRegister,
+        FloatRegister,
+        Memory,
+    };
+
+    // Describes how to revert a single modification made by an instruction. The meaning of the
+    // fields depends on the type.
+    struct UndoRecord
+    {
+        UndoRecordType type{UndoRecordType::Step};
+
+        // Step: the FPSR and halted flags, see StepFlagFPSR and StepFlagHalted
+        // IntRegister/FloatRegister: the register id
+        // Memory: the number of bytes
+        phi::uint8_t info{0u};
+
+        // Step: the last raised exception
+        // IntRegister/FloatRegister: the old value type
+        phi::uint8_t extra{0u};
+
+        // Step: the program counter
+        // Memory: the address
+        phi::uint32_t address{0u};
+
+        // Step: the next program counter
+        phi::uint32_t next_address{0u};
+
+        // Step: the step count
+        // IntRegister/FloatRegister: the old bits
+        // Memory: the old bytes
+        phi::uint64_t value{0u};
+
+        static constexpr const phi::uint8_t StepFlagFPSR{0b01u};
+        static constexpr const phi::uint8_t StepFlagHalted{0b10u};
+    };
+
+    // Bounded ring buffer of undo records grouped into steps. Each step starts with a record of
+    // type Step. When the buffer is full the oldest steps are dropped as a whole.
+    // Steps are numbered consecutively and positions count every record ever pushed so both stay
+    // meaningful after old records were dropped.
+    class UndoLog
+    {
+    public:
+        static constexpr const phi::size_t DefaultCapacity{phi::size_t{1u} << 18u};
+
+        // Every step needs room for its step record and the records of the instruction
+        static constexpr const phi::size_t MinimumCapacity{16u};
+
+        UndoLog() noexcept = default;
+
+        // Clears the log. The buffer is only allocated on the first push.
+        void SetCapacity(phi::size_t capacity) noexcept;
+
+        [[nodiscard]] phi::size_t GetCapacity() const noexcept;
+
+        void Clear() noexcept;
+
+        void BeginStep(const UndoRecord& record) noexcept;
+
+        void Push(const UndoRecord& record) noexcept;
+
+        // Removes the most recent record. There must be at least one step.
+        UndoRecord Pop() noexcept;
+
+        // Drops everything from the given position, which must be the start of the given step
+        void Truncate(phi::uint64_t position, phi::uint64_t step) noexcept;
+
+        [[nodiscard]] phi::uint64_t GetFirstStep() const noexcept;
+
+        // One past the most recent step which is the number of the next step
+        [[nodiscard]] phi::uint64_t GetEndStep() const noexcept;
+
+        [[nodiscard]] phi::size_t GetNumberOfSteps() const noexcept;
+
+        [[nodiscard]] phi::uint64_t GetEndPosition() const noexcept;
+
+        [[nodiscard]] phi::boolean IsEmpty() const noexcept;
+
+    private:
+        void DropOldestStep() noexcept;
+
+        std::vector<UndoRecord> m_Records;
+        phi::size_t             m_Capacity{DefaultCapacity};
+        phi::uint64_t           m_BeginPosition{0u};
+        phi::uint64_t           m_EndPosition{0u};
+        phi::uint64_t           m_FirstStep{0u};
+        phi::uint64_t           m_EndStep{0u};
+    };
+} // namespace dlx
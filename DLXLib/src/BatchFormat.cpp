@@ -0,0 +1,543 @@
+#include "DLX/BatchFormat.hpp"
+
+#include "DLX/BatchRunner.hpp"
+#include "DLX/EnumName.hpp"
+#include "DLX/RegisterNames.hpp"
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
+PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(5262)
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+PHI_MSVC_SUPPRESS_WARNING_POP()
+PHI_GCC_SUPPRESS_WARNING_POP()
+
+namespace dlx
+{
+    [[nodiscard]] static constexpr phi::boolean is_space(char character) noexcept
+    {
+        return character == ' ' || character == '\t' || character == '\r' || character == '\n';
+    }
+
+    [[nodiscard]] static std::string_view trim(std::string_view text) noexcept
+    {
+        while (!text.empty() && is_space(text.front()))
+        {
+            text.remove_prefix(1u);
+        }
+
+        while (!text.empty() && is_space(text.back()))
+        {
+            text.remove_suffix(1u);
+        }
+
+        return text;
+    }
+
+    [[nodiscard]] static constexpr char to_upper(char character) noexcept
+    {
+        return character >= 'a' && character <= 'z' ? static_cast<char>(character - 'a' + 'A') :
+                                                      character;
+    }
+
+    [[nodiscard]] static phi::boolean parse_unsigned(std::string_view text,
+                                                     phi::uint64_t&   value) noexcept
+    {
+        int base{10};
+        if (text.size() > 2u && text[0u] == '0' && to_upper(text[1u]) == 'X')
+        {
+            base = 16;
+            text.remove_prefix(2u);
+        }
+
+        const char* end = text.data() + text.size();
+
+        const std::from_chars_result result = std::from_chars(text.data(), end, value, base);
+        return !text.empty() && result.ec == std::errc{} && result.ptr == end;
+    }
+
+    // Accepts everything representable in 32 bits, negative values in two's complement
+    [[nodiscard]] static phi::boolean parse_word(std::string_view text,
+                                                 phi::uint32_t&   value) noexcept
+    {
+        const phi::boolean negative = !text.empty() && text.front() == '-';
+        if (!text.empty() && (text.front() == '-' || text.front() == '+'))
+        {
+            text.remove_prefix(1u);
+        }
+
+        phi::uint64_t magnitude{0u};
+        if (!parse_unsigned(text, magnitude) ||
+            magnitude > (negative ? phi::uint64_t{0x80000000u} : phi::uint64_t{0xFFFFFFFFu}))
+        {
+            return false;
+        }
+
+        value = static_cast<phi::uint32_t>(negative ? 0u - magnitude : magnitude);
+        return true;
+    }
+
+    template <typename T>
+    [[nodiscard]] static phi::boolean parse_floating(std::string_view text, T& value) noexcept
+    {
+        // strtod needs a null terminated string
+        const std::string terminated{text};
+        const char*       begin = terminated.c_str();
+        char*             end   = nullptr;
+
+        if constexpr (sizeof(T) == sizeof(float))
+        {
+            value = std::strtof(begin, &end);
+        }
+        else
+        {
+            value = std::strtod(begin, &end);
+        }
+
+        return !terminated.empty() && !is_space(terminated.front()) &&
+               end == begin + terminated.size();
+    }
+
+    template <typename T>
+    [[nodiscard]] static phi::boolean store(BatchJob& job, phi::uint64_t address, T value,
+                                            std::string& error) noexcept
+    {
+        const phi::uint64_t start = job.memory_starting_address.unsafe();
+        const phi::uint64_t size  = job.memory_size.unsafe();
+
+        if (address < start || address - start > size || size - (address - start) < sizeof(T))
+        {
+            error = fmt::format("Address {} is outside of the memory [{}, {})", address, start,
+                                start + size);
+            return false;
+        }
+
+        const phi::size_t offset = static_cast<phi::size_t>(address - start);
+        if (offset % sizeof(T) != 0u)
+        {
+            error = fmt::format("Address {} is misaligned for a {} byte value", address,
+                                sizeof(T));
+            return false;
+        }
+
+        if (job.memory_image.size() < offset + sizeof(T))
+        {
+            job.memory_image.resize(offset + sizeof(T), 0u);
+        }
+
+        std::memcpy(job.memory_image.data() + offset, &value, sizeof(T));
+        return true;
+    }
+
+    [[nodiscard]] static phi::boolean apply_memory_assignment(BatchJob&        job,
+                                                              std::string_view target,
+                                                              std::string_view value,
+                                                              std::string&     error) noexcept
+    {
+        // M[<address>], MF[<address>] or MD[<address>]
+        const phi::size_t open = target.find('[');
+        const char        type = open == 2u ? to_upper(target[1u]) : 'M';
+
+        phi::uint64_t address{0u};
+        if (!parse_unsigned(trim(target.substr(open + 1u, target.size() - open - 2u)), address) ||
+            address > 0xFFFFFFFFu)
+        {
+            error = fmt::format("Invalid address in '{}'", target);
+            return false;
+        }
+
+        switch (type)
+        {
+            case 'M': {
+                phi::uint32_t word{0u};
+                if (!parse_word(value, word))
+                {
+                    error = fmt::format("Invalid word '{}'", value);
+                    return false;
+                }
+
+                return store(job, address, word, error);
+            }
+            case 'F': {
+                float single{0.0f};
+                if (!parse_floating(value, single))
+                {
+                    error = fmt::format("Invalid float '{}'", value);
+                    return false;
+                }
+
+                return store(job, address, single, error);
+            }
+            default: {
+                double double_value{0.0};
+                if (!parse_floating(value, double_value))
+                {
+                    error = fmt::format("Invalid double '{}'", value);
+                    return false;
+                }
+
+                return store(job, address, double_value, error);
+            }
+        }
+    }
+
+    [[nodiscard]] static phi::boolean is_memory_target(std::string_view target) noexcept
+    {
+        if (target.size() < 3u || to_upper(target.front()) != 'M' || target.back() != ']')
+        {
+            return false;
+        }
+
+        const phi::size_t open = target.find('[');
+        return open == 1u ||
+               (open == 2u && (to_upper(target[1u]) == 'F' || to_upper(target[1u]) == 'D'));
+    }
+
+    BatchStatus GetBatchStatus(const BatchJob& job, const BatchResult& result) noexcept
+    {
+        const Exception exception = result.last_raised_exception;
+
+        if (exception == Exception::Halt)
+        {
+            return BatchStatus::Halted;
+        }
+
+        // Overflows and underflows only warn
+        if (exception != Exception::None && exception != Exception::Overflow &&
+            exception != Exception::Underflow)
+        {
+            return BatchStatus::Exception;
+        }
+
+        if (job.max_number_of_steps != 0u && result.step_count >= job.max_number_of_steps)
+        {
+            return BatchStatus::StepLimit;
+        }
+
+        return BatchStatus::Halted;
+    }
+
+    phi::boolean ApplyBatchAssignment(BatchJob& job, std::string_view assignment,
+                                      std::string& error) noexcept
+    {
+        const phi::size_t equals = assignment.find('=');
+        if (equals == std::string_view::npos)
+        {
+            error = fmt::format("Expected '<target> = <value>' but got '{}'", trim(assignment));
+            return false;
+        }
+
+        const std::string_view target = trim(assignment.substr(0u, equals));
+        const std::string_view value  = trim(assignment.substr(equals + 1u));
+
+        if (is_memory_target(target))
+        {
+            return apply_memory_assignment(job, target, value, error);
+        }
+
+        const phi::string_view register_name{target.data(), target.size()};
+
+        if (IsFPSR(register_name))
+        {
+            if (value != "0" && value != "1")
+            {
+                error = fmt::format("Invalid FPSR value '{}', expected 0 or 1", value);
+                return false;
+            }
+
+            job.fpsr = value == "1";
+            return true;
+        }
+
+        const IntRegisterID int_register = StringToIntRegister(register_name);
+        if (int_register != IntRegisterID::None)
+        {
+            phi::uint32_t word{0u};
+            if (!parse_word(value, word))
+            {
+                error = fmt::format("Invalid word '{}'", value);
+                return false;
+            }
+
+            job.int_registers[static_cast<phi::size_t>(int_register)] =
+                    static_cast<phi::int32_t>(word);
+            return true;
+        }
+
+        const FloatRegisterID float_register = StringToFloatRegister(register_name);
+        if (float_register != FloatRegisterID::None)
+        {
+            float single{0.0f};
+            if (!parse_floating(value, single))
+            {
+                error = fmt::format("Invalid float '{}'", value);
+                return false;
+            }
+
+            job.float_registers[static_cast<phi::size_t>(float_register)] = single;
+            return true;
+        }
+
+        // D<n> names the pair of float registers starting at F<n>
+        if (!target.empty() && to_upper(target.front()) == 'D')
+        {
+            const std::string     float_name = fmt::format("F{}", target.substr(1u));
+            const FloatRegisterID low_register =
+                    StringToFloatRegister(phi::string_view{float_name.data(), float_name.size()});
+
+            if (low_register != FloatRegisterID::None)
+            {
+                const phi::size_t index = static_cast<phi::size_t>(low_register);
+                if (index % 2u != 0u)
+                {
+                    error = fmt::format("Double register '{}' must be even", target);
+                    return false;
+                }
+
+                double double_value{0.0};
+                if (!parse_floating(value, double_value))
+                {
+                    error = fmt::format("Invalid double '{}'", value);
+                    return false;
+                }
+
+                // The low half goes into the first register like FloatRegisterSetDoubleValue
+                phi::uint64_t bits{0u};
+                std::memcpy(&bits, &double_value, sizeof(bits));
+
+                const phi::uint32_t low_bits  = static_cast<phi::uint32_t>(bits);
+                const phi::uint32_t high_bits = static_cast<phi::uint32_t>(bits >> 32u);
+                std::memcpy(&job.float_registers[index], &low_bits, sizeof(float));
+                std::memcpy(&job.float_registers[index + 1u], &high_bits, sizeof(float));
+                return true;
+            }
+        }
+
+        error = fmt::format("Unknown register or memory location '{}'", target);
+        return false;
+    }
+
+    phi::boolean ApplyBatchAssignments(BatchJob& job, std::string_view text,
+                                       std::string& error) noexcept
+    {
+        phi::size_t line_number{0u};
+
+        while (!text.empty())
+        {
+            const phi::size_t end = text.find('\n');
+            std::string_view  line =
+                    end == std::string_view::npos ? text : text.substr(0u, end);
+            text = end == std::string_view::npos ? std::string_view{} : text.substr(end + 1u);
+            ++line_number;
+
+            const phi::size_t comment = line.find('#');
+            if (comment != std::string_view::npos)
+            {
+                line = line.substr(0u, comment);
+            }
+
+            if (trim(line).empty())
+            {
+                continue;
+            }
+
+            if (!ApplyBatchAssignment(job, line, error))
+            {
+                error = fmt::format("Line {}: {}", line_number, error);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] static const char* get_status_name(BatchStatus status) noexcept
+    {
+        switch (status)
+        {
+            case BatchStatus::Halted:
+                return "Halted";
+            case BatchStatus::StepLimit:
+                return "Step limit";
+            case BatchStatus::Exception:
+                return "Exception";
+        }
+
+        return "";
+    }
+
+    [[nodiscard]] static const char* get_status_json_name(BatchStatus status) noexcept
+    {
+        switch (status)
+        {
+            case BatchStatus::Halted:
+                return "halted";
+            case BatchStatus::StepLimit:
+                return "step_limit";
+            case BatchStatus::Exception:
+                return "exception";
+        }
+
+        return "";
+    }
+
+    // Returns false if the word isn't completely inside of the memory
+    [[nodiscard]] static phi::boolean load_word(const BatchJob& job, const BatchResult& result,
+                                                phi::uint64_t address, phi::int32_t& word) noexcept
+    {
+        const phi::uint64_t start = job.memory_starting_address.unsafe();
+
+        if (address < start || address - start > result.memory.size() ||
+            result.memory.size() - (address - start) < sizeof(word))
+        {
+            return false;
+        }
+
+        std::memcpy(&word, result.memory.data() + (address - start), sizeof(word));
+        return true;
+    }
+
+    [[nodiscard]] static std::string format_float_json(float value) noexcept
+    {
+        return std::isfinite(value) ? fmt::format("{}", value) : std::string{"null"};
+    }
+
+    std::string FormatBatchResult(const BatchJob& job, const BatchResult& result,
+                                  const std::vector<MemoryRange>& memory_ranges) noexcept
+    {
+        std::string text;
+
+        text.append(fmt::format("Status          {:>11}\n",
+                                get_status_name(GetBatchStatus(job, result))));
+        text.append(fmt::format("Exception       {:>11}\n",
+                                enum_name(result.last_raised_exception).data()));
+        text.append(fmt::format("Steps           {:>11}\n", result.step_count.unsafe()));
+        text.append(fmt::format("Program counter {:>11}\n", result.program_counter.unsafe()));
+
+        // Four registers per row
+        for (phi::size_t index{0u}; index < 32u; ++index)
+        {
+            text.append(fmt::format("{}{:<4}{:>12}", index % 4u == 0u ? "\n" : "  ",
+                                    fmt::format("R{}", index), result.int_registers[index]));
+        }
+        text.push_back('\n');
+
+        for (phi::size_t index{0u}; index < 32u; ++index)
+        {
+            text.append(fmt::format("{}{:<4}{:>12}", index % 4u == 0u ? "\n" : "  ",
+                                    fmt::format("F{}", index), result.float_registers[index]));
+        }
+        text.append(fmt::format("\n\nFPSR{:>12}\n", result.fpsr ? 1 : 0));
+
+        for (const MemoryRange& range : memory_ranges)
+        {
+            for (phi::uint32_t word_index{0u}; word_index < range.words; ++word_index)
+            {
+                const phi::uint64_t address = phi::uint64_t{range.address} + word_index * 4u;
+
+                phi::int32_t word{0};
+                if (load_word(job, result, address, word))
+                {
+                    text.append(fmt::format("\n[{}]{:>12}", address, word));
+                }
+                else
+                {
+                    text.append(fmt::format("\n[{}]{:>12}", address, "-"));
+                }
+            }
+        }
+
+        if (!memory_ranges.empty())
+        {
+            text.push_back('\n');
+        }
+
+        return text;
+    }
+
+    std::string FormatBatchResultJson(const BatchJob& job, const BatchResult& result,
+                                      const std::vector<MemoryRange>& memory_ranges,
+                                      std::string_view                input) noexcept
+    {
+        std::string text{"{"};
+
+        if (!input.empty())
+        {
+            text.append(fmt::format("\"input\":{},", FormatJsonString(input)));
+        }
+
+        text.append(fmt::format(
+                "\"status\":\"{}\",\"exception\":\"{}\",\"steps\":{},\"program_counter\":{}",
+                get_status_json_name(GetBatchStatus(job, result)),
+                enum_name(result.last_raised_exception).data(), result.step_count.unsafe(),
+                result.program_counter.unsafe()));
+
+        text.append(",\"int_registers\":[");
+        for (phi::size_t index{0u}; index < 32u; ++index)
+        {
+            text.append(fmt::format("{}{}", index == 0u ? "" : ",", result.int_registers[index]));
+        }
+
+        text.append("],\"float_registers\":[");
+        for (phi::size_t index{0u}; index < 32u; ++index)
+        {
+            text.append(fmt::format("{}{}", index == 0u ? "" : ",",
+                                    format_float_json(result.float_registers[index])));
+        }
+
+        text.append(fmt::format("],\"fpsr\":{},\"memory\":[", result.fpsr ? "true" : "false"));
+        for (phi::size_t range_index{0u}; range_index < memory_ranges.size(); ++range_index)
+        {
+            const MemoryRange& range = memory_ranges[range_index];
+
+            text.append(fmt::format("{}{{\"address\":{},\"words\":[", range_index == 0u ? "" : ",",
+                                    range.address));
+
+            for (phi::uint32_t word_index{0u}; word_index < range.words; ++word_index)
+            {
+                phi::int32_t word{0};
+                const phi::boolean valid = load_word(
+                        job, result, phi::uint64_t{range.address} + word_index * 4u, word);
+
+                text.append(fmt::format("{}{}", word_index == 0u ? "" : ",",
+                                        valid ? fmt::format("{}", word) : std::string{"null"}));
+            }
+
+            text.append("]}");
+        }
+
+        text.append("]}");
+        return text;
+    }
+
+    std::string FormatJsonString(std::string_view value) noexcept
+    {
+        std::string text{"\""};
+        text.reserve(value.size() + 2u);
+
+        for (const char character : value)
+        {
+            if (character == '"' || character == '\\')
+            {
+                text.push_back('\\');
+                text.push_back(character);
+            }
+            else if (static_cast<unsigned char>(character) < 0x20u)
+            {
+                text.append(fmt::format("\\u{:04x}", static_cast<unsigned>(character)));
+            }
+            else
+            {
+                text.push_back(character);
+            }
+        }
+
+        text.push_back('"');
+        return text;
+    }
+} // namespace dlx
@@ -0,0 +1,306 @@
+#include "DLX/BatchRunner.hpp"
+
+#include "DLX/FloatRegister.hpp"
+#include "DLX/IntRegister.hpp"
+#include "DLX/MemoryBlock.hpp"
+#include "DLX/ParsedProgram.hpp"
+#include "DLX/RegisterNames.hpp"
+#include <phi/core/assert.hpp>
+#include <algorithm>
+#include <limits>
+
+namespace dlx
+{
+    [[nodiscard]] static constexpr phi::uint64_t pack_jobs(phi::uint32_t begin,
+                                                          phi::uint32_t end) noexcept
+    {
+        return static_cast<phi::uint64_t>(end) << 32u | begin;
+    }
+
+    [[nodiscard]] static constexpr phi::uint32_t jobs_begin(phi::uint64_t jobs) noexcept
+    {
+        return static_cast<phi::uint32_t>(jobs);
+    }
+
+    [[nodiscard]] static constexpr phi::uint32_t jobs_end(phi::uint64_t jobs) noexcept
+    {
+        return static_cast<phi::uint32_t>(jobs >> 32u);
+    }
+
+    // Takes the first remaining job of the worker
+    [[nodiscard]] static phi::boolean pop_job(std::atomic<phi::uint64_t>& jobs,
+                                              phi::uint32_t&              job_index) noexcept
+    {
+        phi::uint64_t current = jobs.load(std::memory_order_acquire);
+
+        while (jobs_begin(current) < jobs_end(current))
+        {
+            if (jobs.compare_exchange_weak(current,
+                                           pack_jobs(jobs_begin(current) + 1u, jobs_end(current)),
+                                           std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                job_index = jobs_begin(current);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    phi::boolean IsBatchJobValid(const BatchJob& job) noexcept
+    {
+        return job.memory_image.size() <= job.memory_size.unsafe();
+    }
+
+    void ExecuteBatchJob(FastProcessor& processor, const BatchJob& job,
+                         BatchResult& result) noexcept
+    {
+        if (!IsBatchJobValid(job))
+        {
+            result                       = BatchResult{};
+            result.int_registers         = job.int_registers;
+            result.float_registers       = job.float_registers;
+            result.fpsr                  = job.fpsr;
+            result.last_raised_exception = Exception::AddressOutOfBounds;
+            return;
+        }
+
+        // Setup initial state
+        for (phi::size_t index{0u}; index < 32u; ++index)
+        {
+            processor.IntRegisterSetSignedValue(static_cast<IntRegisterID>(index),
+                                                job.int_registers[index]);
+            processor.GetFloatRegister(static_cast<FloatRegisterID>(index))
+                    .SetValue(job.float_registers[index]);
+        }
+        processor.SetFPSRValue(job.fpsr);
+
+        MemoryBlock& memory = processor.GetMemory();
+        memory.SetStartingAddress(job.memory_starting_address);
+        memory.Resize(job.memory_size);
+        memory.Clear();
+
+        // Resizing fails for paged and guarded memory
+        std::vector<MemoryBlock::MemoryByte>& raw_memory = memory.GetRawMemory();
+        const phi::size_t image_size = std::min(job.memory_image.size(), raw_memory.size());
+        for (phi::size_t index{0u}; index < image_size; ++index)
+        {
+            raw_memory[index].unsigned_value = job.memory_image[index];
+        }
+
+        processor.SetMaxNumberOfSteps(job.max_number_of_steps);
+
+        processor.ExecuteCurrentProgram();
+
+        // Collect final state
+        for (phi::size_t index{0u}; index < 32u; ++index)
+        {
+            result.int_registers[index] =
+                    processor.GetIntRegister(static_cast<IntRegisterID>(index))
+                            .GetSignedValue()
+                            .unsafe();
+            result.float_registers[index] =
+                    processor.GetFloatRegister(static_cast<FloatRegisterID>(index))
+                            .GetValue()
+                            .unsafe();
+        }
+        result.fpsr = processor.GetFPSRValue();
+
+        result.memory.resize(raw_memory.size());
+        for (phi::size_t index{0u}; index < raw_memory.size(); ++index)
+        {
+            result.memory[index] = raw_memory[index].unsigned_value;
+        }
+
+        result.program_counter       = processor.GetProgramCounter();
+        result.step_count            = processor.GetCurrentStepCount();
+        result.last_raised_exception = processor.GetLastRaisedException();
+    }
+
+    BatchRunner::BatchRunner(phi::size_t number_of_threads) noexcept
+    {
+        if (number_of_threads == 0u)
+        {
+            number_of_threads = phi::size_t{std::thread::hardware_concurrency()};
+        }
+
+        // hardware_concurrency may not be computable
+        if (number_of_threads == 0u)
+        {
+            number_of_threads = 1u;
+        }
+
+        m_Workers.reserve(number_of_threads);
+        for (phi::size_t index{0u}; index < number_of_threads; ++index)
+        {
+            m_Workers.emplace_back(std::make_unique<Worker>());
+        }
+
+        m_Threads.reserve(number_of_threads);
+        for (phi::size_t index{0u}; index < number_of_threads; ++index)
+        {
+            m_Threads.emplace_back(&BatchRunner::WorkerMain, this, index);
+        }
+    }
+
+    BatchRunner::~BatchRunner() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_Mutex};
+            m_Stop = true;
+        }
+        m_BatchStarted.notify_all();
+
+        for (std::thread& thread : m_Threads)
+        {
+            thread.join();
+        }
+    }
+
+    std::vector<BatchResult> BatchRunner::Run(const ParsedProgram&         program,
+                                              const std::vector<BatchJob>& jobs) noexcept
+    {
+        if (!program.m_ParseErrors.empty())
+        {
+            return {};
+        }
+
+        std::vector<BatchResult> results(jobs.size());
+        if (jobs.empty())
+        {
+            return results;
+        }
+
+        std::lock_guard<std::mutex> run_lock{m_RunMutex};
+
+        PHI_ASSERT(jobs.size() < std::numeric_limits<phi::uint32_t>::max(), "Too many jobs");
+
+        // Split the jobs evenly between all workers
+        const phi::size_t number_of_workers = m_Workers.size();
+        for (phi::size_t index{0u}; index < number_of_workers; ++index)
+        {
+            const phi::size_t begin = jobs.size() * index / number_of_workers;
+            const phi::size_t end   = jobs.size() * (index + 1u) / number_of_workers;
+
+            m_Workers[index]->jobs.store(pack_jobs(static_cast<phi::uint32_t>(begin),
+                                                   static_cast<phi::uint32_t>(end)),
+                                         std::memory_order_relaxed);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock{m_Mutex};
+            m_Program     = &program;
+            m_Jobs        = &jobs;
+            m_Results     = &results;
+            m_BusyWorkers = number_of_workers;
+            ++m_Generation;
+        }
+        m_BatchStarted.notify_all();
+
+        {
+            std::unique_lock<std::mutex> lock{m_Mutex};
+            m_BatchFinished.wait(lock, [this] { return m_BusyWorkers == 0u; });
+
+            m_Program = nullptr;
+            m_Jobs    = nullptr;
+            m_Results = nullptr;
+        }
+
+        return results;
+    }
+
+    phi::size_t BatchRunner::GetNumberOfThreads() const noexcept
+    {
+        return m_Threads.size();
+    }
+
+    void BatchRunner::WorkerMain(phi::size_t index) noexcept
+    {
+        Worker&     worker = *m_Workers[index];
+        phi::size_t generation{0u};
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock{m_Mutex};
+                m_BatchStarted.wait(lock,
+                                    [&] { return m_Stop || m_Generation != generation; });
+
+                if (m_Stop)
+                {
+                    return;
+                }
+
+                generation = m_Generation;
+            }
+
+            ExecuteBatch(worker, index);
+
+            {
+                std::lock_guard<std::mutex> lock{m_Mutex};
+                --m_BusyWorkers;
+
+                if (m_BusyWorkers == 0u)
+                {
+                    m_BatchFinished.notify_one();
+                }
+            }
+        }
+    }
+
+    void BatchRunner::ExecuteBatch(Worker& worker, phi::size_t index) noexcept
+    {
+        FastProcessor& processor = worker.processor;
+
+        const phi::boolean loaded = processor.LoadProgram(*m_Program);
+        PHI_ASSERT(loaded);
+        (void)loaded;
+
+        phi::uint32_t job_index{0u};
+        while (true)
+        {
+            if (!pop_job(worker.jobs, job_index))
+            {
+                // A successful steal refills the jobs of this worker
+                if (!StealJobs(worker, index))
+                {
+                    break;
+                }
+
+                continue;
+            }
+
+            ExecuteBatchJob(processor, (*m_Jobs)[job_index], (*m_Results)[job_index]);
+        }
+    }
+
+    phi::boolean BatchRunner::StealJobs(Worker& thief, phi::size_t index) noexcept
+    {
+        const phi::size_t number_of_workers = m_Workers.size();
+
+        for (phi::size_t offset{1u}; offset < number_of_workers; ++offset)
+        {
+            Worker&       victim  = *m_Workers[(index + offset) % number_of_workers];
+            phi::uint64_t current = victim.jobs.load(std::memory_order_acquire);
+
+            while (jobs_begin(current) < jobs_end(current))
+            {
+                // Take the upper half leaving the victim with the jobs it will process next
+                const phi::uint32_t begin = jobs_begin(current);
+                const phi::uint32_t end   = jobs_end(current);
+                const phi::uint32_t split = begin + (end - begin) / 2u;
+
+                if (victim.jobs.compare_exchange_weak(current, pack_jobs(begin, split),
+                                                      std::memory_order_acq_rel,
+                                                      std::memory_order_acquire))
+                {
+                    // Nobody else modifies the jobs of an idle worker
+                    thief.jobs.store(pack_jobs(split, end), std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+} // namespace dlx
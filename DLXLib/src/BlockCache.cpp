@@ -0,0 +1,106 @@
+#include "DLX/BlockCache.hpp"
+
+#include "DLX/DecodedProgram.hpp"
+#include "DLX/OpCode.hpp"
+#include <phi/core/assert.hpp>
+
+namespace dlx
+{
+    phi::optional<Superinstruction> MatchSuperinstruction(const DecodedProgram& program,
+                                                          phi::size_t           index,
+                                                          phi::size_t block_end) noexcept
+    {
+        PHI_ASSERT(index <= block_end);
+        PHI_ASSERT(block_end < program.m_Instructions.size());
+
+        const std::vector<DecodedInstruction>& instructions = program.m_Instructions;
+        const phi::size_t                      remaining    = block_end - index;
+
+        if (remaining >= 1u)
+        {
+            const OpCode first  = instructions[index].opcode;
+            const OpCode second = instructions[index + 1u].opcode;
+
+            // Compare and branch
+            if (first == OpCode::SLT && second == OpCode::BEQZ)
+            {
+                return Superinstruction::SLT_BEQZ;
+            }
+
+            // Loop back edge
+            if (first == OpCode::ADDI && second == OpCode::J)
+            {
+                return Superinstruction::ADDI_J;
+            }
+
+            // Read modify write
+            if (remaining >= 2u && first == OpCode::LW && second == OpCode::ADD &&
+                instructions[index + 2u].opcode == OpCode::SW)
+            {
+                return Superinstruction::LW_ADD_SW;
+            }
+        }
+
+        return {};
+    }
+
+    void BlockCache::Reset(phi::size_t number_of_instructions) noexcept
+    {
+        m_Operations.clear();
+        m_BlockOffsets.assign(number_of_instructions, NotCached);
+        m_NumberOfCachedBlocks    = 0u;
+        m_NumberOfFusedOperations = 0u;
+    }
+
+    const BlockOperation* BlockCache::CacheBlock(const DecodedProgram& program,
+                                                 phi::uint32_t         start) noexcept
+    {
+        PHI_ASSERT(m_BlockOffsets[start] == NotCached);
+
+        const phi::uint32_t block_end = program.m_BlockEnds[start];
+
+        m_BlockOffsets[start] = static_cast<phi::uint32_t>(m_Operations.size());
+
+        for (phi::uint32_t index = start; index <= block_end;)
+        {
+            BlockOperation operation;
+            operation.instruction = &program.m_Instructions[index];
+            operation.index       = index;
+
+            const phi::optional<Superinstruction> superinstruction =
+                    MatchSuperinstruction(program, index, block_end);
+
+            if (superinstruction)
+            {
+                operation.handler = BlockOperation::FirstSuperinstructionHandler +
+                                    static_cast<phi::uint32_t>(*superinstruction);
+                index += static_cast<phi::uint32_t>(GetSuperinstructionLength(*superinstruction));
+
+                ++m_NumberOfFusedOperations;
+            }
+            else
+            {
+                operation.handler = static_cast<phi::uint32_t>(operation.instruction->opcode);
+                ++index;
+            }
+
+            m_Operations.push_back(operation);
+        }
+
+        // Terminate the block
+        m_Operations.emplace_back();
+        ++m_NumberOfCachedBlocks;
+
+        return &m_Operations[m_BlockOffsets[start]];
+    }
+
+    phi::usize BlockCache::GetNumberOfCachedBlocks() const noexcept
+    {
+        return m_NumberOfCachedBlocks;
+    }
+
+    phi::usize BlockCache::GetNumberOfFusedOperations() const noexcept
+    {
+        return m_NumberOfFusedOperations;
+    }
+} // namespace dlx
@@ -0,0 +1,414 @@
+#include "DLX/BranchPredictor.hpp"
+
+#include "DLX/DecodedProgram.hpp"
+#include "DLX/Instruction.hpp"
+#include "DLX/ParsedProgram.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <algorithm>
+#include <bit>
+
+PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
+PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(5262)
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+PHI_MSVC_SUPPRESS_WARNING_POP()
+PHI_GCC_SUPPRESS_WARNING_POP()
+
+PHI_CLANG_SUPPRESS_WARNING("-Wswitch-default")
+
+namespace dlx
+{
+    // Saturating counters start out weakly not taken and the chooser weakly prefers the local
+    // counters
+    static constexpr const phi::uint8_t InitialCounter{1u};
+
+    static constexpr void update_counter(phi::uint8_t& counter, phi::boolean taken) noexcept
+    {
+        if (taken)
+        {
+            counter = counter == 3u ? phi::uint8_t{3u} : static_cast<phi::uint8_t>(counter + 1u);
+        }
+        else
+        {
+            counter = counter == 0u ? phi::uint8_t{0u} : static_cast<phi::uint8_t>(counter - 1u);
+        }
+    }
+
+    phi::boolean BranchPredictorConfig::IsValid() const noexcept
+    {
+        return table_bits <= MaximumTableBits && history_bits <= table_bits &&
+               (btb_entries == 0u || std::has_single_bit(btb_entries)) &&
+               btb_entries <= MaximumBTBEntries && ras_entries <= MaximumRASEntries;
+    }
+
+    double BranchProfile::GetAccuracy() const noexcept
+    {
+        if (executed == 0u)
+        {
+            return 0.0;
+        }
+
+        return static_cast<double>(executed - mispredictions - misfetches) /
+               static_cast<double>(executed);
+    }
+
+    BranchPredictor::BranchPredictor() noexcept
+    {
+        Clear();
+    }
+
+    BranchPredictor::BranchPredictor(const BranchPredictorConfig& config) noexcept
+    {
+        if (!SetConfig(config))
+        {
+            Clear();
+        }
+    }
+
+    phi::boolean BranchPredictor::SetConfig(const BranchPredictorConfig& config) noexcept
+    {
+        if (!config.IsValid())
+        {
+            return false;
+        }
+
+        m_Config = config;
+        Clear();
+
+        return true;
+    }
+
+    const BranchPredictorConfig& BranchPredictor::GetConfig() const noexcept
+    {
+        return m_Config;
+    }
+
+    void BranchPredictor::Load(const DecodedProgram& program) noexcept
+    {
+        m_Infos.clear();
+        m_Infos.reserve(program.m_Instructions.size());
+
+        for (const DecodedInstruction& instruction : program.m_Instructions)
+        {
+            BranchInfo& info = m_Infos.emplace_back();
+
+            switch (instruction.opcode)
+            {
+                case OpCode::BEQZ:
+                case OpCode::BNEZ:
+                case OpCode::BFPT:
+                case OpCode::BFPF:
+                    info.kind   = BranchKind::Conditional;
+                    info.target = instruction.jump_point;
+                    break;
+
+                case OpCode::J:
+                case OpCode::JAL:
+                    info.kind   = BranchKind::Jump;
+                    info.call   = instruction.opcode == OpCode::JAL;
+                    info.target = instruction.jump_point;
+                    break;
+
+                case OpCode::JR:
+                    info.kind = instruction.GetIntRegister(0u) == IntRegisterID::R31 ?
+                                        BranchKind::Return :
+                                        BranchKind::RegisterJump;
+                    break;
+
+                case OpCode::JALR:
+                    info.kind = BranchKind::RegisterJump;
+                    info.call = true;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+        m_Branches.resize(m_Infos.size());
+        Clear();
+    }
+
+    void BranchPredictor::Clear() noexcept
+    {
+        const BranchPredictorType type       = m_Config.type;
+        const phi::size_t         table_size = phi::size_t{1u} << m_Config.table_bits;
+
+        const phi::boolean local = type == BranchPredictorType::OneBit ||
+                                   type == BranchPredictorType::TwoBit ||
+                                   type == BranchPredictorType::Tournament;
+        const phi::boolean global =
+                type == BranchPredictorType::GShare || type == BranchPredictorType::Tournament;
+        const phi::boolean chooser = type == BranchPredictorType::Tournament;
+
+        // Single bits start out not taken
+        m_LocalCounters.assign(local ? table_size : 0u,
+                               type == BranchPredictorType::OneBit ? phi::uint8_t{0u} :
+                                                                     InitialCounter);
+        m_GlobalCounters.assign(global ? table_size : 0u, InitialCounter);
+        m_ChooserCounters.assign(chooser ? table_size : 0u, InitialCounter);
+
+        m_TableMask = static_cast<phi::uint32_t>(table_size - 1u);
+        m_HistoryMask =
+                static_cast<phi::uint32_t>((phi::uint64_t{1u} << m_Config.history_bits) - 1u);
+        m_History = 0u;
+
+        m_BTB.assign(m_Config.btb_entries, BTBEntry{});
+
+        m_ReturnStack.assign(m_Config.ras_entries, 0u);
+        m_ReturnTop   = 0u;
+        m_ReturnDepth = 0u;
+
+        std::fill(m_Branches.begin(), m_Branches.end(), BranchProfile{});
+    }
+
+    phi::uint8_t BranchPredictor::Resolve(phi::uint32_t index, phi::boolean taken,
+                                          phi::uint32_t target) noexcept
+    {
+        PHI_ASSERT(index < m_Infos.size());
+
+        const BranchInfo& info = m_Infos[index];
+        PHI_ASSERT(info.kind != BranchKind::None);
+
+        BranchProfile& profile = m_Branches[index];
+        ++profile.executed;
+        if (taken)
+        {
+            ++profile.taken;
+        }
+
+        const phi::uint8_t resolve_penalty =
+                m_Config.branch_resolution == BranchResolution::Decode ? 1u : 2u;
+
+        // The target the fetch stage continues with when it predicts the instruction taken
+        phi::uint32_t predicted_target{InvalidTarget};
+        if (info.kind == BranchKind::Return && m_ReturnDepth != 0u)
+        {
+            m_ReturnTop = (m_ReturnTop + static_cast<phi::uint32_t>(m_ReturnStack.size()) - 1u) %
+                          static_cast<phi::uint32_t>(m_ReturnStack.size());
+            predicted_target = m_ReturnStack[m_ReturnTop];
+            --m_ReturnDepth;
+        }
+        else if (!m_BTB.empty())
+        {
+            const BTBEntry& entry = m_BTB[index & (m_BTB.size() - 1u)];
+            if (entry.index == index)
+            {
+                predicted_target = entry.target;
+            }
+        }
+
+        phi::uint8_t penalty{0u};
+        if (info.kind == BranchKind::Conditional)
+        {
+            const phi::boolean predicted_taken = PredictDirection(index, info);
+
+            if (predicted_taken != taken)
+            {
+                ++profile.mispredictions;
+                penalty = resolve_penalty;
+            }
+            else if (taken && predicted_target != target)
+            {
+                // The target of the branch is known after decoding it
+                ++profile.misfetches;
+                penalty = 1u;
+            }
+
+            UpdateDirection(index, taken);
+        }
+        else
+        {
+            // Without a predicted target the fetch stage simply continues
+            const phi::uint32_t predicted_next =
+                    predicted_target != InvalidTarget ? predicted_target : index + 1u;
+
+            if (predicted_next != target)
+            {
+                ++profile.misfetches;
+                penalty = info.kind == BranchKind::Jump ? phi::uint8_t{1u} : resolve_penalty;
+            }
+        }
+
+        profile.penalty_cycles += penalty;
+
+        if (taken && !m_BTB.empty())
+        {
+            m_BTB[index & (m_BTB.size() - 1u)] = BTBEntry{index, target};
+        }
+
+        if (info.call && !m_ReturnStack.empty())
+        {
+            m_ReturnStack[m_ReturnTop] = index + 1u;
+            m_ReturnTop   = (m_ReturnTop + 1u) % static_cast<phi::uint32_t>(m_ReturnStack.size());
+            m_ReturnDepth = std::min(m_ReturnDepth + 1u,
+                                     static_cast<phi::uint32_t>(m_ReturnStack.size()));
+        }
+
+        return penalty;
+    }
+
+    BranchProfile BranchPredictor::GetTotals() const noexcept
+    {
+        BranchProfile totals;
+
+        for (const BranchProfile& profile : m_Branches)
+        {
+            totals.executed += profile.executed;
+            totals.taken += profile.taken;
+            totals.mispredictions += profile.mispredictions;
+            totals.misfetches += profile.misfetches;
+            totals.penalty_cycles += profile.penalty_cycles;
+        }
+
+        return totals;
+    }
+
+    const std::vector<BranchProfile>& BranchPredictor::GetBranches() const noexcept
+    {
+        return m_Branches;
+    }
+
+    std::string BranchPredictor::GetReport(const ParsedProgram& program,
+                                           phi::size_t          max_branches) const noexcept
+    {
+        PHI_ASSERT(program.m_Instructions.size() == m_Branches.size());
+
+        const BranchProfile totals = GetTotals();
+
+        std::string text = fmt::format(
+                "Branches {:>18}\nTaken {:>21}\nMispredicted {:>14}\nMisfetched {:>16}\n"
+                "Accuracy {:>17.2f}%\nPenalty cycles {:>12}\n",
+                totals.executed, totals.taken, totals.mispredictions, totals.misfetches,
+                100.0 * totals.GetAccuracy(), totals.penalty_cycles);
+
+        // Branches ordered by the cycles they lost, ties in program order
+        std::vector<phi::uint32_t> indices;
+        for (phi::uint32_t index{0u}; index < m_Branches.size(); ++index)
+        {
+            if (m_Branches[index].executed != 0u)
+            {
+                indices.push_back(index);
+            }
+        }
+
+        if (indices.empty())
+        {
+            return text;
+        }
+
+        std::stable_sort(indices.begin(), indices.end(), [&](phi::uint32_t lhs, phi::uint32_t rhs) {
+            return m_Branches[lhs].penalty_cycles > m_Branches[rhs].penalty_cycles;
+        });
+
+        text.append(fmt::format("\n{:>6} {:>12} {:>12} {:>12} {:>12} {:>9} {:>12}  {}\n", "Line",
+                                "Executed", "Taken", "Mispredicted", "Misfetched", "Accuracy",
+                                "Penalty", "Instruction"));
+
+        const phi::size_t shown = std::min(indices.size(), max_branches);
+        for (phi::size_t position{0u}; position < shown; ++position)
+        {
+            const phi::uint32_t  index       = indices[position];
+            const BranchProfile& profile     = m_Branches[index];
+            const Instruction&   instruction = program.m_Instructions[index];
+
+            text.append(fmt::format("{:>6} {:>12} {:>12} {:>12} {:>12} {:>8.2f}% {:>12}  {}\n",
+                                    instruction.GetSourceLine().unsafe(), profile.executed,
+                                    profile.taken, profile.mispredictions, profile.misfetches,
+                                    100.0 * profile.GetAccuracy(), profile.penalty_cycles,
+                                    instruction.DebugInfo()));
+        }
+
+        if (indices.size() > shown)
+        {
+            text.append(fmt::format("({} more branches)\n", indices.size() - shown));
+        }
+
+        return text;
+    }
+
+    phi::boolean BranchPredictor::PredictDirection(phi::uint32_t     index,
+                                                   const BranchInfo& info) const noexcept
+    {
+        switch (m_Config.type)
+        {
+            case BranchPredictorType::AlwaysNotTaken:
+                return false;
+
+            case BranchPredictorType::AlwaysTaken:
+                return true;
+
+            case BranchPredictorType::BackwardTaken:
+                return info.target <= index;
+
+            case BranchPredictorType::OneBit:
+                return m_LocalCounters[index & m_TableMask] != 0u;
+
+            case BranchPredictorType::TwoBit:
+                return m_LocalCounters[index & m_TableMask] >= 2u;
+
+            case BranchPredictorType::GShare:
+                return m_GlobalCounters[GShareIndex(index)] >= 2u;
+
+            case BranchPredictorType::Tournament:
+                if (m_ChooserCounters[index & m_TableMask] >= 2u)
+                {
+                    return m_GlobalCounters[GShareIndex(index)] >= 2u;
+                }
+
+                return m_LocalCounters[index & m_TableMask] >= 2u;
+        }
+
+        PHI_ASSERT_NOT_REACHED();
+    }
+
+    void BranchPredictor::UpdateDirection(phi::uint32_t index, phi::boolean taken) noexcept
+    {
+        switch (m_Config.type)
+        {
+            case BranchPredictorType::AlwaysNotTaken:
+            case BranchPredictorType::AlwaysTaken:
+            case BranchPredictorType::BackwardTaken:
+                break;
+
+            case BranchPredictorType::OneBit:
+                m_LocalCounters[index & m_TableMask] = taken ? 1u : 0u;
+                break;
+
+            case BranchPredictorType::TwoBit:
+                update_counter(m_LocalCounters[index & m_TableMask], taken);
+                break;
+
+            case BranchPredictorType::GShare:
+                update_counter(m_GlobalCounters[GShareIndex(index)], taken);
+                break;
+
+            case BranchPredictorType::Tournament: {
+                phi::uint8_t& local  = m_LocalCounters[index & m_TableMask];
+                phi::uint8_t& global = m_GlobalCounters[GShareIndex(index)];
+
+                // Move the chooser towards the predictor which was right if only one of them was
+                const phi::boolean local_correct  = (local >= 2u) == taken;
+                const phi::boolean global_correct = (global >= 2u) == taken;
+                if (local_correct != global_correct)
+                {
+                    update_counter(m_ChooserCounters[index & m_TableMask], global_correct);
+                }
+
+                update_counter(local, taken);
+                update_counter(global, taken);
+                break;
+            }
+        }
+
+        m_History = ((m_History << 1u) | (taken ? 1u : 0u)) & m_HistoryMask;
+    }
+
+    phi::uint32_t BranchPredictor::GShareIndex(phi::uint32_t index) const noexcept
+    {
+        return (index ^ m_History) & m_TableMask;
+    }
+} // namespace dlx
@@ -0,0 +1,715 @@
+#include "DLX/CacheSimulator.hpp"
+
+#include "DLX/Instruction.hpp"
+#include "DLX/ParsedProgram.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <algorithm>
+#include <bit>
+
+PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
+PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(5262)
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+PHI_MSVC_SUPPRESS_WARNING_POP()
+PHI_GCC_SUPPRESS_WARNING_POP()
+
+PHI_CLANG_SUPPRESS_WARNING("-Wswitch-default")
+
+namespace dlx
+{
+    // Instruction fetches set the 33rd address bit
+    static constexpr const phi::uint64_t InstructionAddressSpace{phi::uint64_t{1u} << 32u};
+
+    // Every nibble holds its own index so way 0 starts as the most recently used way
+    static constexpr const phi::uint64_t InitialLRUStack{0xFEDCBA9876543210u};
+
+    static constexpr const phi::uint64_t RepeatedNibble{0x1111111111111111u};
+
+    phi::boolean CacheConfig::IsValid() const noexcept
+    {
+        return std::has_single_bit(size) && std::has_single_bit(line_size) &&
+               std::has_single_bit(associativity) && line_size >= MinimumLineSize &&
+               associativity <= MaximumAssociativity &&
+               static_cast<phi::uint64_t>(line_size) * associativity <= size;
+    }
+
+    phi::uint64_t CacheStatistics::GetAccesses() const noexcept
+    {
+        return reads + writes;
+    }
+
+    phi::uint64_t CacheStatistics::GetMisses() const noexcept
+    {
+        return read_misses + write_misses;
+    }
+
+    phi::uint64_t CacheStatistics::GetHits() const noexcept
+    {
+        return GetAccesses() - GetMisses();
+    }
+
+    double CacheStatistics::GetMissRate() const noexcept
+    {
+        if (GetAccesses() == 0u)
+        {
+            return 0.0;
+        }
+
+        return static_cast<double>(GetMisses()) / static_cast<double>(GetAccesses());
+    }
+
+    void Cache::Reset(const CacheConfig& config, phi::boolean classify_misses,
+                      phi::uint64_t random_seed) noexcept
+    {
+        PHI_ASSERT(!config.enabled || config.IsValid());
+
+        m_Config         = config;
+        m_ClassifyMisses = classify_misses;
+        m_RandomSeed     = random_seed != 0u ? random_seed : 1u;
+
+        if (!config.enabled)
+        {
+            m_Tags.clear();
+            m_ReplacementStates.clear();
+            m_DirtyWays.clear();
+            m_ShadowNodes.clear();
+            m_ShadowLines.clear();
+            m_Statistics = CacheStatistics{};
+            return;
+        }
+
+        const phi::uint32_t number_of_sets =
+                config.size / (config.line_size * config.associativity);
+
+        m_OffsetBits = static_cast<phi::uint32_t>(std::countr_zero(config.line_size));
+        m_SetBits    = static_cast<phi::uint32_t>(std::countr_zero(number_of_sets));
+        m_SetMask    = number_of_sets - 1u;
+        m_Ways       = config.associativity;
+
+        m_Tags.resize(static_cast<phi::size_t>(number_of_sets) * m_Ways);
+        m_ReplacementStates.resize(number_of_sets);
+        m_DirtyWays.resize(number_of_sets);
+
+        Clear();
+    }
+
+    void Cache::Clear() noexcept
+    {
+        std::fill(m_Tags.begin(), m_Tags.end(), InvalidTag);
+        std::fill(m_ReplacementStates.begin(), m_ReplacementStates.end(),
+                  m_Config.replacement == CacheReplacementPolicy::LRU ? InitialLRUStack : 0u);
+        std::fill(m_DirtyWays.begin(), m_DirtyWays.end(), phi::uint16_t{0u});
+
+        m_RandomState = m_RandomSeed;
+        m_Statistics  = CacheStatistics{};
+
+        m_ShadowLines.clear();
+        m_ShadowNodes.clear();
+        m_ShadowHead = NotResident;
+        m_ShadowTail = NotResident;
+
+        if (m_ClassifyMisses)
+        {
+            m_ShadowNodes.reserve(m_Tags.size());
+        }
+    }
+
+    CacheAccessResult Cache::Access(phi::uint64_t address, phi::boolean write) noexcept
+    {
+        PHI_ASSERT(m_Config.enabled);
+
+        const phi::uint64_t line = address >> m_OffsetBits;
+        const phi::uint32_t set  = static_cast<phi::uint32_t>(line) & m_SetMask;
+        const phi::uint32_t tag  = static_cast<phi::uint32_t>(line >> m_SetBits);
+
+        // The shadow cache sees every access so it has to be updated before knowing whether the
+        // access hits
+        const CacheMissClass miss_class =
+                m_ClassifyMisses ? ClassifyAccess(line) : CacheMissClass::None;
+
+        const phi::boolean write_back_policy = m_Config.write_policy == CacheWritePolicy::WriteBack;
+
+        if (write)
+        {
+            ++m_Statistics.writes;
+        }
+        else
+        {
+            ++m_Statistics.reads;
+        }
+
+        CacheAccessResult result;
+
+        phi::uint32_t* tags = m_Tags.data() + static_cast<phi::size_t>(set) * m_Ways;
+        for (phi::uint32_t way{0u}; way < m_Ways; ++way)
+        {
+            if (tags[way] == tag)
+            {
+                Touch(set, way);
+
+                if (write && write_back_policy)
+                {
+                    m_DirtyWays[set] = static_cast<phi::uint16_t>(m_DirtyWays[set] | (1u << way));
+                }
+
+                result.hit = true;
+                return result;
+            }
+        }
+
+        if (write)
+        {
+            ++m_Statistics.write_misses;
+        }
+        else
+        {
+            ++m_Statistics.read_misses;
+        }
+
+        result.miss_class = miss_class;
+        switch (miss_class)
+        {
+            case CacheMissClass::Compulsory:
+                ++m_Statistics.compulsory_misses;
+                break;
+            case CacheMissClass::Capacity:
+                ++m_Statistics.capacity_misses;
+                break;
+            case CacheMissClass::Conflict:
+                ++m_Statistics.conflict_misses;
+                break;
+            case CacheMissClass::None:
+                break;
+        }
+
+        // Write through caches don't allocate on write misses
+        if (write && !write_back_policy)
+        {
+            return result;
+        }
+
+        const phi::uint32_t way      = ChooseVictim(set);
+        const phi::uint16_t way_mask = static_cast<phi::uint16_t>(1u << way);
+
+        if (tags[way] != InvalidTag && (m_DirtyWays[set] & way_mask) != 0u)
+        {
+            result.write_back = true;
+            result.write_back_address =
+                    ((static_cast<phi::uint64_t>(tags[way]) << m_SetBits) | set) << m_OffsetBits;
+            ++m_Statistics.write_backs;
+        }
+
+        tags[way]        = tag;
+        m_DirtyWays[set] = static_cast<phi::uint16_t>(
+                write ? (m_DirtyWays[set] | way_mask) : (m_DirtyWays[set] & ~way_mask));
+        Touch(set, way);
+
+        result.allocated = true;
+        return result;
+    }
+
+    const CacheConfig& Cache::GetConfig() const noexcept
+    {
+        return m_Config;
+    }
+
+    const CacheStatistics& Cache::GetStatistics() const noexcept
+    {
+        return m_Statistics;
+    }
+
+    phi::uint32_t Cache::GetNumberOfSets() const noexcept
+    {
+        return static_cast<phi::uint32_t>(m_ReplacementStates.size());
+    }
+
+    phi::boolean Cache::Contains(phi::uint64_t address) const noexcept
+    {
+        if (!m_Config.enabled)
+        {
+            return false;
+        }
+
+        const phi::uint64_t  line = address >> m_OffsetBits;
+        const phi::uint32_t  set  = static_cast<phi::uint32_t>(line) & m_SetMask;
+        const phi::uint32_t  tag  = static_cast<phi::uint32_t>(line >> m_SetBits);
+        const phi::uint32_t* tags = m_Tags.data() + static_cast<phi::size_t>(set) * m_Ways;
+
+        return std::find(tags, tags + m_Ways, tag) != tags + m_Ways;
+    }
+
+    phi::uint32_t Cache::ChooseVictim(phi::uint32_t set) noexcept
+    {
+        const phi::uint64_t state = m_ReplacementStates[set];
+
+        // Lines are filled from the least recently used end of the stack so invalid ways are
+        // always at the end
+        if (m_Config.replacement == CacheReplacementPolicy::LRU)
+        {
+            return static_cast<phi::uint32_t>((state >> (4u * (m_Ways - 1u))) & 0xFu);
+        }
+
+        const phi::uint32_t* tags = m_Tags.data() + static_cast<phi::size_t>(set) * m_Ways;
+        for (phi::uint32_t way{0u}; way < m_Ways; ++way)
+        {
+            if (tags[way] == InvalidTag)
+            {
+                return way;
+            }
+        }
+
+        if (m_Config.replacement == CacheReplacementPolicy::Random)
+        {
+            // xorshift64
+            m_RandomState ^= m_RandomState << 13u;
+            m_RandomState ^= m_RandomState >> 7u;
+            m_RandomState ^= m_RandomState << 17u;
+
+            return static_cast<phi::uint32_t>(m_RandomState) & (m_Ways - 1u);
+        }
+
+        // Follow the tree bits which point away from the recently used half
+        const phi::uint32_t levels = static_cast<phi::uint32_t>(std::countr_zero(m_Ways));
+
+        phi::uint32_t way{0u};
+        phi::uint32_t node{1u};
+        for (phi::uint32_t level{0u}; level < levels; ++level)
+        {
+            const phi::uint32_t direction = static_cast<phi::uint32_t>((state >> node) & 1u);
+
+            way  = way * 2u + direction;
+            node = node * 2u + direction;
+        }
+
+        return way;
+    }
+
+    void Cache::Touch(phi::uint32_t set, phi::uint32_t way) noexcept
+    {
+        phi::uint64_t& state = m_ReplacementStates[set];
+
+        switch (m_Config.replacement)
+        {
+            case CacheReplacementPolicy::LRU: {
+                // Find the nibble holding the way: XOR turns it into the only zero nibble below
+                // the associativity and the classic zero byte trick works for nibbles as well
+                const phi::uint64_t difference = state ^ (RepeatedNibble * way);
+                const phi::uint64_t zero_nibbles =
+                        (difference - RepeatedNibble) & ~difference & (RepeatedNibble << 3u);
+                const phi::uint32_t position =
+                        static_cast<phi::uint32_t>(std::countr_zero(zero_nibbles)) / 4u;
+
+                // Shift the more recently used ways down by one and put the way on top
+                const phi::uint64_t above   = (phi::uint64_t{1u} << (4u * position)) - 1u;
+                const phi::uint64_t through =
+                        position == 15u ? ~phi::uint64_t{0u} :
+                                          (phi::uint64_t{1u} << (4u * position + 4u)) - 1u;
+
+                state = (state & ~through) | ((state & above) << 4u) | way;
+                break;
+            }
+
+            case CacheReplacementPolicy::PLRU: {
+                const phi::uint32_t levels = static_cast<phi::uint32_t>(std::countr_zero(m_Ways));
+
+                phi::uint32_t node{1u};
+                for (phi::uint32_t level{levels}; level > 0u; --level)
+                {
+                    const phi::uint32_t direction = (way >> (level - 1u)) & 1u;
+
+                    // Point to the other half
+                    if (direction != 0u)
+                    {
+                        state &= ~(phi::uint64_t{1u} << node);
+                    }
+                    else
+                    {
+                        state |= phi::uint64_t{1u} << node;
+                    }
+
+                    node = node * 2u + direction;
+                }
+                break;
+            }
+
+            case CacheReplacementPolicy::Random:
+                break;
+        }
+    }
+
+    CacheMissClass Cache::ClassifyAccess(phi::uint64_t line) noexcept
+    {
+        auto [iterator, inserted] = m_ShadowLines.try_emplace(line, NotResident);
+
+        const auto unlink = [this](phi::uint32_t index) {
+            const ShadowNode& node = m_ShadowNodes[index];
+
+            (node.previous != NotResident ? m_ShadowNodes[node.previous].next : m_ShadowHead) =
+                    node.next;
+            (node.next != NotResident ? m_ShadowNodes[node.next].previous : m_ShadowTail) =
+                    node.previous;
+        };
+
+        CacheMissClass miss_class;
+        phi::uint32_t  index = iterator->second;
+
+        if (index != NotResident)
+        {
+            miss_class = CacheMissClass::Conflict;
+
+            if (index == m_ShadowHead)
+            {
+                return miss_class;
+            }
+
+            unlink(index);
+        }
+        else
+        {
+            miss_class = inserted ? CacheMissClass::Compulsory : CacheMissClass::Capacity;
+
+            if (m_ShadowNodes.size() < m_Tags.size())
+            {
+                index = static_cast<phi::uint32_t>(m_ShadowNodes.size());
+                m_ShadowNodes.push_back(ShadowNode{line, NotResident, NotResident});
+            }
+            else
+            {
+                // Reuse the least recently used node. The line is already in the map so this
+                // doesn't invalidate the iterator.
+                index = m_ShadowTail;
+                unlink(index);
+
+                m_ShadowLines.find(m_ShadowNodes[index].line)->second = NotResident;
+                m_ShadowNodes[index].line                             = line;
+            }
+
+            iterator->second = index;
+        }
+
+        // Link as most recently used
+        ShadowNode& node = m_ShadowNodes[index];
+        node.previous    = NotResident;
+        node.next        = m_ShadowHead;
+
+        if (m_ShadowHead != NotResident)
+        {
+            m_ShadowNodes[m_ShadowHead].previous = index;
+        }
+        else
+        {
+            m_ShadowTail = index;
+        }
+
+        m_ShadowHead = index;
+
+        return miss_class;
+    }
+
+    CacheSimulator::CacheSimulator() noexcept
+        : CacheSimulator(CacheHierarchyConfig{})
+    {}
+
+    CacheSimulator::CacheSimulator(const CacheHierarchyConfig& config) noexcept
+    {
+        if (!SetConfig(config))
+        {
+            PHI_ASSERT_NOT_REACHED();
+
+            [[maybe_unused]] const phi::boolean fallback = SetConfig(CacheHierarchyConfig{});
+        }
+    }
+
+    phi::boolean CacheSimulator::SetConfig(const CacheHierarchyConfig& config) noexcept
+    {
+        const CacheConfig* configs[NumberOfCacheLevels] = {&config.instruction, &config.data,
+                                                           &config.unified};
+
+        for (const CacheConfig* cache_config : configs)
+        {
+            if (cache_config->enabled && !cache_config->IsValid())
+            {
+                return false;
+            }
+        }
+
+        m_Config = config;
+
+        for (phi::size_t level{0u}; level < NumberOfCacheLevels; ++level)
+        {
+            m_Caches[level].Reset(*configs[level], config.classify_misses,
+                                  config.random_seed + level);
+        }
+
+        m_MemoryReads  = 0u;
+        m_MemoryWrites = 0u;
+        std::fill(m_Instructions.begin(), m_Instructions.end(), InstructionCacheProfile{});
+
+        return true;
+    }
+
+    const CacheHierarchyConfig& CacheSimulator::GetConfig() const noexcept
+    {
+        return m_Config;
+    }
+
+    void CacheSimulator::Reset(phi::size_t number_of_instructions) noexcept
+    {
+        m_Instructions.assign(number_of_instructions, InstructionCacheProfile{});
+        Clear();
+    }
+
+    void CacheSimulator::Clear() noexcept
+    {
+        for (Cache& cache : m_Caches)
+        {
+            cache.Clear();
+        }
+
+        std::fill(m_Instructions.begin(), m_Instructions.end(), InstructionCacheProfile{});
+        m_MemoryReads  = 0u;
+        m_MemoryWrites = 0u;
+    }
+
+    void CacheSimulator::FetchInstruction(phi::uint32_t index) noexcept
+    {
+        PHI_ASSERT(index < m_Instructions.size());
+
+        InstructionCacheProfile& profile = m_Instructions[index];
+
+        const phi::uint64_t address = InstructionAddressSpace | (phi::uint64_t{index} * 4u);
+
+        if (AccessFirstLevel(m_Caches[static_cast<phi::size_t>(CacheLevel::Instruction)], address,
+                             false, profile))
+        {
+            ++profile.fetch_misses;
+        }
+    }
+
+    void CacheSimulator::AccessData(phi::uint32_t index, phi::uint32_t address, phi::size_t size,
+                                    phi::boolean write) noexcept
+    {
+        PHI_ASSERT(index < m_Instructions.size());
+        PHI_ASSERT(size != 0u);
+
+        InstructionCacheProfile& profile = m_Instructions[index];
+        Cache& cache = m_Caches[static_cast<phi::size_t>(CacheLevel::Data)];
+
+        ++profile.data_accesses;
+
+        const phi::uint64_t first = address;
+        const phi::uint64_t last  = first + size - 1u;
+
+        phi::boolean missed = AccessFirstLevel(cache, first, write, profile);
+
+        // Unaligned accesses may touch the next line as well
+        const phi::uint64_t line_size = cache.GetConfig().line_size;
+        if (cache.GetConfig().enabled && first / line_size != last / line_size)
+        {
+            missed = AccessFirstLevel(cache, last, write, profile) || missed;
+        }
+
+        if (missed)
+        {
+            ++profile.data_misses;
+        }
+    }
+
+    const Cache& CacheSimulator::GetCache(CacheLevel level) const noexcept
+    {
+        return m_Caches[static_cast<phi::size_t>(level)];
+    }
+
+    const CacheStatistics& CacheSimulator::GetStatistics(CacheLevel level) const noexcept
+    {
+        return GetCache(level).GetStatistics();
+    }
+
+    const std::vector<InstructionCacheProfile>& CacheSimulator::GetInstructions() const noexcept
+    {
+        return m_Instructions;
+    }
+
+    phi::uint64_t CacheSimulator::GetMemoryReads() const noexcept
+    {
+        return m_MemoryReads;
+    }
+
+    phi::uint64_t CacheSimulator::GetMemoryWrites() const noexcept
+    {
+        return m_MemoryWrites;
+    }
+
+    std::string CacheSimulator::GetReport(const ParsedProgram& program,
+                                          phi::size_t          max_instructions) const noexcept
+    {
+        PHI_ASSERT(program.m_Instructions.size() == m_Instructions.size());
+
+        // The classes are only counted while classifying misses
+        const phi::boolean classified = m_Config.classify_misses;
+
+        std::string text = fmt::format("{:<5} {:>12} {:>12} {:>12} {:>9} ", "Cache", "Accesses",
+                                       "Hits", "Misses", "Miss rate");
+        if (classified)
+        {
+            text.append(fmt::format("{:>12} {:>12} {:>12} ", "Compulsory", "Capacity", "Conflict"));
+        }
+        text.append(fmt::format("{:>12}\n", "Write backs"));
+
+        static constexpr const char* names[NumberOfCacheLevels] = {"L1I", "L1D", "L2"};
+
+        for (phi::size_t level{0u}; level < NumberOfCacheLevels; ++level)
+        {
+            if (!m_Caches[level].GetConfig().enabled)
+            {
+                continue;
+            }
+
+            const CacheStatistics& statistics = m_Caches[level].GetStatistics();
+
+            text.append(fmt::format("{:<5} {:>12} {:>12} {:>12} {:>8.2f}% ", names[level],
+                                    statistics.GetAccesses(), statistics.GetHits(),
+                                    statistics.GetMisses(), 100.0 * statistics.GetMissRate()));
+            if (classified)
+            {
+                text.append(fmt::format("{:>12} {:>12} {:>12} ", statistics.compulsory_misses,
+                                        statistics.capacity_misses, statistics.conflict_misses));
+            }
+            text.append(fmt::format("{:>12}\n", statistics.write_backs));
+        }
+
+        text.append(fmt::format("Memory reads {}, writes {}\n", m_MemoryReads, m_MemoryWrites));
+
+        // Instructions ordered by the misses they caused, ties in program order
+        std::vector<phi::uint32_t> indices;
+        const auto misses = [&](phi::uint32_t index) {
+            const InstructionCacheProfile& profile = m_Instructions[index];
+            return profile.fetch_misses + profile.data_misses + profile.unified_misses;
+        };
+
+        for (phi::uint32_t index{0u}; index < m_Instructions.size(); ++index)
+        {
+            if (misses(index) != 0u)
+            {
+                indices.push_back(index);
+            }
+        }
+
+        if (indices.empty())
+        {
+            return text;
+        }
+
+        std::stable_sort(indices.begin(), indices.end(), [&](phi::uint32_t lhs, phi::uint32_t rhs) {
+            return misses(lhs) > misses(rhs);
+        });
+
+        text.append(fmt::format("\n{:>6} {:>12} {:>12} {:>12} {:>12}  {}\n", "Line", "Fetch misses",
+                                "Accesses", "Data misses", "L2 misses", "Instruction"));
+
+        const phi::size_t shown = std::min(indices.size(), max_instructions);
+        for (phi::size_t position{0u}; position < shown; ++position)
+        {
+            const phi::uint32_t            index       = indices[position];
+            const InstructionCacheProfile& profile     = m_Instructions[index];
+            const Instruction&             instruction = program.m_Instructions[index];
+
+            text.append(fmt::format("{:>6} {:>12} {:>12} {:>12} {:>12}  {}\n",
+                                    instruction.GetSourceLine().unsafe(), profile.fetch_misses,
+                                    profile.data_accesses, profile.data_misses,
+                                    profile.unified_misses, instruction.DebugInfo()));
+        }
+
+        if (indices.size() > shown)
+        {
+            text.append(fmt::format("({} more instructions)\n", indices.size() - shown));
+        }
+
+        return text;
+    }
+
+    phi::boolean CacheSimulator::AccessFirstLevel(Cache& cache, phi::uint64_t address,
+                                                  phi::boolean             write,
+                                                  InstructionCacheProfile& profile) noexcept
+    {
+        // Everything goes straight to the unified cache without a first level cache
+        if (!cache.GetConfig().enabled)
+        {
+            AccessUnified(address, write, profile);
+            return false;
+        }
+
+        const CacheAccessResult result = cache.Access(address, write);
+
+        if (result.write_back)
+        {
+            AccessUnified(result.write_back_address, true, profile);
+        }
+
+        if (write && cache.GetConfig().write_policy == CacheWritePolicy::WriteThrough)
+        {
+            AccessUnified(address, true, profile);
+        }
+
+        if (result.hit)
+        {
+            return false;
+        }
+
+        switch (result.miss_class)
+        {
+            case CacheMissClass::Compulsory:
+                ++profile.compulsory_misses;
+                break;
+            case CacheMissClass::Capacity:
+                ++profile.capacity_misses;
+                break;
+            case CacheMissClass::Conflict:
+                ++profile.conflict_misses;
+                break;
+            case CacheMissClass::None:
+                break;
+        }
+
+        // Fill the line
+        if (result.allocated)
+        {
+            AccessUnified(address, false, profile);
+        }
+
+        return true;
+    }
+
+    void CacheSimulator::AccessUnified(phi::uint64_t address, phi::boolean write,
+                                       InstructionCacheProfile& profile) noexcept
+    {
+        Cache& cache = m_Caches[static_cast<phi::size_t>(CacheLevel::Unified)];
+
+        if (!cache.GetConfig().enabled)
+        {
+            ++(write ? m_MemoryWrites : m_MemoryReads);
+            return;
+        }
+
+        const CacheAccessResult result = cache.Access(address, write);
+
+        if (result.write_back ||
+            (write && cache.GetConfig().write_policy == CacheWritePolicy::WriteThrough))
+        {
+            ++m_MemoryWrites;
+        }
+
+        if (!result.hit)
+        {
+            ++profile.unified_misses;
+
+            if (result.allocated)
+            {
+                ++m_MemoryReads;
+            }
+        }
+    }
+} // namespace dlx
@@ -0,0 +1,126 @@
+#include "DLX/DecodedProgram.hpp"
+
+#include "DLX/Instruction.hpp"
+#include "DLX/InstructionArgument.hpp"
+#include "DLX/InstructionInfo.hpp"
+#include "DLX/ParsedProgram.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <phi/type_traits/to_underlying.hpp>
+
+PHI_CLANG_SUPPRESS_WARNING("-Wswitch-default")
+
+using namespace phi::literals;
+
+namespace dlx
+{
+    static void decode_argument(DecodedInstruction& decoded, phi::size_t index,
+                                const InstructionArgument& argument) noexcept
+    {
+        switch (argument.GetType())
+        {
+            case ArgumentType::IntRegister:
+                decoded.registers[index] = static_cast<phi::uint8_t>(
+                        phi::to_underlying(argument.AsRegisterInt().register_id));
+                break;
+
+            case ArgumentType::FloatRegister:
+                decoded.registers[index] = static_cast<phi::uint8_t>(
+                        phi::to_underlying(argument.AsRegisterFloat().register_id));
+                break;
+
+            case ArgumentType::ImmediateInteger:
+                // An immediate used as address has no base register
+                decoded.registers[index] = static_cast<phi::uint8_t>(IntRegisterID::None);
+                decoded.immediate        = argument.AsImmediateValue().signed_value.unsafe();
+                break;
+
+            case ArgumentType::AddressDisplacement:
+                decoded.registers[index] = static_cast<phi::uint8_t>(
+                        phi::to_underlying(argument.AsAddressDisplacement().register_id));
+                decoded.immediate        = argument.AsAddressDisplacement().displacement.unsafe();
+                break;
+
+            case ArgumentType::Label:
+                decoded.jump_point = argument.AsLabel().jump_point;
+                break;
+
+            case ArgumentType::None:
+                break;
+
+#if !defined(DLXEMU_COVERAGE_BUILD)
+            default:
+                PHI_ASSERT_NOT_REACHED();
+                break;
+#endif
+        }
+    }
+
+    DecodedInstruction DecodeInstruction(const Instruction& instruction) noexcept
+    {
+        const InstructionInfo& info = instruction.GetInfo();
+
+        const InstructionArgument& arg1 = instruction.GetArg1();
+        const InstructionArgument& arg2 = instruction.GetArg2();
+        const InstructionArgument& arg3 = instruction.GetArg3();
+
+        PHI_ASSERT(info.GetExecutor(), "No execution function defined");
+
+        // Make sure non arguments are marked as unknown
+        PHI_ASSERT(arg1.GetType() != ArgumentType::Unknown, "Arg1 type is unknown");
+        PHI_ASSERT(arg2.GetType() != ArgumentType::Unknown, "Arg2 type is unknown");
+        PHI_ASSERT(arg3.GetType() != ArgumentType::Unknown, "Arg3 type is unknown");
+
+        // Make sure argument types match
+        PHI_ASSERT(ArgumentTypeIncludes(arg1.GetType(), info.GetArgumentType(0_u8)),
+                   "Unexpected argument type for arg1");
+        PHI_ASSERT(ArgumentTypeIncludes(arg2.GetType(), info.GetArgumentType(1_u8)),
+                   "Unexpected argument type for arg2");
+        PHI_ASSERT(ArgumentTypeIncludes(arg3.GetType(), info.GetArgumentType(2_u8)),
+                   "Unexpected argument type for arg3");
+
+        DecodedInstruction decoded;
+        decoded.executor             = info.GetExecutor();
+        decoded.opcode               = info.GetOpCode();
+        decoded.register_access_type = info.GetRegisterAccessType();
+        decoded.registers            = {static_cast<phi::uint8_t>(IntRegisterID::None),
+                                        static_cast<phi::uint8_t>(IntRegisterID::None),
+                                        static_cast<phi::uint8_t>(IntRegisterID::None)};
+
+        decode_argument(decoded, 0u, arg1);
+        decode_argument(decoded, 1u, arg2);
+        decode_argument(decoded, 2u, arg3);
+
+        return decoded;
+    }
+
+    DecodedProgram DecodeProgram(const ParsedProgram& program) noexcept
+    {
+        DecodedProgram decoded_program;
+        decoded_program.m_Instructions.reserve(program.m_Instructions.size());
+
+        for (const Instruction& instruction : program.m_Instructions)
+        {
+            decoded_program.m_Instructions.emplace_back(DecodeInstruction(instruction));
+        }
+
+        // Calculate the block ends walking backwards from the last instruction
+        const phi::size_t number_of_instructions = decoded_program.m_Instructions.size();
+        decoded_program.m_BlockEnds.resize(number_of_instructions);
+
+        phi::uint32_t block_end = static_cast<phi::uint32_t>(number_of_instructions) - 1u;
+        for (phi::size_t index = number_of_instructions; index > 0u; --index)
+        {
+            const phi::size_t current_index = index - 1u;
+
+            if (IsControlTransferInstruction(decoded_program.m_Instructions[current_index].opcode))
+            {
+                block_end = static_cast<phi::uint32_t>(current_index);
+            }
+
+            decoded_program.m_BlockEnds[current_index] = block_end;
+        }
+
+        return decoded_program;
+    }
+} // namespace dlx
@@ -0,0 +1,148 @@
+#include "DLX/ExecutionProfile.hpp"
+
+#include "DLX/Instruction.hpp"
+#include "DLX/ParsedProgram.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <algorithm>
+#include <unordered_map>
+
+PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
+PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(5262)
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+PHI_MSVC_SUPPRESS_WARNING_POP()
+PHI_GCC_SUPPRESS_WARNING_POP()
+
+namespace dlx
+{
+    void ExecutionProfile::Reset(phi::size_t number_of_instructions) noexcept
+    {
+        m_Instructions.assign(number_of_instructions, InstructionProfile{});
+        m_TotalExecuted = 0u;
+    }
+
+    void ExecutionProfile::Clear() noexcept
+    {
+        std::fill(m_Instructions.begin(), m_Instructions.end(), InstructionProfile{});
+        m_TotalExecuted = 0u;
+    }
+
+    const std::vector<InstructionProfile>& ExecutionProfile::GetInstructions() const noexcept
+    {
+        return m_Instructions;
+    }
+
+    phi::uint64_t ExecutionProfile::GetTotalExecuted() const noexcept
+    {
+        return m_TotalExecuted;
+    }
+
+    std::vector<phi::uint32_t> ExecutionProfile::GetHotInstructions() const noexcept
+    {
+        std::vector<phi::uint32_t> indices;
+
+        for (phi::uint32_t index{0u}; index < m_Instructions.size(); ++index)
+        {
+            if (m_Instructions[index].executed != 0u)
+            {
+                indices.push_back(index);
+            }
+        }
+
+        // Ties are kept in program order
+        std::stable_sort(indices.begin(), indices.end(), [&](phi::uint32_t lhs, phi::uint32_t rhs) {
+            return m_Instructions[lhs].executed > m_Instructions[rhs].executed;
+        });
+
+        return indices;
+    }
+
+    std::vector<LineProfile> ExecutionProfile::GetHotLines(
+            const ParsedProgram& program) const noexcept
+    {
+        PHI_ASSERT(program.m_Instructions.size() == m_Instructions.size());
+
+        std::vector<LineProfile>                       lines;
+        std::unordered_map<phi::uint32_t, phi::size_t> line_indices;
+
+        for (phi::size_t index{0u}; index < m_Instructions.size(); ++index)
+        {
+            const InstructionProfile& counters = m_Instructions[index];
+            if (counters.executed == 0u)
+            {
+                continue;
+            }
+
+            const phi::uint32_t line = static_cast<phi::uint32_t>(
+                    program.m_Instructions[index].GetSourceLine().unsafe());
+
+            auto [iterator, inserted] = line_indices.try_emplace(line, lines.size());
+            if (inserted)
+            {
+                lines.push_back(LineProfile{line, {}});
+            }
+
+            InstructionProfile& line_counters = lines[iterator->second].counters;
+            line_counters.executed += counters.executed;
+            line_counters.taken_branches += counters.taken_branches;
+            line_counters.memory_accesses += counters.memory_accesses;
+        }
+
+        std::sort(lines.begin(), lines.end(), [](const LineProfile& lhs, const LineProfile& rhs) {
+            if (lhs.counters.executed != rhs.counters.executed)
+            {
+                return lhs.counters.executed > rhs.counters.executed;
+            }
+
+            return lhs.line < rhs.line;
+        });
+
+        return lines;
+    }
+
+    std::string ExecutionProfile::GetReport(const ParsedProgram& program,
+                                            phi::size_t          max_lines) const noexcept
+    {
+        std::string text = fmt::format("Executed {} instructions\n", m_TotalExecuted);
+
+        const std::vector<LineProfile> lines = GetHotLines(program);
+        if (lines.empty())
+        {
+            return text;
+        }
+
+        // Maps the lines back to their first instruction to show what is executed there
+        std::unordered_map<phi::uint32_t, phi::size_t> first_instructions;
+        for (phi::size_t index{program.m_Instructions.size()}; index > 0u; --index)
+        {
+            first_instructions[static_cast<phi::uint32_t>(
+                    program.m_Instructions[index - 1u].GetSourceLine().unsafe())] = index - 1u;
+        }
+
+        text.append(fmt::format("{:>6} {:>12} {:>7} {:>12} {:>12}  {}\n", "Line", "Executed",
+                                "Share", "Taken", "Memory", "Instruction"));
+
+        const phi::size_t shown = std::min(lines.size(), max_lines);
+        for (phi::size_t index{0u}; index < shown; ++index)
+        {
+            const LineProfile& line = lines[index];
+            const double       share = 100.0 * static_cast<double>(line.counters.executed) /
+                                   static_cast<double>(m_TotalExecuted);
+
+            text.append(fmt::format(
+                    "{:>6} {:>12} {:>6.2f}% {:>12} {:>12}  {}\n", line.line,
+                    line.counters.executed, share, line.counters.taken_branches,
+                    line.counters.memory_accesses,
+                    program.m_Instructions[first_instructions[line.line]].DebugInfo()));
+        }
+
+        if (lines.size() > shown)
+        {
+            text.append(fmt::format("({} more lines)\n", lines.size() - shown));
+        }
+
+        return text;
+    }
+} // namespace dlx
@@ -0,0 +1,278 @@
+#include "DLX/GuardedMemory.hpp"
+
+#include "DLX/Logger.hpp"
+#include <phi/compiler_support/unused.hpp>
+#include <phi/core/assert.hpp>
+#include <phi/core/move.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#if DLX_GUARDED_MEMORY_SUPPORTED
+#    include <signal.h>
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+
+namespace dlx
+{
+#if DLX_GUARDED_MEMORY_SUPPORTED
+    // Any 32-bit offset plus the largest value (a double) must stay inside the reservation
+    static constexpr const phi::size_t GuardSize{(phi::size_t{1u} << 32u) + 8u};
+
+    static thread_local GuardedExecution* current_execution{nullptr};
+
+    static struct sigaction previous_action;
+
+    static void guard_fault_handler(int signal_number, siginfo_t* info, void* context) noexcept
+    {
+        GuardedExecution* execution = current_execution;
+
+        if (execution != nullptr && execution->region->Contains(info->si_addr))
+        {
+            siglongjmp(execution->environment, 1);
+        }
+
+        // Not caused by guarded memory so forward it to the previous handler
+        if ((previous_action.sa_flags & SA_SIGINFO) != 0)
+        {
+            previous_action.sa_sigaction(signal_number, info, context);
+            return;
+        }
+
+        if (previous_action.sa_handler == SIG_DFL || previous_action.sa_handler == SIG_IGN)
+        {
+            // Returning retries the faulting access which now terminates the process
+            struct sigaction default_action;
+            std::memset(&default_action, 0, sizeof(default_action));
+            default_action.sa_handler = SIG_DFL;
+            sigaction(SIGSEGV, &default_action, nullptr);
+            return;
+        }
+
+        previous_action.sa_handler(signal_number);
+    }
+
+    [[nodiscard]] static phi::boolean install_guard_fault_handler() noexcept
+    {
+        struct sigaction action;
+        std::memset(&action, 0, sizeof(action));
+        action.sa_sigaction = guard_fault_handler;
+        // Not blocking SIGSEGV inside the handler allows jumping out of it without restoring the
+        // signal mask which would cost a system call for every guarded execution
+        action.sa_flags = SA_SIGINFO | SA_NODEFER;
+        sigemptyset(&action.sa_mask);
+
+        if (sigaction(SIGSEGV, &action, &previous_action) != 0)
+        {
+            DLX_ERROR("Failed to install the guarded memory signal handler");
+            return false;
+        }
+
+        return true;
+    }
+
+    void EnterGuardedExecution(GuardedExecution& execution, const GuardedRegion& region) noexcept
+    {
+        static const phi::boolean handler_installed = install_guard_fault_handler();
+        PHI_ASSERT(handler_installed);
+        PHI_UNUSED_VARIABLE(handler_installed);
+
+        execution.region   = &region;
+        execution.previous = current_execution;
+        current_execution  = &execution;
+
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+
+    void LeaveGuardedExecution(GuardedExecution& execution) noexcept
+    {
+        PHI_ASSERT(current_execution == &execution, "Guarded executions must be strictly nested");
+
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+
+        current_execution = execution.previous;
+    }
+
+    phi::boolean IsInGuardedExecution(const GuardedRegion& region) noexcept
+    {
+        return current_execution != nullptr && current_execution->region == &region;
+    }
+
+    GuardedRegion::GuardedRegion(phi::size_t size) noexcept
+    {
+        const phi::size_t page_size       = static_cast<phi::size_t>(sysconf(_SC_PAGESIZE));
+        const phi::size_t accessible_size = ((size + page_size - 1u) / page_size) * page_size;
+        const phi::size_t reservation_size =
+                accessible_size + ((GuardSize + page_size - 1u) / page_size) * page_size;
+
+        void* reservation = mmap(nullptr, reservation_size, PROT_NONE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (reservation == MAP_FAILED)
+        {
+            DLX_ERROR("Failed to reserve {} bytes of guarded memory", reservation_size);
+            return;
+        }
+
+        if (accessible_size != 0u &&
+            mprotect(reservation, accessible_size, PROT_READ | PROT_WRITE) != 0)
+        {
+            DLX_ERROR("Failed to make {} bytes of guarded memory accessible", accessible_size);
+            munmap(reservation, reservation_size);
+            return;
+        }
+
+        m_Reservation     = static_cast<phi::uint8_t*>(reservation);
+        m_ReservationSize = reservation_size;
+        // Align the end of the data with the end of the accessible pages so the first byte past
+        // the data already faults
+        m_Data = m_Reservation + (accessible_size - size);
+        m_Size = size;
+    }
+
+    void GuardedRegion::Release() noexcept
+    {
+        if (m_Reservation != nullptr)
+        {
+            munmap(m_Reservation, m_ReservationSize);
+        }
+
+        m_Reservation     = nullptr;
+        m_ReservationSize = 0u;
+        m_Data            = nullptr;
+        m_Size            = 0u;
+    }
+
+    phi::boolean GuardedRegion::Contains(const void* address) const noexcept
+    {
+        const phi::uint8_t* byte_address = static_cast<const phi::uint8_t*>(address);
+
+        return byte_address >= m_Reservation && byte_address < m_Reservation + m_ReservationSize;
+    }
+#else
+    GuardedRegion::GuardedRegion(phi::size_t /*size*/) noexcept
+    {
+        DLX_ERROR("Guarded memory is not supported on this platform");
+    }
+
+    void GuardedRegion::Release() noexcept
+    {}
+
+    phi::boolean GuardedRegion::Contains(const void* /*address*/) const noexcept
+    {
+        return false;
+    }
+#endif
+
+    GuardedRegion::GuardedRegion(const GuardedRegion& other) noexcept
+    {
+        *this = other;
+    }
+
+    GuardedRegion::GuardedRegion(GuardedRegion&& other) noexcept
+    {
+        *this = phi::move(other);
+    }
+
+    GuardedRegion::~GuardedRegion() noexcept
+    {
+        Release();
+    }
+
+    GuardedRegion& GuardedRegion::operator=(const GuardedRegion& other) noexcept
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        if (!CopyFrom(other))
+        {
+            DLX_ERROR("Failed to copy {} bytes of guarded memory", other.m_Size);
+            Release();
+        }
+
+        return *this;
+    }
+
+    GuardedRegion& GuardedRegion::operator=(GuardedRegion&& other) noexcept
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        Release();
+
+        m_Reservation     = other.m_Reservation;
+        m_ReservationSize = other.m_ReservationSize;
+        m_Data            = other.m_Data;
+        m_Size            = other.m_Size;
+
+        other.m_Reservation     = nullptr;
+        other.m_ReservationSize = 0u;
+        other.m_Data            = nullptr;
+        other.m_Size            = 0u;
+
+        return *this;
+    }
+
+    phi::boolean GuardedRegion::CopyFrom(const GuardedRegion& other) noexcept
+    {
+        if (this == &other)
+        {
+            return true;
+        }
+
+        if (!other.IsValid())
+        {
+            Release();
+            return true;
+        }
+
+        // Snapshots and undo checkpoints keep copying memory of the same size
+        if (IsValid() && m_Size == other.m_Size)
+        {
+            if (m_Size != 0u)
+            {
+                std::memcpy(m_Data, other.m_Data, m_Size);
+            }
+
+            return true;
+        }
+
+        GuardedRegion copy{other.m_Size};
+        if (!copy.IsValid())
+        {
+            return false;
+        }
+
+        if (other.m_Size != 0u)
+        {
+            std::memcpy(copy.m_Data, other.m_Data, other.m_Size);
+        }
+
+        *this = phi::move(copy);
+
+        return true;
+    }
+
+    phi::boolean GuardedRegion::Resize(phi::size_t new_size) noexcept
+    {
+        GuardedRegion resized{new_size};
+
+        if (!resized.IsValid())
+        {
+            return false;
+        }
+
+        if (m_Size != 0u && new_size != 0u)
+        {
+            std::memcpy(resized.m_Data, m_Data, std::min(m_Size, new_size));
+        }
+
+        *this = phi::move(resized);
+
+        return true;
+    }
+} // namespace dlx
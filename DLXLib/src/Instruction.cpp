@@ -1,5 +1,6 @@
 #include "DLX/Instruction.hpp"
 
+#include "DLX/DecodedProgram.hpp"
 #include "DLX/InstructionArgument.hpp"
 #include <phi/compiler_support/warning.hpp>
 #include <phi/core/assert.hpp>
@@ -79,7 +80,7 @@ namespace dlx
 
     void Instruction::Execute(Processor& processor) const noexcept
     {
-        m_Info.Execute(processor, m_Arg1, m_Arg2, m_Arg3);
+        m_Info.Execute(processor, DecodeInstruction(*this));
     }
 
     const InstructionInfo& Instruction::GetInfo() const noexcept
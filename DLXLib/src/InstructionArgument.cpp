@@ -197,10 +197,18 @@ namespace dlx
     }
 
     InstructionArgument ConstructInstructionArgumentLabel(phi::string_view label_name) noexcept
+    {
+        return ConstructInstructionArgumentLabel(label_name,
+                                                 InstructionArgument::Label::UnresolvedJumpPoint);
+    }
+
+    InstructionArgument ConstructInstructionArgumentLabel(phi::string_view label_name,
+                                                          phi::uint32_t    jump_point) noexcept
     {
         InstructionArgument arg;
         arg.m_Type           = ArgumentType::Label;
         arg.label.label_name = label_name;
+        arg.label.jump_point = jump_point;
         return arg;
     }
 } // namespace dlx
@@ -1,8 +1,10 @@
 #include "DLX/InstructionImplementation.hpp"
 
+#include "DLX/Instruction.hpp"
 #include "DLX/InstructionArgument.hpp"
 #include "DLX/InstructionInfo.hpp"
 #include "DLX/Logger.hpp"
+#include "DLX/ObservingProcessor.hpp"
 #include "DLX/Parser.hpp"
 #include "DLX/Processor.hpp"
 #include "DLX/RegisterNames.hpp"
@@ -10,6 +12,7 @@
 #include <phi/core/assert.hpp>
 #include <phi/core/boolean.hpp>
 #include <phi/core/types.hpp>
+#include <cstring>
 
 // TODO: Fix warnings
 PHI_CLANG_AND_GCC_SUPPRESS_WARNING("-Wunused-parameter")
@@ -33,28 +36,49 @@ namespace dlx
 
     PHI_GCC_SUPPRESS_WARNING_POP()
 
-    static void JumpToLabel(Processor& processor, phi::string_view label_name) noexcept
+    // Unresolved labels only keep their name in the parsed instruction
+    template <typename ProcessorT>
+    [[nodiscard]] static phi::string_view GetUnresolvedLabelName(
+            const ProcessorT& processor) noexcept
     {
-        // Lookup the label
-        const phi::observer_ptr<ParsedProgram> program = processor.GetCurrentProgram();
+        const phi::observer_ptr<const ParsedProgram> program = processor.GetCurrentProgram();
         PHI_ASSERT(program != nullptr);
-        PHI_ASSERT(!label_name.is_empty(), "Can't jump to empty label");
 
-        if (program->m_JumpData.find(label_name) == program->m_JumpData.end())
+        // The next program counter still points behind the jumping instruction
+        const Instruction& instruction =
+                program->m_Instructions[(processor.GetNextProgramCounter() - 1u).unsafe()];
+
+        // BEQZ and BNEZ test a register before the label
+        const InstructionArgument& first_argument = instruction.GetArg1();
+        if (first_argument.GetType() == ArgumentType::Label)
+        {
+            return first_argument.AsLabel().label_name;
+        }
+
+        return instruction.GetArg2().AsLabel().label_name;
+    }
+
+    template <typename ProcessorT>
+    static void JumpToLabel(ProcessorT& processor, phi::uint32_t jump_point) noexcept
+    {
+        // Labels are resolved to instruction indices by the parser
+        if (jump_point == InstructionArgument::Label::UnresolvedJumpPoint)
         {
-            DLX_ERROR("Unable to find jump label {}", label_name);
+            DLX_ERROR("Unable to find jump label {}", GetUnresolvedLabelName(processor));
             processor.Raise(Exception::UnknownLabel);
             return;
         }
 
-        const phi::uint32_t jump_point = program->m_JumpData.at(label_name);
-        PHI_ASSERT(jump_point < program->m_Instructions.size(), "Jump point out of bounds");
+        PHI_ASSERT(processor.GetCurrentProgram() != nullptr);
+        PHI_ASSERT(jump_point < processor.GetCurrentProgram()->m_Instructions.size(),
+                   "Jump point out of bounds");
 
         // Set program counter
         processor.SetNextProgramCounter(jump_point);
     }
 
-    static void JumpToRegister(Processor& processor, IntRegisterID reg_id) noexcept
+    template <typename ProcessorT>
+    static void JumpToRegister(ProcessorT& processor, IntRegisterID reg_id) noexcept
     {
         phi::u32 address = processor.IntRegisterGetUnsignedValue(reg_id);
 
@@ -71,54 +95,124 @@ namespace dlx
 
     PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wmaybe-uninitialized")
 
-    static phi::optional<phi::i32> CalculateDisplacementAddress(
-            Processor&                                      processor,
-            const InstructionArgument::AddressDisplacement& adr_displacement) noexcept
+    template <typename ProcessorT>
+    static phi::optional<phi::u32> CalculateDisplacementAddress(
+            ProcessorT& processor, IntRegisterID register_id, phi::i32 displacement) noexcept
     {
-        phi::i32 register_value = processor.IntRegisterGetSignedValue(adr_displacement.register_id);
+        const phi::int32_t register_value =
+                processor.IntRegisterGetSignedValue(register_id).unsafe();
 
-        phi::i32 address = adr_displacement.displacement + register_value;
+        // Paged memory covers the whole 32-bit address space so the base is unsigned there
+        const phi::int64_t base =
+                processor.GetMemory().IsPaged() ?
+                        static_cast<phi::int64_t>(static_cast<phi::uint32_t>(register_value)) :
+                        static_cast<phi::int64_t>(register_value);
 
-        if (address < 0)
+        const phi::int64_t address = base + displacement.unsafe();
+
+        if (address < 0 || address > phi::int64_t{phi::u32::limits_type::max()})
         {
             processor.Raise(Exception::AddressOutOfBounds);
             return {};
         }
 
-        return address;
+        return static_cast<phi::uint32_t>(address);
     }
 
     PHI_GCC_SUPPRESS_WARNING_POP()
 
-    PHI_GCC_SUPPRESS_WARNING_PUSH()
-    PHI_GCC_SUPPRESS_WARNING("-Wreturn-type")
-    PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(4702) // Unreachable code
-
-    static phi::optional<phi::i32> GetLoadStoreAddress(Processor&                processor,
-                                                       const InstructionArgument argument) noexcept
+    template <typename ProcessorT>
+    static phi::optional<phi::u32> GetLoadStoreAddress(ProcessorT&               processor,
+                                                       const DecodedInstruction& instruction,
+                                                       phi::size_t               index) noexcept
     {
-        if (argument.GetType() == ArgumentType::ImmediateInteger)
-        {
-            const auto& imm_value = argument.AsImmediateValue();
+        const IntRegisterID base_register = instruction.GetIntRegister(index);
+        const phi::i32      displacement  = instruction.GetSignedImmediate();
 
-            if (imm_value.signed_value < 0)
+        // Immediate addresses are decoded without a base register
+        if (base_register == IntRegisterID::None)
+        {
+            if (displacement < 0)
             {
                 return {};
             }
 
-            return imm_value.signed_value;
+            return static_cast<phi::uint32_t>(displacement.unsafe());
         }
 
-        PHI_ASSERT(argument.GetType() == ArgumentType::AddressDisplacement);
+        return CalculateDisplacementAddress(processor, base_register, displacement);
+    }
 
-        const auto& adr_displacement = argument.AsAddressDisplacement();
-        return CalculateDisplacementAddress(processor, adr_displacement);
+    // Loads from the address of a load instruction raising AddressOutOfBounds on failure
+    template <typename T, typename ProcessorT>
+    [[nodiscard]] static phi::boolean LoadFromMemory(ProcessorT&               processor,
+                                                     const DecodedInstruction& instruction,
+                                                     T&                        value) noexcept
+    {
+        const phi::optional<phi::u32> address = GetLoadStoreAddress(processor, instruction, 1u);
+
+        if (!address.has_value())
+        {
+            processor.Raise(Exception::AddressOutOfBounds);
+            return false;
+        }
+
+        if (processor.GetMemory().Load(static_cast<phi::size_t>(address->unsafe()), value) !=
+            MemoryAccessResult::Success)
+        {
+            processor.Raise(Exception::AddressOutOfBounds);
+            DLX_ERROR("Failed to load {} bytes at address {}", sizeof(T), address->unsafe());
+            return false;
+        }
+
+        // Only accesses which happened are traced and simulated
+        if constexpr (ProcessorT::ObservesAccesses)
+        {
+            processor.ObserveMemoryLoad(*address, sizeof(T));
+        }
+
+        return true;
     }
 
-    PHI_MSVC_SUPPRESS_WARNING_POP()
-    PHI_GCC_SUPPRESS_WARNING_POP()
+    // Stores to the address of a store instruction raising AddressOutOfBounds on failure
+    template <typename T, typename ProcessorT>
+    static void StoreToMemory(ProcessorT& processor, const DecodedInstruction& instruction,
+                              T value) noexcept
+    {
+        const phi::optional<phi::u32> address = GetLoadStoreAddress(processor, instruction, 0u);
+
+        if (!address.has_value())
+        {
+            processor.Raise(Exception::AddressOutOfBounds);
+            return;
+        }
+
+        if constexpr (ProcessorT::ObservesAccesses)
+        {
+            processor.PrepareMemoryStore(*address, sizeof(T));
+        }
+
+        if (processor.GetMemory().Store(static_cast<phi::size_t>(address->unsafe()), value) !=
+            MemoryAccessResult::Success)
+        {
+            processor.Raise(Exception::AddressOutOfBounds);
+            DLX_ERROR("Failed to store {} bytes at address {}", sizeof(T), address->unsafe());
+            return;
+        }
+
+        if constexpr (ProcessorT::ObservesAccesses)
+        {
+            static_assert(sizeof(T) <= sizeof(phi::uint64_t));
+
+            phi::uint64_t value_bits{0u};
+            std::memcpy(&value_bits, &value, sizeof(T));
+
+            processor.ObserveMemoryStore(*address, sizeof(T), value_bits);
+        }
+    }
 
-    static void SafeWriteInteger(Processor& processor, IntRegisterID dest_reg,
+    template <typename ProcessorT>
+    static void SafeWriteInteger(ProcessorT& processor, IntRegisterID dest_reg,
                                  phi::i64 value) noexcept
     {
         static const constexpr phi::i64 min = phi::i32::limits_type::min();
@@ -145,7 +239,8 @@ namespace dlx
         processor.IntRegisterSetSignedValue(dest_reg, static_cast<phi::int32_t>(value.unsafe()));
     }
 
-    static void SafeWriteInteger(Processor& processor, IntRegisterID dest_reg,
+    template <typename ProcessorT>
+    static void SafeWriteInteger(ProcessorT& processor, IntRegisterID dest_reg,
                                  phi::u64 value) noexcept
     {
         static constexpr const phi::u64 max = phi::u32::limits_type::max();
@@ -163,7 +258,8 @@ namespace dlx
         processor.IntRegisterSetUnsignedValue(dest_reg, static_cast<phi::uint32_t>(value.unsafe()));
     }
 
-    static void Addition(Processor& processor, IntRegisterID dest_reg, phi::i32 lhs,
+    template <typename ProcessorT>
+    static void Addition(ProcessorT& processor, IntRegisterID dest_reg, phi::i32 lhs,
                          phi::i32 rhs) noexcept
     {
         phi::i64 res = phi::i64(lhs) + rhs;
@@ -171,7 +267,8 @@ namespace dlx
         SafeWriteInteger(processor, dest_reg, res);
     }
 
-    static void Addition(Processor& processor, IntRegisterID dest_reg, phi::u32 lhs,
+    template <typename ProcessorT>
+    static void Addition(ProcessorT& processor, IntRegisterID dest_reg, phi::u32 lhs,
                          phi::u32 rhs) noexcept
     {
         phi::u64 res = phi::u64(lhs) + rhs;
@@ -179,7 +276,8 @@ namespace dlx
         SafeWriteInteger(processor, dest_reg, res);
     }
 
-    static void Subtraction(Processor& processor, IntRegisterID dest_reg, phi::i32 lhs,
+    template <typename ProcessorT>
+    static void Subtraction(ProcessorT& processor, IntRegisterID dest_reg, phi::i32 lhs,
                             phi::i32 rhs) noexcept
     {
         phi::i64 res = phi::i64(lhs) - rhs;
@@ -187,7 +285,8 @@ namespace dlx
         SafeWriteInteger(processor, dest_reg, res);
     }
 
-    static void Subtraction(Processor& processor, IntRegisterID dest_reg, phi::u32 lhs,
+    template <typename ProcessorT>
+    static void Subtraction(ProcessorT& processor, IntRegisterID dest_reg, phi::u32 lhs,
                             phi::u32 rhs) noexcept
     {
         constexpr phi::u32 max = phi::u32::limits_type::max();
@@ -206,7 +305,8 @@ namespace dlx
         SafeWriteInteger(processor, dest_reg, res);
     }
 
-    static void Multiplication(Processor& processor, IntRegisterID dest_reg, phi::i32 lhs,
+    template <typename ProcessorT>
+    static void Multiplication(ProcessorT& processor, IntRegisterID dest_reg, phi::i32 lhs,
                                phi::i32 rhs) noexcept
     {
         phi::i64 res = phi::i64(lhs) * rhs;
@@ -214,7 +314,8 @@ namespace dlx
         SafeWriteInteger(processor, dest_reg, res);
     }
 
-    static void Multiplication(Processor& processor, IntRegisterID dest_reg, phi::u32 lhs,
+    template <typename ProcessorT>
+    static void Multiplication(ProcessorT& processor, IntRegisterID dest_reg, phi::u32 lhs,
                                phi::u32 rhs) noexcept
     {
         phi::u64 res = phi::u64(lhs) * rhs;
@@ -222,7 +323,8 @@ namespace dlx
         SafeWriteInteger(processor, dest_reg, res);
     }
 
-    static void Division(Processor& processor, IntRegisterID dest_reg, phi::i32 lhs,
+    template <typename ProcessorT>
+    static void Division(ProcessorT& processor, IntRegisterID dest_reg, phi::i32 lhs,
                          phi::i32 rhs) noexcept
     {
         if (rhs == 0)
@@ -236,7 +338,8 @@ namespace dlx
         SafeWriteInteger(processor, dest_reg, res);
     }
 
-    static void Division(Processor& processor, IntRegisterID dest_reg, phi::u32 lhs,
+    template <typename ProcessorT>
+    static void Division(ProcessorT& processor, IntRegisterID dest_reg, phi::u32 lhs,
                          phi::u32 rhs) noexcept
     {
         if (rhs == 0u)
@@ -250,7 +353,8 @@ namespace dlx
         SafeWriteInteger(processor, dest_reg, res);
     }
 
-    static void ShiftRightLogical(Processor& processor, IntRegisterID dest_reg, phi::i32 base,
+    template <typename ProcessorT>
+    static void ShiftRightLogical(ProcessorT& processor, IntRegisterID dest_reg, phi::i32 base,
                                   phi::i32 shift) noexcept
     {
         // Prevent undefined behavior by shifting by more than 31
@@ -284,7 +388,8 @@ namespace dlx
         processor.IntRegisterSetSignedValue(dest_reg, new_value);
     }
 
-    static void ShiftRightArithmetic(Processor& processor, IntRegisterID dest_reg, phi::i32 base,
+    template <typename ProcessorT>
+    static void ShiftRightArithmetic(ProcessorT& processor, IntRegisterID dest_reg, phi::i32 base,
                                      phi::i32 shift) noexcept
     {
         // Prevent undefined behavior by shifting by more than 31
@@ -319,7 +424,8 @@ namespace dlx
     }
 
     // Behavior is the same for logical and arithmetic shifts
-    static void ShiftLeft(Processor& processor, IntRegisterID dest_reg, phi::i32 base,
+    template <typename ProcessorT>
+    static void ShiftLeft(ProcessorT& processor, IntRegisterID dest_reg, phi::i32 base,
                           phi::i32 shift) noexcept
     {
         if (shift > 31)
@@ -345,62 +451,62 @@ namespace dlx
 
     namespace impl
     {
-        void ADD(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void ADD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
 
-            Addition(processor, dest_reg.register_id, lhs_value, rhs_value);
+            Addition(processor, dest_reg, lhs_value, rhs_value);
         }
 
-        void ADDI(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void ADDI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg.register_id);
+            phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg);
 
-            Addition(processor, dest_reg.register_id, src_value, imm_value.signed_value);
+            Addition(processor, dest_reg, src_value, imm_value);
         }
 
-        void ADDU(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void ADDU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg.register_id);
-            phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg.register_id);
+            phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg);
+            phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg);
 
-            Addition(processor, dest_reg.register_id, lhs_value, rhs_value);
+            Addition(processor, dest_reg, lhs_value, rhs_value);
         }
 
-        void ADDUI(Processor& processor, const InstructionArgument& arg1,
-                   const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void ADDUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::u32      imm_value = instruction.GetUnsignedImmediate();
 
-            phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg.register_id);
+            phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg);
 
-            Addition(processor, dest_reg.register_id, src_value, imm_value.unsigned_value);
+            Addition(processor, dest_reg, src_value, imm_value);
         }
 
-        void ADDF(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void ADDF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterFloat().register_id;
-            const auto& lhs_reg  = arg2.AsRegisterFloat().register_id;
-            const auto& rhs_reg  = arg3.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID lhs_reg  = instruction.GetFloatRegister(1u);
+            const FloatRegisterID rhs_reg  = instruction.GetFloatRegister(2u);
 
             const phi::f32 lhs_value = processor.FloatRegisterGetFloatValue(lhs_reg);
             const phi::f32 rhs_value = processor.FloatRegisterGetFloatValue(rhs_reg);
@@ -410,12 +516,12 @@ namespace dlx
             processor.FloatRegisterSetFloatValue(dest_reg, new_value);
         }
 
-        void ADDD(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void ADDD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterFloat().register_id;
-            const auto& lhs_reg  = arg2.AsRegisterFloat().register_id;
-            const auto& rhs_reg  = arg3.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID lhs_reg  = instruction.GetFloatRegister(1u);
+            const FloatRegisterID rhs_reg  = instruction.GetFloatRegister(2u);
 
             const phi::f64 lhs_value = processor.FloatRegisterGetDoubleValue(lhs_reg);
             const phi::f64 rhs_value = processor.FloatRegisterGetDoubleValue(rhs_reg);
@@ -425,62 +531,62 @@ namespace dlx
             processor.FloatRegisterSetDoubleValue(dest_reg, new_value);
         }
 
-        void SUB(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SUB(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
 
-            Subtraction(processor, dest_reg.register_id, lhs_value, rhs_value);
+            Subtraction(processor, dest_reg, lhs_value, rhs_value);
         }
 
-        void SUBI(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SUBI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg.register_id);
+            phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg);
 
-            Subtraction(processor, dest_reg.register_id, src_value, imm_value.signed_value);
+            Subtraction(processor, dest_reg, src_value, imm_value);
         }
 
-        void SUBU(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SUBU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg.register_id);
-            phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg.register_id);
+            phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg);
+            phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg);
 
-            Subtraction(processor, dest_reg.register_id, lhs_value, rhs_value);
+            Subtraction(processor, dest_reg, lhs_value, rhs_value);
         }
 
-        void SUBUI(Processor& processor, const InstructionArgument& arg1,
-                   const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SUBUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::u32      imm_value = instruction.GetUnsignedImmediate();
 
-            phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg.register_id);
+            phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg);
 
-            Subtraction(processor, dest_reg.register_id, src_value, imm_value.unsigned_value);
+            Subtraction(processor, dest_reg, src_value, imm_value);
         }
 
-        void SUBF(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SUBF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterFloat().register_id;
-            const auto& lhs_reg  = arg2.AsRegisterFloat().register_id;
-            const auto& rhs_reg  = arg3.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID lhs_reg  = instruction.GetFloatRegister(1u);
+            const FloatRegisterID rhs_reg  = instruction.GetFloatRegister(2u);
 
             const phi::f32 lhs_value = processor.FloatRegisterGetFloatValue(lhs_reg);
             const phi::f32 rhs_value = processor.FloatRegisterGetFloatValue(rhs_reg);
@@ -490,12 +596,12 @@ namespace dlx
             processor.FloatRegisterSetFloatValue(dest_reg, new_value);
         }
 
-        void SUBD(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SUBD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterFloat().register_id;
-            const auto& lhs_reg  = arg2.AsRegisterFloat().register_id;
-            const auto& rhs_reg  = arg3.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID lhs_reg  = instruction.GetFloatRegister(1u);
+            const FloatRegisterID rhs_reg  = instruction.GetFloatRegister(2u);
 
             const phi::f64 lhs_value = processor.FloatRegisterGetDoubleValue(lhs_reg);
             const phi::f64 rhs_value = processor.FloatRegisterGetDoubleValue(rhs_reg);
@@ -505,62 +611,62 @@ namespace dlx
             processor.FloatRegisterSetDoubleValue(dest_reg, new_value);
         }
 
-        void MULT(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void MULT(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
 
-            Multiplication(processor, dest_reg.register_id, lhs_value, rhs_value);
+            Multiplication(processor, dest_reg, lhs_value, rhs_value);
         }
 
-        void MULTI(Processor& processor, const InstructionArgument& arg1,
-                   const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void MULTI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg.register_id);
+            phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg);
 
-            Multiplication(processor, dest_reg.register_id, src_value, imm_value.signed_value);
+            Multiplication(processor, dest_reg, src_value, imm_value);
         }
 
-        void MULTU(Processor& processor, const InstructionArgument& arg1,
-                   const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void MULTU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg.register_id);
-            phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg.register_id);
+            phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg);
+            phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg);
 
-            Multiplication(processor, dest_reg.register_id, lhs_value, rhs_value);
+            Multiplication(processor, dest_reg, lhs_value, rhs_value);
         }
 
-        void MULTUI(Processor& processor, const InstructionArgument& arg1,
-                    const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void MULTUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::u32      imm_value = instruction.GetUnsignedImmediate();
 
-            phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg.register_id);
+            phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg);
 
-            Multiplication(processor, dest_reg.register_id, src_value, imm_value.unsigned_value);
+            Multiplication(processor, dest_reg, src_value, imm_value);
         }
 
-        void MULTF(Processor& processor, const InstructionArgument& arg1,
-                   const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void MULTF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterFloat().register_id;
-            const auto& lhs_reg  = arg2.AsRegisterFloat().register_id;
-            const auto& rhs_reg  = arg3.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID lhs_reg  = instruction.GetFloatRegister(1u);
+            const FloatRegisterID rhs_reg  = instruction.GetFloatRegister(2u);
 
             const phi::f32 lhs_value = processor.FloatRegisterGetFloatValue(lhs_reg);
             const phi::f32 rhs_value = processor.FloatRegisterGetFloatValue(rhs_reg);
@@ -570,12 +676,12 @@ namespace dlx
             processor.FloatRegisterSetFloatValue(dest_reg, new_value);
         }
 
-        void MULTD(Processor& processor, const InstructionArgument& arg1,
-                   const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void MULTD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterFloat().register_id;
-            const auto& lhs_reg  = arg2.AsRegisterFloat().register_id;
-            const auto& rhs_reg  = arg3.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID lhs_reg  = instruction.GetFloatRegister(1u);
+            const FloatRegisterID rhs_reg  = instruction.GetFloatRegister(2u);
 
             const phi::f64 lhs_value = processor.FloatRegisterGetDoubleValue(lhs_reg);
             const phi::f64 rhs_value = processor.FloatRegisterGetDoubleValue(rhs_reg);
@@ -585,62 +691,62 @@ namespace dlx
             processor.FloatRegisterSetDoubleValue(dest_reg, new_value);
         }
 
-        void DIV(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void DIV(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
 
-            Division(processor, dest_reg.register_id, lhs_value, rhs_value);
+            Division(processor, dest_reg, lhs_value, rhs_value);
         }
 
-        void DIVI(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void DIVI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg.register_id);
+            phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg);
 
-            Division(processor, dest_reg.register_id, src_value, imm_value.signed_value);
+            Division(processor, dest_reg, src_value, imm_value);
         }
 
-        void DIVU(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void DIVU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg.register_id);
-            phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg.register_id);
+            phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg);
+            phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg);
 
-            Division(processor, dest_reg.register_id, lhs_value, rhs_value);
+            Division(processor, dest_reg, lhs_value, rhs_value);
         }
 
-        void DIVUI(Processor& processor, const InstructionArgument& arg1,
-                   const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void DIVUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::u32      imm_value = instruction.GetUnsignedImmediate();
 
-            phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg.register_id);
+            phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg);
 
-            Division(processor, dest_reg.register_id, src_value, imm_value.unsigned_value);
+            Division(processor, dest_reg, src_value, imm_value);
         }
 
-        void DIVF(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void DIVF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterFloat().register_id;
-            const auto& lhs_reg  = arg2.AsRegisterFloat().register_id;
-            const auto& rhs_reg  = arg3.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID lhs_reg  = instruction.GetFloatRegister(1u);
+            const FloatRegisterID rhs_reg  = instruction.GetFloatRegister(2u);
 
             const phi::f32 lhs_value = processor.FloatRegisterGetFloatValue(lhs_reg);
             const phi::f32 rhs_value = processor.FloatRegisterGetFloatValue(rhs_reg);
@@ -656,12 +762,12 @@ namespace dlx
             processor.FloatRegisterSetFloatValue(dest_reg, new_value);
         }
 
-        void DIVD(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void DIVD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterFloat().register_id;
-            const auto& lhs_reg  = arg2.AsRegisterFloat().register_id;
-            const auto& rhs_reg  = arg3.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID lhs_reg  = instruction.GetFloatRegister(1u);
+            const FloatRegisterID rhs_reg  = instruction.GetFloatRegister(2u);
 
             const phi::f64 lhs_value = processor.FloatRegisterGetDoubleValue(lhs_reg);
             const phi::f64 rhs_value = processor.FloatRegisterGetDoubleValue(rhs_reg);
@@ -677,254 +783,254 @@ namespace dlx
             processor.FloatRegisterSetDoubleValue(dest_reg, new_value);
         }
 
-        void SLL(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SLL(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
 
-            ShiftLeft(processor, dest_reg.register_id, lhs_value, rhs_value);
+            ShiftLeft(processor, dest_reg, lhs_value, rhs_value);
         }
 
-        void SLLI(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SLLI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            phi::i32 src_value   = processor.IntRegisterGetSignedValue(src_reg.register_id);
-            phi::i32 shift_value = imm_value.signed_value;
+            phi::i32 src_value   = processor.IntRegisterGetSignedValue(src_reg);
+            phi::i32 shift_value = imm_value;
 
-            ShiftLeft(processor, dest_reg.register_id, src_value, shift_value);
+            ShiftLeft(processor, dest_reg, src_value, shift_value);
         }
 
-        void SRL(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SRL(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
 
-            ShiftRightLogical(processor, dest_reg.register_id, lhs_value, rhs_value);
+            ShiftRightLogical(processor, dest_reg, lhs_value, rhs_value);
         }
 
-        void SRLI(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SRLI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            phi::i32 src_value   = processor.IntRegisterGetSignedValue(src_reg.register_id);
-            phi::i32 shift_value = imm_value.signed_value;
+            phi::i32 src_value   = processor.IntRegisterGetSignedValue(src_reg);
+            phi::i32 shift_value = imm_value;
 
-            ShiftRightLogical(processor, dest_reg.register_id, src_value, shift_value);
+            ShiftRightLogical(processor, dest_reg, src_value, shift_value);
         }
 
-        void SLA(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SLA(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
 
-            ShiftLeft(processor, dest_reg.register_id, lhs_value, rhs_value);
+            ShiftLeft(processor, dest_reg, lhs_value, rhs_value);
         }
 
-        void SLAI(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SLAI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            phi::i32 src_value   = processor.IntRegisterGetSignedValue(src_reg.register_id);
-            phi::i32 shift_value = imm_value.signed_value;
+            phi::i32 src_value   = processor.IntRegisterGetSignedValue(src_reg);
+            phi::i32 shift_value = imm_value;
 
-            ShiftLeft(processor, dest_reg.register_id, src_value, shift_value);
+            ShiftLeft(processor, dest_reg, src_value, shift_value);
         }
 
-        void SRA(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SRA(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
 
-            ShiftRightArithmetic(processor, dest_reg.register_id, lhs_value, rhs_value);
+            ShiftRightArithmetic(processor, dest_reg, lhs_value, rhs_value);
         }
 
-        void SRAI(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SRAI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            phi::i32 src_value   = processor.IntRegisterGetSignedValue(src_reg.register_id);
-            phi::i32 shift_value = imm_value.signed_value;
+            phi::i32 src_value   = processor.IntRegisterGetSignedValue(src_reg);
+            phi::i32 shift_value = imm_value;
 
-            ShiftRightArithmetic(processor, dest_reg.register_id, src_value, shift_value);
+            ShiftRightArithmetic(processor, dest_reg, src_value, shift_value);
         }
 
-        void AND(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void AND(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
             phi::i32 new_value = lhs_value.unsafe() & rhs_value.unsafe();
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void ANDI(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void ANDI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg.register_id);
-            phi::i32 new_value = src_value.unsafe() & imm_value.signed_value.unsafe();
+            phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg);
+            phi::i32 new_value = src_value.unsafe() & imm_value.unsafe();
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void OR(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void OR(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
             phi::i32 new_value = lhs_value.unsafe() | rhs_value.unsafe();
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void ORI(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void ORI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg.register_id);
-            phi::i32 new_value = src_value.unsafe() | imm_value.signed_value.unsafe();
+            phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg);
+            phi::i32 new_value = src_value.unsafe() | imm_value.unsafe();
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void XOR(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void XOR(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
             phi::i32 new_value = lhs_value.unsafe() ^ rhs_value.unsafe();
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void XORI(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void XORI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg.register_id);
-            phi::i32 new_value = src_value.unsafe() ^ imm_value.signed_value.unsafe();
+            phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg);
+            phi::i32 new_value = src_value.unsafe() ^ imm_value.unsafe();
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void SLT(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SLT(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            const phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            const phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            const phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            const phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
 
             const phi::i32 new_value = (lhs_value < rhs_value ? 1 : 0);
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void SLTI(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SLTI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            const phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg.register_id);
+            const phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg);
 
-            const phi::i32 new_value = (src_value < imm_value.signed_value ? 1 : 0);
+            const phi::i32 new_value = (src_value < imm_value ? 1 : 0);
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void SLTU(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SLTU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            const phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg.register_id);
-            const phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg.register_id);
+            const phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg);
+            const phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg);
 
             const phi::u32 new_value = (lhs_value < rhs_value ? 1u : 0u);
 
-            processor.IntRegisterSetUnsignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetUnsignedValue(dest_reg, new_value);
         }
 
-        void SLTUI(Processor& processor, const InstructionArgument& arg1,
-                   const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SLTUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::u32      imm_value = instruction.GetUnsignedImmediate();
 
-            const phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg.register_id);
+            const phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg);
 
-            const phi::u32 new_value = (src_value < imm_value.unsigned_value ? 1u : 0u);
+            const phi::u32 new_value = (src_value < imm_value ? 1u : 0u);
 
-            processor.IntRegisterSetUnsignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetUnsignedValue(dest_reg, new_value);
         }
 
-        void LTF(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void LTF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID lhs_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID rhs_reg = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID lhs_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID rhs_reg = instruction.GetFloatRegister(1u);
 
             const phi::f32 lhs_value = processor.FloatRegisterGetFloatValue(lhs_reg);
             const phi::f32 rhs_value = processor.FloatRegisterGetFloatValue(rhs_reg);
@@ -934,11 +1040,11 @@ namespace dlx
             processor.SetFPSRValue(new_value);
         }
 
-        void LTD(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void LTD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID lhs_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID rhs_reg = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID lhs_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID rhs_reg = instruction.GetFloatRegister(1u);
 
             const phi::f64 lhs_value = processor.FloatRegisterGetDoubleValue(lhs_reg);
             const phi::f64 rhs_value = processor.FloatRegisterGetDoubleValue(rhs_reg);
@@ -948,69 +1054,69 @@ namespace dlx
             processor.SetFPSRValue(new_value);
         }
 
-        void SGT(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SGT(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            const phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            const phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            const phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            const phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
 
             const phi::i32 new_value = (lhs_value > rhs_value ? 1 : 0);
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void SGTI(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SGTI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            const phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg.register_id);
+            const phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg);
 
-            const phi::i32 new_value = (src_value > imm_value.signed_value ? 1 : 0);
+            const phi::i32 new_value = (src_value > imm_value ? 1 : 0);
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void SGTU(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SGTU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            const phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg.register_id);
-            const phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg.register_id);
+            const phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg);
+            const phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg);
 
             const phi::u32 new_value = (lhs_value > rhs_value ? 1u : 0u);
 
-            processor.IntRegisterSetUnsignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetUnsignedValue(dest_reg, new_value);
         }
 
-        void SGTUI(Processor& processor, const InstructionArgument& arg1,
-                   const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SGTUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::u32      imm_value = instruction.GetUnsignedImmediate();
 
-            const phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg.register_id);
+            const phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg);
 
-            const phi::u32 new_value = (src_value > imm_value.unsigned_value ? 1u : 0u);
+            const phi::u32 new_value = (src_value > imm_value ? 1u : 0u);
 
-            processor.IntRegisterSetUnsignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetUnsignedValue(dest_reg, new_value);
         }
 
-        void GTF(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void GTF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID lhs_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID rhs_reg = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID lhs_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID rhs_reg = instruction.GetFloatRegister(1u);
 
             const phi::f32 lhs_value = processor.FloatRegisterGetFloatValue(lhs_reg);
             const phi::f32 rhs_value = processor.FloatRegisterGetFloatValue(rhs_reg);
@@ -1020,11 +1126,11 @@ namespace dlx
             processor.SetFPSRValue(new_value);
         }
 
-        void GTD(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void GTD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID lhs_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID rhs_reg = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID lhs_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID rhs_reg = instruction.GetFloatRegister(1u);
 
             const phi::f64 lhs_value = processor.FloatRegisterGetDoubleValue(lhs_reg);
             const phi::f64 rhs_value = processor.FloatRegisterGetDoubleValue(rhs_reg);
@@ -1034,69 +1140,69 @@ namespace dlx
             processor.SetFPSRValue(new_value);
         }
 
-        void SLE(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SLE(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            const phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            const phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            const phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            const phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
 
             const phi::i32 new_value = (lhs_value <= rhs_value ? 1 : 0);
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void SLEI(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SLEI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            const phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg.register_id);
+            const phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg);
 
-            const phi::i32 new_value = (src_value <= imm_value.signed_value ? 1 : 0);
+            const phi::i32 new_value = (src_value <= imm_value ? 1 : 0);
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void SLEU(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SLEU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            const phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg.register_id);
-            const phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg.register_id);
+            const phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg);
+            const phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg);
 
             const phi::u32 new_value = (lhs_value <= rhs_value ? 1u : 0u);
 
-            processor.IntRegisterSetUnsignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetUnsignedValue(dest_reg, new_value);
         }
 
-        void SLEUI(Processor& processor, const InstructionArgument& arg1,
-                   const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SLEUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::u32      imm_value = instruction.GetUnsignedImmediate();
 
-            const phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg.register_id);
+            const phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg);
 
-            const phi::u32 new_value = (src_value <= imm_value.unsigned_value ? 1u : 0u);
+            const phi::u32 new_value = (src_value <= imm_value ? 1u : 0u);
 
-            processor.IntRegisterSetUnsignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetUnsignedValue(dest_reg, new_value);
         }
 
-        void LEF(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void LEF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID lhs_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID rhs_reg = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID lhs_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID rhs_reg = instruction.GetFloatRegister(1u);
 
             const phi::f32 lhs_value = processor.FloatRegisterGetFloatValue(lhs_reg);
             const phi::f32 rhs_value = processor.FloatRegisterGetFloatValue(rhs_reg);
@@ -1106,11 +1212,11 @@ namespace dlx
             processor.SetFPSRValue(new_value);
         }
 
-        void LED(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void LED(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID lhs_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID rhs_reg = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID lhs_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID rhs_reg = instruction.GetFloatRegister(1u);
 
             const phi::f64 lhs_value = processor.FloatRegisterGetDoubleValue(lhs_reg);
             const phi::f64 rhs_value = processor.FloatRegisterGetDoubleValue(rhs_reg);
@@ -1120,69 +1226,69 @@ namespace dlx
             processor.SetFPSRValue(new_value);
         }
 
-        void SGE(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SGE(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            const phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            const phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            const phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            const phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
 
             const phi::i32 new_value = (lhs_value >= rhs_value ? 1 : 0);
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void SGEI(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SGEI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            const phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg.register_id);
+            const phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg);
 
-            const phi::i32 new_value = (src_value >= imm_value.signed_value ? 1 : 0);
+            const phi::i32 new_value = (src_value >= imm_value ? 1 : 0);
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void SGEU(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SGEU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            const phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg.register_id);
-            const phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg.register_id);
+            const phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg);
+            const phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg);
 
             const phi::u32 new_value = (lhs_value >= rhs_value ? 1u : 0u);
 
-            processor.IntRegisterSetUnsignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetUnsignedValue(dest_reg, new_value);
         }
 
-        void SGEUI(Processor& processor, const InstructionArgument& arg1,
-                   const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SGEUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::u32      imm_value = instruction.GetUnsignedImmediate();
 
-            const phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg.register_id);
+            const phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg);
 
-            const phi::u32 new_value = (src_value >= imm_value.unsigned_value ? 1u : 0u);
+            const phi::u32 new_value = (src_value >= imm_value ? 1u : 0u);
 
-            processor.IntRegisterSetUnsignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetUnsignedValue(dest_reg, new_value);
         }
 
-        void GEF(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void GEF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID lhs_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID rhs_reg = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID lhs_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID rhs_reg = instruction.GetFloatRegister(1u);
 
             const phi::f32 lhs_value = processor.FloatRegisterGetFloatValue(lhs_reg);
             const phi::f32 rhs_value = processor.FloatRegisterGetFloatValue(rhs_reg);
@@ -1192,11 +1298,11 @@ namespace dlx
             processor.SetFPSRValue(new_value);
         }
 
-        void GED(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void GED(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID lhs_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID rhs_reg = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID lhs_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID rhs_reg = instruction.GetFloatRegister(1u);
 
             const phi::f64 lhs_value = processor.FloatRegisterGetDoubleValue(lhs_reg);
             const phi::f64 rhs_value = processor.FloatRegisterGetDoubleValue(rhs_reg);
@@ -1206,69 +1312,69 @@ namespace dlx
             processor.SetFPSRValue(new_value);
         }
 
-        void SEQ(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SEQ(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            const phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            const phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            const phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            const phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
 
             const phi::i32 new_value = (lhs_value == rhs_value ? 1 : 0);
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void SEQI(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SEQI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            const phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg.register_id);
+            const phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg);
 
-            const phi::i32 new_value = (src_value == imm_value.signed_value ? 1 : 0);
+            const phi::i32 new_value = (src_value == imm_value ? 1 : 0);
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void SEQU(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SEQU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            const phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg.register_id);
-            const phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg.register_id);
+            const phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg);
+            const phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg);
 
             const phi::u32 new_value = (lhs_value == rhs_value ? 1u : 0u);
 
-            processor.IntRegisterSetUnsignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetUnsignedValue(dest_reg, new_value);
         }
 
-        void SEQUI(Processor& processor, const InstructionArgument& arg1,
-                   const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SEQUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::u32      imm_value = instruction.GetUnsignedImmediate();
 
-            const phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg.register_id);
+            const phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg);
 
-            const phi::u32 new_value = (src_value == imm_value.unsigned_value ? 1u : 0u);
+            const phi::u32 new_value = (src_value == imm_value ? 1u : 0u);
 
-            processor.IntRegisterSetUnsignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetUnsignedValue(dest_reg, new_value);
         }
 
-        void EQF(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void EQF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID lhs_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID rhs_reg = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID lhs_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID rhs_reg = instruction.GetFloatRegister(1u);
 
             const phi::f32 lhs_value = processor.FloatRegisterGetFloatValue(lhs_reg);
             const phi::f32 rhs_value = processor.FloatRegisterGetFloatValue(rhs_reg);
@@ -1278,11 +1384,11 @@ namespace dlx
             processor.SetFPSRValue(new_value);
         }
 
-        void EQD(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void EQD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID lhs_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID rhs_reg = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID lhs_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID rhs_reg = instruction.GetFloatRegister(1u);
 
             const phi::f64 lhs_value = processor.FloatRegisterGetDoubleValue(lhs_reg);
             const phi::f64 rhs_value = processor.FloatRegisterGetDoubleValue(rhs_reg);
@@ -1292,69 +1398,69 @@ namespace dlx
             processor.SetFPSRValue(new_value);
         }
 
-        void SNE(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SNE(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            const phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg.register_id);
-            const phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg.register_id);
+            const phi::i32 lhs_value = processor.IntRegisterGetSignedValue(lhs_reg);
+            const phi::i32 rhs_value = processor.IntRegisterGetSignedValue(rhs_reg);
 
             const phi::i32 new_value = (lhs_value != rhs_value ? 1 : 0);
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void SNEI(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SNEI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::i32      imm_value = instruction.GetSignedImmediate();
 
-            const phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg.register_id);
+            const phi::i32 src_value = processor.IntRegisterGetSignedValue(src_reg);
 
-            const phi::i32 new_value = (src_value != imm_value.signed_value ? 1 : 0);
+            const phi::i32 new_value = (src_value != imm_value ? 1 : 0);
 
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetSignedValue(dest_reg, new_value);
         }
 
-        void SNEU(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SNEU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-            const auto& lhs_reg  = arg2.AsRegisterInt();
-            const auto& rhs_reg  = arg3.AsRegisterInt();
+            const IntRegisterID dest_reg = instruction.GetIntRegister(0u);
+            const IntRegisterID lhs_reg  = instruction.GetIntRegister(1u);
+            const IntRegisterID rhs_reg  = instruction.GetIntRegister(2u);
 
-            const phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg.register_id);
-            const phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg.register_id);
+            const phi::u32 lhs_value = processor.IntRegisterGetUnsignedValue(lhs_reg);
+            const phi::u32 rhs_value = processor.IntRegisterGetUnsignedValue(rhs_reg);
 
             const phi::u32 new_value = (lhs_value != rhs_value ? 1u : 0u);
 
-            processor.IntRegisterSetUnsignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetUnsignedValue(dest_reg, new_value);
         }
 
-        void SNEUI(Processor& processor, const InstructionArgument& arg1,
-                   const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SNEUI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg  = arg1.AsRegisterInt();
-            const auto& src_reg   = arg2.AsRegisterInt();
-            const auto& imm_value = arg3.AsImmediateValue();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            const IntRegisterID src_reg   = instruction.GetIntRegister(1u);
+            const phi::u32      imm_value = instruction.GetUnsignedImmediate();
 
-            const phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg.register_id);
+            const phi::u32 src_value = processor.IntRegisterGetUnsignedValue(src_reg);
 
-            const phi::u32 new_value = (src_value != imm_value.unsigned_value ? 1u : 0u);
+            const phi::u32 new_value = (src_value != imm_value ? 1u : 0u);
 
-            processor.IntRegisterSetUnsignedValue(dest_reg.register_id, new_value);
+            processor.IntRegisterSetUnsignedValue(dest_reg, new_value);
         }
 
-        void NEF(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void NEF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID lhs_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID rhs_reg = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID lhs_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID rhs_reg = instruction.GetFloatRegister(1u);
 
             const phi::f32 lhs_value = processor.FloatRegisterGetFloatValue(lhs_reg);
             const phi::f32 rhs_value = processor.FloatRegisterGetFloatValue(rhs_reg);
@@ -1364,11 +1470,11 @@ namespace dlx
             processor.SetFPSRValue(new_value);
         }
 
-        void NED(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void NED(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID lhs_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID rhs_reg = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID lhs_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID rhs_reg = instruction.GetFloatRegister(1u);
 
             const phi::f64 lhs_value = processor.FloatRegisterGetDoubleValue(lhs_reg);
             const phi::f64 rhs_value = processor.FloatRegisterGetDoubleValue(rhs_reg);
@@ -1378,588 +1484,282 @@ namespace dlx
             processor.SetFPSRValue(new_value);
         }
 
-        void BEQZ(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void BEQZ(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& test_reg   = arg1.AsRegisterInt();
-            const auto& jump_label = arg2.AsLabel();
+            const IntRegisterID test_reg = instruction.GetIntRegister(0u);
 
-            phi::i32 test_value = processor.IntRegisterGetSignedValue(test_reg.register_id);
+            phi::i32 test_value = processor.IntRegisterGetSignedValue(test_reg);
 
             if (test_value == 0)
             {
-                JumpToLabel(processor, jump_label.label_name);
+                JumpToLabel(processor, instruction.jump_point);
             }
         }
 
-        void BNEZ(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void BNEZ(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& test_reg   = arg1.AsRegisterInt();
-            const auto& jump_label = arg2.AsLabel();
+            const IntRegisterID test_reg = instruction.GetIntRegister(0u);
 
-            phi::i32 test_value = processor.IntRegisterGetSignedValue(test_reg.register_id);
+            phi::i32 test_value = processor.IntRegisterGetSignedValue(test_reg);
 
             if (test_value != 0)
             {
-                JumpToLabel(processor, jump_label.label_name);
+                JumpToLabel(processor, instruction.jump_point);
             }
         }
 
-        void BFPT(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void BFPT(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& jump_label = arg1.AsLabel();
-
             phi::boolean test_value = processor.GetFPSRValue();
 
             if (test_value)
             {
-                JumpToLabel(processor, jump_label.label_name);
+                JumpToLabel(processor, instruction.jump_point);
             }
         }
 
-        void BFPF(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void BFPF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& jump_label = arg1.AsLabel();
-
             phi::boolean test_value = processor.GetFPSRValue();
 
             if (!test_value)
             {
-                JumpToLabel(processor, jump_label.label_name);
+                JumpToLabel(processor, instruction.jump_point);
             }
         }
 
-        void J(Processor& processor, const InstructionArgument& arg1,
-               const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void J(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& jump_label = arg1.AsLabel();
-
-            JumpToLabel(processor, jump_label.label_name);
+            JumpToLabel(processor, instruction.jump_point);
         }
 
-        void JR(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void JR(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& jump_register = arg1.AsRegisterInt();
+            const IntRegisterID jump_register = instruction.GetIntRegister(0u);
 
-            JumpToRegister(processor, jump_register.register_id);
+            JumpToRegister(processor, jump_register);
         }
 
-        void JAL(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void JAL(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& jump_label = arg1.AsLabel();
-
             processor.IntRegisterSetUnsignedValue(IntRegisterID::R31,
                                                   processor.GetNextProgramCounter());
 
-            JumpToLabel(processor, jump_label.label_name);
+            JumpToLabel(processor, instruction.jump_point);
         }
 
-        void JALR(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void JALR(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& jump_register = arg1.AsRegisterInt();
+            const IntRegisterID jump_register = instruction.GetIntRegister(0u);
 
             processor.IntRegisterSetUnsignedValue(IntRegisterID::R31,
                                                   processor.GetNextProgramCounter());
 
-            JumpToRegister(processor, jump_register.register_id);
+            JumpToRegister(processor, jump_register);
         }
 
-        void LHI(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void LHI(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const IntRegisterID dest_reg  = arg1.AsRegisterInt().register_id;
-            phi::int32_t        imm_value = arg2.AsImmediateValue().signed_value.unsafe();
+            const IntRegisterID dest_reg  = instruction.GetIntRegister(0u);
+            phi::int32_t        imm_value = instruction.GetSignedImmediate().unsafe();
 
             imm_value = static_cast<phi::int32_t>((imm_value << 16) & 0xFFFF0000);
 
             processor.IntRegisterSetSignedValue(dest_reg, imm_value);
         }
 
-        void LB(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void LB(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-
-            auto optional_address = GetLoadStoreAddress(processor, arg2);
+            phi::int8_t value;
 
-            if (!optional_address.has_value())
+            if (LoadFromMemory(processor, instruction, value))
             {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
+                processor.IntRegisterSetSignedValue(instruction.GetIntRegister(0u), value);
             }
-
-            phi::i32 address = optional_address.value();
-
-            auto optional_value =
-                    processor.GetMemory().LoadByte(static_cast<phi::size_t>(address.unsafe()));
-
-            if (!optional_value.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to load byte at address {}", address.unsafe());
-                return;
-            }
-
-            phi::i32 value = optional_value.value();
-
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, value);
         }
 
-        void LBU(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void LBU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-
-            auto optional_address = GetLoadStoreAddress(processor, arg2);
-
-            if (!optional_address.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
-            }
+            phi::uint8_t value;
 
-            phi::i32 address = optional_address.value();
-
-            auto optional_value = processor.GetMemory().LoadUnsignedByte(
-                    static_cast<phi::size_t>(address.unsafe()));
-
-            if (!optional_value.has_value())
+            if (LoadFromMemory(processor, instruction, value))
             {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to load unsigned byte at address {}", address.unsafe());
-                return;
+                processor.IntRegisterSetUnsignedValue(instruction.GetIntRegister(0u), value);
             }
-
-            phi::u32 value = optional_value.value();
-
-            processor.IntRegisterSetUnsignedValue(dest_reg.register_id, value);
         }
 
-        void LH(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void LH(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-
-            auto optional_address = GetLoadStoreAddress(processor, arg2);
+            phi::int16_t value;
 
-            if (!optional_address.has_value())
+            if (LoadFromMemory(processor, instruction, value))
             {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
-            }
-
-            phi::i32 address = optional_address.value();
-
-            auto optional_value =
-                    processor.GetMemory().LoadHalfWord(static_cast<phi::size_t>(address.unsafe()));
-
-            if (!optional_value.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to load half byte at address {}", address.unsafe());
-                return;
+                processor.IntRegisterSetSignedValue(instruction.GetIntRegister(0u), value);
             }
-
-            phi::i32 value = optional_value.value();
-
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, value);
         }
 
-        void LHU(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void LHU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
+            phi::uint16_t value;
 
-            auto optional_address = GetLoadStoreAddress(processor, arg2);
-
-            if (!optional_address.has_value())
+            if (LoadFromMemory(processor, instruction, value))
             {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
+                processor.IntRegisterSetUnsignedValue(instruction.GetIntRegister(0u), value);
             }
-
-            phi::i32 address = optional_address.value();
-
-            auto optional_value = processor.GetMemory().LoadUnsignedHalfWord(
-                    static_cast<phi::size_t>(address.unsafe()));
-
-            if (!optional_value.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to load unsigned half byte at address {}", address.unsafe());
-                return;
-            }
-
-            phi::u32 value = optional_value.value();
-
-            processor.IntRegisterSetUnsignedValue(dest_reg.register_id, value);
         }
 
-        void LW(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void LW(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-
-            auto optional_address = GetLoadStoreAddress(processor, arg2);
+            phi::int32_t value;
 
-            if (!optional_address.has_value())
+            if (LoadFromMemory(processor, instruction, value))
             {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
-            }
-
-            phi::i32 address = optional_address.value();
-
-            auto optional_value =
-                    processor.GetMemory().LoadWord(static_cast<phi::size_t>(address.unsafe()));
-
-            if (!optional_value.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to load word at address {}", address.unsafe());
-                return;
+                processor.IntRegisterSetSignedValue(instruction.GetIntRegister(0u), value);
             }
-
-            processor.IntRegisterSetSignedValue(dest_reg.register_id, optional_value.value());
         }
 
-        void LWU(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void LWU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterInt();
-
-            auto optional_address = GetLoadStoreAddress(processor, arg2);
-
-            if (!optional_address.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
-            }
+            phi::uint32_t value;
 
-            phi::i32 address = optional_address.value();
-
-            auto optional_value = processor.GetMemory().LoadUnsignedWord(
-                    static_cast<phi::size_t>(address.unsafe()));
-
-            if (!optional_value.has_value())
+            if (LoadFromMemory(processor, instruction, value))
             {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to load unsigned word at address {}", address.unsafe());
-                return;
+                processor.IntRegisterSetUnsignedValue(instruction.GetIntRegister(0u), value);
             }
-
-            processor.IntRegisterSetUnsignedValue(dest_reg.register_id, optional_value.value());
         }
 
-        void LF(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void LF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterFloat();
-
-            auto optional_address = GetLoadStoreAddress(processor, arg2);
-
-            if (!optional_address.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
-            }
-
-            phi::i32 address = optional_address.value();
-
-            auto optional_value =
-                    processor.GetMemory().LoadFloat(static_cast<phi::size_t>(address.unsafe()));
+            float value;
 
-            if (!optional_value.has_value())
+            if (LoadFromMemory(processor, instruction, value))
             {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to load float at address {}", address.unsafe());
-                return;
+                processor.FloatRegisterSetFloatValue(instruction.GetFloatRegister(0u), value);
             }
-
-            processor.FloatRegisterSetFloatValue(dest_reg.register_id, optional_value.value());
         }
 
-        void LD(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void LD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const auto& dest_reg = arg1.AsRegisterFloat();
-
-            auto optional_address = GetLoadStoreAddress(processor, arg2);
+            double value;
 
-            if (!optional_address.has_value())
+            if (LoadFromMemory(processor, instruction, value))
             {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
-            }
-
-            phi::i32 address = optional_address.value();
-
-            auto optional_value =
-                    processor.GetMemory().LoadDouble(static_cast<phi::size_t>(address.unsafe()));
-
-            if (!optional_value.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to load double at address {}", address.unsafe());
-                return;
+                processor.FloatRegisterSetDoubleValue(instruction.GetFloatRegister(0u), value);
             }
-
-            processor.FloatRegisterSetDoubleValue(dest_reg.register_id, optional_value.value());
         }
 
-        void SB(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SB(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            auto optional_address = GetLoadStoreAddress(processor, arg1);
-
-            if (!optional_address.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
-            }
-
-            phi::i32 address = optional_address.value();
+            const phi::int8_t value = static_cast<phi::int8_t>(
+                    processor.IntRegisterGetSignedValue(instruction.GetIntRegister(1u)).unsafe());
 
-            const auto& src_reg = arg2.AsRegisterInt();
-
-            phi::i32 value = processor.IntRegisterGetSignedValue(src_reg.register_id);
-
-            phi::boolean success =
-                    processor.GetMemory().StoreByte(static_cast<phi::size_t>(address.unsafe()),
-                                                    static_cast<phi::int8_t>(value.unsafe()));
-
-            if (!success)
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to store byte at address {}", address.unsafe());
-            }
+            StoreToMemory(processor, instruction, value);
         }
 
-        void SBU(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SBU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            auto optional_address = GetLoadStoreAddress(processor, arg1);
-
-            if (!optional_address.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
-            }
-
-            phi::i32 address = optional_address.value();
-
-            const auto& src_reg = arg2.AsRegisterInt();
-
-            phi::u32 value = processor.IntRegisterGetUnsignedValue(src_reg.register_id);
-
-            phi::boolean success = processor.GetMemory().StoreUnsignedByte(
-                    static_cast<phi::size_t>(address.unsafe()),
-                    static_cast<phi::uint8_t>(value.unsafe()));
+            const phi::uint8_t value = static_cast<phi::uint8_t>(
+                    processor.IntRegisterGetUnsignedValue(instruction.GetIntRegister(1u)).unsafe());
 
-            if (!success)
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to store unsigned byte at address {}", address.unsafe());
-            }
+            StoreToMemory(processor, instruction, value);
         }
 
-        void SH(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SH(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            auto optional_address = GetLoadStoreAddress(processor, arg1);
-
-            if (!optional_address.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
-            }
-
-            phi::i32 address = optional_address.value();
+            const phi::int16_t value = static_cast<phi::int16_t>(
+                    processor.IntRegisterGetSignedValue(instruction.GetIntRegister(1u)).unsafe());
 
-            const auto& src_reg = arg2.AsRegisterInt();
-
-            phi::i32 value = processor.IntRegisterGetSignedValue(src_reg.register_id);
-
-            phi::boolean success =
-                    processor.GetMemory().StoreHalfWord(static_cast<phi::size_t>(address.unsafe()),
-                                                        static_cast<phi::int16_t>(value.unsafe()));
-
-            if (!success)
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to store half word at address {}", address.unsafe());
-            }
+            StoreToMemory(processor, instruction, value);
         }
 
-        void SHU(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SHU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            auto optional_address = GetLoadStoreAddress(processor, arg1);
+            const phi::uint16_t value = static_cast<phi::uint16_t>(
+                    processor.IntRegisterGetUnsignedValue(instruction.GetIntRegister(1u)).unsafe());
 
-            if (!optional_address.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
-            }
-
-            phi::i32 address = optional_address.value();
-
-            const auto& src_reg = arg2.AsRegisterInt();
-
-            phi::u32 value = processor.IntRegisterGetUnsignedValue(src_reg.register_id);
-
-            phi::boolean success = processor.GetMemory().StoreUnsignedHalfWord(
-                    static_cast<phi::size_t>(address.unsafe()),
-                    static_cast<phi::uint16_t>(value.unsafe()));
-
-            if (!success)
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to store unsigned half word at address {}", address.unsafe());
-            }
+            StoreToMemory(processor, instruction, value);
         }
 
-        void SW(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SW(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            auto optional_address = GetLoadStoreAddress(processor, arg1);
-
-            if (!optional_address.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
-            }
+            const phi::int32_t value = processor.IntRegisterGetSignedValue(instruction.GetIntRegister(1u)).unsafe();
 
-            phi::i32 address = optional_address.value();
-
-            const auto& src_reg = arg2.AsRegisterInt();
-
-            phi::i32 value = processor.IntRegisterGetSignedValue(src_reg.register_id);
-
-            phi::boolean success = processor.GetMemory().StoreWord(
-                    static_cast<phi::size_t>(address.unsafe()), value);
-
-            if (!success)
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to store word at address {}", address.unsafe());
-            }
+            StoreToMemory(processor, instruction, value);
         }
 
-        void SWU(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SWU(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            auto optional_address = GetLoadStoreAddress(processor, arg1);
-
-            if (!optional_address.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
-            }
-
-            phi::i32 address = optional_address.value();
-
-            const auto& src_reg = arg2.AsRegisterInt();
-
-            phi::u32 value = processor.IntRegisterGetUnsignedValue(src_reg.register_id);
+            const phi::uint32_t value = processor.IntRegisterGetUnsignedValue(instruction.GetIntRegister(1u)).unsafe();
 
-            phi::boolean success = processor.GetMemory().StoreUnsignedWord(
-                    static_cast<phi::size_t>(address.unsafe()), value);
-
-            if (!success)
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to store unsigned word at address {}", address.unsafe());
-            }
+            StoreToMemory(processor, instruction, value);
         }
 
-        void SF(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            auto optional_address = GetLoadStoreAddress(processor, arg1);
-
-            if (!optional_address.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
-            }
+            const float value = processor.FloatRegisterGetFloatValue(instruction.GetFloatRegister(1u)).unsafe();
 
-            phi::i32 address = optional_address.value();
-
-            const auto& src_reg = arg2.AsRegisterFloat();
-
-            phi::f32 value = processor.FloatRegisterGetFloatValue(src_reg.register_id);
-
-            phi::boolean success = processor.GetMemory().StoreFloat(
-                    static_cast<phi::size_t>(address.unsafe()), value);
-
-            if (!success)
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to store float at address {}", address.unsafe());
-            }
+            StoreToMemory(processor, instruction, value);
         }
 
-        void SD(Processor& processor, const InstructionArgument& arg1,
-                const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void SD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            auto optional_address = GetLoadStoreAddress(processor, arg1);
+            const double value = processor.FloatRegisterGetDoubleValue(instruction.GetFloatRegister(1u)).unsafe();
 
-            if (!optional_address.has_value())
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                return;
-            }
-
-            phi::i32 address = optional_address.value();
-
-            const auto& src_reg = arg2.AsRegisterFloat();
-
-            phi::f64 value = processor.FloatRegisterGetDoubleValue(src_reg.register_id);
-
-            phi::boolean success = processor.GetMemory().StoreDouble(
-                    static_cast<phi::size_t>(address.unsafe()), value);
-
-            if (!success)
-            {
-                processor.Raise(Exception::AddressOutOfBounds);
-                DLX_ERROR("Failed to store float at address {}", address.unsafe());
-            }
+            StoreToMemory(processor, instruction, value);
         }
 
-        void MOVF(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void MOVF(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID dest_reg   = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID source_reg = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg   = instruction.GetFloatRegister(0u);
+            const FloatRegisterID source_reg = instruction.GetFloatRegister(1u);
 
             const phi::f32 source_value = processor.FloatRegisterGetFloatValue(source_reg);
 
             processor.FloatRegisterSetFloatValue(dest_reg, source_value);
         }
 
-        void MOVD(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void MOVD(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID dest_reg   = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID source_reg = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg   = instruction.GetFloatRegister(0u);
+            const FloatRegisterID source_reg = instruction.GetFloatRegister(1u);
 
             const phi::f64 source_value = processor.FloatRegisterGetDoubleValue(source_reg);
 
             processor.FloatRegisterSetDoubleValue(dest_reg, source_value);
         }
 
-        void MOVFP2I(Processor& processor, const InstructionArgument& arg1,
-                     const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void MOVFP2I(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const IntRegisterID   dest_reg   = arg1.AsRegisterInt().register_id;
-            const FloatRegisterID source_reg = arg2.AsRegisterFloat().register_id;
+            const IntRegisterID   dest_reg   = instruction.GetIntRegister(0u);
+            const FloatRegisterID source_reg = instruction.GetFloatRegister(1u);
 
             const float source_value = processor.FloatRegisterGetFloatValue(source_reg).unsafe();
 
@@ -1968,11 +1768,11 @@ namespace dlx
             processor.IntRegisterSetSignedValue(dest_reg, moved_value);
         }
 
-        void MOVI2FP(Processor& processor, const InstructionArgument& arg1,
-                     const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void MOVI2FP(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID dest_reg   = arg1.AsRegisterFloat().register_id;
-            const IntRegisterID   source_reg = arg2.AsRegisterInt().register_id;
+            const FloatRegisterID dest_reg   = instruction.GetFloatRegister(0u);
+            const IntRegisterID   source_reg = instruction.GetIntRegister(1u);
 
             const phi::int32_t source_value =
                     processor.IntRegisterGetSignedValue(source_reg).unsafe();
@@ -1982,22 +1782,22 @@ namespace dlx
             processor.FloatRegisterSetFloatValue(dest_reg, moved_value);
         }
 
-        void CVTF2D(Processor& processor, const InstructionArgument& arg1,
-                    const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void CVTF2D(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID dest_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID src_reg  = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID src_reg  = instruction.GetFloatRegister(1u);
 
             const phi::f32 src_value = processor.FloatRegisterGetFloatValue(src_reg);
 
             processor.FloatRegisterSetDoubleValue(dest_reg, src_value);
         }
 
-        void CVTF2I(Processor& processor, const InstructionArgument& arg1,
-                    const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void CVTF2I(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID dest_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID src_reg  = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID src_reg  = instruction.GetFloatRegister(1u);
 
             const float        src_value = processor.FloatRegisterGetFloatValue(src_reg).unsafe();
             const phi::int32_t converted_value_int = static_cast<phi::int32_t>(src_value);
@@ -2007,11 +1807,11 @@ namespace dlx
             processor.FloatRegisterSetFloatValue(dest_reg, converted_value_float);
         }
 
-        void CVTD2F(Processor& processor, const InstructionArgument& arg1,
-                    const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void CVTD2F(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID dest_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID src_reg  = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID src_reg  = instruction.GetFloatRegister(1u);
 
             const double src_value       = processor.FloatRegisterGetDoubleValue(src_reg).unsafe();
             const float  converted_value = static_cast<float>(src_value);
@@ -2019,11 +1819,11 @@ namespace dlx
             processor.FloatRegisterSetFloatValue(dest_reg, converted_value);
         }
 
-        void CVTD2I(Processor& processor, const InstructionArgument& arg1,
-                    const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void CVTD2I(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID dest_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID src_reg  = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID src_reg  = instruction.GetFloatRegister(1u);
 
             const double       src_value = processor.FloatRegisterGetDoubleValue(src_reg).unsafe();
             const phi::int32_t converted_value_int = static_cast<phi::int32_t>(src_value);
@@ -2033,11 +1833,11 @@ namespace dlx
             processor.FloatRegisterSetFloatValue(dest_reg, converted_value_float);
         }
 
-        void CVTI2F(Processor& processor, const InstructionArgument& arg1,
-                    const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void CVTI2F(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID dest_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID src_reg  = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID src_reg  = instruction.GetFloatRegister(1u);
 
             const float        src_value = processor.FloatRegisterGetFloatValue(src_reg).unsafe();
             const phi::int32_t converted_value_int =
@@ -2047,11 +1847,11 @@ namespace dlx
             processor.FloatRegisterSetFloatValue(dest_reg, converted_value_float);
         }
 
-        void CVTI2D(Processor& processor, const InstructionArgument& arg1,
-                    const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void CVTI2D(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
-            const FloatRegisterID dest_reg = arg1.AsRegisterFloat().register_id;
-            const FloatRegisterID src_reg  = arg2.AsRegisterFloat().register_id;
+            const FloatRegisterID dest_reg = instruction.GetFloatRegister(0u);
+            const FloatRegisterID src_reg  = instruction.GetFloatRegister(1u);
 
             const float        src_value = processor.FloatRegisterGetFloatValue(src_reg).unsafe();
             const phi::int32_t converted_value_int =
@@ -2061,22 +1861,39 @@ namespace dlx
             processor.FloatRegisterSetDoubleValue(dest_reg, converted_value_double);
         }
 
-        void TRAP(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void TRAP(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
             processor.Raise(Exception::Trap);
         }
 
-        void HALT(Processor& processor, const InstructionArgument& arg1,
-                  const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void HALT(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
             processor.Raise(Exception::Halt);
         }
 
-        void NOP(Processor& processor, const InstructionArgument& arg1,
-                 const InstructionArgument& arg2, const InstructionArgument& arg3) noexcept
+        template <typename ProcessorT>
+        void NOP(ProcessorT& processor, const DecodedInstruction& instruction) noexcept
         {
             /* Do nothing */
         }
+
+        // Instantiate every instruction for all processor policies with and without observing
+#define DLX_ENUM_OPCODE_IMPL(name)                                                                 \
+    template void name<Processor>(Processor& processor, const DecodedInstruction& instruction)     \
+            noexcept;                                                                              \
+    template void name<FastProcessor>(FastProcessor& processor,                                    \
+                                      const DecodedInstruction& instruction) noexcept;             \
+    template void name<ObservingProcessor<Processor>>(                                             \
+            ObservingProcessor<Processor>& processor, const DecodedInstruction& instruction)       \
+            noexcept;                                                                              \
+    template void name<ObservingProcessor<FastProcessor>>(                                         \
+            ObservingProcessor<FastProcessor>& processor, const DecodedInstruction& instruction)   \
+            noexcept;
+
+        DLX_ENUM_OPCODE
+
+#undef DLX_ENUM_OPCODE_IMPL
     } // namespace impl
 } // namespace dlx
@@ -0,0 +1,734 @@
+#include "DLX/JITCompiler.hpp"
+
+#include "DLX/DecodedProgram.hpp"
+#include "DLX/InstructionArgument.hpp"
+#include "DLX/IntRegister.hpp"
+#include "DLX/OpCode.hpp"
+#include "DLX/Processor.hpp"
+#include "DLX/RegisterNames.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+
+#if DLX_JIT_SUPPORTED
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+
+PHI_CLANG_SUPPRESS_WARNING("-Wswitch-enum")
+PHI_GCC_SUPPRESS_WARNING("-Wswitch-enum")
+
+namespace dlx
+{
+#if DLX_JIT_SUPPORTED
+    static constexpr phi::size_t   MinimumRegionSize = 64u * 1024u;
+    static constexpr phi::uint64_t HaltedFlag       = phi::uint64_t{1u} << 32u;
+
+    // Called from compiled code for every instruction which is not emitted natively. Returns the
+    // next program counter or HaltedFlag if the instruction halted the processor.
+    template <typename ProcessorT>
+    static phi::uint64_t jit_execute_instruction(void*                     processor_pointer,
+                                                 const DecodedInstruction* instruction,
+                                                 phi::uint32_t             program_counter) noexcept
+    {
+        ProcessorT& processor = *static_cast<ProcessorT*>(processor_pointer);
+
+        processor.SetNextProgramCounter(program_counter + 1u);
+        processor.ExecuteInstruction(*instruction);
+
+        if (processor.IsHalted())
+        {
+            return HaltedFlag;
+        }
+
+        return processor.GetNextProgramCounter().unsafe();
+    }
+
+    // Called from compiled code when a signed operation overflowed. Since the result wrapped
+    // around, a negative result means the exact value was too large.
+    template <typename ProcessorT>
+    static void jit_raise_signed_overflow(void* processor, phi::int32_t result) noexcept
+    {
+        static_cast<ProcessorT*>(processor)->Raise(result < 0 ? Exception::Overflow :
+                                                                Exception::Underflow);
+    }
+
+    template <typename ProcessorT>
+    static void jit_raise(void* processor, phi::uint32_t exception) noexcept
+    {
+        static_cast<ProcessorT*>(processor)->Raise(static_cast<Exception>(exception));
+    }
+
+    // Minimal x86-64 machine code emitter. The compiled blocks use the following registers:
+    //   rbx - IntRegister array
+    //   r12 - IntRegisterValueType array
+    //   r13 - Processor
+    //   r14 - DecodedInstruction array
+    // eax and ecx hold the operands of the current instruction.
+    class Emitter
+    {
+    public:
+        static_assert(sizeof(IntRegisterValueType) == 4u);
+        static_assert(sizeof(phi::boolean) == 1u);
+
+        // Addresses of the helper functions for the processor type being compiled for
+        struct Helpers
+        {
+            phi::uint64_t execute_instruction;
+            phi::uint64_t raise_signed_overflow;
+            phi::uint64_t raise;
+        };
+
+        Emitter(std::vector<phi::uint8_t>& code, const Helpers& helpers, phi::size_t value_offset,
+                phi::size_t read_only_offset, phi::boolean track_value_types) noexcept
+            : m_Code{code}
+            , m_Helpers{helpers}
+            , m_ValueOffset{value_offset}
+            , m_ReadOnlyOffset{read_only_offset}
+            , m_TrackValueTypes{track_value_types}
+        {}
+
+        [[nodiscard]] const Helpers& GetHelpers() const noexcept
+        {
+            return m_Helpers;
+        }
+
+        void Bytes(std::initializer_list<phi::uint8_t> bytes) noexcept
+        {
+            m_Code.insert(m_Code.end(), bytes.begin(), bytes.end());
+        }
+
+        void Imm32(phi::uint32_t value) noexcept
+        {
+            for (phi::size_t index{0u}; index < 4u; ++index)
+            {
+                m_Code.push_back(static_cast<phi::uint8_t>(value >> (index * 8u)));
+            }
+        }
+
+        void Imm64(phi::uint64_t value) noexcept
+        {
+            for (phi::size_t index{0u}; index < 8u; ++index)
+            {
+                m_Code.push_back(static_cast<phi::uint8_t>(value >> (index * 8u)));
+            }
+        }
+
+        void Prologue() noexcept
+        {
+            // push rbx, r12, r13, r14 and keep the stack 16 byte aligned with one spill slot
+            Bytes({0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56});
+            Bytes({0x48, 0x83, 0xEC, 0x08});
+
+            // mov rbx, rsi; mov r12, rdx; mov r13, rdi; mov r14, rcx
+            Bytes({0x48, 0x89, 0xF3});
+            Bytes({0x49, 0x89, 0xD4});
+            Bytes({0x49, 0x89, 0xFD});
+            Bytes({0x49, 0x89, 0xCE});
+        }
+
+        // Returns rax
+        void Epilogue() noexcept
+        {
+            Bytes({0x48, 0x83, 0xC4, 0x08});
+            Bytes({0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5B, 0xC3});
+        }
+
+        void Return(phi::uint32_t executed, phi::uint32_t program_counter) noexcept
+        {
+            // mov rax, imm64
+            Bytes({0x48, 0xB8});
+            Imm64((phi::uint64_t{executed} << 32u) | program_counter);
+            Epilogue();
+        }
+
+        // Returns with the program counter already in eax
+        void ReturnEax(phi::uint32_t executed) noexcept
+        {
+            // mov rdx, imm64; or rax, rdx
+            Bytes({0x48, 0xBA});
+            Imm64(phi::uint64_t{executed} << 32u);
+            Bytes({0x48, 0x09, 0xD0});
+            Epilogue();
+        }
+
+        void LoadEax(IntRegisterID id) noexcept
+        {
+            // mov eax, [rbx + disp32]
+            Bytes({0x8B, 0x83});
+            Imm32(ValueOffset(id));
+        }
+
+        void LoadEcx(IntRegisterID id) noexcept
+        {
+            // mov ecx, [rbx + disp32]
+            Bytes({0x8B, 0x8B});
+            Imm32(ValueOffset(id));
+        }
+
+        void MovEaxImm(phi::uint32_t value) noexcept
+        {
+            Bytes({0xB8});
+            Imm32(value);
+        }
+
+        void MovEcxImm(phi::uint32_t value) noexcept
+        {
+            Bytes({0xB9});
+            Imm32(value);
+        }
+
+        // opcode is the 'op r/m32, r32' encoding, e.g. 0x01 for add
+        void AluEaxEcx(phi::uint8_t opcode) noexcept
+        {
+            Bytes({opcode, 0xC8});
+        }
+
+        // opcode is the 'op eax, imm32' encoding, e.g. 0x05 for add
+        void AluEaxImm(phi::uint8_t opcode, phi::uint32_t value) noexcept
+        {
+            Bytes({opcode});
+            Imm32(value);
+        }
+
+        void SetLessEax() noexcept
+        {
+            // setl al; movzx eax, al
+            Bytes({0x0F, 0x9C, 0xC0, 0x0F, 0xB6, 0xC0});
+        }
+
+        // Emits a short conditional jump and returns the position to patch
+        [[nodiscard]] phi::size_t Jump8(phi::uint8_t opcode) noexcept
+        {
+            Bytes({opcode, 0x00});
+            return m_Code.size();
+        }
+
+        void Bind8(phi::size_t position) noexcept
+        {
+            const phi::size_t distance = m_Code.size() - position;
+            PHI_ASSERT(distance <= 127u);
+
+            m_Code[position - 1u] = static_cast<phi::uint8_t>(distance);
+        }
+
+        void CallHelper(phi::uint64_t function) noexcept
+        {
+            // mov rax, imm64; call rax
+            Bytes({0x48, 0xB8});
+            Imm64(function);
+            Bytes({0xFF, 0xD0});
+        }
+
+        // Calls the helper with the processor and the current result which is preserved
+        void CallRaiseHelper(phi::uint64_t function, phi::uint32_t argument,
+                             phi::boolean pass_result) noexcept
+        {
+            // mov [rsp], eax; mov rdi, r13
+            Bytes({0x89, 0x04, 0x24});
+            Bytes({0x4C, 0x89, 0xEF});
+
+            if (pass_result)
+            {
+                // mov esi, eax
+                Bytes({0x89, 0xC6});
+            }
+            else
+            {
+                // mov esi, imm32
+                Bytes({0xBE});
+                Imm32(argument);
+            }
+
+            CallHelper(function);
+
+            // mov eax, [rsp]
+            Bytes({0x8B, 0x04, 0x24});
+        }
+
+        // Writes eax into the register unless it is read only, like Processor::IntRegisterSet*
+        void StoreEax(IntRegisterID id, IntRegisterValueType value_type) noexcept
+        {
+            // cmp byte [rbx + disp32], 0
+            Bytes({0x80, 0xBB});
+            Imm32(ReadOnlyOffset(id));
+            Bytes({0x00});
+
+            const phi::size_t skip = Jump8(0x75);
+
+            // mov [rbx + disp32], eax
+            Bytes({0x89, 0x83});
+            Imm32(ValueOffset(id));
+
+            if (m_TrackValueTypes)
+            {
+                // mov dword [r12 + disp32], imm32
+                Bytes({0x41, 0xC7, 0x84, 0x24});
+                Imm32(static_cast<phi::uint32_t>(static_cast<phi::size_t>(id) *
+                                                 sizeof(IntRegisterValueType)));
+                Imm32(static_cast<phi::uint32_t>(value_type));
+            }
+
+            Bind8(skip);
+        }
+
+        void CompareZero(IntRegisterID id) noexcept
+        {
+            // cmp dword [rbx + disp32], 0
+            Bytes({0x83, 0xBB});
+            Imm32(ValueOffset(id));
+            Bytes({0x00});
+        }
+
+        void ExecuteFallback(phi::uint32_t index, phi::uint32_t program_counter) noexcept
+        {
+            // mov rdi, r13; lea rsi, [r14 + disp32]; mov edx, imm32
+            Bytes({0x4C, 0x89, 0xEF});
+            Bytes({0x49, 0x8D, 0xB6});
+            Imm32(static_cast<phi::uint32_t>(program_counter * sizeof(DecodedInstruction)));
+            Bytes({0xBA});
+            Imm32(program_counter);
+
+            CallHelper(m_Helpers.execute_instruction);
+
+            // mov rcx, rax; shr rcx, 32; jz continue
+            Bytes({0x48, 0x89, 0xC1});
+            Bytes({0x48, 0xC1, 0xE9, 0x20});
+            const phi::size_t not_halted = Jump8(0x74);
+
+            // The halting instruction is not counted and the program counter stays on it
+            Return(index, program_counter);
+
+            Bind8(not_halted);
+        }
+
+    private:
+        [[nodiscard]] phi::uint32_t ValueOffset(IntRegisterID id) const noexcept
+        {
+            return static_cast<phi::uint32_t>(static_cast<phi::size_t>(id) * sizeof(IntRegister) +
+                                              m_ValueOffset);
+        }
+
+        [[nodiscard]] phi::uint32_t ReadOnlyOffset(IntRegisterID id) const noexcept
+        {
+            return static_cast<phi::uint32_t>(static_cast<phi::size_t>(id) * sizeof(IntRegister) +
+                                              m_ReadOnlyOffset);
+        }
+
+        std::vector<phi::uint8_t>& m_Code;
+        Helpers                    m_Helpers;
+        phi::size_t                m_ValueOffset;
+        phi::size_t                m_ReadOnlyOffset;
+        phi::boolean               m_TrackValueTypes;
+    };
+
+    enum class OverflowCheck
+    {
+        None,
+        Signed,
+        UnsignedCarry,
+        UnsignedBorrow,
+    };
+
+    struct NativeOperation
+    {
+        phi::uint8_t         register_opcode;
+        phi::uint8_t         immediate_opcode;
+        OverflowCheck        overflow_check;
+        IntRegisterValueType value_type;
+    };
+
+    static void emit_overflow_check(Emitter& emitter, OverflowCheck check) noexcept
+    {
+        switch (check)
+        {
+            case OverflowCheck::None:
+                return;
+
+            case OverflowCheck::Signed: {
+                // jno
+                const phi::size_t no_overflow = emitter.Jump8(0x71);
+                emitter.CallRaiseHelper(emitter.GetHelpers().raise_signed_overflow, 0u, true);
+                emitter.Bind8(no_overflow);
+                return;
+            }
+
+            case OverflowCheck::UnsignedCarry:
+            case OverflowCheck::UnsignedBorrow: {
+                const Exception exception = check == OverflowCheck::UnsignedCarry ?
+                                                    Exception::Overflow :
+                                                    Exception::Underflow;
+
+                // jnc
+                const phi::size_t no_carry = emitter.Jump8(0x73);
+                emitter.CallRaiseHelper(emitter.GetHelpers().raise,
+                                        static_cast<phi::uint32_t>(exception), false);
+                emitter.Bind8(no_carry);
+                return;
+            }
+
+#if !defined(DLXEMU_COVERAGE_BUILD)
+            default:
+                PHI_ASSERT_NOT_REACHED();
+#endif
+        }
+    }
+
+    // Emits the instruction natively if possible. Returns false if the executor has to be used.
+    static phi::boolean emit_native(Emitter&                  emitter,
+                                    const DecodedInstruction& instruction) noexcept
+    {
+        // ADD r/m32, r32 = 0x01, OR = 0x09, AND = 0x21, SUB = 0x29, XOR = 0x31, CMP = 0x39
+        NativeOperation operation{};
+        phi::boolean    is_immediate{false};
+        phi::boolean    is_set_less{false};
+        phi::uint32_t   immediate = static_cast<phi::uint32_t>(instruction.immediate);
+
+        switch (instruction.opcode)
+        {
+            case OpCode::NOP:
+                return true;
+
+            case OpCode::LHI:
+                emitter.MovEaxImm(static_cast<phi::uint32_t>(instruction.immediate) << 16u);
+                emitter.StoreEax(instruction.GetIntRegister(0u), IntRegisterValueType::Signed);
+                return true;
+
+            case OpCode::ADDI:
+                is_immediate = true;
+                [[fallthrough]];
+            case OpCode::ADD:
+                operation = {0x01, 0x05, OverflowCheck::Signed, IntRegisterValueType::Signed};
+                break;
+
+            case OpCode::SUBI:
+                is_immediate = true;
+                [[fallthrough]];
+            case OpCode::SUB:
+                operation = {0x29, 0x2D, OverflowCheck::Signed, IntRegisterValueType::Signed};
+                break;
+
+            case OpCode::ADDUI:
+                is_immediate = true;
+                immediate    = instruction.GetUnsignedImmediate().unsafe();
+                [[fallthrough]];
+            case OpCode::ADDU:
+                operation = {0x01, 0x05, OverflowCheck::UnsignedCarry,
+                             IntRegisterValueType::Unsigned};
+                break;
+
+            case OpCode::SUBUI:
+                is_immediate = true;
+                immediate    = instruction.GetUnsignedImmediate().unsafe();
+                [[fallthrough]];
+            case OpCode::SUBU:
+                operation = {0x29, 0x2D, OverflowCheck::UnsignedBorrow,
+                             IntRegisterValueType::Unsigned};
+                break;
+
+            case OpCode::ANDI:
+                is_immediate = true;
+                [[fallthrough]];
+            case OpCode::AND:
+                operation = {0x21, 0x25, OverflowCheck::None, IntRegisterValueType::Signed};
+                break;
+
+            case OpCode::ORI:
+                is_immediate = true;
+                [[fallthrough]];
+            case OpCode::OR:
+                operation = {0x09, 0x0D, OverflowCheck::None, IntRegisterValueType::Signed};
+                break;
+
+            case OpCode::XORI:
+                is_immediate = true;
+                [[fallthrough]];
+            case OpCode::XOR:
+                operation = {0x31, 0x35, OverflowCheck::None, IntRegisterValueType::Signed};
+                break;
+
+            case OpCode::SLTI:
+                is_immediate = true;
+                [[fallthrough]];
+            case OpCode::SLT:
+                operation   = {0x39, 0x3D, OverflowCheck::None, IntRegisterValueType::Signed};
+                is_set_less = true;
+                break;
+
+            default:
+                return false;
+        }
+
+        emitter.LoadEax(instruction.GetIntRegister(1u));
+
+        if (is_immediate)
+        {
+            emitter.AluEaxImm(operation.immediate_opcode, immediate);
+        }
+        else
+        {
+            emitter.LoadEcx(instruction.GetIntRegister(2u));
+            emitter.AluEaxEcx(operation.register_opcode);
+        }
+
+        if (is_set_less)
+        {
+            emitter.SetLessEax();
+        }
+
+        emit_overflow_check(emitter, operation.overflow_check);
+
+        emitter.StoreEax(instruction.GetIntRegister(0u), operation.value_type);
+
+        return true;
+    }
+
+    // Emits a branch ending the block natively leaving the next program counter in eax. Returns
+    // false if the executor has to be used.
+    static phi::boolean emit_native_branch(Emitter& emitter, const DecodedInstruction& instruction,
+                                           phi::uint32_t program_counter) noexcept
+    {
+        // Unknown labels need to be raised by the executor
+        if (instruction.jump_point == InstructionArgument::Label::UnresolvedJumpPoint)
+        {
+            return false;
+        }
+
+        switch (instruction.opcode)
+        {
+            case OpCode::J:
+                emitter.MovEaxImm(instruction.jump_point);
+                return true;
+
+            case OpCode::BEQZ:
+            case OpCode::BNEZ:
+                emitter.MovEaxImm(program_counter + 1u);
+                emitter.MovEcxImm(instruction.jump_point);
+                emitter.CompareZero(instruction.GetIntRegister(0u));
+
+                // cmove eax, ecx or cmovne eax, ecx
+                emitter.Bytes({0x0F, instruction.opcode == OpCode::BEQZ ? phi::uint8_t{0x44} :
+                                                                         phi::uint8_t{0x45},
+                               0xC1});
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    JITCompiler::~JITCompiler() noexcept
+    {
+        ReleaseRegions();
+    }
+
+    void JITCompiler::Reset(phi::size_t number_of_instructions) noexcept
+    {
+        ReleaseRegions();
+
+        m_Blocks.assign(number_of_instructions, nullptr);
+        m_NumberOfCompiledBlocks = 0u;
+    }
+
+    template <typename ProcessorT>
+    JITCompiler::CompiledBlock JITCompiler::GetOrCompileBlock(const DecodedProgram& program,
+                                                              phi::uint32_t         start) noexcept
+    {
+        PHI_ASSERT(m_Blocks.size() == program.m_Instructions.size(),
+                   "JITCompiler was not reset for the current program");
+        PHI_ASSERT(start < m_Blocks.size());
+
+        if (m_Blocks[start] != nullptr || m_Disabled)
+        {
+            return m_Blocks[start];
+        }
+
+        const phi::uint32_t end = program.m_BlockEnds[start];
+
+        static_assert(std::is_standard_layout_v<IntRegister>);
+        constexpr phi::size_t value_offset     = offsetof(IntRegister, m_ValueSigned);
+        constexpr phi::size_t read_only_offset = offsetof(IntRegister, m_IsReadOnly);
+
+        const Emitter::Helpers helpers{
+                reinterpret_cast<phi::uint64_t>(&jit_execute_instruction<ProcessorT>),
+                reinterpret_cast<phi::uint64_t>(&jit_raise_signed_overflow<ProcessorT>),
+                reinterpret_cast<phi::uint64_t>(&jit_raise<ProcessorT>)};
+
+        std::vector<phi::uint8_t> code;
+        Emitter emitter{code, helpers, value_offset, read_only_offset,
+                        ProcessorT::Policy::TrackRegisterValueTypes};
+
+        emitter.Prologue();
+
+        for (phi::uint32_t program_counter = start; program_counter <= end; ++program_counter)
+        {
+            const DecodedInstruction& instruction = program.m_Instructions[program_counter];
+            const phi::uint32_t       index       = program_counter - start;
+            const phi::uint32_t       executed    = index + 1u;
+
+            if (IsControlTransferInstruction(instruction.opcode))
+            {
+                PHI_ASSERT(program_counter == end);
+
+                if (!emit_native_branch(emitter, instruction, program_counter))
+                {
+                    // The executor returns the next program counter in eax
+                    emitter.ExecuteFallback(index, program_counter);
+                }
+
+                emitter.ReturnEax(executed);
+                break;
+            }
+
+            if (!emit_native(emitter, instruction))
+            {
+                emitter.ExecuteFallback(index, program_counter);
+            }
+
+            if (program_counter == end)
+            {
+                emitter.Return(executed, program_counter + 1u);
+            }
+        }
+
+        void* installed = Install(code);
+        if (installed == nullptr)
+        {
+            return nullptr;
+        }
+
+        m_Blocks[start] = reinterpret_cast<CompiledBlock>(installed);
+        ++m_NumberOfCompiledBlocks;
+
+        return m_Blocks[start];
+    }
+
+    void* JITCompiler::Install(const std::vector<phi::uint8_t>& code) noexcept
+    {
+        const phi::size_t page_size = static_cast<phi::size_t>(sysconf(_SC_PAGESIZE));
+
+        if (m_Regions.empty() || m_Regions.back().size - m_Regions.back().used < code.size())
+        {
+            const phi::size_t size =
+                    ((std::max(MinimumRegionSize, code.size()) + page_size - 1u) / page_size) *
+                    page_size;
+
+            void* data = mmap(nullptr, size, PROT_READ | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS,
+                              -1, 0);
+            if (data == MAP_FAILED)
+            {
+                return nullptr;
+            }
+
+            m_Regions.push_back(CodeRegion{static_cast<phi::uint8_t*>(data), size, 0u});
+        }
+
+        CodeRegion& region = m_Regions.back();
+
+        // Only the pages the code is copied to become writable while the blocks compiled before
+        // stay executable. Never keep a page writable and executable at the same time.
+        const phi::size_t pages_begin = region.used / page_size * page_size;
+        const phi::size_t pages_end =
+                (region.used + code.size() + page_size - 1u) / page_size * page_size;
+
+        phi::uint8_t*     pages       = region.data + pages_begin;
+        const phi::size_t pages_size  = pages_end - pages_begin;
+        phi::uint8_t*     destination = region.data + region.used;
+
+        if (mprotect(pages, pages_size, PROT_READ | PROT_WRITE) != 0)
+        {
+            DisableAfterFailure();
+            return nullptr;
+        }
+
+        std::memcpy(destination, code.data(), code.size());
+        region.used += code.size();
+
+        if (mprotect(pages, pages_size, PROT_READ | PROT_EXEC) != 0)
+        {
+            DisableAfterFailure();
+            return nullptr;
+        }
+
+        return destination;
+    }
+
+    void JITCompiler::DisableAfterFailure() noexcept
+    {
+        // The pages of the last region may be left writable or not executable so neither it nor
+        // the blocks compiled into it can be used anymore
+        const CodeRegion& region = m_Regions.back();
+
+        for (CompiledBlock& block : m_Blocks)
+        {
+            const phi::uint8_t* code = reinterpret_cast<const phi::uint8_t*>(block);
+            if (code >= region.data && code < region.data + region.size)
+            {
+                block = nullptr;
+                --m_NumberOfCompiledBlocks;
+            }
+        }
+
+        munmap(region.data, region.size);
+        m_Regions.pop_back();
+
+        m_Disabled = true;
+    }
+
+    void JITCompiler::ReleaseRegions() noexcept
+    {
+        for (const CodeRegion& region : m_Regions)
+        {
+            munmap(region.data, region.size);
+        }
+
+        m_Regions.clear();
+    }
+#else
+    JITCompiler::~JITCompiler() noexcept = default;
+
+    void JITCompiler::Reset(phi::size_t number_of_instructions) noexcept
+    {
+        m_Blocks.assign(number_of_instructions, nullptr);
+    }
+
+    template <typename ProcessorT>
+    JITCompiler::CompiledBlock JITCompiler::GetOrCompileBlock(const DecodedProgram& /*program*/,
+                                                              phi::uint32_t /*start*/) noexcept
+    {
+        return nullptr;
+    }
+
+    void* JITCompiler::Install(const std::vector<phi::uint8_t>& /*code*/) noexcept
+    {
+        return nullptr;
+    }
+
+    void JITCompiler::DisableAfterFailure() noexcept
+    {
+        m_Disabled = true;
+    }
+
+    void JITCompiler::ReleaseRegions() noexcept
+    {}
+#endif
+
+    template JITCompiler::CompiledBlock JITCompiler::GetOrCompileBlock<Processor>(
+            const DecodedProgram& program, phi::uint32_t start) noexcept;
+    template JITCompiler::CompiledBlock JITCompiler::GetOrCompileBlock<FastProcessor>(
+            const DecodedProgram& program, phi::uint32_t start) noexcept;
+
+    phi::usize JITCompiler::GetNumberOfCompiledBlocks() const noexcept
+    {
+        return m_NumberOfCompiledBlocks;
+    }
+
+    phi::boolean JITCompiler::IsDisabled() const noexcept
+    {
+        return m_Disabled;
+    }
+} // namespace dlx
@@ -2,337 +2,770 @@
 
 #include "DLX/Logger.hpp"
 #include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
 #include <phi/core/integer.hpp>
+#include <phi/core/move.hpp>
 #include <phi/core/types.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <memory>
 
 namespace dlx
 {
+    static constexpr const phi::size_t BitsPerWord{64u};
+
+    static constexpr const phi::uint32_t InvalidPageNumber{~0u};
+
+    [[nodiscard]] static constexpr phi::size_t number_of_pages(phi::size_t size) noexcept
+    {
+        return (size + MemoryBlock::PageSize - 1u) / MemoryBlock::PageSize;
+    }
+
     MemoryBlock::MemoryBlock(phi::usize start_address, phi::usize starting_size) noexcept
         : m_StartingAddress(start_address)
     {
-        m_Values.resize(starting_size.unsafe());
+        Resize(starting_size);
     }
 
-    phi::optional<phi::i8> MemoryBlock::LoadByte(phi::usize address) const noexcept
+    MemoryBlock::MemoryBlock(const MemoryBlock& other) noexcept
+        : m_StartingAddress(other.m_StartingAddress)
+    {
+        *this = other;
+    }
+
+    MemoryBlock& MemoryBlock::operator=(const MemoryBlock& other) noexcept
     {
-        if (!IsAddressValid(address, 1u))
+        if (this == &other)
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
-            return {};
+            return *this;
         }
 
-        const phi::size_t raw_address = (address - m_StartingAddress).unsafe();
+        if (other.m_Guarded && !m_GuardedRegion.CopyFrom(other.m_GuardedRegion))
+        {
+            DLX_WARN("Failed to reserve guarded memory for a copy, falling back to unguarded "
+                     "memory");
+
+            m_Values.resize(other.m_GuardedRegion.GetSize());
+            if (!m_Values.empty())
+            {
+                std::memcpy(&m_Values.front().signed_value, other.m_GuardedRegion.GetData(),
+                            m_Values.size());
+            }
+
+            m_GuardedRegion       = GuardedRegion{};
+            m_Guarded             = false;
+            m_RequiresFullRestore = true;
+        }
+        else
+        {
+            if (!other.m_Guarded)
+            {
+                m_GuardedRegion = GuardedRegion{};
+            }
+
+            m_Values              = other.m_Values;
+            m_Guarded             = other.m_Guarded;
+            m_RequiresFullRestore = other.m_RequiresFullRestore;
+        }
 
-        return m_Values[raw_address].signed_value;
+        m_StartingAddress = other.m_StartingAddress;
+        m_DirtyPages      = other.m_DirtyPages;
+        m_Paged           = other.m_Paged;
+        m_Pages           = other.m_Pages;
+        m_PageDirectory   = other.m_PageDirectory;
+        m_PageTables      = other.m_PageTables;
+        m_TLBPageNumber   = other.m_TLBPageNumber;
+        m_TLBPage         = other.m_TLBPage;
+
+        return *this;
     }
 
-    phi::optional<phi::u8> MemoryBlock::LoadUnsignedByte(phi::usize address) const noexcept
+    template <typename T>
+    MemoryAccessResult MemoryBlock::CheckedLoad(phi::usize address, T& value) const noexcept
     {
-        if (!IsAddressValid(address, 1u))
+        // Guarded memory relies on the fault handler which is only active while executing
+        if (m_Guarded && !IsAddressValid(address, sizeof(T)))
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
-            return {};
+            return MemoryAccessResult::OutOfBounds;
         }
 
-        const phi::size_t raw_address = (address - m_StartingAddress).unsafe();
-        return m_Values[raw_address].unsigned_value;
+        return Load(address.unsafe(), value);
     }
 
-    phi::optional<phi::i16> MemoryBlock::LoadHalfWord(phi::usize address) const noexcept
+    template <typename T>
+    MemoryAccessResult MemoryBlock::CheckedStore(phi::usize address, T value) noexcept
     {
-        if (!IsAddressValid(address, 2u))
+        if (m_Guarded && !IsAddressValid(address, sizeof(T)))
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
-            return {};
+            return MemoryAccessResult::OutOfBounds;
         }
 
-        const phi::size_t raw_address = (address - m_StartingAddress).unsafe();
+        return Store(address.unsafe(), value);
+    }
 
-        if (!IsAddressAlignedCorrectly(raw_address, 2u))
+    // Logs why an access failed
+    static phi::boolean CheckAccessResult(MemoryAccessResult result, phi::usize address) noexcept
+    {
+        switch (result)
         {
-            DLX_ERROR("Address {} is misaligned", address.unsafe());
-            return {};
+            case MemoryAccessResult::Success:
+                return true;
+            case MemoryAccessResult::OutOfBounds:
+                DLX_ERROR("Address {} is out of bounds", address.unsafe());
+                return false;
+            case MemoryAccessResult::Misaligned:
+                DLX_ERROR("Address {} is misaligned", address.unsafe());
+                return false;
         }
 
-        return *reinterpret_cast<const phi::int16_t*>(&m_Values[raw_address].signed_value);
+        return false;
     }
 
-    phi::optional<phi::u16> MemoryBlock::LoadUnsignedHalfWord(phi::usize address) const noexcept
+    phi::optional<phi::i8> MemoryBlock::LoadByte(phi::usize address) const noexcept
     {
-        if (!IsAddressValid(address, 2u))
+        phi::int8_t value;
+        if (!CheckAccessResult(CheckedLoad(address, value), address))
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
             return {};
         }
 
-        const phi::size_t raw_address = (address - m_StartingAddress).unsafe();
+        return value;
+    }
 
-        if (!IsAddressAlignedCorrectly(raw_address, 2u))
+    phi::optional<phi::u8> MemoryBlock::LoadUnsignedByte(phi::usize address) const noexcept
+    {
+        phi::uint8_t value;
+        if (!CheckAccessResult(CheckedLoad(address, value), address))
         {
-            DLX_ERROR("Address {} is misaligned", address.unsafe());
             return {};
         }
 
-        return *reinterpret_cast<const phi::uint16_t*>(&m_Values[raw_address].unsigned_value);
+        return value;
     }
 
-    phi::optional<phi::i32> MemoryBlock::LoadWord(phi::usize address) const noexcept
+    phi::optional<phi::i16> MemoryBlock::LoadHalfWord(phi::usize address) const noexcept
     {
-        if (!IsAddressValid(address, 4u))
+        phi::int16_t value;
+        if (!CheckAccessResult(CheckedLoad(address, value), address))
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
             return {};
         }
 
-        const phi::size_t raw_address = (address - m_StartingAddress).unsafe();
+        return value;
+    }
 
-        if (!IsAddressAlignedCorrectly(raw_address, 4u))
+    phi::optional<phi::u16> MemoryBlock::LoadUnsignedHalfWord(phi::usize address) const noexcept
+    {
+        phi::uint16_t value;
+        if (!CheckAccessResult(CheckedLoad(address, value), address))
         {
-            DLX_ERROR("Address {} is misaligned", address.unsafe());
             return {};
         }
 
-        return *reinterpret_cast<const phi::int32_t*>(&m_Values[raw_address].signed_value);
+        return value;
     }
 
-    phi::optional<phi::u32> MemoryBlock::LoadUnsignedWord(phi::usize address) const noexcept
+    phi::optional<phi::i32> MemoryBlock::LoadWord(phi::usize address) const noexcept
     {
-        if (!IsAddressValid(address, 4u))
+        phi::int32_t value;
+        if (!CheckAccessResult(CheckedLoad(address, value), address))
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
             return {};
         }
 
-        const phi::size_t raw_address = (address - m_StartingAddress).unsafe();
+        return value;
+    }
 
-        if (!IsAddressAlignedCorrectly(raw_address, 4u))
+    phi::optional<phi::u32> MemoryBlock::LoadUnsignedWord(phi::usize address) const noexcept
+    {
+        phi::uint32_t value;
+        if (!CheckAccessResult(CheckedLoad(address, value), address))
         {
-            DLX_ERROR("Address {} is misaligned", address.unsafe());
             return {};
         }
 
-        return *reinterpret_cast<const phi::uint32_t*>(&m_Values[raw_address].unsigned_value);
+        return value;
     }
 
     phi::optional<phi::f32> MemoryBlock::LoadFloat(phi::usize address) const noexcept
     {
-        if (!IsAddressValid(address, 4u))
+        float value;
+        if (!CheckAccessResult(CheckedLoad(address, value), address))
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
             return {};
         }
 
-        const phi::size_t raw_address = (address - m_StartingAddress).unsafe();
+        return value;
+    }
 
-        if (!IsAddressAlignedCorrectly(raw_address, sizeof(phi::f32)))
+    phi::optional<phi::f64> MemoryBlock::LoadDouble(phi::usize address) const noexcept
+    {
+        double value;
+        if (!CheckAccessResult(CheckedLoad(address, value), address))
         {
-            DLX_ERROR("Address {} is misaligned", address.unsafe());
             return {};
         }
 
-        return *reinterpret_cast<const float*>(&m_Values[raw_address].signed_value);
+        return value;
     }
 
-    phi::optional<phi::f64> MemoryBlock::LoadDouble(phi::usize address) const noexcept
+    phi::boolean MemoryBlock::StoreByte(phi::usize address, phi::i8 value) noexcept
+    {
+        return CheckAccessResult(CheckedStore(address, value.unsafe()), address);
+    }
+
+    phi::boolean MemoryBlock::StoreUnsignedByte(phi::usize address, phi::u8 value) noexcept
+    {
+        return CheckAccessResult(CheckedStore(address, value.unsafe()), address);
+    }
+
+    phi::boolean MemoryBlock::StoreHalfWord(phi::usize address, phi::i16 value) noexcept
+    {
+        return CheckAccessResult(CheckedStore(address, value.unsafe()), address);
+    }
+
+    phi::boolean MemoryBlock::StoreUnsignedHalfWord(phi::usize address, phi::u16 value) noexcept
     {
-        if (!IsAddressValid(address, 8u))
+        return CheckAccessResult(CheckedStore(address, value.unsafe()), address);
+    }
+
+    phi::boolean MemoryBlock::StoreWord(phi::usize address, phi::i32 value) noexcept
+    {
+        return CheckAccessResult(CheckedStore(address, value.unsafe()), address);
+    }
+
+    phi::boolean MemoryBlock::StoreUnsignedWord(phi::usize address, phi::u32 value) noexcept
+    {
+        return CheckAccessResult(CheckedStore(address, value.unsafe()), address);
+    }
+
+    phi::boolean MemoryBlock::StoreFloat(phi::usize address, phi::f32 value) noexcept
+    {
+        return CheckAccessResult(CheckedStore(address, value.unsafe()), address);
+    }
+
+    phi::boolean MemoryBlock::StoreDouble(phi::usize address, phi::f64 value) noexcept
+    {
+        return CheckAccessResult(CheckedStore(address, value.unsafe()), address);
+    }
+
+    phi::boolean MemoryBlock::IsAddressValid(phi::usize address, phi::usize size) const noexcept
+    {
+        if (m_Paged)
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
-            return {};
+            return size.unsafe() <= AddressSpaceSize &&
+                   address.unsafe() <= AddressSpaceSize - size.unsafe();
         }
 
-        const phi::size_t raw_address = (address - m_StartingAddress).unsafe();
+        // Cannot access anything before the starting address
+        if (address < m_StartingAddress)
+        {
+            return false;
+        }
 
-        if (!IsAddressAlignedCorrectly(raw_address, sizeof(phi::f64)))
+        // Check if address + size will overflow
+        if (phi::detail::will_addition_error(phi::detail::arithmetic_tag_for<phi::size_t>{},
+                                             address.unsafe(), size.unsafe()))
         {
-            DLX_ERROR("Address {} is misaligned", address.unsafe());
-            return {};
+            return false;
         }
 
-        return *reinterpret_cast<const double*>(&m_Values[(raw_address)].signed_value);
-    }
+        // Check if m_StartingAddress + size of the memory will overflow
+        if (phi::detail::will_addition_error(phi::detail::arithmetic_tag_for<phi::size_t>{},
+                                             m_StartingAddress.unsafe(), GetContiguousSize()))
+        {
+            return false;
+        }
 
-    phi::boolean MemoryBlock::StoreByte(phi::usize address, phi::i8 value) noexcept
-    {
-        if (!IsAddressValid(address, 1u))
+        // Check if address is out of bounds
+        if ((address + size) > (m_StartingAddress + GetContiguousSize()))
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
             return false;
         }
 
-        m_Values[(address - m_StartingAddress).unsafe()].signed_value = value.unsafe();
+        // Otherwise this is a valid address
         return true;
     }
 
-    phi::boolean MemoryBlock::StoreUnsignedByte(phi::usize address, phi::u8 value) noexcept
+    phi::boolean MemoryBlock::IsAddressAlignedCorrectly(phi::usize address,
+                                                        phi::usize size) noexcept
+    {
+        return size != 0u && (address % size) == 0u;
+    }
+
+    void MemoryBlock::Clear() noexcept
     {
-        if (!IsAddressValid(address, 1u))
+        if (m_Paged)
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
-            return false;
+            m_Pages.clear();
+            m_PageDirectory.clear();
+            m_PageTables.clear();
+            m_DirtyPages.clear();
+            m_TLBPageNumber       = InvalidPageNumber;
+            m_RequiresFullRestore = true;
+            return;
         }
 
-        m_Values[(address - m_StartingAddress).unsafe()].unsigned_value = value.unsafe();
-        return true;
+        if (m_Guarded)
+        {
+            std::memset(m_GuardedRegion.GetData(), 0, m_GuardedRegion.GetSize());
+        }
+
+        for (auto& val : m_Values)
+        {
+            val.signed_value = 0;
+        }
+
+        MarkAllPagesDirty();
     }
 
-    phi::boolean MemoryBlock::StoreHalfWord(phi::usize address, phi::i16 value) noexcept
+    void MemoryBlock::SetPaged(phi::boolean paged) noexcept
     {
-        if (!IsAddressValid(address, 2u))
+        if (paged == m_Paged)
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
-            return false;
+            return;
         }
 
-        phi::size_t index = (address - m_StartingAddress).unsafe();
-        *reinterpret_cast<phi::int16_t*>(&m_Values[index].signed_value) = value.unsafe();
+        SetGuarded(false);
 
-        return true;
+        // Both modes start out empty
+        m_Values.clear();
+        m_Values.shrink_to_fit();
+        m_StartingAddress = 0u;
+        m_DirtyPages.clear();
+
+        Clear();
+
+        m_Paged               = paged;
+        m_RequiresFullRestore = true;
     }
 
-    phi::boolean MemoryBlock::StoreUnsignedHalfWord(phi::usize address, phi::u16 value) noexcept
+    phi::boolean MemoryBlock::IsPaged() const noexcept
+    {
+        return m_Paged;
+    }
+
+    phi::boolean MemoryBlock::SetGuarded(phi::boolean guarded) noexcept
     {
-        if (!IsAddressValid(address, 2u))
+        if (guarded == m_Guarded)
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
+            return true;
+        }
+
+        if (!guarded)
+        {
+            m_Values.resize(m_GuardedRegion.GetSize());
+            if (!m_Values.empty())
+            {
+                std::memcpy(&m_Values.front().signed_value, m_GuardedRegion.GetData(),
+                            m_Values.size());
+            }
+
+            m_GuardedRegion       = GuardedRegion{};
+            m_Guarded             = false;
+            m_RequiresFullRestore = true;
+            return true;
+        }
+
+        if (m_Paged)
+        {
+            DLX_WARN("Paged memory cannot be guarded");
             return false;
         }
 
-        phi::size_t index = (address - m_StartingAddress).unsafe();
-        *reinterpret_cast<phi::uint16_t*>(&m_Values[index].unsigned_value) = value.unsafe();
+        if (!FitsGuardedAddressSpace(m_StartingAddress, m_Values.size()))
+        {
+            DLX_WARN("Guarded memory must lie within the 32-bit address space");
+            return false;
+        }
+
+        GuardedRegion region{m_Values.size()};
+        if (!region.IsValid())
+        {
+            return false;
+        }
+
+        if (!m_Values.empty())
+        {
+            std::memcpy(region.GetData(), &m_Values.front().signed_value, m_Values.size());
+        }
+
+        m_Values.clear();
+        m_Values.shrink_to_fit();
+        m_GuardedRegion       = phi::move(region);
+        m_Guarded             = true;
+        m_RequiresFullRestore = true;
 
         return true;
     }
 
-    phi::boolean MemoryBlock::StoreWord(phi::usize address, phi::i32 value) noexcept
+    phi::boolean MemoryBlock::IsGuarded() const noexcept
+    {
+        return m_Guarded;
+    }
+
+    const GuardedRegion& MemoryBlock::GetGuardedRegion() const noexcept
+    {
+        return m_GuardedRegion;
+    }
+
+    phi::usize MemoryBlock::GetStartingAddress() const noexcept
     {
-        if (!IsAddressValid(address, 4u))
+        return m_StartingAddress;
+    }
+
+    void MemoryBlock::SetStartingAddress(phi::usize new_starting_address) noexcept
+    {
+        if (m_Paged)
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
-            return false;
+            DLX_WARN("Trying to set the starting address of paged memory");
+            return;
         }
 
-        phi::size_t index = (address - m_StartingAddress).unsafe();
-        *reinterpret_cast<phi::int32_t*>(&m_Values[index].signed_value) = value.unsafe();
+        if (m_Guarded && !FitsGuardedAddressSpace(new_starting_address, GetContiguousSize()))
+        {
+            DLX_WARN("Guarded memory must lie within the 32-bit address space");
+            return;
+        }
 
-        return true;
+        m_StartingAddress = new_starting_address;
     }
 
-    phi::boolean MemoryBlock::StoreUnsignedWord(phi::usize address, phi::u32 value) noexcept
+    phi::usize MemoryBlock::GetSize() const noexcept
     {
-        if (!IsAddressValid(address, 4u))
+        if (m_Paged)
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
-            return false;
+            return m_Pages.size() * PageSize;
         }
 
-        phi::size_t index = (address - m_StartingAddress).unsafe();
-        *reinterpret_cast<phi::uint32_t*>(&m_Values[index].unsigned_value) = value.unsafe();
+        return GetContiguousSize();
+    }
 
-        return true;
+    void MemoryBlock::Resize(phi::usize new_size) noexcept
+    {
+        if (m_Paged)
+        {
+            DLX_WARN("Trying to resize paged memory");
+            return;
+        }
+
+        if (m_Guarded)
+        {
+            if (!FitsGuardedAddressSpace(m_StartingAddress, new_size))
+            {
+                DLX_WARN("Guarded memory must lie within the 32-bit address space");
+                return;
+            }
+
+            if (!m_GuardedRegion.Resize(new_size.unsafe()))
+            {
+                return;
+            }
+        }
+        else
+        {
+            m_Values.resize(new_size.unsafe());
+        }
+
+        m_DirtyPages.resize((number_of_pages(GetContiguousSize()) + BitsPerWord - 1u) /
+                            BitsPerWord);
+
+        MarkAllPagesDirty();
     }
 
-    phi::boolean MemoryBlock::StoreFloat(phi::usize address, phi::f32 value) noexcept
+    std::vector<MemoryBlock::MemoryByte>& MemoryBlock::GetRawMemory() noexcept
     {
-        if (!IsAddressValid(address, 4u))
+        MarkAllPagesDirty();
+
+        return m_Values;
+    }
+
+    const std::vector<MemoryBlock::MemoryByte>& MemoryBlock::GetRawMemory() const noexcept
+    {
+        return m_Values;
+    }
+
+    phi::size_t MemoryBlock::GetNumberOfPages() const noexcept
+    {
+        if (m_Paged)
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
-            return false;
+            return m_Pages.size();
         }
 
-        phi::size_t index = (address - m_StartingAddress).unsafe();
-        *reinterpret_cast<float*>(&m_Values[index].signed_value) = value.unsafe();
+        return number_of_pages(GetContiguousSize());
+    }
 
-        return true;
+    phi::boolean MemoryBlock::IsPageDirty(phi::size_t page) const noexcept
+    {
+        PHI_ASSERT(page < GetNumberOfPages());
+
+        return (m_DirtyPages[page / BitsPerWord] >> (page % BitsPerWord) & 1u) != 0u;
     }
 
-    phi::boolean MemoryBlock::StoreDouble(phi::usize address, phi::f64 value) noexcept
+    phi::size_t MemoryBlock::GetNumberOfDirtyPages() const noexcept
     {
-        if (!IsAddressValid(address, 8u))
+        phi::size_t count{0u};
+        for (const phi::uint64_t word : m_DirtyPages)
         {
-            DLX_ERROR("Address {} is out of bounds", address.unsafe());
-            return false;
+            count += static_cast<phi::size_t>(std::popcount(word));
         }
 
-        phi::size_t index = (address - m_StartingAddress).unsafe();
-        *reinterpret_cast<double*>(&m_Values[index].signed_value) = value.unsafe();
+        return count;
+    }
 
-        return true;
+    void MemoryBlock::ClearDirtyPages() noexcept
+    {
+        std::fill(m_DirtyPages.begin(), m_DirtyPages.end(), phi::uint64_t{0u});
+        m_RequiresFullRestore = false;
     }
 
-    phi::boolean MemoryBlock::IsAddressValid(phi::usize address, phi::usize size) const noexcept
+    void MemoryBlock::MarkAllPagesDirty() noexcept
     {
-        // Cannot access anything before the starting address
-        if (address < m_StartingAddress)
+        const phi::size_t pages = GetNumberOfPages();
+
+        std::fill(m_DirtyPages.begin(), m_DirtyPages.end(), ~phi::uint64_t{0u});
+
+        // Keep the bits past the last page cleared so counting stays exact
+        if (pages % BitsPerWord != 0u)
         {
-            return false;
+            m_DirtyPages.back() = (phi::uint64_t{1u} << (pages % BitsPerWord)) - 1u;
         }
+    }
 
-        // Check if address + size will overflow
-        if (phi::detail::will_addition_error(phi::detail::arithmetic_tag_for<phi::size_t>{},
-                                             address.unsafe(), size.unsafe()))
+    void MemoryBlock::RestoreDirtyPages(const MemoryBlock& other) noexcept
+    {
+        // Pages allocated since other was copied come after all of its pages
+        const phi::boolean compatible =
+                m_Paged == other.m_Paged && m_Guarded == other.m_Guarded &&
+                !m_RequiresFullRestore &&
+                (m_Paged ? m_Pages.size() >= other.m_Pages.size() :
+                           GetContiguousSize() == other.GetContiguousSize());
+
+        if (!compatible)
         {
-            return false;
+            *this = other;
+            ClearDirtyPages();
+            return;
         }
 
-        // Check if m_StartingAddress + m_Values.size() will overflow
-        if (phi::detail::will_addition_error(phi::detail::arithmetic_tag_for<phi::size_t>{},
-                                             m_StartingAddress.unsafe(), m_Values.size()))
+        for (phi::size_t word_index{0u}; word_index < m_DirtyPages.size(); ++word_index)
         {
-            return false;
+            phi::uint64_t word = m_DirtyPages[word_index];
+
+            while (word != 0u)
+            {
+                const phi::size_t page = word_index * BitsPerWord +
+                                         static_cast<phi::size_t>(std::countr_zero(word));
+                word &= word - 1u;
+
+                if (m_Paged)
+                {
+                    if (page < other.m_Pages.size())
+                    {
+                        m_Pages[page] = other.m_Pages[page];
+                    }
+
+                    continue;
+                }
+
+                const phi::size_t begin = page * PageSize;
+                const phi::size_t end   = std::min(begin + PageSize, GetContiguousSize());
+
+                if (m_Guarded)
+                {
+                    std::memcpy(m_GuardedRegion.GetData() + begin,
+                                other.m_GuardedRegion.GetData() + begin, end - begin);
+                    continue;
+                }
+
+                std::copy(other.m_Values.begin() + static_cast<std::ptrdiff_t>(begin),
+                          other.m_Values.begin() + static_cast<std::ptrdiff_t>(end),
+                          m_Values.begin() + static_cast<std::ptrdiff_t>(begin));
+            }
+
+            m_DirtyPages[word_index] = 0u;
         }
 
-        // Check if address is out of bounds
-        if ((address + size) > (m_StartingAddress + m_Values.size()))
+        if (m_Paged)
         {
-            return false;
+            // Drop the pages allocated since other was copied
+            m_Pages.shrink(other.m_Pages.size());
+            m_PageDirectory = other.m_PageDirectory;
+            m_PageTables    = other.m_PageTables;
+            m_DirtyPages.resize(other.m_DirtyPages.size());
+            m_TLBPageNumber = InvalidPageNumber;
         }
 
-        // Otherwise this is a valid address
-        return true;
+        m_StartingAddress = other.m_StartingAddress;
     }
 
-    phi::boolean MemoryBlock::IsAddressAlignedCorrectly(phi::usize address,
-                                                        phi::usize size) noexcept
+    phi::size_t MemoryBlock::GetContiguousSize() const noexcept
     {
-        return size != 0u && (address % size) == 0u;
+        return m_Guarded ? m_GuardedRegion.GetSize() : m_Values.size();
     }
 
-    void MemoryBlock::Clear() noexcept
+    phi::boolean MemoryBlock::FitsGuardedAddressSpace(phi::usize starting_address,
+                                                      phi::usize size) noexcept
     {
-        for (auto& val : m_Values)
+        return starting_address.unsafe() <= AddressSpaceSize &&
+               size.unsafe() <= AddressSpaceSize - starting_address.unsafe();
+    }
+
+    phi::uint32_t MemoryBlock::FindPage(phi::uint32_t page_number) const noexcept
+    {
+        if (page_number == m_TLBPageNumber)
         {
-            val.signed_value = 0;
+            return m_TLBPage;
+        }
+
+        if (m_PageDirectory.empty())
+        {
+            return 0u;
         }
+
+        const phi::uint32_t table = m_PageDirectory[page_number / PageTableSize];
+        if (table == 0u)
+        {
+            return 0u;
+        }
+
+        const phi::uint32_t page = m_PageTables[table - 1u][page_number % PageTableSize];
+        if (page != 0u)
+        {
+            m_TLBPageNumber = page_number;
+            m_TLBPage       = page;
+        }
+
+        return page;
     }
 
-    phi::usize MemoryBlock::GetStartingAddress() const noexcept
+    phi::uint32_t MemoryBlock::FindOrAllocatePage(phi::uint32_t page_number) noexcept
     {
-        return m_StartingAddress;
+        const phi::uint32_t existing_page = FindPage(page_number);
+        if (existing_page != 0u)
+        {
+            return existing_page;
+        }
+
+        if (m_PageDirectory.empty())
+        {
+            m_PageDirectory.resize(PageTableSize);
+        }
+
+        phi::uint32_t& table = m_PageDirectory[page_number / PageTableSize];
+        if (table == 0u)
+        {
+            m_PageTables.emplace_back();
+            table = static_cast<phi::uint32_t>(m_PageTables.size());
+        }
+
+        m_Pages.emplace_back();
+        if (m_DirtyPages.size() * BitsPerWord < m_Pages.size())
+        {
+            m_DirtyPages.push_back(0u);
+        }
+
+        const phi::uint32_t page = static_cast<phi::uint32_t>(m_Pages.size());
+        m_PageTables[table - 1u][page_number % PageTableSize] = page;
+        MarkPageDirty(page - 1u);
+
+        m_TLBPageNumber = page_number;
+        m_TLBPage       = page;
+
+        return page;
     }
 
-    void MemoryBlock::SetStartingAddress(phi::usize new_starting_address) noexcept
+    void MemoryBlock::ReadPaged(phi::size_t address, void* destination,
+                                phi::size_t size) const noexcept
     {
-        m_StartingAddress = new_starting_address;
+        phi::uint8_t* destination_bytes = static_cast<phi::uint8_t*>(destination);
+
+        // Unaligned accesses may span two pages
+        while (size > 0u)
+        {
+            const phi::size_t offset = address % PageSize;
+            const phi::size_t count  = std::min(size, PageSize - offset);
+            const phi::uint32_t page = FindPage(static_cast<phi::uint32_t>(address / PageSize));
+
+            if (page != 0u)
+            {
+                std::memcpy(destination_bytes, m_Pages[page - 1u].data() + offset, count);
+            }
+            else
+            {
+                std::memset(destination_bytes, 0, count);
+            }
+
+            destination_bytes += count;
+            address += count;
+            size -= count;
+        }
     }
 
-    phi::usize MemoryBlock::GetSize() const noexcept
+    void MemoryBlock::WritePaged(phi::size_t address, const void* source,
+                                 phi::size_t size) noexcept
+    {
+        const phi::uint8_t* source_bytes = static_cast<const phi::uint8_t*>(source);
+
+        // Unaligned accesses may span two pages
+        while (size > 0u)
+        {
+            const phi::size_t   offset = address % PageSize;
+            const phi::size_t   count  = std::min(size, PageSize - offset);
+            const phi::uint32_t page =
+                    FindOrAllocatePage(static_cast<phi::uint32_t>(address / PageSize));
+
+            std::memcpy(m_Pages[page - 1u].data() + offset, source_bytes, count);
+            MarkPageDirty(page - 1u);
+
+            source_bytes += count;
+            address += count;
+            size -= count;
+        }
+    }
+
+    MemoryBlock::PageList::PageList(const PageList& other) noexcept
     {
-        return m_Values.size();
+        *this = other;
     }
 
-    void MemoryBlock::Resize(phi::usize new_size) noexcept
+    MemoryBlock::PageList& MemoryBlock::PageList::operator=(const PageList& other) noexcept
     {
-        m_Values.resize(new_size.unsafe());
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        m_Pages.reserve(other.m_Pages.size());
+        for (phi::size_t index{0u}; index < other.m_Pages.size(); ++index)
+        {
+            if (index < m_Pages.size())
+            {
+                *m_Pages[index] = *other.m_Pages[index];
+            }
+            else
+            {
+                m_Pages.emplace_back(std::make_unique<Page>(*other.m_Pages[index]));
+            }
+        }
+        shrink(other.m_Pages.size());
+
+        return *this;
     }
 
-    std::vector<MemoryBlock::MemoryByte>& MemoryBlock::GetRawMemory() noexcept
+    void MemoryBlock::PageList::shrink(phi::size_t size) noexcept
     {
-        return m_Values;
+        if (size < m_Pages.size())
+        {
+            m_Pages.erase(m_Pages.begin() + static_cast<std::ptrdiff_t>(size), m_Pages.end());
+        }
     }
 
-    const std::vector<MemoryBlock::MemoryByte>& MemoryBlock::GetRawMemory() const noexcept
+    void MemoryBlock::PageList::emplace_back() noexcept
     {
-        return m_Values;
+        // Value initialization zeroes the page
+        m_Pages.emplace_back(std::make_unique<Page>());
     }
 } // namespace dlx
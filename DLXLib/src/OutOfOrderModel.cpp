@@ -0,0 +1,385 @@
+#include "DLX/OutOfOrderModel.hpp"
+
+#include "DLX/DecodedProgram.hpp"
+#include "DLX/Instruction.hpp"
+#include "DLX/ParsedProgram.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <algorithm>
+#include <bit>
+
+PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
+PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(5262)
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+PHI_MSVC_SUPPRESS_WARNING_POP()
+PHI_GCC_SUPPRESS_WARNING_POP()
+
+namespace dlx
+{
+    phi::boolean OutOfOrderConfig::IsValid() const noexcept
+    {
+        for (const OutOfOrderUnitConfig& unit : units)
+        {
+            if (unit.stations == 0u || unit.stations > MaximumStations || unit.units == 0u ||
+                unit.units > MaximumUnits)
+            {
+                return false;
+            }
+        }
+
+        return common_data_buses != 0u && common_data_buses <= MaximumCommonDataBuses &&
+               history <= MaximumHistory;
+    }
+
+    double OutOfOrderStatistics::GetIPC() const noexcept
+    {
+        if (cycles == 0u)
+        {
+            return 0.0;
+        }
+
+        return static_cast<double>(instructions) / static_cast<double>(cycles);
+    }
+
+    OutOfOrderModel::OutOfOrderModel() noexcept
+    {
+        Clear();
+    }
+
+    OutOfOrderModel::OutOfOrderModel(const OutOfOrderConfig& config) noexcept
+    {
+        if (config.IsValid())
+        {
+            m_Config = config;
+        }
+
+        Clear();
+    }
+
+    phi::boolean OutOfOrderModel::SetConfig(const OutOfOrderConfig& config) noexcept
+    {
+        if (!config.IsValid())
+        {
+            return false;
+        }
+
+        m_Config = config;
+
+        return true;
+    }
+
+    const OutOfOrderConfig& OutOfOrderModel::GetConfig() const noexcept
+    {
+        return m_Config;
+    }
+
+    void OutOfOrderModel::Load(const DecodedProgram& program) noexcept
+    {
+        PipelineConfig pipeline_config;
+        pipeline_config.latencies = m_Config.latencies;
+
+        m_Instructions.clear();
+        m_Instructions.reserve(program.m_Instructions.size());
+
+        for (const DecodedInstruction& decoded : program.m_Instructions)
+        {
+            const PipelineInstruction pipeline_instruction =
+                    PrecomputePipelineInstruction(decoded, pipeline_config);
+
+            PrecomputedInstruction& instruction = m_Instructions.emplace_back();
+            instruction.sources                 = pipeline_instruction.sources;
+            instruction.destinations            = pipeline_instruction.destinations;
+            instruction.latency                 = pipeline_instruction.latency;
+            instruction.unit = static_cast<phi::uint8_t>(GetOutOfOrderUnit(decoded.opcode));
+            instruction.control_transfer = IsControlTransferInstruction(decoded.opcode);
+        }
+
+        Clear();
+    }
+
+    void OutOfOrderModel::Clear() noexcept
+    {
+        // Every instruction in a station can be delayed by all others executing and broadcasting
+        // before it, so that's the furthest a reservation can lie ahead of the issue cycle
+        phi::uint64_t stations{0u};
+        for (const OutOfOrderUnitConfig& unit : m_Config.units)
+        {
+            stations += unit.stations;
+        }
+
+        const phi::uint64_t latency =
+                std::max(*std::max_element(m_Config.latencies.begin(), m_Config.latencies.end()),
+                         phi::uint8_t{1u});
+        const phi::uint64_t capacity = std::bit_ceil(stations * (latency + stations + 2u) + 64u);
+
+        m_Reservations.assign(capacity * ReservationColumns, 0u);
+        m_WindowMask  = capacity - 1u;
+        m_WindowStart = 1u;
+
+        m_Ready.fill(0u);
+        for (auto& stations_free : m_StationFree)
+        {
+            stations_free.fill(0u);
+        }
+
+        m_LastIssue       = 0u;
+        m_BranchResolved  = 0u;
+        m_LastMemoryStart = 0u;
+        m_LastStoreWrite  = 0u;
+        m_Statistics      = OutOfOrderStatistics{};
+
+        m_History.assign(m_Config.history, OutOfOrderRecord{});
+        m_HistoryNext = 0u;
+        m_HistorySize = 0u;
+    }
+
+    void OutOfOrderModel::Retire(phi::uint32_t index) noexcept
+    {
+        PHI_ASSERT(index < m_Instructions.size());
+
+        const PrecomputedInstruction& instruction = m_Instructions[index];
+        const OutOfOrderUnitConfig&   unit_config = m_Config.units[instruction.unit];
+        const OutOfOrderUnit          unit        = static_cast<OutOfOrderUnit>(instruction.unit);
+
+        // Issue in order after every preceding control transfer was resolved
+        phi::uint64_t issue = m_LastIssue + 1u;
+        if (m_BranchResolved > issue)
+        {
+            m_Statistics.branch_stalls += m_BranchResolved - issue;
+            issue = m_BranchResolved;
+        }
+
+        // Take the station which is free first
+        std::array<phi::uint64_t, OutOfOrderConfig::MaximumStations>& stations =
+                m_StationFree[instruction.unit];
+        phi::uint64_t* const station =
+                std::min_element(stations.begin(), stations.begin() + unit_config.stations);
+        if (*station > issue)
+        {
+            m_Statistics.station_stalls += *station - issue;
+            issue = *station;
+        }
+
+        AdvanceWindow(issue);
+
+        // Operands come from the register file or the common data bus
+        phi::uint64_t ready = issue + 1u;
+        const phi::uint64_t operands = std::max(
+                std::max(m_Ready[instruction.sources[0u]], m_Ready[instruction.sources[1u]]),
+                std::max(m_Ready[instruction.sources[2u]], m_Ready[instruction.sources[3u]]));
+        if (operands > ready)
+        {
+            m_Statistics.operand_waits += operands - ready;
+            ready = operands;
+        }
+
+        // Memory accesses may only be reordered among loads
+        phi::uint64_t memory_order{0u};
+        if (unit == OutOfOrderUnit::Load)
+        {
+            memory_order = m_LastStoreWrite + 1u;
+        }
+        else if (unit == OutOfOrderUnit::Store)
+        {
+            memory_order = std::max(m_LastMemoryStart, m_LastStoreWrite + 1u);
+        }
+
+        if (memory_order > ready)
+        {
+            m_Statistics.memory_order_waits += memory_order - ready;
+            ready = memory_order;
+        }
+
+        // Wait for a unit accepting the instruction for all cycles it occupies
+        const phi::uint64_t latency   = instruction.latency;
+        const phi::uint64_t occupancy = unit_config.pipelined ? 1u : latency;
+
+        phi::uint64_t start = ready;
+        for (phi::uint64_t cycle{start}; cycle < start + occupancy; ++cycle)
+        {
+            if (Reservations(cycle, instruction.unit) >= unit_config.units)
+            {
+                start = cycle + 1u;
+            }
+        }
+
+        m_Statistics.unit_waits += start - ready;
+        m_Statistics.busy_cycles[instruction.unit] += occupancy;
+
+        for (phi::uint64_t cycle{start}; cycle < start + occupancy; ++cycle)
+        {
+            ++Reservations(cycle, instruction.unit);
+        }
+
+        const phi::uint64_t execute_end = start + latency - 1u;
+
+        // Results are broadcast on the next free bus, stores write the memory right away
+        phi::uint64_t write{0u};
+        phi::uint64_t completion{execute_end};
+        if (instruction.destinations[0u] != PipelineModel::NoSlot)
+        {
+            write = execute_end + 1u;
+            while (Reservations(write, BusColumn) >= m_Config.common_data_buses)
+            {
+                ++write;
+            }
+
+            m_Statistics.bus_waits += write - execute_end - 1u;
+            ++Reservations(write, BusColumn);
+
+            m_Ready[instruction.destinations[0u]] = write + 1u;
+            m_Ready[instruction.destinations[1u]] = write + 1u;
+            completion                             = write;
+        }
+        else if (unit == OutOfOrderUnit::Store)
+        {
+            write            = execute_end + 1u;
+            m_LastStoreWrite = write;
+            completion       = write;
+        }
+
+        if (unit == OutOfOrderUnit::Load || unit == OutOfOrderUnit::Store)
+        {
+            m_LastMemoryStart = std::max(m_LastMemoryStart, start);
+        }
+
+        if (instruction.control_transfer)
+        {
+            m_BranchResolved = execute_end + 1u;
+        }
+
+        *station    = completion + 1u;
+        m_LastIssue = issue;
+
+        ++m_Statistics.instructions;
+        m_Statistics.cycles = std::max(m_Statistics.cycles, completion);
+
+        if (!m_History.empty())
+        {
+            m_History[m_HistoryNext] = OutOfOrderRecord{index, issue, start, execute_end, write};
+            m_HistoryNext            = (m_HistoryNext + 1u) % m_History.size();
+            m_HistorySize            = std::min(m_HistorySize + 1u, m_History.size());
+        }
+    }
+
+    const OutOfOrderStatistics& OutOfOrderModel::GetStatistics() const noexcept
+    {
+        return m_Statistics;
+    }
+
+    std::vector<OutOfOrderRecord> OutOfOrderModel::GetHistory() const noexcept
+    {
+        std::vector<OutOfOrderRecord> records;
+        records.reserve(m_HistorySize);
+
+        const phi::size_t first = (m_HistoryNext + m_History.size() - m_HistorySize) %
+                                  std::max(m_History.size(), phi::size_t{1u});
+        for (phi::size_t offset{0u}; offset < m_HistorySize; ++offset)
+        {
+            records.emplace_back(m_History[(first + offset) % m_History.size()]);
+        }
+
+        return records;
+    }
+
+    std::string OutOfOrderModel::GetReport(const ParsedProgram& program,
+                                           phi::size_t          max_records) const noexcept
+    {
+        const OutOfOrderStatistics& statistics = m_Statistics;
+
+        std::string text = fmt::format("Instructions {:>14}\nCycles {:>20}\nIPC {:>23.3f}\n",
+                                       statistics.instructions, statistics.cycles,
+                                       statistics.GetIPC());
+
+        text.append(fmt::format("Issue stalls\n  {:<17} {:>7}\n  {:<17} {:>7}\n",
+                                "No free station", statistics.station_stalls, "Branch",
+                                statistics.branch_stalls));
+        text.append(fmt::format(
+                "Station waits\n  {:<17} {:>7}\n  {:<17} {:>7}\n  {:<17} {:>7}\n  {:<17} {:>7}\n",
+                "Operands", statistics.operand_waits, "Memory order",
+                statistics.memory_order_waits, "Functional unit", statistics.unit_waits,
+                "Data bus", statistics.bus_waits));
+
+        static constexpr const char* names[NumberOfOutOfOrderUnits] = {
+                "Integer",        "Integer multiply", "Integer divide", "Float add",
+                "Float multiply", "Float divide",     "Load",           "Store"};
+
+        text.append("Unit utilization\n");
+        for (phi::size_t unit{0u}; unit < NumberOfOutOfOrderUnits; ++unit)
+        {
+            const phi::uint64_t capacity = statistics.cycles * m_Config.units[unit].units;
+            const double        share =
+                    capacity == 0u ? 0.0 :
+                                     100.0 * static_cast<double>(statistics.busy_cycles[unit]) /
+                                             static_cast<double>(capacity);
+
+            text.append(fmt::format("  {:<17} {:>6.2f}%\n", names[unit], share));
+        }
+
+        std::vector<OutOfOrderRecord> records = GetHistory();
+        if (records.empty())
+        {
+            return text;
+        }
+
+        if (records.size() > max_records)
+        {
+            records.erase(records.begin(),
+                          records.end() - static_cast<std::ptrdiff_t>(max_records));
+        }
+
+        text.append(fmt::format("\n{:>10} {:>10} {:>10} {:>10}  {}\n", "Issue", "Start", "End",
+                                "Write", "Instruction"));
+
+        for (const OutOfOrderRecord& record : records)
+        {
+            PHI_ASSERT(record.index < program.m_Instructions.size());
+
+            text.append(fmt::format(
+                    "{:>10} {:>10} {:>10} {:>10}  {}\n", record.issue, record.execute_start,
+                    record.execute_end, record.write == 0u ? std::string{"-"} :
+                                                             std::to_string(record.write),
+                    program.m_Instructions[record.index].DebugInfo()));
+        }
+
+        return text;
+    }
+
+    void OutOfOrderModel::AdvanceWindow(phi::uint64_t cycle) noexcept
+    {
+        if (cycle <= m_WindowStart)
+        {
+            return;
+        }
+
+        const phi::uint64_t capacity = m_WindowMask + 1u;
+        if (cycle - m_WindowStart >= capacity)
+        {
+            std::fill(m_Reservations.begin(), m_Reservations.end(), phi::uint8_t{0u});
+        }
+        else
+        {
+            for (phi::uint64_t freed{m_WindowStart}; freed < cycle; ++freed)
+            {
+                const phi::size_t row = static_cast<phi::size_t>(freed & m_WindowMask);
+                std::fill_n(m_Reservations.begin() +
+                                    static_cast<std::ptrdiff_t>(row * ReservationColumns),
+                            ReservationColumns, phi::uint8_t{0u});
+            }
+        }
+
+        m_WindowStart = cycle;
+    }
+
+    phi::uint8_t& OutOfOrderModel::Reservations(phi::uint64_t cycle, phi::size_t column) noexcept
+    {
+        PHI_ASSERT(cycle >= m_WindowStart && cycle - m_WindowStart <= m_WindowMask,
+                   "Reservation outside of the window");
+
+        return m_Reservations[static_cast<phi::size_t>(cycle & m_WindowMask) * ReservationColumns +
+                              column];
+    }
+} // namespace dlx
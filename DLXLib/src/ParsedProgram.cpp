@@ -28,7 +28,9 @@ namespace dlx
     {
         std::string text;
 
-        text.append(fmt::format("Valid: {:s}\n\n", IsValid() ? "True" : "False"));
+        text.append(fmt::format("Valid: {:s}\n", IsValid() ? "True" : "False"));
+        text.append(fmt::format("Unresolved labels: {:s}\n\n",
+                                m_HasUnresolvedLabels ? "True" : "False"));
 
         // Parser errors
         text.append("Parser errors:\n");
@@ -14,11 +14,13 @@
 #include "DLX/Tokenize.hpp"
 #include <phi/core/assert.hpp>
 #include <phi/core/boolean.hpp>
+#include <phi/core/move.hpp>
 #include <phi/core/optional.hpp>
 #include <phi/core/types.hpp>
 #include <phi/preprocessor/function_like_macro.hpp>
 #include <algorithm>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 
 using namespace phi::literals;
@@ -175,6 +177,45 @@ namespace dlx
         }
     }
 
+    static InstructionArgument link_instruction_argument(const InstructionArgument& argument,
+                                                         ParsedProgram& program) noexcept
+    {
+        if (argument.GetType() != ArgumentType::Label)
+        {
+            return argument;
+        }
+
+        const phi::string_view label_name = argument.AsLabel().label_name;
+
+        const auto it = program.m_JumpData.find(label_name);
+        if (it == program.m_JumpData.end())
+        {
+            // Leave the label unresolved, the processor will refuse to execute this program
+            program.m_HasUnresolvedLabels = true;
+            return argument;
+        }
+
+        return ConstructInstructionArgumentLabel(label_name, it->second);
+    }
+
+    // Resolve every label argument to the index of the instruction it points to
+    static void link_jump_labels(ParsedProgram& program) noexcept
+    {
+        for (Instruction& instruction : program.m_Instructions)
+        {
+            const InstructionArgument arg1 =
+                    link_instruction_argument(instruction.GetArg1(), program);
+            const InstructionArgument arg2 =
+                    link_instruction_argument(instruction.GetArg2(), program);
+            const InstructionArgument arg3 =
+                    link_instruction_argument(instruction.GetArg3(), program);
+
+            instruction.SetArgument(0_u8, arg1);
+            instruction.SetArgument(1_u8, arg2);
+            instruction.SetArgument(2_u8, arg3);
+        }
+    }
+
     ParsedProgram Parser::Parse(TokenStream& tokens) noexcept
     {
         ParsedProgram program;
@@ -396,6 +437,8 @@ namespace dlx
             }
         }
 
+        link_jump_labels(program);
+
         return program;
     }
 
@@ -404,4 +447,21 @@ namespace dlx
         TokenStream tokens = Tokenize(source);
         return Parse(tokens);
     }
+
+    ParsedProgram Parser::ParseOwned(std::string source) noexcept
+    {
+        // The string is heap allocated so views into it survive moving the program
+        std::shared_ptr<const std::string> owned_source =
+                std::make_shared<const std::string>(phi::move(source));
+
+        ParsedProgram program = Parse(*owned_source);
+        program.m_Source      = phi::move(owned_source);
+
+        return program;
+    }
+
+    SharedParsedProgram Parser::ParseShared(std::string source) noexcept
+    {
+        return std::make_shared<const ParsedProgram>(ParseOwned(phi::move(source)));
+    }
 } // namespace dlx
@@ -0,0 +1,318 @@
+#include "DLX/PipelineModel.hpp"
+
+#include "DLX/DecodedProgram.hpp"
+#include "DLX/InstructionInfo.hpp"
+#include "DLX/InstructionLibrary.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/type_traits/to_underlying.hpp>
+
+PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
+PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(5262)
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+PHI_MSVC_SUPPRESS_WARNING_POP()
+PHI_GCC_SUPPRESS_WARNING_POP()
+
+namespace dlx
+{
+    [[nodiscard]] static constexpr phi::boolean reads_double(OpCode opcode) noexcept
+    {
+        switch (opcode)
+        {
+            case OpCode::ADDD:
+            case OpCode::SUBD:
+            case OpCode::MULTD:
+            case OpCode::DIVD:
+            case OpCode::LTD:
+            case OpCode::GTD:
+            case OpCode::LED:
+            case OpCode::GED:
+            case OpCode::EQD:
+            case OpCode::NED:
+            case OpCode::MOVD:
+            case OpCode::CVTD2F:
+            case OpCode::CVTD2I:
+            case OpCode::SD:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    [[nodiscard]] static constexpr phi::boolean writes_double(OpCode opcode) noexcept
+    {
+        switch (opcode)
+        {
+            case OpCode::ADDD:
+            case OpCode::SUBD:
+            case OpCode::MULTD:
+            case OpCode::DIVD:
+            case OpCode::MOVD:
+            case OpCode::CVTF2D:
+            case OpCode::CVTI2D:
+            case OpCode::LD:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    [[nodiscard]] static constexpr phi::boolean is_float_compare(OpCode opcode) noexcept
+    {
+        switch (opcode)
+        {
+            case OpCode::LTF:
+            case OpCode::LTD:
+            case OpCode::GTF:
+            case OpCode::GTD:
+            case OpCode::LEF:
+            case OpCode::LED:
+            case OpCode::GEF:
+            case OpCode::GED:
+            case OpCode::EQF:
+            case OpCode::EQD:
+            case OpCode::NEF:
+            case OpCode::NED:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    [[nodiscard]] static constexpr phi::boolean is_store(OpCode opcode) noexcept
+    {
+        switch (opcode)
+        {
+            case OpCode::SB:
+            case OpCode::SBU:
+            case OpCode::SH:
+            case OpCode::SHU:
+            case OpCode::SW:
+            case OpCode::SWU:
+            case OpCode::SF:
+            case OpCode::SD:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    PipelineInstruction PrecomputePipelineInstruction(const DecodedInstruction& decoded,
+                                                      const PipelineConfig&     config) noexcept
+    {
+        const OpCode           opcode = decoded.opcode;
+        const InstructionInfo& info   = LookUpInstructionInfo(opcode);
+
+        PipelineInstruction instruction;
+        instruction.sources      = {PipelineModel::NoSlot, PipelineModel::NoSlot,
+                                    PipelineModel::NoSlot, PipelineModel::NoSlot};
+        instruction.destinations = {PipelineModel::NoSlot, PipelineModel::NoSlot};
+
+        const phi::boolean store            = is_store(opcode);
+        const phi::boolean control_transfer = IsControlTransferInstruction(opcode);
+        const phi::boolean float_compare    = is_float_compare(opcode);
+
+        // Only the first argument is ever written to
+        const phi::boolean writes_first_argument = !store && !control_transfer && !float_compare;
+
+        phi::size_t number_of_sources{0u};
+        for (phi::size_t index{0u}; index < decoded.registers.size(); ++index)
+        {
+            // Immediate values, labels and missing arguments have no register
+            const phi::uint8_t register_id = decoded.registers[index];
+            if (register_id >= PipelineModel::FloatRegisterSlot)
+            {
+                continue;
+            }
+
+            const phi::boolean is_float =
+                    info.GetArgumentType(static_cast<phi::uint8_t>(index)) ==
+                    ArgumentType::FloatRegister;
+            const phi::uint8_t slot = static_cast<phi::uint8_t>(
+                    is_float ? PipelineModel::FloatRegisterSlot + register_id : register_id);
+
+            if (index == 0u && writes_first_argument)
+            {
+                // Writes to R0 are discarded
+                if (is_float || register_id != 0u)
+                {
+                    instruction.destinations = {
+                            slot, static_cast<phi::uint8_t>(
+                                          is_float && writes_double(opcode) ? slot + 1u : slot)};
+                }
+
+                continue;
+            }
+
+            PHI_ASSERT(number_of_sources < 2u);
+
+            instruction.sources[number_of_sources * 2u] = slot;
+            instruction.sources[number_of_sources * 2u + 1u] =
+                    static_cast<phi::uint8_t>(is_float && reads_double(opcode) ? slot + 1u : slot);
+            ++number_of_sources;
+        }
+
+        if (float_compare)
+        {
+            instruction.destinations = {PipelineModel::FPSRSlot, PipelineModel::FPSRSlot};
+        }
+        else if (opcode == OpCode::BFPT || opcode == OpCode::BFPF)
+        {
+            instruction.sources[0u] = PipelineModel::FPSRSlot;
+            instruction.sources[1u] = PipelineModel::FPSRSlot;
+        }
+        else if (opcode == OpCode::JAL || opcode == OpCode::JALR)
+        {
+            instruction.destinations = {static_cast<phi::uint8_t>(IntRegisterID::R31),
+                                        static_cast<phi::uint8_t>(IntRegisterID::R31)};
+        }
+
+        const PipelineUnit unit    = GetPipelineUnit(opcode);
+        const phi::uint8_t latency = std::max(
+                config.latencies[static_cast<phi::size_t>(phi::to_underlying(opcode))],
+                phi::uint8_t{1u});
+
+        instruction.latency = latency;
+        instruction.unit    = phi::to_underlying(unit);
+        instruction.occupancy =
+                config.pipelined_units[phi::to_underlying(unit)] ? phi::uint8_t{1u} : latency;
+
+        if (IsMemoryAccessInstruction(opcode))
+        {
+            instruction.flags |= store ? PipelineInstruction::FlagStore :
+                                         PipelineInstruction::FlagLoad;
+        }
+
+        if (control_transfer)
+        {
+            // The target of a jump to a label is known once it's decoded
+            if (opcode == OpCode::J || opcode == OpCode::JAL ||
+                config.branch_resolution == BranchResolution::Decode)
+            {
+                instruction.taken_penalty = 1u;
+            }
+            else
+            {
+                instruction.taken_penalty = 2u;
+            }
+
+            if (config.branch_resolution == BranchResolution::Decode)
+            {
+                instruction.flags |= PipelineInstruction::FlagEarlyOperands;
+            }
+        }
+
+        return instruction;
+    }
+
+    phi::uint64_t PipelineStatistics::GetTotalStalls() const noexcept
+    {
+        return data_stalls + load_use_stalls + structural_stalls + write_after_write_stalls +
+               control_stalls;
+    }
+
+    double PipelineStatistics::GetCPI() const noexcept
+    {
+        if (instructions == 0u)
+        {
+            return 0.0;
+        }
+
+        return static_cast<double>(cycles) / static_cast<double>(instructions);
+    }
+
+    PipelineModel::PipelineModel() noexcept = default;
+
+    PipelineModel::PipelineModel(const PipelineConfig& config) noexcept
+        : m_Config{config}
+    {}
+
+    void PipelineModel::SetConfig(const PipelineConfig& config) noexcept
+    {
+        m_Config = config;
+    }
+
+    const PipelineConfig& PipelineModel::GetConfig() const noexcept
+    {
+        return m_Config;
+    }
+
+    void PipelineModel::Load(const DecodedProgram& program) noexcept
+    {
+        m_Instructions.clear();
+        m_Instructions.reserve(program.m_Instructions.size());
+
+        for (const DecodedInstruction& instruction : program.m_Instructions)
+        {
+            m_Instructions.emplace_back(PrecomputePipelineInstruction(instruction, m_Config));
+        }
+
+        // Stored values are forwarded to the memory stage one cycle after the execute stage while
+        // branches resolved in the decode stage need their operands one cycle before it. Without
+        // forwarding both read the register file in the decode stage like everything else.
+        m_StoreDataRelief   = m_Config.forwarding ? 2u : 0u;
+        m_EarlyOperandDelay = m_Config.forwarding ? 1u : 0u;
+
+        Clear();
+    }
+
+    void PipelineModel::Clear() noexcept
+    {
+        m_Ready.fill(0u);
+        m_WriteBack.fill(0u);
+        m_UnitFree.fill(0u);
+
+        // The first instruction is fetched in cycle 0 and executed in cycle 2
+        m_LastExecute    = 1u;
+        m_LastWriteBack  = 0u;
+        m_PendingPenalty = 0u;
+        m_Statistics     = PipelineStatistics{};
+    }
+
+    PipelineStatistics PipelineModel::GetStatistics() const noexcept
+    {
+        PipelineStatistics statistics = m_Statistics;
+        statistics.cycles = statistics.instructions == 0u ? 0u : m_LastWriteBack + 1u;
+
+        return statistics;
+    }
+
+    const std::vector<PipelineInstruction>& PipelineModel::GetInstructions() const noexcept
+    {
+        return m_Instructions;
+    }
+
+    std::string PipelineModel::GetReport() const noexcept
+    {
+        const PipelineStatistics statistics = GetStatistics();
+
+        std::string text = fmt::format("Instructions {:>14}\nCycles {:>20}\nCPI {:>23.3f}\n",
+                                       statistics.instructions, statistics.cycles,
+                                       statistics.GetCPI());
+
+        const phi::uint64_t total_stalls = statistics.GetTotalStalls();
+        text.append(fmt::format("Stalls {:>20}\n", total_stalls));
+
+        const auto append_stalls = [&](const char* name, phi::uint64_t stalls) {
+            const double share = total_stalls == 0u ? 0.0 :
+                                                      100.0 * static_cast<double>(stalls) /
+                                                              static_cast<double>(total_stalls);
+
+            text.append(fmt::format("  {:<17} {:>7} {:>6.2f}%\n", name, stalls, share));
+        };
+
+        append_stalls("Data", statistics.data_stalls);
+        append_stalls("Load use", statistics.load_use_stalls);
+        append_stalls("Structural", statistics.structural_stalls);
+        append_stalls("Write after write", statistics.write_after_write_stalls);
+        append_stalls("Control", statistics.control_stalls);
+
+        return text;
+    }
+} // namespace dlx
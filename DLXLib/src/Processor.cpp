@@ -1,18 +1,28 @@
 #include "DLX/Processor.hpp"
 
+#include "DLX/BlockCache.hpp"
 #include "DLX/FloatRegister.hpp"
 #include "DLX/Instruction.hpp"
+#include "DLX/InstructionImplementation.hpp"
 #include "DLX/InstructionInfo.hpp"
 #include "DLX/IntRegister.hpp"
 #include "DLX/Logger.hpp"
+#include "DLX/ObservingProcessor.hpp"
+#include "DLX/OpCode.hpp"
 #include "DLX/Parser.hpp"
 #include "DLX/RegisterNames.hpp"
 #include "DLX/StatusRegister.hpp"
+#include <phi/compiler_support/compiler.hpp>
+#include <phi/compiler_support/unused.hpp>
 #include <phi/compiler_support/warning.hpp>
 #include <phi/core/assert.hpp>
 #include <phi/core/boolean.hpp>
+#include <phi/core/move.hpp>
 #include <phi/core/types.hpp>
 #include <phi/type_traits/to_underlying.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 
 PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
 PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(5262)
@@ -27,6 +37,15 @@ PHI_GCC_SUPPRESS_WARNING("-Wconversion")
 // TODO: Fix strict aliasing problems
 PHI_GCC_SUPPRESS_WARNING("-Wstrict-aliasing")
 
+// Use computed goto for the threaded dispatch loop where the compiler supports it
+#if !defined(DLX_PROCESSOR_USE_COMPUTED_GOTO)
+#    if PHI_COMPILER_IS(GCC) || PHI_COMPILER_IS(CLANG)
+#        define DLX_PROCESSOR_USE_COMPUTED_GOTO 1
+#    else
+#        define DLX_PROCESSOR_USE_COMPUTED_GOTO 0
+#    endif
+#endif
+
 namespace dlx
 {
     static constexpr phi::boolean RegisterAccessTypeMatches(RegisterAccessType expected_access,
@@ -55,7 +74,34 @@ namespace dlx
         }
     }
 
-    Processor::Processor() noexcept
+    PHI_CLANG_AND_GCC_SUPPRESS_WARNING_PUSH()
+    PHI_CLANG_AND_GCC_SUPPRESS_WARNING("-Wswitch")
+
+    template <typename ProcessorT>
+    static void dispatch_instruction(ProcessorT& processor, const DecodedInstruction& inst) noexcept
+    {
+        switch (inst.opcode)
+        {
+#define DLX_ENUM_OPCODE_IMPL(name)                                                                 \
+    case OpCode::name:                                                                             \
+        impl::name(processor, inst);                                                               \
+        return;
+
+            DLX_ENUM_OPCODE
+
+#undef DLX_ENUM_OPCODE_IMPL
+
+#if !defined(DLXEMU_COVERAGE_BUILD)
+            default:
+                PHI_ASSERT_NOT_REACHED();
+#endif
+        }
+    }
+
+    PHI_CLANG_AND_GCC_SUPPRESS_WARNING_POP()
+
+    template <typename PolicyT>
+    BasicProcessor<PolicyT>::BasicProcessor() noexcept
         : m_IntRegistersValueTypes{}
         , m_FloatRegistersValueTypes{}
         , m_MemoryBlock(1000u, 1000u)
@@ -64,7 +110,8 @@ namespace dlx
         m_IntRegisters[0].SetReadOnly(true);
     }
 
-    IntRegister& Processor::GetIntRegister(IntRegisterID id) noexcept
+    template <typename PolicyT>
+    IntRegister& BasicProcessor<PolicyT>::GetIntRegister(IntRegisterID id) noexcept
     {
         PHI_ASSERT(id != IntRegisterID::None);
         phi::size_t id_value = phi::to_underlying(id);
@@ -74,7 +121,8 @@ namespace dlx
         return m_IntRegisters[id_value];
     }
 
-    const IntRegister& Processor::GetIntRegister(IntRegisterID id) const noexcept
+    template <typename PolicyT>
+    const IntRegister& BasicProcessor<PolicyT>::GetIntRegister(IntRegisterID id) const noexcept
     {
         PHI_ASSERT(id != IntRegisterID::None);
         phi::size_t id_value = phi::to_underlying(id);
@@ -84,49 +132,62 @@ namespace dlx
         return m_IntRegisters[id_value];
     }
 
-    phi::i32 Processor::IntRegisterGetSignedValue(IntRegisterID id) const noexcept
+    template <typename PolicyT>
+    phi::i32 BasicProcessor<PolicyT>::IntRegisterGetSignedValue(IntRegisterID id) const noexcept
     {
-        PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
-                                             RegisterAccessType::Signed),
-                   "Mismatch for instruction access type");
+        if constexpr (PolicyT::TrackRegisterValueTypes)
+        {
+            PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
+                                                 RegisterAccessType::Signed),
+                       "Mismatch for instruction access type");
 
-        const phi::size_t id_value = phi::to_underlying(id);
+            const phi::size_t id_value = phi::to_underlying(id);
 
-        PHI_ASSERT(id_value < m_IntRegistersValueTypes.size());
-        const IntRegisterValueType register_value_type = m_IntRegistersValueTypes[id_value];
-        if (register_value_type != IntRegisterValueType::NotSet &&
-            register_value_type != IntRegisterValueType::Signed)
-        {
-            DLX_WARN("Mismatch for register value type");
+            PHI_ASSERT(id_value < m_IntRegistersValueTypes.size());
+            const IntRegisterValueType register_value_type = m_IntRegistersValueTypes[id_value];
+            if (register_value_type != IntRegisterValueType::NotSet &&
+                register_value_type != IntRegisterValueType::Signed)
+            {
+                DLX_WARN("Mismatch for register value type");
+            }
         }
 
         return GetIntRegister(id).GetSignedValue();
     }
 
-    phi::u32 Processor::IntRegisterGetUnsignedValue(IntRegisterID id) const noexcept
+    template <typename PolicyT>
+    phi::u32 BasicProcessor<PolicyT>::IntRegisterGetUnsignedValue(IntRegisterID id) const noexcept
     {
-        PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
-                                             RegisterAccessType::Unsigned),
-                   "Mismatch for instruction access type");
+        if constexpr (PolicyT::TrackRegisterValueTypes)
+        {
+            PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
+                                                 RegisterAccessType::Unsigned),
+                       "Mismatch for instruction access type");
 
-        const phi::size_t id_value = phi::to_underlying(id);
+            const phi::size_t id_value = phi::to_underlying(id);
 
-        PHI_ASSERT(id_value < m_IntRegistersValueTypes.size());
-        const IntRegisterValueType register_value_type = m_IntRegistersValueTypes[id_value];
-        if (register_value_type != IntRegisterValueType::NotSet &&
-            register_value_type != IntRegisterValueType::Unsigned)
-        {
-            DLX_WARN("Mismatch for register value type");
+            PHI_ASSERT(id_value < m_IntRegistersValueTypes.size());
+            const IntRegisterValueType register_value_type = m_IntRegistersValueTypes[id_value];
+            if (register_value_type != IntRegisterValueType::NotSet &&
+                register_value_type != IntRegisterValueType::Unsigned)
+            {
+                DLX_WARN("Mismatch for register value type");
+            }
         }
 
         return GetIntRegister(id).GetUnsignedValue();
     }
 
-    void Processor::IntRegisterSetSignedValue(IntRegisterID id, phi::i32 value) noexcept
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::IntRegisterSetSignedValue(IntRegisterID id,
+                                                            phi::i32      value) noexcept
     {
-        PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
-                                             RegisterAccessType::Signed),
-                   "Mismatch for instruction access type");
+        if constexpr (PolicyT::TrackRegisterValueTypes)
+        {
+            PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
+                                                 RegisterAccessType::Signed),
+                       "Mismatch for instruction access type");
+        }
 
         IntRegister& reg = GetIntRegister(id);
 
@@ -137,17 +198,25 @@ namespace dlx
 
         reg.SetSignedValue(value);
 
-        const phi::size_t id_value = phi::to_underlying(id);
+        if constexpr (PolicyT::TrackRegisterValueTypes)
+        {
+            const phi::size_t id_value = phi::to_underlying(id);
 
-        PHI_ASSERT(id_value < m_IntRegistersValueTypes.size());
-        m_IntRegistersValueTypes[id_value] = IntRegisterValueType::Signed;
+            PHI_ASSERT(id_value < m_IntRegistersValueTypes.size());
+            m_IntRegistersValueTypes[id_value] = IntRegisterValueType::Signed;
+        }
     }
 
-    void Processor::IntRegisterSetUnsignedValue(IntRegisterID id, phi::u32 value) noexcept
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::IntRegisterSetUnsignedValue(IntRegisterID id,
+                                                              phi::u32      value) noexcept
     {
-        PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
-                                             RegisterAccessType::Unsigned),
-                   "Mismatch for instruction access type");
+        if constexpr (PolicyT::TrackRegisterValueTypes)
+        {
+            PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
+                                                 RegisterAccessType::Unsigned),
+                       "Mismatch for instruction access type");
+        }
 
         IntRegister& reg = GetIntRegister(id);
 
@@ -158,13 +227,17 @@ namespace dlx
 
         reg.SetUnsignedValue(value);
 
-        const phi::size_t id_value = phi::to_underlying(id);
+        if constexpr (PolicyT::TrackRegisterValueTypes)
+        {
+            const phi::size_t id_value = phi::to_underlying(id);
 
-        PHI_ASSERT(id_value < m_IntRegistersValueTypes.size());
-        m_IntRegistersValueTypes[id_value] = IntRegisterValueType::Unsigned;
+            PHI_ASSERT(id_value < m_IntRegistersValueTypes.size());
+            m_IntRegistersValueTypes[id_value] = IntRegisterValueType::Unsigned;
+        }
     }
 
-    FloatRegister& Processor::GetFloatRegister(FloatRegisterID id) noexcept
+    template <typename PolicyT>
+    FloatRegister& BasicProcessor<PolicyT>::GetFloatRegister(FloatRegisterID id) noexcept
     {
         PHI_ASSERT(id != FloatRegisterID::None);
         const phi::size_t id_value = phi::to_underlying(id);
@@ -174,7 +247,9 @@ namespace dlx
         return m_FloatRegisters[id_value];
     }
 
-    const FloatRegister& Processor::GetFloatRegister(FloatRegisterID id) const noexcept
+    template <typename PolicyT>
+    const FloatRegister& BasicProcessor<PolicyT>::GetFloatRegister(
+            FloatRegisterID id) const noexcept
     {
         PHI_ASSERT(id != FloatRegisterID::None);
         const phi::size_t id_value = phi::to_underlying(id);
@@ -184,22 +259,28 @@ namespace dlx
         return m_FloatRegisters[id_value];
     }
 
-    [[nodiscard]] phi::f32 Processor::FloatRegisterGetFloatValue(FloatRegisterID id) const noexcept
+    template <typename PolicyT>
+    [[nodiscard]] phi::f32 BasicProcessor<PolicyT>::FloatRegisterGetFloatValue(
+            FloatRegisterID id) const noexcept
     {
-        PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
-                                             RegisterAccessType::Float),
-                   "Mismatch for instruction access type");
+        if constexpr (PolicyT::TrackRegisterValueTypes)
+        {
+            PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
+                                                 RegisterAccessType::Float),
+                       "Mismatch for instruction access type");
 
-        const phi::size_t id_value = phi::to_underlying(id);
+            const phi::size_t id_value = phi::to_underlying(id);
 
-        PHI_ASSERT(id_value < m_FloatRegistersValueTypes.size());
-        const FloatRegisterValueType register_value_type = m_FloatRegistersValueTypes[id_value];
-        if (register_value_type != FloatRegisterValueType::NotSet &&
-            register_value_type != FloatRegisterValueType::Float)
-        {
-            /*
-            DLX_WARN("Mismatch for register value type");
-            */
+            PHI_ASSERT(id_value < m_FloatRegistersValueTypes.size());
+            const FloatRegisterValueType register_value_type =
+                    m_FloatRegistersValueTypes[id_value];
+            if (register_value_type != FloatRegisterValueType::NotSet &&
+                register_value_type != FloatRegisterValueType::Float)
+            {
+                /*
+                DLX_WARN("Mismatch for register value type");
+                */
+            }
         }
 
         const FloatRegister& reg = GetFloatRegister(id);
@@ -207,11 +288,16 @@ namespace dlx
         return reg.GetValue();
     }
 
-    [[nodiscard]] phi::f64 Processor::FloatRegisterGetDoubleValue(FloatRegisterID id) noexcept
+    template <typename PolicyT>
+    [[nodiscard]] phi::f64 BasicProcessor<PolicyT>::FloatRegisterGetDoubleValue(
+            FloatRegisterID id) noexcept
     {
-        PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
-                                             RegisterAccessType::Double),
-                   "Mismatch for instruction access type");
+        if constexpr (PolicyT::TrackRegisterValueTypes)
+        {
+            PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
+                                                 RegisterAccessType::Double),
+                       "Mismatch for instruction access type");
+        }
 
         if (phi::to_underlying(id) % 2 == 1)
         {
@@ -219,22 +305,26 @@ namespace dlx
             return {0.0};
         }
 
-        const phi::size_t id_value = phi::to_underlying(id);
-
-        PHI_ASSERT(id_value + 1u < m_FloatRegistersValueTypes.size());
-        const FloatRegisterValueType register_value_type_low = m_FloatRegistersValueTypes[id_value];
-        if (register_value_type_low != FloatRegisterValueType::NotSet &&
-            register_value_type_low != FloatRegisterValueType::DoubleLow)
+        if constexpr (PolicyT::TrackRegisterValueTypes)
         {
-            DLX_WARN("Mismatch for register value type");
-        }
+            const phi::size_t id_value = phi::to_underlying(id);
 
-        const FloatRegisterValueType register_value_type_high =
-                m_FloatRegistersValueTypes[id_value + 1u];
-        if (register_value_type_high != FloatRegisterValueType::NotSet &&
-            register_value_type_high != FloatRegisterValueType::DoubleHigh)
-        {
-            DLX_WARN("Mismatch for register value type");
+            PHI_ASSERT(id_value + 1u < m_FloatRegistersValueTypes.size());
+            const FloatRegisterValueType register_value_type_low =
+                    m_FloatRegistersValueTypes[id_value];
+            if (register_value_type_low != FloatRegisterValueType::NotSet &&
+                register_value_type_low != FloatRegisterValueType::DoubleLow)
+            {
+                DLX_WARN("Mismatch for register value type");
+            }
+
+            const FloatRegisterValueType register_value_type_high =
+                    m_FloatRegistersValueTypes[id_value + 1u];
+            if (register_value_type_high != FloatRegisterValueType::NotSet &&
+                register_value_type_high != FloatRegisterValueType::DoubleHigh)
+            {
+                DLX_WARN("Mismatch for register value type");
+            }
         }
 
         const FloatRegister& first_reg = GetFloatRegister(id);
@@ -260,27 +350,37 @@ namespace dlx
         PHI_CLANG_SUPPRESS_WARNING_POP()
     }
 
-    void Processor::FloatRegisterSetFloatValue(FloatRegisterID id, phi::f32 value) noexcept
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::FloatRegisterSetFloatValue(FloatRegisterID id,
+                                                             phi::f32        value) noexcept
     {
-        PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
-                                             RegisterAccessType::Float),
-                   "Mismatch for instruction access type");
-
         FloatRegister& reg = GetFloatRegister(id);
 
         reg.SetValue(value);
 
-        const phi::size_t id_value = phi::to_underlying(id);
+        if constexpr (PolicyT::TrackRegisterValueTypes)
+        {
+            PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
+                                                 RegisterAccessType::Float),
+                       "Mismatch for instruction access type");
 
-        PHI_ASSERT(id_value < m_FloatRegistersValueTypes.size());
-        m_FloatRegistersValueTypes[id_value] = FloatRegisterValueType::Float;
+            const phi::size_t id_value = phi::to_underlying(id);
+
+            PHI_ASSERT(id_value < m_FloatRegistersValueTypes.size());
+            m_FloatRegistersValueTypes[id_value] = FloatRegisterValueType::Float;
+        }
     }
 
-    void Processor::FloatRegisterSetDoubleValue(FloatRegisterID id, phi::f64 value) noexcept
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::FloatRegisterSetDoubleValue(FloatRegisterID id,
+                                                              phi::f64        value) noexcept
     {
-        PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
-                                             RegisterAccessType::Double),
-                   "Mismatch for instruction access type");
+        if constexpr (PolicyT::TrackRegisterValueTypes)
+        {
+            PHI_ASSERT(RegisterAccessTypeMatches(m_CurrentInstructionAccessType,
+                                                 RegisterAccessType::Double),
+                       "Mismatch for instruction access type");
+        }
 
         if (phi::to_underlying(id) % 2 == 1)
         {
@@ -307,45 +407,115 @@ namespace dlx
         first_reg.SetValue(first_value);
         second_reg.SetValue(second_value);
 
-        const phi::size_t id_value = phi::to_underlying(id);
+        if constexpr (PolicyT::TrackRegisterValueTypes)
+        {
+            const phi::size_t id_value = phi::to_underlying(id);
 
-        PHI_ASSERT(id_value + 1u < m_FloatRegistersValueTypes.size());
-        m_FloatRegistersValueTypes[id_value]      = FloatRegisterValueType::DoubleLow;
-        m_FloatRegistersValueTypes[id_value + 1u] = FloatRegisterValueType::DoubleHigh;
+            PHI_ASSERT(id_value + 1u < m_FloatRegistersValueTypes.size());
+            m_FloatRegistersValueTypes[id_value]      = FloatRegisterValueType::DoubleLow;
+            m_FloatRegistersValueTypes[id_value + 1u] = FloatRegisterValueType::DoubleHigh;
+        }
     }
 
-    StatusRegister& Processor::GetFPSR() noexcept
+    template <typename PolicyT>
+    StatusRegister& BasicProcessor<PolicyT>::GetFPSR() noexcept
     {
         return m_FPSR;
     }
 
-    const StatusRegister& Processor::GetFPSR() const noexcept
+    template <typename PolicyT>
+    const StatusRegister& BasicProcessor<PolicyT>::GetFPSR() const noexcept
     {
         return m_FPSR;
     }
 
-    phi::boolean Processor::GetFPSRValue() const noexcept
+    template <typename PolicyT>
+    phi::boolean BasicProcessor<PolicyT>::GetFPSRValue() const noexcept
     {
         const StatusRegister& status_reg = GetFPSR();
 
         return status_reg.Get();
     }
 
-    void Processor::SetFPSRValue(phi::boolean value) noexcept
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::SetFPSRValue(phi::boolean value) noexcept
     {
         StatusRegister& status_reg = GetFPSR();
 
         status_reg.SetStatus(value);
     }
 
-    void Processor::ExecuteInstruction(const Instruction& inst) noexcept
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ExecuteInstruction(const Instruction& inst) noexcept
+    {
+        const phi::boolean completed = RunGuarded([&]() {
+            if constexpr (PolicyT::TrackRegisterValueTypes)
+            {
+                m_CurrentInstructionAccessType = inst.GetInfo().GetRegisterAccessType();
+
+                inst.Execute(*this);
+            }
+            else
+            {
+                ExecuteInstruction(DecodeInstruction(inst));
+            }
+        });
+
+        if (!completed)
+        {
+            Raise(Exception::AddressOutOfBounds);
+        }
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ExecuteInstruction(const DecodedInstruction& inst) noexcept
+    {
+        const phi::boolean completed = RunGuarded([&]() {
+            if constexpr (PolicyT::TrackRegisterValueTypes)
+            {
+                PHI_ASSERT(inst.executor, "No execution function defined");
+
+                m_CurrentInstructionAccessType = inst.register_access_type;
+
+                inst.executor(*this, inst);
+            }
+            else
+            {
+                // The executors stored in the decoded instructions are bound to the checked
+                // processor
+                dispatch_instruction(*this, inst);
+            }
+        });
+
+        if (!completed)
+        {
+            Raise(Exception::AddressOutOfBounds);
+        }
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ExecuteObservedInstruction(
+            const DecodedInstruction& inst) noexcept
     {
-        m_CurrentInstructionAccessType = inst.GetInfo().GetRegisterAccessType();
+        ObservingProcessor<BasicProcessor> observing{*this};
+
+        const phi::boolean completed = RunGuarded([&]() {
+            if constexpr (PolicyT::TrackRegisterValueTypes)
+            {
+                m_CurrentInstructionAccessType = inst.register_access_type;
+            }
+
+            dispatch_instruction(observing, inst);
+        });
 
-        inst.Execute(*this);
+        if (!completed)
+        {
+            Raise(Exception::AddressOutOfBounds);
+        }
     }
 
-    phi::boolean Processor::LoadProgram(ParsedProgram& program) noexcept
+    template <typename PolicyT>
+    phi::boolean BasicProcessor<PolicyT>::LoadProgram(const ParsedProgram& program) noexcept
     {
         if (!program.m_ParseErrors.empty())
         {
@@ -354,6 +524,33 @@ namespace dlx
         }
 
         m_CurrentProgram = &program;
+        m_SharedProgram.reset();
+        m_DecodedProgram = DecodeProgram(program);
+        m_BlockCache.Reset(m_DecodedProgram.m_Instructions.size());
+        m_JITCompiler.Reset(m_DecodedProgram.m_Instructions.size());
+        m_Breakpoints.assign((m_DecodedProgram.m_Instructions.size() + 63u) / 64u, 0u);
+        m_Profile.Reset(m_DecodedProgram.m_Instructions.size());
+        ClearUndoHistory();
+
+        if (m_PipelineModel)
+        {
+            m_PipelineModel->Load(m_DecodedProgram);
+        }
+
+        if (m_BranchPredictor)
+        {
+            m_BranchPredictor->Load(m_DecodedProgram);
+        }
+
+        if (m_OutOfOrderModel)
+        {
+            m_OutOfOrderModel->Load(m_DecodedProgram);
+        }
+
+        if (m_CacheSimulator)
+        {
+            m_CacheSimulator->Reset(m_DecodedProgram.m_Instructions.size());
+        }
 
         m_ProgramCounter               = 0u;
         m_Halted                       = false;
@@ -361,15 +558,61 @@ namespace dlx
         m_LastRaisedException          = Exception::None;
         m_CurrentStepCount             = 0u;
 
+        // Labels are resolved by the parser so unknown labels are reported before executing
+        if (program.m_HasUnresolvedLabels)
+        {
+            Raise(Exception::UnknownLabel);
+        }
+
+        return true;
+    }
+
+    template <typename PolicyT>
+    phi::boolean BasicProcessor<PolicyT>::LoadProgram(
+            std::shared_ptr<const ParsedProgram> program) noexcept
+    {
+        PHI_ASSERT(program);
+
+        if (!LoadProgram(*program))
+        {
+            return false;
+        }
+
+        m_SharedProgram = phi::move(program);
+
         return true;
     }
 
-    phi::observer_ptr<ParsedProgram> Processor::GetCurrentProgram() const noexcept
+    template <typename PolicyT>
+    phi::observer_ptr<const ParsedProgram> BasicProcessor<PolicyT>::GetCurrentProgram()
+            const noexcept
     {
         return m_CurrentProgram;
     }
 
-    void Processor::ExecuteStep() noexcept
+    template <typename PolicyT>
+    const DecodedProgram& BasicProcessor<PolicyT>::GetDecodedProgram() const noexcept
+    {
+        return m_DecodedProgram;
+    }
+
+    template <typename PolicyT>
+    const BlockCache& BasicProcessor<PolicyT>::GetBlockCache() const noexcept
+    {
+        return m_BlockCache;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ExecuteStep() noexcept
+    {
+        if (!RunGuarded([this]() { ExecuteSingleStep(); }))
+        {
+            HandleGuardedMemoryFault();
+        }
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ExecuteSingleStep() noexcept
     {
         // No nothing when no program is loaded
         if (!m_CurrentProgram)
@@ -378,7 +621,7 @@ namespace dlx
         }
 
         // Halt if there are no instruction to execute
-        if (m_CurrentProgram->m_Instructions.empty())
+        if (m_DecodedProgram.m_Instructions.empty())
         {
             m_Halted                       = true;
             m_CurrentInstructionAccessType = RegisterAccessType::Ignored;
@@ -390,15 +633,128 @@ namespace dlx
             return;
         }
 
+        // Get current instruction pointed to by the program counter
+        const DecodedInstruction& current_instruction =
+                m_DecodedProgram.m_Instructions.at(m_ProgramCounter.unsafe());
+
+        if (m_ReverseExecutionEnabled)
+        {
+            if (m_UndoCheckpoints.empty() ||
+                m_UndoLog.GetEndStep() - m_UndoCheckpoints.back().step >= UndoCheckpoint::Interval)
+            {
+                // Checkpoints before the oldest step can't be used anymore
+                const phi::uint64_t first_step = m_UndoLog.GetFirstStep();
+                m_UndoCheckpoints.erase(m_UndoCheckpoints.begin(),
+                                        std::find_if(m_UndoCheckpoints.begin(),
+                                                     m_UndoCheckpoints.end(),
+                                                     [&](const UndoCheckpoint& checkpoint) {
+                                                         return checkpoint.step >= first_step;
+                                                     }));
+
+                if (m_UndoCheckpoints.size() == UndoCheckpoint::MaximumNumber)
+                {
+                    m_UndoCheckpoints.erase(m_UndoCheckpoints.begin());
+                }
+
+                UndoCheckpoint& checkpoint = m_UndoCheckpoints.emplace_back();
+                checkpoint.step            = m_UndoLog.GetEndStep();
+                checkpoint.position        = m_UndoLog.GetEndPosition();
+                CaptureState(checkpoint.snapshot);
+            }
+
+            // Everything which changes with every instruction is stored in the step record. The
+            // instruction itself records the registers and memory it modifies.
+            UndoRecord record;
+            record.type = UndoRecordType::Step;
+            record.info = static_cast<phi::uint8_t>(
+                    (m_FPSR.Get() ? UndoRecord::StepFlagFPSR : 0u) |
+                    (m_Halted ? UndoRecord::StepFlagHalted : 0u));
+            record.extra        = static_cast<phi::uint8_t>(m_LastRaisedException);
+            record.address      = m_ProgramCounter.unsafe();
+            record.next_address = m_NextProgramCounter.unsafe();
+            record.value        = m_CurrentStepCount.unsafe();
+
+            m_UndoLog.BeginStep(record);
+            m_ObservingAccesses = true;
+        }
+
+        if (m_TracingEnabled)
+        {
+            m_TraceRecord                 = TraceRecord{};
+            m_TraceRecord.step            = m_CurrentStepCount.unsafe();
+            m_TraceRecord.program_counter = m_ProgramCounter.unsafe();
+            m_TraceRecord.opcode          = static_cast<phi::uint16_t>(current_instruction.opcode);
+            m_ObservingAccesses           = true;
+        }
+
+        if (m_CacheSimulator)
+        {
+            m_CacheSimulator->FetchInstruction(m_ProgramCounter.unsafe());
+            m_ObservingAccesses = true;
+        }
+
         // Increase Next program counter (may be later overwritten by branch instructions)
         m_NextProgramCounter = m_ProgramCounter + 1u;
 
-        // Get current instruction pointed to by the program counter
-        const auto& current_instruction =
-                m_CurrentProgram->m_Instructions.at(m_ProgramCounter.unsafe());
-
         // Execute current instruction
-        ExecuteInstruction(current_instruction);
+        if (m_ObservingAccesses)
+        {
+            ExecuteObservedInstruction(current_instruction);
+        }
+        else
+        {
+            ExecuteInstruction(current_instruction);
+        }
+
+        m_ObservingAccesses = false;
+
+        if (m_ProfilingEnabled || m_PipelineModel || m_BranchPredictor)
+        {
+            const OpCode       opcode           = current_instruction.opcode;
+            const phi::boolean control_transfer = IsControlTransferInstruction(opcode);
+            const phi::boolean taken =
+                    control_transfer && m_NextProgramCounter != m_ProgramCounter + 1u;
+
+            if (m_ProfilingEnabled)
+            {
+                m_Profile.Record(m_ProgramCounter.unsafe(), taken,
+                                 IsMemoryAccessInstruction(opcode));
+            }
+
+            // The predictor decides how many cycles are lost after a control transfer
+            if (m_BranchPredictor && control_transfer)
+            {
+                const phi::uint8_t penalty = m_BranchPredictor->Resolve(
+                        m_ProgramCounter.unsafe(), taken, m_NextProgramCounter.unsafe());
+
+                if (m_PipelineModel)
+                {
+                    m_PipelineModel->RetireWithPenalty(m_ProgramCounter.unsafe(), penalty);
+                }
+            }
+            else if (m_PipelineModel)
+            {
+                m_PipelineModel->Retire(m_ProgramCounter.unsafe(), taken);
+            }
+        }
+
+        if (m_OutOfOrderModel)
+        {
+            m_OutOfOrderModel->Retire(m_ProgramCounter.unsafe());
+        }
+
+        if (m_TracingEnabled)
+        {
+            if (m_Halted)
+            {
+                m_TraceRecord.flags |= TraceRecord::FlagHalted;
+            }
+
+            if (m_TraceWriter)
+            {
+                m_TraceWriter->Append(m_TraceRecord);
+            }
+        }
 
         // Stop executing if the last instruction halted the processor
         if (m_Halted)
@@ -412,14 +768,15 @@ namespace dlx
         ++m_CurrentStepCount;
 
         if ((m_MaxNumberOfSteps != 0u && m_CurrentStepCount >= m_MaxNumberOfSteps) ||
-            (m_ProgramCounter >= m_CurrentProgram->m_Instructions.size()))
+            (m_ProgramCounter >= m_DecodedProgram.m_Instructions.size()))
         {
             m_Halted                       = true;
             m_CurrentInstructionAccessType = RegisterAccessType::Ignored;
         }
     }
 
-    void Processor::ExecuteCurrentProgram() noexcept
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ExecuteCurrentProgram() noexcept
     {
         // Do nothing when no program is loaded
         if (!m_CurrentProgram)
@@ -433,65 +790,1073 @@ namespace dlx
         m_LastRaisedException          = Exception::None;
         m_CurrentStepCount             = 0u;
 
-        while (!m_Halted)
+        // Running the whole program isn't recorded so the previous history doesn't apply anymore
+        ClearUndoHistory();
+        m_Profile.Clear();
+        if (m_PipelineModel)
+        {
+            m_PipelineModel->Clear();
+        }
+
+        if (m_BranchPredictor)
+        {
+            m_BranchPredictor->Clear();
+        }
+
+        if (m_OutOfOrderModel)
+        {
+            m_OutOfOrderModel->Clear();
+        }
+
+        if (m_CacheSimulator)
+        {
+            m_CacheSimulator->Clear();
+        }
+
+        const phi::boolean reverse_execution_enabled = m_ReverseExecutionEnabled;
+        m_ReverseExecutionEnabled                    = false;
+
+        if (m_CurrentProgram->m_HasUnresolvedLabels)
+        {
+            Raise(Exception::UnknownLabel);
+        }
+
+        // The threaded and compiled code don't trace, profile, time, predict or cache instructions
+        if (m_TracingEnabled || m_ProfilingEnabled || m_PipelineModel || m_BranchPredictor ||
+            m_OutOfOrderModel || m_CacheSimulator)
         {
-            ExecuteStep();
+            if (!m_Halted && !RunGuarded([this]() {
+                    while (!m_Halted)
+                    {
+                        ExecuteSingleStep();
+                    }
+                }))
+            {
+                HandleGuardedMemoryFault();
+            }
+        }
+        else if (!m_Halted && !RunGuarded([this]() { ExecuteThreaded(); }))
+        {
+            HandleGuardedMemoryFault();
         }
 
+        m_ReverseExecutionEnabled = reverse_execution_enabled;
+
         PHI_ASSERT(m_CurrentInstructionAccessType == RegisterAccessType::Ignored,
                    "RegisterAccessType was not reset correctly");
     }
 
-    void Processor::Reset() noexcept
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::SetBreakpoint(phi::u32 instruction_index,
+                                                phi::boolean enabled) noexcept
     {
-        ClearMemory();
-        ClearMemory();
-        m_CurrentProgram.reset();
-        m_ProgramCounter               = 0u;
-        m_NextProgramCounter           = 0u;
-        m_Halted                       = true;
-        m_CurrentInstructionAccessType = RegisterAccessType::Ignored;
-        m_LastRaisedException          = Exception::None;
-        m_CurrentStepCount             = 0u;
-    }
+        const phi::uint32_t index = instruction_index.unsafe();
 
-    void Processor::ClearRegisters() noexcept
-    {
-        for (auto& reg : m_IntRegisters)
+        if (index >= m_DecodedProgram.m_Instructions.size())
         {
-            reg.SetSignedValue(0);
+            DLX_WARN("Trying to set breakpoint on non existing instruction {}", index);
+            return;
         }
 
-        for (auto& reg : m_FloatRegisters)
+        const phi::uint64_t mask = phi::uint64_t{1u} << (index % 64u);
+
+        if (enabled)
         {
-            reg.SetValue(0.0f);
+            m_Breakpoints[index / 64u] |= mask;
+        }
+        else
+        {
+            m_Breakpoints[index / 64u] &= ~mask;
         }
+    }
 
-        m_FPSR.SetStatus(false);
+    template <typename PolicyT>
+    phi::boolean BasicProcessor<PolicyT>::HasBreakpoint(phi::u32 instruction_index) const noexcept
+    {
+        const phi::uint32_t index = instruction_index.unsafe();
+
+        return index < m_DecodedProgram.m_Instructions.size() &&
+               (m_Breakpoints[index / 64u] >> (index % 64u) & 1u) != 0u;
     }
 
-    void Processor::ClearMemory() noexcept
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::SetBreakpointsFromSourceLines(
+            const std::unordered_set<phi::uint32_t>& source_lines) noexcept
     {
-        m_MemoryBlock.Clear();
+        ClearBreakpoints();
+
+        if (!m_CurrentProgram)
+        {
+            return;
+        }
+
+        const std::vector<Instruction>& instructions = m_CurrentProgram->m_Instructions;
+        for (phi::uint32_t index{0u}; index < instructions.size(); ++index)
+        {
+            const phi::uint64_t source_line = instructions[index].GetSourceLine().unsafe();
+
+            if (source_line <= phi::u32::limits_type::max() &&
+                source_lines.contains(static_cast<phi::uint32_t>(source_line)))
+            {
+                SetBreakpoint(index, true);
+            }
+        }
     }
 
-    PHI_CLANG_AND_GCC_SUPPRESS_WARNING_PUSH()
-    PHI_CLANG_AND_GCC_SUPPRESS_WARNING("-Wswitch")
-    PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(4702) // Unreachable code
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ClearBreakpoints() noexcept
+    {
+        std::fill(m_Breakpoints.begin(), m_Breakpoints.end(), phi::uint64_t{0u});
+    }
 
-    void Processor::Raise(Exception exception) noexcept
+    template <typename PolicyT>
+    StopReason BasicProcessor<PolicyT>::RunUntilBreak(phi::usize max_steps) noexcept
     {
-        PHI_ASSERT(exception != Exception::None, "Cannot raise None exception");
+        if (!m_CurrentProgram)
+        {
+            return StopReason::Halted;
+        }
 
-        m_LastRaisedException = exception;
+        StopReason reason = StopReason::StepLimit;
 
-        switch (exception)
+        const phi::boolean completed = RunGuarded([&]() {
+            const phi::size_t steps = max_steps.unsafe();
+
+            for (phi::size_t step{0u}; step < steps; ++step)
+            {
+                if (m_Halted)
+                {
+                    reason = StopReason::Halted;
+                    return;
+                }
+
+                const phi::uint32_t pc = m_ProgramCounter.unsafe();
+                if (step != 0u && (m_Breakpoints[pc / 64u] >> (pc % 64u) & 1u) != 0u)
+                {
+                    reason = StopReason::Breakpoint;
+                    return;
+                }
+
+                ExecuteSingleStep();
+            }
+
+            if (m_Halted)
+            {
+                reason = StopReason::Halted;
+            }
+        });
+
+        if (!completed)
         {
-            case Exception::DivideByZero:
-                m_Halted = true;
-                DLX_ERROR("Division through zero");
-                return;
-            case Exception::Overflow:
+            HandleGuardedMemoryFault();
+            return StopReason::Halted;
+        }
+
+        return reason;
+    }
+
+    PHI_GCC_SUPPRESS_WARNING_PUSH()
+    PHI_GCC_SUPPRESS_WARNING("-Wpedantic")
+    PHI_CLANG_SUPPRESS_WARNING_PUSH()
+    PHI_CLANG_SUPPRESS_WARNING("-Wgnu-label-as-value")
+    PHI_CLANG_SUPPRESS_WARNING("-Wswitch-default")
+
+    // Runs the loaded program until the processor halts. Produces exactly the same results as
+    // calling ExecuteStep in a loop but executes whole straight line blocks from the block cache,
+    // only checking the step budget and program counter bounds at block boundaries.
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ExecuteThreaded() noexcept
+    {
+        const std::vector<DecodedInstruction>& instructions = m_DecodedProgram.m_Instructions;
+        const std::vector<phi::uint32_t>&      block_ends   = m_DecodedProgram.m_BlockEnds;
+
+        const phi::size_t number_of_instructions = instructions.size();
+        const phi::size_t max_steps              = m_MaxNumberOfSteps.unsafe();
+
+        phi::size_t           steps       = m_CurrentStepCount.unsafe();
+        phi::uint32_t         pc          = m_ProgramCounter.unsafe();
+        phi::uint32_t         block_start = 0u;
+        phi::uint32_t         block_end   = 0u;
+        const BlockOperation* operation   = nullptr;
+
+#if DLX_PROCESSOR_USE_COMPUTED_GOTO
+        static const void* const dispatch_table[] = {
+#    define DLX_ENUM_OPCODE_IMPL(name) &&execute_##name,
+                DLX_ENUM_OPCODE
+#    undef DLX_ENUM_OPCODE_IMPL
+#    define DLX_ENUM_SUPERINSTRUCTION_IMPL(name) &&execute_##name,
+                DLX_ENUM_SUPERINSTRUCTION
+#    undef DLX_ENUM_SUPERINSTRUCTION_IMPL
+                &&end_of_block,
+        };
+
+        static_assert(sizeof(dispatch_table) / sizeof(dispatch_table[0]) ==
+                      BlockOperation::EndOfBlockHandler + 1u);
+
+#    define DLX_DISPATCH() goto* dispatch_table[operation->handler]
+#    define DLX_HANDLER(name, handler_id) execute_##name:
+#    define DLX_END_OF_BLOCK_HANDLER() end_of_block:
+#else
+#    define DLX_DISPATCH() goto dispatch
+#    define DLX_HANDLER(name, handler_id) case handler_id:
+#    define DLX_END_OF_BLOCK_HANDLER() case BlockOperation::EndOfBlockHandler:
+#endif
+
+        // Executes the instruction at the given offset from the first instruction of the current
+        // operation exactly like ExecuteStep does
+#define DLX_EXECUTE(name, offset)                                                                  \
+    m_NextProgramCounter = operation->index + (offset) + 1u;                                       \
+    if constexpr (PolicyT::TrackRegisterValueTypes)                                                \
+    {                                                                                              \
+        m_CurrentInstructionAccessType = operation->instruction[offset].register_access_type;     \
+    }                                                                                              \
+                                                                                                   \
+    impl::name(*this, operation->instruction[offset]);                                             \
+                                                                                                   \
+    if (m_Halted)                                                                                  \
+    {                                                                                              \
+        pc = operation->index + (offset);                                                          \
+        goto halted_in_block;                                                                      \
+    }
+
+        // Control transfer instructions always end the block so they skip the end of block marker
+#define DLX_ENUM_OPCODE_IMPL(name)                                                                 \
+    DLX_HANDLER(name, static_cast<phi::uint32_t>(OpCode::name))                                    \
+    {                                                                                              \
+        DLX_EXECUTE(name, 0u)                                                                      \
+                                                                                                   \
+        if (IsControlTransferInstruction(OpCode::name))                                            \
+        {                                                                                          \
+            goto block_finished;                                                                   \
+        }                                                                                          \
+                                                                                                   \
+        ++operation;                                                                               \
+        DLX_DISPATCH();                                                                            \
+    }
+
+#define DLX_SUPERINSTRUCTION_HANDLER(name)                                                         \
+    DLX_HANDLER(name, BlockOperation::FirstSuperinstructionHandler +                               \
+                              static_cast<phi::uint32_t>(Superinstruction::name))
+
+    block_boundary:
+        if ((max_steps != 0u && steps >= max_steps) || pc >= number_of_instructions)
+        {
+            m_Halted = true;
+            goto halted;
+        }
+
+        // Lets a faulting access to guarded memory work out where inside the block it happened
+        m_ProgramCounter   = pc;
+        m_CurrentStepCount = steps;
+
+        block_end = block_ends[pc];
+
+        // Not enough steps left to execute the whole block so finish step by step
+        if (max_steps != 0u && steps + (block_end - pc + 1u) > max_steps)
+        {
+            while (!m_Halted)
+            {
+                ExecuteSingleStep();
+            }
+
+            return;
+        }
+
+        if (m_JITEnabled)
+        {
+            const JITCompiler::CompiledBlock compiled_block =
+                    m_JITCompiler.GetOrCompileBlock<BasicProcessor>(m_DecodedProgram, pc);
+
+            if (compiled_block != nullptr)
+            {
+                const phi::uint64_t result =
+                        compiled_block(this, m_IntRegisters.data(), m_IntRegistersValueTypes.data(),
+                                       instructions.data());
+
+                steps += static_cast<phi::size_t>(result >> 32u);
+                pc = static_cast<phi::uint32_t>(result);
+
+                if (m_Halted)
+                {
+                    goto halted;
+                }
+
+                m_NextProgramCounter = pc;
+                goto block_boundary;
+            }
+        }
+
+        block_start = pc;
+        operation   = m_BlockCache.GetBlock(m_DecodedProgram, pc);
+        DLX_DISPATCH();
+
+#if DLX_PROCESSOR_USE_COMPUTED_GOTO
+        {
+#else
+    dispatch:
+        switch (operation->handler)
+        {
+#endif
+            DLX_ENUM_OPCODE
+
+            DLX_SUPERINSTRUCTION_HANDLER(SLT_BEQZ)
+            {
+                DLX_EXECUTE(SLT, 0u)
+                DLX_EXECUTE(BEQZ, 1u)
+
+                goto block_finished;
+            }
+
+            DLX_SUPERINSTRUCTION_HANDLER(ADDI_J)
+            {
+                DLX_EXECUTE(ADDI, 0u)
+                DLX_EXECUTE(J, 1u)
+
+                goto block_finished;
+            }
+
+            DLX_SUPERINSTRUCTION_HANDLER(LW_ADD_SW)
+            {
+                DLX_EXECUTE(LW, 0u)
+                DLX_EXECUTE(ADD, 1u)
+                DLX_EXECUTE(SW, 2u)
+
+                ++operation;
+                DLX_DISPATCH();
+            }
+
+            DLX_END_OF_BLOCK_HANDLER()
+            {
+                goto block_finished;
+            }
+
+#if !DLX_PROCESSOR_USE_COMPUTED_GOTO && !defined(DLXEMU_COVERAGE_BUILD)
+            default:
+                PHI_ASSERT_NOT_REACHED();
+                break;
+#endif
+        }
+
+#undef DLX_SUPERINSTRUCTION_HANDLER
+#undef DLX_ENUM_OPCODE_IMPL
+#undef DLX_EXECUTE
+#undef DLX_END_OF_BLOCK_HANDLER
+#undef DLX_HANDLER
+#undef DLX_DISPATCH
+
+    block_finished:
+        // Every instruction of the block was executed so all steps are accounted at once
+        steps += block_end - block_start + 1u;
+        pc = m_NextProgramCounter.unsafe();
+        goto block_boundary;
+
+    halted_in_block:
+        // The halting instruction is not counted
+        steps += pc - block_start;
+
+    halted:
+        m_ProgramCounter               = pc;
+        m_CurrentStepCount             = steps;
+        m_CurrentInstructionAccessType = RegisterAccessType::Ignored;
+    }
+
+    PHI_CLANG_SUPPRESS_WARNING_POP()
+    PHI_GCC_SUPPRESS_WARNING_POP()
+
+    template <typename PolicyT>
+    template <typename FunctionT>
+    phi::boolean BasicProcessor<PolicyT>::RunGuarded(FunctionT function) noexcept
+    {
+#if DLX_GUARDED_MEMORY_SUPPORTED
+        const GuardedRegion& region = m_MemoryBlock.GetGuardedRegion();
+
+        if (m_MemoryBlock.IsGuarded() && !IsInGuardedExecution(region))
+        {
+            GuardedExecution execution;
+            EnterGuardedExecution(execution, region);
+
+            // A faulting access jumps back here skipping the rest of the function. The executors
+            // don't own any resources so nothing is leaked.
+            if (sigsetjmp(execution.environment, 0) != 0)
+            {
+                LeaveGuardedExecution(execution);
+                return false;
+            }
+
+            function();
+
+            LeaveGuardedExecution(execution);
+            return true;
+        }
+#endif
+
+        function();
+        return true;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::HandleGuardedMemoryFault() noexcept
+    {
+        // Both write the program counter and step count before the first instruction they
+        // execute and set the next program counter before every instruction. Loads and stores
+        // never change the next program counter.
+        const phi::u32 faulting_program_counter = m_NextProgramCounter - 1u;
+
+        m_CurrentStepCount +=
+                static_cast<phi::size_t>((faulting_program_counter - m_ProgramCounter).unsafe());
+        m_ProgramCounter = faulting_program_counter;
+
+        // Still set when the fault happened in the middle of a traced step
+        const phi::boolean trace_step = m_ObservingAccesses && m_TracingEnabled;
+
+        Raise(Exception::AddressOutOfBounds);
+
+        m_CurrentInstructionAccessType = RegisterAccessType::Ignored;
+        m_ObservingAccesses            = false;
+
+        // Only ExecuteSingleStep runs while profiling or timing and it didn't get to count the
+        // access
+        if (m_ProfilingEnabled)
+        {
+            m_Profile.Record(faulting_program_counter.unsafe(), false, true);
+        }
+
+        if (m_PipelineModel)
+        {
+            m_PipelineModel->Retire(faulting_program_counter.unsafe(), false);
+        }
+
+        if (m_OutOfOrderModel)
+        {
+            m_OutOfOrderModel->Retire(faulting_program_counter.unsafe());
+        }
+
+        if (trace_step)
+        {
+            m_TraceRecord.flags |= TraceRecord::FlagHalted;
+
+            if (m_TraceWriter)
+            {
+                m_TraceWriter->Append(m_TraceRecord);
+            }
+        }
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::Reset() noexcept
+    {
+        ClearMemory();
+        m_CurrentProgram.reset();
+        m_SharedProgram.reset();
+        m_DecodedProgram.m_Instructions.clear();
+        m_BlockCache.Reset(0u);
+        m_JITCompiler.Reset(0u);
+        m_Breakpoints.clear();
+        m_Profile.Reset(0u);
+        ClearUndoHistory();
+
+        if (m_PipelineModel)
+        {
+            m_PipelineModel->Load(m_DecodedProgram);
+        }
+
+        if (m_BranchPredictor)
+        {
+            m_BranchPredictor->Load(m_DecodedProgram);
+        }
+
+        if (m_OutOfOrderModel)
+        {
+            m_OutOfOrderModel->Load(m_DecodedProgram);
+        }
+
+        if (m_CacheSimulator)
+        {
+            m_CacheSimulator->Reset(0u);
+        }
+
+        m_ProgramCounter               = 0u;
+        m_NextProgramCounter           = 0u;
+        m_Halted                       = true;
+        m_CurrentInstructionAccessType = RegisterAccessType::Ignored;
+        m_LastRaisedException          = Exception::None;
+        m_CurrentStepCount             = 0u;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::SetReverseExecutionEnabled(phi::boolean enabled,
+                                                             phi::usize   capacity) noexcept
+    {
+        m_ReverseExecutionEnabled = enabled;
+
+        // Also releases the buffer which is only allocated once recording
+        m_UndoLog.SetCapacity(capacity.unsafe());
+        ClearUndoHistory();
+    }
+
+    template <typename PolicyT>
+    phi::boolean BasicProcessor<PolicyT>::IsReverseExecutionEnabled() const noexcept
+    {
+        return m_ReverseExecutionEnabled;
+    }
+
+    template <typename PolicyT>
+    phi::usize BasicProcessor<PolicyT>::GetNumberOfUndoableSteps() const noexcept
+    {
+        return m_UndoLog.GetNumberOfSteps();
+    }
+
+    template <typename PolicyT>
+    phi::usize BasicProcessor<PolicyT>::StepBack(phi::usize steps) noexcept
+    {
+        const phi::size_t count = std::min(steps.unsafe(), m_UndoLog.GetNumberOfSteps());
+        if (count == 0u)
+        {
+            return 0u;
+        }
+
+        const phi::uint64_t target_step = m_UndoLog.GetEndStep() - count;
+
+        // Replaying from the closest checkpoint before the target is faster when it needs fewer
+        // instructions than undoing them one by one
+        const auto checkpoint = std::find_if(m_UndoCheckpoints.rbegin(), m_UndoCheckpoints.rend(),
+                                             [&](const UndoCheckpoint& candidate) {
+                                                 return candidate.step <= target_step;
+                                             });
+
+        if (checkpoint == m_UndoCheckpoints.rend() ||
+            checkpoint->step < m_UndoLog.GetFirstStep() || target_step - checkpoint->step >= count)
+        {
+            for (phi::size_t step{0u}; step < count; ++step)
+            {
+                UndoStep();
+            }
+
+            return count;
+        }
+
+        // Everything after the checkpoint is recorded again while replaying
+        m_UndoLog.Truncate(checkpoint->position, checkpoint->step);
+        m_UndoCheckpoints.erase(checkpoint.base(), m_UndoCheckpoints.end());
+
+        RestoreState(m_UndoCheckpoints.back().snapshot);
+
+        // The replayed instructions were already traced, profiled, timed, predicted and cached
+        const phi::boolean                       tracing_enabled   = m_TracingEnabled;
+        const phi::boolean                       profiling_enabled = m_ProfilingEnabled;
+        const phi::observer_ptr<PipelineModel>   pipeline_model    = m_PipelineModel;
+        const phi::observer_ptr<BranchPredictor> branch_predictor  = m_BranchPredictor;
+        const phi::observer_ptr<OutOfOrderModel> out_of_order      = m_OutOfOrderModel;
+        const phi::observer_ptr<CacheSimulator>  cache_simulator   = m_CacheSimulator;
+        m_TracingEnabled                                           = false;
+        m_ProfilingEnabled                                         = false;
+        m_PipelineModel.reset();
+        m_BranchPredictor.reset();
+        m_OutOfOrderModel.reset();
+        m_CacheSimulator.reset();
+
+        const phi::uint64_t replay_steps = target_step - m_UndoCheckpoints.back().step;
+        const phi::boolean  completed    = RunGuarded([&]() {
+            for (phi::uint64_t step{0u}; step < replay_steps; ++step)
+            {
+                ExecuteSingleStep();
+            }
+        });
+
+        if (!completed)
+        {
+            HandleGuardedMemoryFault();
+        }
+
+        m_TracingEnabled   = tracing_enabled;
+        m_ProfilingEnabled = profiling_enabled;
+        m_PipelineModel    = pipeline_model;
+        m_BranchPredictor  = branch_predictor;
+        m_OutOfOrderModel  = out_of_order;
+        m_CacheSimulator   = cache_simulator;
+
+        return count;
+    }
+
+    template <typename PolicyT>
+    StopReason BasicProcessor<PolicyT>::RunBackwardsUntilBreak(phi::usize max_steps) noexcept
+    {
+        const phi::size_t steps = max_steps.unsafe();
+
+        for (phi::size_t step{0u}; step < steps; ++step)
+        {
+            if (m_UndoLog.IsEmpty())
+            {
+                return StopReason::StartOfHistory;
+            }
+
+            UndoStep();
+
+            if (HasBreakpoint(m_ProgramCounter))
+            {
+                return StopReason::Breakpoint;
+            }
+        }
+
+        return StopReason::StepLimit;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::SetTraceWriter(phi::observer_ptr<TraceWriter> writer) noexcept
+    {
+        m_TraceWriter    = writer;
+        m_TracingEnabled = writer != nullptr;
+    }
+
+    template <typename PolicyT>
+    phi::observer_ptr<TraceWriter> BasicProcessor<PolicyT>::GetTraceWriter() const noexcept
+    {
+        return m_TraceWriter;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::SetTracingEnabled(phi::boolean enabled) noexcept
+    {
+        m_TracingEnabled = enabled;
+
+        if (!enabled)
+        {
+            m_TraceWriter.reset();
+        }
+    }
+
+    template <typename PolicyT>
+    phi::boolean BasicProcessor<PolicyT>::IsTracingEnabled() const noexcept
+    {
+        return m_TracingEnabled;
+    }
+
+    template <typename PolicyT>
+    const TraceRecord& BasicProcessor<PolicyT>::GetLastTraceRecord() const noexcept
+    {
+        return m_TraceRecord;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::SetProfilingEnabled(phi::boolean enabled) noexcept
+    {
+        m_ProfilingEnabled = enabled;
+    }
+
+    template <typename PolicyT>
+    phi::boolean BasicProcessor<PolicyT>::IsProfilingEnabled() const noexcept
+    {
+        return m_ProfilingEnabled;
+    }
+
+    template <typename PolicyT>
+    const ExecutionProfile& BasicProcessor<PolicyT>::GetProfile() const noexcept
+    {
+        return m_Profile;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ClearProfile() noexcept
+    {
+        m_Profile.Clear();
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::SetPipelineModel(phi::observer_ptr<PipelineModel> model) noexcept
+    {
+        m_PipelineModel = model;
+
+        if (m_PipelineModel)
+        {
+            m_PipelineModel->Load(m_DecodedProgram);
+        }
+    }
+
+    template <typename PolicyT>
+    phi::observer_ptr<PipelineModel> BasicProcessor<PolicyT>::GetPipelineModel() const noexcept
+    {
+        return m_PipelineModel;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::SetBranchPredictor(
+            phi::observer_ptr<BranchPredictor> predictor) noexcept
+    {
+        m_BranchPredictor = predictor;
+
+        if (m_BranchPredictor)
+        {
+            m_BranchPredictor->Load(m_DecodedProgram);
+        }
+    }
+
+    template <typename PolicyT>
+    phi::observer_ptr<BranchPredictor> BasicProcessor<PolicyT>::GetBranchPredictor() const noexcept
+    {
+        return m_BranchPredictor;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::SetOutOfOrderModel(
+            phi::observer_ptr<OutOfOrderModel> model) noexcept
+    {
+        m_OutOfOrderModel = model;
+
+        if (m_OutOfOrderModel)
+        {
+            m_OutOfOrderModel->Load(m_DecodedProgram);
+        }
+    }
+
+    template <typename PolicyT>
+    phi::observer_ptr<OutOfOrderModel> BasicProcessor<PolicyT>::GetOutOfOrderModel() const noexcept
+    {
+        return m_OutOfOrderModel;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::SetCacheSimulator(
+            phi::observer_ptr<CacheSimulator> simulator) noexcept
+    {
+        m_CacheSimulator = simulator;
+
+        if (m_CacheSimulator)
+        {
+            m_CacheSimulator->Reset(m_DecodedProgram.m_Instructions.size());
+        }
+    }
+
+    template <typename PolicyT>
+    phi::observer_ptr<CacheSimulator> BasicProcessor<PolicyT>::GetCacheSimulator() const noexcept
+    {
+        return m_CacheSimulator;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ObserveFPSRWrite(phi::boolean value) noexcept
+    {
+        // The FPSR is restored from the step record so it only needs to be traced
+        m_TraceRecord.destination_type = TraceDestination::FPSR;
+        m_TraceRecord.destination      = 0u;
+        m_TraceRecord.value            = value ? 1u : 0u;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::PrepareMemoryStore(phi::u32 address, phi::size_t size) noexcept
+    {
+        if (m_ReverseExecutionEnabled)
+        {
+            RecordMemoryUndo(address, size);
+        }
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ObserveMemoryStore(phi::u32 address, phi::size_t size,
+                                                     phi::uint64_t value_bits) noexcept
+    {
+        m_TraceRecord.destination_type = TraceDestination::Memory;
+        m_TraceRecord.destination      = static_cast<phi::uint8_t>(size);
+        m_TraceRecord.value            = value_bits;
+        m_TraceRecord.memory_address   = address.unsafe();
+        m_TraceRecord.flags |= TraceRecord::FlagMemoryAccess;
+
+        if (m_CacheSimulator)
+        {
+            m_CacheSimulator->AccessData(m_ProgramCounter.unsafe(), address.unsafe(), size, true);
+        }
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ObserveMemoryLoad(phi::u32 address, phi::size_t size) noexcept
+    {
+        m_TraceRecord.memory_address = address.unsafe();
+        m_TraceRecord.flags |= TraceRecord::FlagMemoryAccess;
+
+        if (m_CacheSimulator)
+        {
+            m_CacheSimulator->AccessData(m_ProgramCounter.unsafe(), address.unsafe(), size, false);
+        }
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ObserveIntRegisterWrite(IntRegisterID id,
+                                                          phi::uint32_t value_bits) noexcept
+    {
+        if (m_ReverseExecutionEnabled)
+        {
+            RecordIntRegisterUndo(id);
+        }
+
+        m_TraceRecord.destination_type = TraceDestination::IntRegister;
+        m_TraceRecord.destination      = static_cast<phi::uint8_t>(phi::to_underlying(id));
+        m_TraceRecord.value            = value_bits;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ObserveFloatRegisterWrite(FloatRegisterID id,
+                                                            phi::uint32_t   value_bits) noexcept
+    {
+        if (m_ReverseExecutionEnabled)
+        {
+            RecordFloatRegisterUndo(id);
+        }
+
+        m_TraceRecord.destination_type = TraceDestination::FloatRegister;
+        m_TraceRecord.destination      = static_cast<phi::uint8_t>(phi::to_underlying(id));
+        m_TraceRecord.value            = value_bits;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ObserveDoubleRegisterWrite(FloatRegisterID id,
+                                                             phi::uint64_t   value_bits) noexcept
+    {
+        if (m_ReverseExecutionEnabled)
+        {
+            RecordFloatRegisterUndo(id);
+            RecordFloatRegisterUndo(
+                    static_cast<FloatRegisterID>(static_cast<phi::size_t>(id) + 1));
+        }
+
+        m_TraceRecord.destination_type = TraceDestination::DoubleRegister;
+        m_TraceRecord.destination      = static_cast<phi::uint8_t>(phi::to_underlying(id));
+        m_TraceRecord.value            = value_bits;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::RecordMemoryUndo(phi::u32 address, phi::size_t size) noexcept
+    {
+        PHI_ASSERT(size <= sizeof(phi::uint64_t));
+
+        UndoRecord record;
+        record.type    = UndoRecordType::Memory;
+        record.info    = static_cast<phi::uint8_t>(size);
+        record.address = address.unsafe();
+
+        for (phi::size_t index{0u}; index < size; ++index)
+        {
+            phi::uint8_t byte;
+
+            // The store fails as well so there is nothing to undo
+            if (m_MemoryBlock.Load(static_cast<phi::size_t>(address.unsafe()) + index, byte) !=
+                MemoryAccessResult::Success)
+            {
+                return;
+            }
+
+            record.value |= static_cast<phi::uint64_t>(byte) << (8u * index);
+        }
+
+        m_UndoLog.Push(record);
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::RecordIntRegisterUndo(IntRegisterID id) noexcept
+    {
+        const phi::size_t id_value = phi::to_underlying(id);
+        PHI_ASSERT(id_value < m_IntRegisters.size());
+
+        UndoRecord record;
+        record.type  = UndoRecordType::IntRegister;
+        record.info  = static_cast<phi::uint8_t>(id_value);
+        record.extra = static_cast<phi::uint8_t>(m_IntRegistersValueTypes[id_value]);
+        record.value = m_IntRegisters[id_value].GetUnsignedValue().unsafe();
+
+        m_UndoLog.Push(record);
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::RecordFloatRegisterUndo(FloatRegisterID id) noexcept
+    {
+        const phi::size_t id_value = phi::to_underlying(id);
+        PHI_ASSERT(id_value < m_FloatRegisters.size());
+
+        const float   value = m_FloatRegisters[id_value].GetValue().unsafe();
+        phi::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        UndoRecord record;
+        record.type  = UndoRecordType::FloatRegister;
+        record.info  = static_cast<phi::uint8_t>(id_value);
+        record.extra = static_cast<phi::uint8_t>(m_FloatRegistersValueTypes[id_value]);
+        record.value = bits;
+
+        m_UndoLog.Push(record);
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::UndoStep() noexcept
+    {
+        // Revert the modifications of the instruction in reverse order until reaching its step
+        // record
+        while (true)
+        {
+            const UndoRecord record = m_UndoLog.Pop();
+
+            switch (record.type)
+            {
+                case UndoRecordType::IntRegister:
+                    m_IntRegisters[record.info].SetUnsignedValue(
+                            static_cast<phi::uint32_t>(record.value));
+                    m_IntRegistersValueTypes[record.info] =
+                            static_cast<IntRegisterValueType>(record.extra);
+                    break;
+
+                case UndoRecordType::FloatRegister: {
+                    const phi::uint32_t bits = static_cast<phi::uint32_t>(record.value);
+                    float               value;
+                    std::memcpy(&value, &bits, sizeof(value));
+
+                    m_FloatRegisters[record.info].SetValue(value);
+                    m_FloatRegistersValueTypes[record.info] =
+                            static_cast<FloatRegisterValueType>(record.extra);
+                    break;
+                }
+
+                case UndoRecordType::Memory:
+                    for (phi::size_t index{0u}; index < record.info; ++index)
+                    {
+                        const MemoryAccessResult result = m_MemoryBlock.Store(
+                                static_cast<phi::size_t>(record.address) + index,
+                                static_cast<phi::uint8_t>(record.value >> (8u * index)));
+                        PHI_ASSERT(result == MemoryAccessResult::Success);
+                        PHI_UNUSED_VARIABLE(result);
+                    }
+                    break;
+
+                case UndoRecordType::Step:
+                    m_ProgramCounter      = record.address;
+                    m_NextProgramCounter  = record.next_address;
+                    m_CurrentStepCount    = static_cast<phi::size_t>(record.value);
+                    m_LastRaisedException = static_cast<Exception>(record.extra);
+                    m_Halted              = (record.info & UndoRecord::StepFlagHalted) != 0u;
+                    m_FPSR.SetStatus((record.info & UndoRecord::StepFlagFPSR) != 0u);
+
+                    m_CurrentInstructionAccessType = RegisterAccessType::Ignored;
+                    return;
+            }
+        }
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ClearUndoHistory() noexcept
+    {
+        m_UndoLog.Clear();
+        m_UndoCheckpoints.clear();
+    }
+
+    // Shared by all processors so a snapshot can never be mistaken for another one
+    static std::atomic<phi::uint64_t> next_snapshot_id{1u};
+
+    template <typename PolicyT>
+    ProcessorSnapshot BasicProcessor<PolicyT>::Snapshot() noexcept
+    {
+        ProcessorSnapshot snapshot;
+
+        CaptureState(snapshot);
+        snapshot.id = next_snapshot_id.fetch_add(1u, std::memory_order_relaxed);
+
+        m_MemoryBlock.ClearDirtyPages();
+        m_SnapshotID = snapshot.id;
+
+        return snapshot;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::Restore(const ProcessorSnapshot& snapshot) noexcept
+    {
+        ClearUndoHistory();
+        RestoreState(snapshot);
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::CaptureState(ProcessorSnapshot& snapshot) const noexcept
+    {
+        snapshot.int_registers               = m_IntRegisters;
+        snapshot.int_registers_value_types   = m_IntRegistersValueTypes;
+        snapshot.float_registers             = m_FloatRegisters;
+        snapshot.float_registers_value_types = m_FloatRegistersValueTypes;
+        snapshot.fpsr                        = m_FPSR;
+        snapshot.memory                      = m_MemoryBlock;
+        snapshot.program_counter             = m_ProgramCounter;
+        snapshot.next_program_counter        = m_NextProgramCounter;
+        snapshot.step_count                  = m_CurrentStepCount;
+        snapshot.last_raised_exception       = m_LastRaisedException;
+        snapshot.halted                      = m_Halted;
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::RestoreState(const ProcessorSnapshot& snapshot) noexcept
+    {
+        m_IntRegisters             = snapshot.int_registers;
+        m_IntRegistersValueTypes   = snapshot.int_registers_value_types;
+        m_FloatRegisters           = snapshot.float_registers;
+        m_FloatRegistersValueTypes = snapshot.float_registers_value_types;
+        m_FPSR                     = snapshot.fpsr;
+        m_ProgramCounter           = snapshot.program_counter;
+        m_NextProgramCounter       = snapshot.next_program_counter;
+        m_CurrentStepCount         = snapshot.step_count;
+        m_LastRaisedException      = snapshot.last_raised_exception;
+        m_Halted                   = snapshot.halted;
+
+        m_CurrentInstructionAccessType = RegisterAccessType::Ignored;
+
+        if (snapshot.id != 0u && snapshot.id == m_SnapshotID)
+        {
+            m_MemoryBlock.RestoreDirtyPages(snapshot.memory);
+        }
+        else
+        {
+            m_MemoryBlock = snapshot.memory;
+            m_MemoryBlock.ClearDirtyPages();
+            m_SnapshotID = snapshot.id;
+        }
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ClearRegisters() noexcept
+    {
+        for (auto& reg : m_IntRegisters)
+        {
+            reg.SetSignedValue(0);
+        }
+
+        for (auto& reg : m_FloatRegisters)
+        {
+            reg.SetValue(0.0f);
+        }
+
+        m_FPSR.SetStatus(false);
+    }
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::ClearMemory() noexcept
+    {
+        m_MemoryBlock.Clear();
+    }
+
+    PHI_CLANG_AND_GCC_SUPPRESS_WARNING_PUSH()
+    PHI_CLANG_AND_GCC_SUPPRESS_WARNING("-Wswitch")
+    PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(4702) // Unreachable code
+
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::Raise(Exception exception) noexcept
+    {
+        PHI_ASSERT(exception != Exception::None, "Cannot raise None exception");
+
+        m_LastRaisedException = exception;
+
+        if (m_ObservingAccesses)
+        {
+            m_TraceRecord.exception = static_cast<phi::uint8_t>(exception);
+        }
+
+        switch (exception)
+        {
+            case Exception::DivideByZero:
+                m_Halted = true;
+                DLX_ERROR("Division through zero");
+                return;
+            case Exception::Overflow:
                 DLX_WARN("Overflow");
                 return;
             case Exception::Underflow:
@@ -534,59 +1899,88 @@ namespace dlx
     PHI_MSVC_SUPPRESS_WARNING_POP()
     PHI_CLANG_AND_GCC_SUPPRESS_WARNING_POP()
 
-    Exception Processor::GetLastRaisedException() const noexcept
+    template <typename PolicyT>
+    Exception BasicProcessor<PolicyT>::GetLastRaisedException() const noexcept
     {
         return m_LastRaisedException;
     }
 
-    phi::boolean Processor::IsHalted() const noexcept
+    template <typename PolicyT>
+    phi::boolean BasicProcessor<PolicyT>::IsHalted() const noexcept
     {
         return m_Halted;
     }
 
-    const MemoryBlock& Processor::GetMemory() const noexcept
+    template <typename PolicyT>
+    const MemoryBlock& BasicProcessor<PolicyT>::GetMemory() const noexcept
     {
         return m_MemoryBlock;
     }
 
-    MemoryBlock& Processor::GetMemory() noexcept
+    template <typename PolicyT>
+    MemoryBlock& BasicProcessor<PolicyT>::GetMemory() noexcept
     {
         return m_MemoryBlock;
     }
 
-    phi::u32 Processor::GetProgramCounter() const noexcept
+    template <typename PolicyT>
+    phi::u32 BasicProcessor<PolicyT>::GetProgramCounter() const noexcept
     {
         return m_ProgramCounter;
     }
 
-    void Processor::SetProgramCounter(phi::u32 new_pc) noexcept
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::SetProgramCounter(phi::u32 new_pc) noexcept
     {
         m_ProgramCounter = new_pc;
     }
 
-    phi::u32 Processor::GetNextProgramCounter() const noexcept
+    template <typename PolicyT>
+    phi::u32 BasicProcessor<PolicyT>::GetNextProgramCounter() const noexcept
     {
         return m_NextProgramCounter;
     }
 
-    void Processor::SetNextProgramCounter(phi::u32 new_npc) noexcept
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::SetNextProgramCounter(phi::u32 new_npc) noexcept
     {
         m_NextProgramCounter = new_npc;
     }
 
-    phi::usize Processor::GetCurrentStepCount() const noexcept
+    template <typename PolicyT>
+    phi::usize BasicProcessor<PolicyT>::GetCurrentStepCount() const noexcept
     {
         return m_CurrentStepCount;
     }
 
-    void Processor::SetMaxNumberOfSteps(phi::usize new_max) noexcept
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::SetMaxNumberOfSteps(phi::usize new_max) noexcept
     {
         m_MaxNumberOfSteps = new_max;
     }
 
+    template <typename PolicyT>
+    void BasicProcessor<PolicyT>::SetJITEnabled(phi::boolean enabled) noexcept
+    {
+        m_JITEnabled = enabled && JITCompiler::IsSupported();
+    }
+
+    template <typename PolicyT>
+    phi::boolean BasicProcessor<PolicyT>::IsJITEnabled() const noexcept
+    {
+        return m_JITEnabled;
+    }
+
+    template <typename PolicyT>
+    const JITCompiler& BasicProcessor<PolicyT>::GetJITCompiler() const noexcept
+    {
+        return m_JITCompiler;
+    }
+
     PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wabi-tag")
 
-    std::string Processor::GetRegisterDump() const noexcept
+    template <typename PolicyT>
+    std::string BasicProcessor<PolicyT>::GetRegisterDump() const noexcept
     {
         std::string text{"Int registers:\n"};
 
@@ -616,7 +2010,8 @@ namespace dlx
         return text;
     }
 
-    std::string Processor::GetMemoryDump() const noexcept
+    template <typename PolicyT>
+    std::string BasicProcessor<PolicyT>::GetMemoryDump() const noexcept
     {
         std::string text{"Not Implemented"};
 
@@ -625,7 +2020,8 @@ namespace dlx
         return text;
     }
 
-    std::string Processor::GetProcessorDump() const noexcept
+    template <typename PolicyT>
+    std::string BasicProcessor<PolicyT>::GetProcessorDump() const noexcept
     {
         std::string text;
 
@@ -658,7 +2054,8 @@ namespace dlx
         return text;
     }
 
-    std::string Processor::GetCurrentProgramDump() const noexcept
+    template <typename PolicyT>
+    std::string BasicProcessor<PolicyT>::GetCurrentProgramDump() const noexcept
     {
         if (m_CurrentProgram)
         {
@@ -669,4 +2066,7 @@ namespace dlx
     }
 
     PHI_GCC_SUPPRESS_WARNING_POP()
+
+    template class BasicProcessor<CheckedPolicy>;
+    template class BasicProcessor<FastPolicy>;
 } // namespace dlx
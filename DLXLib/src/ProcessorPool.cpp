@@ -0,0 +1,159 @@
+#include "DLX/ProcessorPool.hpp"
+
+#include <phi/core/assert.hpp>
+#include <phi/core/move.hpp>
+
+namespace dlx
+{
+    ProcessorPool::ProcessorPool(phi::size_t number_of_threads,
+                                 phi::size_t queue_capacity) noexcept
+        : m_QueueCapacity{queue_capacity == 0u ? phi::size_t{1u} : queue_capacity}
+    {
+        if (number_of_threads == 0u)
+        {
+            number_of_threads = phi::size_t{std::thread::hardware_concurrency()};
+        }
+
+        // hardware_concurrency may not be computable
+        if (number_of_threads == 0u)
+        {
+            number_of_threads = 1u;
+        }
+
+        m_Processors.reserve(number_of_threads);
+        for (phi::size_t index{0u}; index < number_of_threads; ++index)
+        {
+            m_Processors.emplace_back(std::make_unique<FastProcessor>());
+        }
+
+        m_Threads.reserve(number_of_threads);
+        for (phi::size_t index{0u}; index < number_of_threads; ++index)
+        {
+            m_Threads.emplace_back(&ProcessorPool::WorkerMain, this, index);
+        }
+    }
+
+    ProcessorPool::~ProcessorPool() noexcept
+    {
+        Shutdown();
+    }
+
+    phi::boolean ProcessorPool::Submit(SharedParsedProgram program, BatchJob job,
+                                       Callback callback) noexcept
+    {
+        return Enqueue(Job{phi::move(program), phi::move(job), phi::move(callback)}, true);
+    }
+
+    phi::boolean ProcessorPool::TrySubmit(SharedParsedProgram program, BatchJob job,
+                                          Callback callback) noexcept
+    {
+        return Enqueue(Job{phi::move(program), phi::move(job), phi::move(callback)}, false);
+    }
+
+    void ProcessorPool::Shutdown() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_Mutex};
+            m_Stop = true;
+        }
+        m_JobQueued.notify_all();
+        m_JobTaken.notify_all();
+
+        for (std::thread& thread : m_Threads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+    }
+
+    phi::size_t ProcessorPool::GetNumberOfThreads() const noexcept
+    {
+        return m_Threads.size();
+    }
+
+    phi::size_t ProcessorPool::GetQueueCapacity() const noexcept
+    {
+        return m_QueueCapacity;
+    }
+
+    phi::size_t ProcessorPool::GetQueueSize() const noexcept
+    {
+        std::lock_guard<std::mutex> lock{m_Mutex};
+
+        return m_Queue.size();
+    }
+
+    phi::boolean ProcessorPool::Enqueue(Job&& job, phi::boolean wait) noexcept
+    {
+        if (!job.program || !job.program->m_ParseErrors.empty() || !IsBatchJobValid(job.job))
+        {
+            return false;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock{m_Mutex};
+
+            if (wait)
+            {
+                m_JobTaken.wait(lock,
+                                [this] { return m_Stop || m_Queue.size() < m_QueueCapacity; });
+            }
+
+            if (m_Stop || m_Queue.size() >= m_QueueCapacity)
+            {
+                return false;
+            }
+
+            m_Queue.push_back(phi::move(job));
+        }
+        m_JobQueued.notify_one();
+
+        return true;
+    }
+
+    void ProcessorPool::WorkerMain(phi::size_t index) noexcept
+    {
+        FastProcessor&       processor = *m_Processors[index];
+        const ParsedProgram* loaded_program{nullptr};
+
+        while (true)
+        {
+            Job job;
+
+            {
+                std::unique_lock<std::mutex> lock{m_Mutex};
+                m_JobQueued.wait(lock, [this] { return m_Stop || !m_Queue.empty(); });
+
+                // Only stop once all queued jobs are done
+                if (m_Queue.empty())
+                {
+                    return;
+                }
+
+                job = phi::move(m_Queue.front());
+                m_Queue.pop_front();
+            }
+            m_JobTaken.notify_one();
+
+            // The processor keeps its program alive so the address can't be reused meanwhile
+            if (job.program.get() != loaded_program)
+            {
+                const phi::boolean loaded = processor.LoadProgram(job.program);
+                PHI_ASSERT(loaded);
+                (void)loaded;
+
+                loaded_program = job.program.get();
+            }
+
+            BatchResult result;
+            ExecuteBatchJob(processor, job.job, result);
+
+            if (job.callback)
+            {
+                job.callback(result);
+            }
+        }
+    }
+} // namespace dlx
@@ -0,0 +1,108 @@
+#include "DLX/ProgramCache.hpp"
+
+#include "DLX/Parser.hpp"
+#include <functional>
+
+namespace dlx
+{
+    ProgramCache::ProgramCache(phi::size_t capacity) noexcept
+        : m_Capacity{capacity == 0u ? phi::size_t{1u} : capacity}
+    {}
+
+    SharedParsedProgram ProgramCache::Get(std::string_view source) noexcept
+    {
+        const phi::size_t hash = std::hash<std::string_view>{}(source);
+
+        {
+            std::lock_guard<std::mutex> lock{m_Mutex};
+
+            if (SharedParsedProgram program = Find(hash, source))
+            {
+                ++m_Hits;
+                return program;
+            }
+
+            ++m_Misses;
+        }
+
+        SharedParsedProgram program = Parser::ParseShared(std::string{source});
+
+        std::lock_guard<std::mutex> lock{m_Mutex};
+
+        // Another thread may have parsed the same source in the meantime
+        if (SharedParsedProgram cached = Find(hash, source))
+        {
+            return cached;
+        }
+
+        const auto index_it = m_Index.find(hash);
+        if (index_it != m_Index.end())
+        {
+            m_Entries.erase(index_it->second);
+            m_Index.erase(index_it);
+        }
+        else if (m_Entries.size() >= m_Capacity)
+        {
+            m_Index.erase(m_Entries.back().hash);
+            m_Entries.pop_back();
+        }
+
+        m_Entries.push_front(Entry{hash, program});
+        m_Index.emplace(hash, m_Entries.begin());
+
+        return program;
+    }
+
+    void ProgramCache::Clear() noexcept
+    {
+        std::lock_guard<std::mutex> lock{m_Mutex};
+
+        m_Entries.clear();
+        m_Index.clear();
+    }
+
+    phi::size_t ProgramCache::GetSize() const noexcept
+    {
+        std::lock_guard<std::mutex> lock{m_Mutex};
+
+        return m_Entries.size();
+    }
+
+    phi::size_t ProgramCache::GetCapacity() const noexcept
+    {
+        return m_Capacity;
+    }
+
+    phi::uint64_t ProgramCache::GetHits() const noexcept
+    {
+        std::lock_guard<std::mutex> lock{m_Mutex};
+
+        return m_Hits;
+    }
+
+    phi::uint64_t ProgramCache::GetMisses() const noexcept
+    {
+        std::lock_guard<std::mutex> lock{m_Mutex};
+
+        return m_Misses;
+    }
+
+    SharedParsedProgram ProgramCache::Find(phi::size_t hash, std::string_view source) noexcept
+    {
+        const auto index_it = m_Index.find(hash);
+        if (index_it == m_Index.end())
+        {
+            return {};
+        }
+
+        // Compare the source to rule out hash collisions
+        const SharedParsedProgram& program = index_it->second->program;
+        if (!program->m_Source || *program->m_Source != source)
+        {
+            return {};
+        }
+
+        m_Entries.splice(m_Entries.begin(), m_Entries, index_it->second);
+        return program;
+    }
+} // namespace dlx
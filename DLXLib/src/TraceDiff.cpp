@@ -0,0 +1,528 @@
+#include "DLX/TraceDiff.hpp"
+
+#include "DLX/OpCode.hpp"
+#include "DLX/ParsedProgram.hpp"
+#include "DLX/Processor.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <algorithm>
+#include <cstring>
+
+PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
+PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(5262)
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+PHI_MSVC_SUPPRESS_WARNING_POP()
+PHI_GCC_SUPPRESS_WARNING_POP()
+
+namespace dlx
+{
+    // Registers and the FPSR are placed above the 32-bit memory addresses
+    static constexpr const phi::uint64_t IntRegisterLocation{phi::uint64_t{1u} << 32u};
+    static constexpr const phi::uint64_t FloatRegisterLocation{phi::uint64_t{2u} << 32u};
+    static constexpr const phi::uint64_t FPSRLocation{phi::uint64_t{3u} << 32u};
+
+    // splitmix64 finalizer
+    [[nodiscard]] static constexpr phi::uint64_t mix(phi::uint64_t value) noexcept
+    {
+        value = (value ^ (value >> 30u)) * 0xBF58476D1CE4E5B9u;
+        value = (value ^ (value >> 27u)) * 0x94D049BB133111EBu;
+        return value ^ (value >> 31u);
+    }
+
+    [[nodiscard]] static constexpr phi::uint64_t location_hash(phi::uint64_t location,
+                                                               phi::uint32_t value) noexcept
+    {
+        return mix(mix(location) ^ value);
+    }
+
+    void TraceState::Reset() noexcept
+    {
+        m_IntRegisters.fill(0u);
+        m_FloatRegisters.fill(0u);
+        m_FPSR = 0u;
+        m_Pages.clear();
+        m_LastPage = nullptr;
+        m_Hash     = 0u;
+    }
+
+    void TraceState::Apply(const TraceRecord& record) noexcept
+    {
+        const phi::uint8_t destination = record.destination;
+
+        switch (record.destination_type)
+        {
+            case TraceDestination::None:
+                break;
+
+            case TraceDestination::IntRegister:
+                if (destination < m_IntRegisters.size())
+                {
+                    SetLocation(IntRegisterLocation + destination, m_IntRegisters[destination],
+                                static_cast<phi::uint32_t>(record.value));
+                }
+                break;
+
+            case TraceDestination::FloatRegister:
+                if (destination < m_FloatRegisters.size())
+                {
+                    SetLocation(FloatRegisterLocation + destination,
+                                m_FloatRegisters[destination],
+                                static_cast<phi::uint32_t>(record.value));
+                }
+                break;
+
+            case TraceDestination::DoubleRegister:
+                if (destination + 1u < m_FloatRegisters.size())
+                {
+                    SetLocation(FloatRegisterLocation + destination,
+                                m_FloatRegisters[destination],
+                                static_cast<phi::uint32_t>(record.value));
+                    SetLocation(FloatRegisterLocation + destination + 1u,
+                                m_FloatRegisters[destination + 1u],
+                                static_cast<phi::uint32_t>(record.value >> 32u));
+                }
+                break;
+
+            case TraceDestination::FPSR:
+                SetLocation(FPSRLocation, m_FPSR, static_cast<phi::uint32_t>(record.value));
+                break;
+
+            case TraceDestination::Memory: {
+                // Same byte order as the store which recorded the value
+                phi::uint8_t bytes[sizeof(record.value)];
+                std::memcpy(bytes, &record.value, sizeof(bytes));
+
+                const phi::size_t size = std::min(phi::size_t{destination}, sizeof(bytes));
+                for (phi::size_t index{0u}; index < size; ++index)
+                {
+                    StoreByte(static_cast<phi::uint32_t>(record.memory_address + index),
+                              bytes[index]);
+                }
+                break;
+            }
+        }
+    }
+
+    phi::uint64_t TraceState::GetHash() const noexcept
+    {
+        return m_Hash;
+    }
+
+    phi::uint32_t TraceState::GetIntRegister(phi::size_t index) const noexcept
+    {
+        PHI_ASSERT(index < m_IntRegisters.size());
+
+        return m_IntRegisters[index];
+    }
+
+    phi::uint32_t TraceState::GetFloatRegister(phi::size_t index) const noexcept
+    {
+        PHI_ASSERT(index < m_FloatRegisters.size());
+
+        return m_FloatRegisters[index];
+    }
+
+    phi::boolean TraceState::GetFPSR() const noexcept
+    {
+        return m_FPSR != 0u;
+    }
+
+    phi::uint8_t TraceState::GetMemoryByte(phi::uint32_t address) const noexcept
+    {
+        const auto page = m_Pages.find(address / PageSize);
+        if (page == m_Pages.end())
+        {
+            return 0u;
+        }
+
+        return (*page->second)[address % PageSize];
+    }
+
+    const std::unordered_map<phi::uint32_t, std::unique_ptr<TraceState::Page>>& TraceState::
+            GetPages() const noexcept
+    {
+        return m_Pages;
+    }
+
+    void TraceState::SetLocation(phi::uint64_t location, phi::uint32_t& storage,
+                                 phi::uint32_t value) noexcept
+    {
+        m_Hash += location_hash(location, value) - location_hash(location, storage);
+        storage = value;
+    }
+
+    void TraceState::StoreByte(phi::uint32_t address, phi::uint8_t value) noexcept
+    {
+        const phi::uint32_t page_index = address / PageSize;
+
+        if (m_LastPage == nullptr || m_LastPageIndex != page_index)
+        {
+            std::unique_ptr<Page>& page = m_Pages[page_index];
+            if (!page)
+            {
+                page = std::make_unique<Page>();
+                page->fill(0u);
+            }
+
+            m_LastPage      = page.get();
+            m_LastPageIndex = page_index;
+        }
+
+        phi::uint8_t& storage = (*m_LastPage)[address % PageSize];
+
+        m_Hash += location_hash(address, value) - location_hash(address, storage);
+        storage = value;
+    }
+
+    TraceComparer::TraceComparer(phi::boolean compare_program_counter) noexcept
+        : m_ComparePC{compare_program_counter}
+    {}
+
+    void TraceComparer::Reset() noexcept
+    {
+        m_StateA.Reset();
+        m_StateB.Reset();
+        m_NumberOfStepsA = 0u;
+        m_NumberOfStepsB = 0u;
+        m_Diverged       = false;
+        m_DivergedStep   = 0u;
+        m_HasRecordA     = false;
+        m_HasRecordB     = false;
+    }
+
+    phi::boolean TraceComparer::Step(const TraceRecord* record_a,
+                                     const TraceRecord* record_b) noexcept
+    {
+        if (m_Diverged)
+        {
+            return true;
+        }
+
+        const phi::uint64_t step = std::max(m_NumberOfStepsA, m_NumberOfStepsB);
+
+        if (record_a != nullptr)
+        {
+            m_StateA.Apply(*record_a);
+            ++m_NumberOfStepsA;
+        }
+
+        if (record_b != nullptr)
+        {
+            m_StateB.Apply(*record_b);
+            ++m_NumberOfStepsB;
+        }
+
+        const phi::boolean program_counter_differs =
+                m_ComparePC && record_a != nullptr && record_b != nullptr &&
+                record_a->program_counter != record_b->program_counter;
+
+        if (m_StateA.GetHash() == m_StateB.GetHash() && !program_counter_differs)
+        {
+            return false;
+        }
+
+        m_Diverged     = true;
+        m_DivergedStep = step;
+        m_HasRecordA   = record_a != nullptr;
+        m_HasRecordB   = record_b != nullptr;
+
+        if (m_HasRecordA)
+        {
+            m_RecordA = *record_a;
+        }
+
+        if (m_HasRecordB)
+        {
+            m_RecordB = *record_b;
+        }
+
+        return true;
+    }
+
+    phi::boolean TraceComparer::HasDiverged() const noexcept
+    {
+        return m_Diverged;
+    }
+
+    TraceDiffResult TraceComparer::GetResult() const noexcept
+    {
+        TraceDiffResult result;
+        result.diverged          = m_Diverged;
+        result.number_of_steps_a = m_NumberOfStepsA;
+        result.number_of_steps_b = m_NumberOfStepsB;
+
+        if (!m_Diverged)
+        {
+            return result;
+        }
+
+        result.step         = m_DivergedStep;
+        result.record_a     = m_RecordA;
+        result.record_b     = m_RecordB;
+        result.has_record_a = m_HasRecordA;
+        result.has_record_b = m_HasRecordB;
+
+        // Registers
+        for (phi::uint8_t index{0u}; index < 32u; ++index)
+        {
+            if (m_StateA.GetIntRegister(index) != m_StateB.GetIntRegister(index))
+            {
+                result.registers.push_back({TraceDestination::IntRegister, index,
+                                            m_StateA.GetIntRegister(index),
+                                            m_StateB.GetIntRegister(index)});
+            }
+        }
+
+        for (phi::uint8_t index{0u}; index < 32u; ++index)
+        {
+            if (m_StateA.GetFloatRegister(index) != m_StateB.GetFloatRegister(index))
+            {
+                result.registers.push_back({TraceDestination::FloatRegister, index,
+                                            m_StateA.GetFloatRegister(index),
+                                            m_StateB.GetFloatRegister(index)});
+            }
+        }
+
+        if (m_StateA.GetFPSR() != m_StateB.GetFPSR())
+        {
+            result.registers.push_back({TraceDestination::FPSR, 0u, m_StateA.GetFPSR() ? 1u : 0u,
+                                        m_StateB.GetFPSR() ? 1u : 0u});
+        }
+
+        // Memory, only pages written by either side can differ
+        std::vector<phi::uint32_t> page_indices;
+        for (const auto& [page_index, page] : m_StateA.GetPages())
+        {
+            page_indices.push_back(page_index);
+        }
+        for (const auto& [page_index, page] : m_StateB.GetPages())
+        {
+            page_indices.push_back(page_index);
+        }
+
+        std::sort(page_indices.begin(), page_indices.end());
+        page_indices.erase(std::unique(page_indices.begin(), page_indices.end()),
+                           page_indices.end());
+
+        for (const phi::uint32_t page_index : page_indices)
+        {
+            for (phi::size_t offset{0u}; offset < TraceState::PageSize; ++offset)
+            {
+                const phi::uint32_t address =
+                        static_cast<phi::uint32_t>(page_index * TraceState::PageSize + offset);
+                const phi::uint8_t byte_a = m_StateA.GetMemoryByte(address);
+                const phi::uint8_t byte_b = m_StateB.GetMemoryByte(address);
+
+                if (byte_a == byte_b)
+                {
+                    continue;
+                }
+
+                ++result.number_of_differing_bytes;
+
+                // Extend the previous range if it ends right in front of this byte
+                if (!result.memory.empty() &&
+                    result.memory.back().address + result.memory.back().bytes_a.size() == address)
+                {
+                    result.memory.back().bytes_a.push_back(byte_a);
+                    result.memory.back().bytes_b.push_back(byte_b);
+                }
+                else if (result.memory.size() < TraceDiffResult::MaximumMemoryDifferences)
+                {
+                    result.memory.push_back({address, {byte_a}, {byte_b}});
+                }
+            }
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] static std::string format_record(const TraceRecord& record) noexcept
+    {
+        std::string text =
+                fmt::format("pc {} {}", record.program_counter,
+                            record.opcode < static_cast<phi::uint16_t>(OpCode::NUMBER_OF_ELEMENTS) ?
+                                    enum_name(static_cast<OpCode>(record.opcode)).data() :
+                                    "?");
+
+        switch (record.destination_type)
+        {
+            case TraceDestination::None:
+                break;
+            case TraceDestination::IntRegister:
+                text.append(fmt::format(" -> R{} = {}", record.destination,
+                                        static_cast<phi::int32_t>(record.value)));
+                break;
+            case TraceDestination::FloatRegister:
+                text.append(fmt::format(" -> F{} = 0x{:08X}", record.destination, record.value));
+                break;
+            case TraceDestination::DoubleRegister:
+                text.append(fmt::format(" -> F{}:F{} = 0x{:016X}", record.destination,
+                                        record.destination + 1u, record.value));
+                break;
+            case TraceDestination::FPSR:
+                text.append(fmt::format(" -> FPSR = {}", record.value));
+                break;
+            case TraceDestination::Memory:
+                text.append(fmt::format(" -> [{}] = 0x{:0{}X}", record.memory_address,
+                                        record.value, record.destination * 2u));
+                break;
+        }
+
+        if (record.exception != 0u)
+        {
+            text.append(fmt::format(" raised {}",
+                                    enum_name(static_cast<Exception>(record.exception)).data()));
+        }
+
+        return text;
+    }
+
+    std::string TraceDiffResult::GetSummary() const noexcept
+    {
+        if (!diverged)
+        {
+            return fmt::format("No divergence, A executed {} steps and B {} steps\n",
+                               number_of_steps_a, number_of_steps_b);
+        }
+
+        std::string text = fmt::format("Diverged at step {}\n", step);
+
+        text.append(fmt::format("  A: {}\n", has_record_a ? format_record(record_a) :
+                                                             std::string{"finished"}));
+        text.append(fmt::format("  B: {}\n", has_record_b ? format_record(record_b) :
+                                                             std::string{"finished"}));
+
+        if (!registers.empty())
+        {
+            text.append("Registers (A != B):\n");
+        }
+
+        for (const RegisterDifference& difference : registers)
+        {
+            switch (difference.type)
+            {
+                case TraceDestination::IntRegister:
+                    text.append(fmt::format("  R{}: {} != {}\n", difference.index,
+                                            static_cast<phi::int32_t>(difference.value_a),
+                                            static_cast<phi::int32_t>(difference.value_b)));
+                    break;
+                case TraceDestination::FloatRegister: {
+                    float value_a;
+                    float value_b;
+                    std::memcpy(&value_a, &difference.value_a, sizeof(value_a));
+                    std::memcpy(&value_b, &difference.value_b, sizeof(value_b));
+
+                    text.append(fmt::format("  F{}: {} != {}\n", difference.index, value_a,
+                                            value_b));
+                    break;
+                }
+                default:
+                    text.append(fmt::format("  FPSR: {} != {}\n", difference.value_a,
+                                            difference.value_b));
+                    break;
+            }
+        }
+
+        if (!memory.empty())
+        {
+            text.append(fmt::format("Memory ({} bytes, A != B):\n", number_of_differing_bytes));
+        }
+
+        for (const MemoryDifference& difference : memory)
+        {
+            // Long ranges are cut to keep the summary compact
+            static constexpr const phi::size_t MaximumBytes{16u};
+            const phi::size_t shown = std::min(difference.bytes_a.size(), MaximumBytes);
+
+            std::string bytes_a;
+            std::string bytes_b;
+            for (phi::size_t index{0u}; index < shown; ++index)
+            {
+                bytes_a.append(fmt::format("{:02X}", difference.bytes_a[index]));
+                bytes_b.append(fmt::format("{:02X}", difference.bytes_b[index]));
+            }
+
+            text.append(fmt::format("  [{}, {}): {}{} != {}{}\n", difference.address,
+                                    difference.address + difference.bytes_a.size(), bytes_a,
+                                    shown < difference.bytes_a.size() ? "..." : "", bytes_b,
+                                    shown < difference.bytes_b.size() ? "..." : ""));
+        }
+
+        return text;
+    }
+
+    TraceDiffResult CompareTraces(const std::vector<TraceRecord>& trace_a,
+                                  const std::vector<TraceRecord>& trace_b,
+                                  phi::boolean                    compare_program_counter) noexcept
+    {
+        TraceComparer comparer{compare_program_counter};
+
+        const phi::size_t length = std::max(trace_a.size(), trace_b.size());
+        for (phi::size_t index{0u}; index < length; ++index)
+        {
+            if (comparer.Step(index < trace_a.size() ? &trace_a[index] : nullptr,
+                              index < trace_b.size() ? &trace_b[index] : nullptr))
+            {
+                break;
+            }
+        }
+
+        return comparer.GetResult();
+    }
+
+    // Loads the program and returns whether there is anything to execute
+    [[nodiscard]] static phi::boolean prepare_processor(FastProcessor&       processor,
+                                                        const ParsedProgram& program,
+                                                        phi::usize           max_steps) noexcept
+    {
+        processor.SetMaxNumberOfSteps(max_steps);
+        processor.SetTracingEnabled(true);
+
+        return processor.LoadProgram(program) && !program.m_Instructions.empty() &&
+               !processor.IsHalted();
+    }
+
+    TraceDiffResult ComparePrograms(const ParsedProgram& program_a, const ParsedProgram& program_b,
+                                    phi::usize   max_steps,
+                                    phi::boolean compare_program_counter) noexcept
+    {
+        FastProcessor processor_a;
+        FastProcessor processor_b;
+
+        phi::boolean running_a = prepare_processor(processor_a, program_a, max_steps);
+        phi::boolean running_b = prepare_processor(processor_b, program_b, max_steps);
+
+        TraceComparer comparer{compare_program_counter};
+
+        while (running_a || running_b)
+        {
+            const TraceRecord* record_a{nullptr};
+            const TraceRecord* record_b{nullptr};
+
+            if (running_a)
+            {
+                processor_a.ExecuteStep();
+                record_a  = &processor_a.GetLastTraceRecord();
+                running_a = !processor_a.IsHalted();
+            }
+
+            if (running_b)
+            {
+                processor_b.ExecuteStep();
+                record_b  = &processor_b.GetLastTraceRecord();
+                running_b = !processor_b.IsHalted();
+            }
+
+            if (comparer.Step(record_a, record_b))
+            {
+                break;
+            }
+        }
+
+        return comparer.GetResult();
+    }
+} // namespace dlx
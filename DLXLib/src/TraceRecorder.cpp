@@ -0,0 +1,347 @@
+#include "DLX/TraceRecorder.hpp"
+
+#include "DLX/Logger.hpp"
+#include <phi/core/assert.hpp>
+#include <algorithm>
+#include <cstddef>
+
+#if DLX_TRACE_MMAP_SUPPORTED
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+
+namespace dlx
+{
+    static constexpr const phi::size_t NumberOfRecordsOffset{
+            offsetof(TraceFileHeader, number_of_records)};
+
+    TraceWriter::~TraceWriter() noexcept
+    {
+        Close();
+    }
+
+    phi::uint64_t TraceWriter::GetNumberOfRecords() const noexcept
+    {
+        const phi::uint64_t size =
+                m_WindowOffset + static_cast<phi::uint64_t>(m_Cursor - m_Window);
+
+        // The header takes up the space of one record
+        return size <= sizeof(TraceFileHeader) ? 0u : size / sizeof(TraceRecord) - 1u;
+    }
+
+#if DLX_TRACE_MMAP_SUPPORTED
+    phi::boolean TraceWriter::Open(const std::string& path, phi::size_t buffer_size) noexcept
+    {
+        Close();
+
+        const int file_descriptor =
+                open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (file_descriptor == -1)
+        {
+            DLX_ERROR("Failed to open trace file '{}'", path);
+            return false;
+        }
+
+        // Windows must start at a multiple of the page size which is also a multiple of the
+        // record size
+        const phi::size_t page_size = static_cast<phi::size_t>(sysconf(_SC_PAGESIZE));
+
+        m_FileDescriptor = file_descriptor;
+        m_WindowSize     = std::max((buffer_size + page_size - 1u) / page_size, phi::size_t{1u}) *
+                       page_size;
+        m_WindowOffset = 0u;
+
+        if (!AdvanceWindow())
+        {
+            return false;
+        }
+
+        TraceFileHeader header;
+        std::memcpy(header.magic, TraceFileHeader::Magic, sizeof(header.magic));
+        std::memcpy(m_Cursor, &header, sizeof(header));
+        m_Cursor += sizeof(header);
+
+        return true;
+    }
+
+    void TraceWriter::Close() noexcept
+    {
+        if (!IsOpen())
+        {
+            return;
+        }
+
+        const phi::uint64_t size =
+                m_WindowOffset + static_cast<phi::uint64_t>(m_Cursor - m_Window);
+
+        WriteNumberOfRecords();
+
+        if (m_Window != nullptr)
+        {
+            munmap(m_Window, m_WindowSize);
+        }
+
+        // Cut off the unused rest of the last window
+        if (ftruncate(m_FileDescriptor, static_cast<off_t>(size)) != 0)
+        {
+            DLX_ERROR("Failed to truncate trace file to {} bytes", size);
+        }
+
+        close(m_FileDescriptor);
+
+        m_FileDescriptor = -1;
+        m_Window         = nullptr;
+        m_Cursor         = nullptr;
+        m_End            = nullptr;
+        m_WindowOffset   = size;
+    }
+
+    phi::boolean TraceWriter::IsOpen() const noexcept
+    {
+        return m_FileDescriptor != -1;
+    }
+
+    void TraceWriter::Flush() noexcept
+    {
+        if (!IsOpen())
+        {
+            return;
+        }
+
+        if (m_Window != nullptr)
+        {
+            msync(m_Window, static_cast<phi::size_t>(m_Cursor - m_Window), MS_ASYNC);
+        }
+
+        WriteNumberOfRecords();
+    }
+
+    phi::boolean TraceWriter::AdvanceWindow() noexcept
+    {
+        if (!IsOpen())
+        {
+            return false;
+        }
+
+        if (m_Window != nullptr)
+        {
+            // Unmapping leaves writing the full window back to the kernel
+            munmap(m_Window, m_WindowSize);
+            m_WindowOffset += m_WindowSize;
+
+            m_Window = nullptr;
+            m_Cursor = nullptr;
+            m_End    = nullptr;
+
+            WriteNumberOfRecords();
+        }
+
+        if (ftruncate(m_FileDescriptor, static_cast<off_t>(m_WindowOffset + m_WindowSize)) != 0)
+        {
+            DLX_ERROR("Failed to grow trace file to {} bytes", m_WindowOffset + m_WindowSize);
+            Close();
+            return false;
+        }
+
+        void* window = mmap(nullptr, m_WindowSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                            m_FileDescriptor, static_cast<off_t>(m_WindowOffset));
+        if (window == MAP_FAILED)
+        {
+            DLX_ERROR("Failed to map {} bytes of the trace file", m_WindowSize);
+            Close();
+            return false;
+        }
+
+        m_Window = static_cast<phi::uint8_t*>(window);
+        m_Cursor = m_Window;
+        m_End    = m_Window + m_WindowSize;
+
+        return true;
+    }
+
+    void TraceWriter::WriteNumberOfRecords() noexcept
+    {
+        const phi::uint64_t number_of_records = GetNumberOfRecords();
+
+        // Goes through the page cache so it doesn't conflict with a mapping of the header
+        if (pwrite(m_FileDescriptor, &number_of_records, sizeof(number_of_records),
+                   NumberOfRecordsOffset) != sizeof(number_of_records))
+        {
+            DLX_ERROR("Failed to write the number of records to the trace file");
+        }
+    }
+#else
+    phi::boolean TraceWriter::Open(const std::string& path, phi::size_t buffer_size) noexcept
+    {
+        Close();
+
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (file == nullptr)
+        {
+            DLX_ERROR("Failed to open trace file '{}'", path);
+            return false;
+        }
+
+        m_File = file;
+        // Room for at least the header and one record
+        m_WindowSize = std::max(buffer_size / sizeof(TraceRecord), phi::size_t{2u}) *
+                       sizeof(TraceRecord);
+        m_WindowOffset = 0u;
+
+        m_Buffer.resize(m_WindowSize);
+        m_Window = m_Buffer.data();
+        m_Cursor = m_Window;
+        m_End    = m_Window + m_WindowSize;
+
+        TraceFileHeader header;
+        std::memcpy(header.magic, TraceFileHeader::Magic, sizeof(header.magic));
+        std::memcpy(m_Cursor, &header, sizeof(header));
+        m_Cursor += sizeof(header);
+
+        return true;
+    }
+
+    void TraceWriter::Close() noexcept
+    {
+        if (!IsOpen())
+        {
+            return;
+        }
+
+        Flush();
+
+        if (m_File != nullptr)
+        {
+            std::fclose(m_File);
+        }
+
+        m_WindowOffset += static_cast<phi::uint64_t>(m_Cursor - m_Window);
+
+        m_File   = nullptr;
+        m_Window = nullptr;
+        m_Cursor = nullptr;
+        m_End    = nullptr;
+        m_Buffer.clear();
+        m_Buffer.shrink_to_fit();
+    }
+
+    phi::boolean TraceWriter::IsOpen() const noexcept
+    {
+        return m_File != nullptr;
+    }
+
+    void TraceWriter::Flush() noexcept
+    {
+        if (!IsOpen() || !AdvanceWindow())
+        {
+            return;
+        }
+
+        WriteNumberOfRecords();
+        std::fflush(m_File);
+    }
+
+    phi::boolean TraceWriter::AdvanceWindow() noexcept
+    {
+        if (!IsOpen())
+        {
+            return false;
+        }
+
+        const phi::size_t size = static_cast<phi::size_t>(m_Cursor - m_Window);
+
+        if (std::fwrite(m_Window, 1u, size, m_File) != size)
+        {
+            DLX_ERROR("Failed to write {} bytes to the trace file", size);
+
+            // Keep what was written so far
+            std::fclose(m_File);
+            m_File   = nullptr;
+            m_Window = nullptr;
+            m_Cursor = nullptr;
+            m_End    = nullptr;
+            return false;
+        }
+
+        m_WindowOffset += size;
+        m_Cursor = m_Window;
+
+        return true;
+    }
+
+    void TraceWriter::WriteNumberOfRecords() noexcept
+    {
+        const phi::uint64_t number_of_records = GetNumberOfRecords();
+
+        if (std::fseek(m_File, static_cast<long>(NumberOfRecordsOffset), SEEK_SET) != 0 ||
+            std::fwrite(&number_of_records, sizeof(number_of_records), 1u, m_File) != 1u ||
+            std::fseek(m_File, 0, SEEK_END) != 0)
+        {
+            DLX_ERROR("Failed to write the number of records to the trace file");
+        }
+    }
+#endif
+
+    phi::boolean TraceReader::Open(const std::string& path) noexcept
+    {
+        m_Records.clear();
+
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr)
+        {
+            DLX_ERROR("Failed to open trace file '{}'", path);
+            return false;
+        }
+
+        TraceFileHeader header;
+        if (std::fread(&header, sizeof(header), 1u, file) != 1u ||
+            std::memcmp(header.magic, TraceFileHeader::Magic, sizeof(header.magic)) != 0 ||
+            header.version != TraceFileHeader::CurrentVersion ||
+            header.record_size != sizeof(TraceRecord))
+        {
+            DLX_ERROR("'{}' is not a trace file of version {}", path,
+                      TraceFileHeader::CurrentVersion);
+            std::fclose(file);
+            return false;
+        }
+
+        std::fseek(file, 0, SEEK_END);
+        const long file_size = std::ftell(file);
+        std::fseek(file, sizeof(header), SEEK_SET);
+
+        // An unfinished trace may contain more records than the header which are incomplete
+        const phi::uint64_t stored_records =
+                file_size < 0 ? 0u :
+                                (static_cast<phi::uint64_t>(file_size) - sizeof(header)) /
+                                        sizeof(TraceRecord);
+        const phi::size_t number_of_records =
+                static_cast<phi::size_t>(std::min(header.number_of_records, stored_records));
+
+        m_Records.resize(number_of_records);
+        const phi::size_t read_records =
+                std::fread(m_Records.data(), sizeof(TraceRecord), number_of_records, file);
+        m_Records.resize(read_records);
+
+        std::fclose(file);
+
+        return read_records == number_of_records;
+    }
+
+    phi::size_t TraceReader::GetNumberOfRecords() const noexcept
+    {
+        return m_Records.size();
+    }
+
+    const TraceRecord& TraceReader::GetRecord(phi::size_t index) const noexcept
+    {
+        PHI_ASSERT(index < m_Records.size());
+
+        return m_Records[index];
+    }
+
+    const std::vector<TraceRecord>& TraceReader::GetRecords() const noexcept
+    {
+        return m_Records;
+    }
+} // namespace dlx
@@ -0,0 +1,118 @@
+#include "DLX/UndoLog.hpp"
+
+#include <phi/core/assert.hpp>
+#include <algorithm>
+
+namespace dlx
+{
+    void UndoLog::SetCapacity(phi::size_t capacity) noexcept
+    {
+        m_Capacity = std::max(capacity, MinimumCapacity);
+        m_Records.clear();
+        m_Records.shrink_to_fit();
+
+        Clear();
+    }
+
+    phi::size_t UndoLog::GetCapacity() const noexcept
+    {
+        return m_Capacity;
+    }
+
+    void UndoLog::Clear() noexcept
+    {
+        // Keep counting so positions and steps are never reused
+        m_BeginPosition = m_EndPosition;
+        m_FirstStep     = m_EndStep;
+    }
+
+    void UndoLog::BeginStep(const UndoRecord& record) noexcept
+    {
+        PHI_ASSERT(record.type == UndoRecordType::Step);
+
+        Push(record);
+        ++m_EndStep;
+    }
+
+    void UndoLog::Push(const UndoRecord& record) noexcept
+    {
+        PHI_ASSERT(record.type == UndoRecordType::Step || m_EndStep != m_FirstStep,
+                   "Records must belong to a step");
+
+        if (m_Records.size() != m_Capacity)
+        {
+            m_Records.resize(m_Capacity);
+        }
+
+        if (m_EndPosition - m_BeginPosition == m_Capacity)
+        {
+            DropOldestStep();
+        }
+
+        m_Records[m_EndPosition % m_Capacity] = record;
+        ++m_EndPosition;
+    }
+
+    UndoRecord UndoLog::Pop() noexcept
+    {
+        PHI_ASSERT(!IsEmpty());
+
+        --m_EndPosition;
+        const UndoRecord record = m_Records[m_EndPosition % m_Capacity];
+
+        if (record.type == UndoRecordType::Step)
+        {
+            --m_EndStep;
+        }
+
+        return record;
+    }
+
+    void UndoLog::Truncate(phi::uint64_t position, phi::uint64_t step) noexcept
+    {
+        PHI_ASSERT(position >= m_BeginPosition && position <= m_EndPosition);
+        PHI_ASSERT(step >= m_FirstStep && step <= m_EndStep);
+
+        m_EndPosition = position;
+        m_EndStep     = step;
+    }
+
+    phi::uint64_t UndoLog::GetFirstStep() const noexcept
+    {
+        return m_FirstStep;
+    }
+
+    phi::uint64_t UndoLog::GetEndStep() const noexcept
+    {
+        return m_EndStep;
+    }
+
+    phi::size_t UndoLog::GetNumberOfSteps() const noexcept
+    {
+        return static_cast<phi::size_t>(m_EndStep - m_FirstStep);
+    }
+
+    phi::uint64_t UndoLog::GetEndPosition() const noexcept
+    {
+        return m_EndPosition;
+    }
+
+    phi::boolean UndoLog::IsEmpty() const noexcept
+    {
+        return m_EndStep == m_FirstStep;
+    }
+
+    void UndoLog::DropOldestStep() noexcept
+    {
+        PHI_ASSERT(m_Records[m_BeginPosition % m_Capacity].type == UndoRecordType::Step);
+
+        // Drop the step record and everything up to the next step
+        do
+        {
+            ++m_BeginPosition;
+        } while (m_BeginPosition != m_EndPosition &&
+                 m_Records[m_BeginPosition % m_Capacity].type != UndoRecordType::Step);
+
+        ++m_FirstStep;
+    }
+} // namespace dlx
@@ -0,0 +1,190 @@
+#include <DLX/ParseError.hpp>
+#include <DLX/ParsedProgram.hpp>
+#include <DLX/Parser.hpp>
+#include <DLX/TraceDiff.hpp>
+#include <DLX/TraceRecorder.hpp>
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/move.hpp>
+#include <phi/core/types.hpp>
+#include <charconv>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
+
+PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
+PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(5262)
+
+#include <fmt/core.h>
+
+PHI_MSVC_SUPPRESS_WARNING_POP()
+PHI_GCC_SUPPRESS_WARNING_POP()
+
+// Exit codes
+static constexpr const int NoDivergence{0};
+static constexpr const int Diverged{1};
+static constexpr const int Error{2};
+
+static void print_usage() noexcept
+{
+    std::fputs("Usage: dlxdiff [options] <a> <b>\n"
+               "\n"
+               "Runs two DLX programs in lockstep, or compares two recorded traces, and reports\n"
+               "the first step after which the registers or memory differ.\n"
+               "\n"
+               "Options:\n"
+               "  --traces      <a> and <b> are trace files instead of programs\n"
+               "  --steps <n>   Maximum number of steps per program (default 1000000, 0 for no\n"
+               "                limit)\n"
+               "  --compare-pc  Also diverge when the program counters differ\n"
+               "  -h, --help    Show this help\n"
+               "\n"
+               "Exits with 0 if the runs don't diverge, 1 if they do and 2 on errors.\n",
+               stdout);
+}
+
+[[nodiscard]] static std::optional<std::string> read_file(const std::string& path) noexcept
+{
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+    {
+        return {};
+    }
+
+    std::string content;
+    char        buffer[4096];
+    phi::size_t read_bytes;
+    while ((read_bytes = std::fread(buffer, 1u, sizeof(buffer), file)) != 0u)
+    {
+        content.append(buffer, read_bytes);
+    }
+
+    const phi::boolean failed = std::ferror(file) != 0;
+    std::fclose(file);
+
+    if (failed)
+    {
+        return {};
+    }
+
+    return content;
+}
+
+[[nodiscard]] static std::optional<dlx::ParsedProgram> load_program(
+        const std::string& path) noexcept
+{
+    std::optional<std::string> source = read_file(path);
+    if (!source)
+    {
+        fmt::print(stderr, "Failed to read '{}'\n", path);
+        return {};
+    }
+
+    dlx::ParsedProgram program = dlx::Parser::ParseOwned(phi::move(*source));
+    if (!program.m_ParseErrors.empty())
+    {
+        fmt::print(stderr, "Failed to parse '{}':\n", path);
+        for (const dlx::ParseError& error : program.m_ParseErrors)
+        {
+            fmt::print(stderr, "  {}\n", error.ConstructMessage());
+        }
+
+        return {};
+    }
+
+    return program;
+}
+
+int main(int argc, char* argv[])
+{
+    phi::boolean  compare_traces{false};
+    phi::boolean  compare_program_counter{false};
+    phi::uint64_t max_steps{1'000'000u};
+    std::string   paths[2];
+    phi::size_t   number_of_paths{0u};
+
+    for (int index{1}; index < argc; ++index)
+    {
+        const std::string_view argument = argv[index];
+
+        if (argument == "-h" || argument == "--help")
+        {
+            print_usage();
+            return NoDivergence;
+        }
+
+        if (argument == "--traces")
+        {
+            compare_traces = true;
+        }
+        else if (argument == "--compare-pc")
+        {
+            compare_program_counter = true;
+        }
+        else if (argument == "--steps" && index + 1 < argc)
+        {
+            const std::string_view value = argv[++index];
+
+            if (std::from_chars(value.data(), value.data() + value.size(), max_steps).ec !=
+                std::errc{})
+            {
+                fmt::print(stderr, "Invalid number of steps '{}'\n", value);
+                return Error;
+            }
+        }
+        else if (!argument.empty() && argument.front() != '-' && number_of_paths < 2u)
+        {
+            paths[number_of_paths++] = argument;
+        }
+        else
+        {
+            fmt::print(stderr, "Unexpected argument '{}'\n\n", argument);
+            print_usage();
+            return Error;
+        }
+    }
+
+    if (number_of_paths != 2u)
+    {
+        print_usage();
+        return Error;
+    }
+
+    dlx::TraceDiffResult result;
+
+    if (compare_traces)
+    {
+        dlx::TraceReader reader_a;
+        dlx::TraceReader reader_b;
+
+        for (phi::size_t index{0u}; index < 2u; ++index)
+        {
+            if (!(index == 0u ? reader_a : reader_b).Open(paths[index]))
+            {
+                fmt::print(stderr, "Failed to read trace file '{}'\n", paths[index]);
+                return Error;
+            }
+        }
+
+        result = dlx::CompareTraces(reader_a.GetRecords(), reader_b.GetRecords(),
+                                    compare_program_counter);
+    }
+    else
+    {
+        std::optional<dlx::ParsedProgram> program_a = load_program(paths[0]);
+        std::optional<dlx::ParsedProgram> program_b = load_program(paths[1]);
+
+        if (!program_a || !program_b)
+        {
+            return Error;
+        }
+
+        result = dlx::ComparePrograms(*program_a, *program_b, max_steps,
+                                      compare_program_counter);
+    }
+
+    fmt::print("A: {}\nB: {}\n{}", paths[0], paths[1], result.GetSummary());
+
+    return result.diverged ? Diverged : NoDivergence;
+}
@@ -0,0 +1,305 @@
+#include <DLX/BatchFormat.hpp>
+#include <DLX/BatchRunner.hpp>
+#include <DLX/ParseError.hpp>
+#include <DLX/ParsedProgram.hpp>
+#include <DLX/Parser.hpp>
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/move.hpp>
+#include <phi/core/types.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
+PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(5262)
+
+#include <fmt/core.h>
+
+PHI_MSVC_SUPPRESS_WARNING_POP()
+PHI_GCC_SUPPRESS_WARNING_POP()
+
+// Exit codes
+static constexpr const int Success{0};
+static constexpr const int Failed{1};
+static constexpr const int Error{2};
+
+static void print_usage() noexcept
+{
+    std::fputs("Usage: dlxrun [options] <program>\n"
+               "\n"
+               "Runs a DLX program without a user interface and prints the final state.\n"
+               "\n"
+               "Options:\n"
+               "  --set <assignment>       Set an initial value, may be given multiple times\n"
+               "  --input <file>           Read initial values from a file with one assignment\n"
+               "                           per line. Every input file is a separate run of the\n"
+               "                           program, --set values apply to all of them.\n"
+               "  --steps <n>              Maximum number of steps per run (default 1000000, 0\n"
+               "                           for no limit)\n"
+               "  --memory <start>:<size>  Memory of the processor (default 1000:1000)\n"
+               "  --dump <address>[:<n>]   Print n memory words (default 1) after running, may\n"
+               "                           be given multiple times\n"
+               "  --json                   Print one JSON object per run and line\n"
+               "  --threads <n>            Number of threads running the inputs (default one\n"
+               "                           per hardware thread)\n"
+               "  -h, --help               Show this help\n"
+               "\n"
+               "Assignments:\n"
+               "  R<n>=<integer>  F<n>=<float>  D<n>=<double>  FPSR=<0 or 1>\n"
+               "  M[<address>]=<integer>  MF[<address>]=<float>  MD[<address>]=<double>\n"
+               "\n"
+               "Exits with 0 if every run halted, 1 if any run raised an exception or reached\n"
+               "the step limit and 2 on errors.\n",
+               stdout);
+}
+
+[[nodiscard]] static std::optional<std::string> read_file(const std::string& path) noexcept
+{
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr)
+    {
+        return {};
+    }
+
+    std::string content;
+    char        buffer[4096];
+    phi::size_t read_bytes;
+    while ((read_bytes = std::fread(buffer, 1u, sizeof(buffer), file)) != 0u)
+    {
+        content.append(buffer, read_bytes);
+    }
+
+    const phi::boolean failed = std::ferror(file) != 0;
+    std::fclose(file);
+
+    if (failed)
+    {
+        return {};
+    }
+
+    return content;
+}
+
+template <typename T>
+[[nodiscard]] static phi::boolean parse_number(std::string_view text, T& value) noexcept
+{
+    const char* end = text.data() + text.size();
+
+    const std::from_chars_result result = std::from_chars(text.data(), end, value);
+    return !text.empty() && result.ec == std::errc{} && result.ptr == end;
+}
+
+// Parses "<first>:<second>" where ":<second>" may be omitted if second_optional is set
+[[nodiscard]] static phi::boolean parse_pair(std::string_view text, phi::uint32_t& first,
+                                             phi::uint32_t& second,
+                                             phi::boolean   second_optional) noexcept
+{
+    const phi::size_t colon = text.find(':');
+    if (colon == std::string_view::npos)
+    {
+        return second_optional && parse_number(text, first);
+    }
+
+    return parse_number(text.substr(0u, colon), first) &&
+           parse_number(text.substr(colon + 1u), second);
+}
+
+int main(int argc, char* argv[])
+{
+    phi::boolean                  json{false};
+    phi::uint64_t                 max_steps{1'000'000u};
+    phi::uint32_t                 memory_start{1000u};
+    phi::uint32_t                 memory_size{1000u};
+    phi::size_t                   number_of_threads{0u};
+    std::vector<std::string>      assignments;
+    std::vector<std::string>      input_paths;
+    std::vector<dlx::MemoryRange> memory_ranges;
+    std::string                   program_path;
+
+    for (int index{1}; index < argc; ++index)
+    {
+        const std::string_view argument = argv[index];
+        const phi::boolean     has_value = index + 1 < argc;
+
+        if (argument == "-h" || argument == "--help")
+        {
+            print_usage();
+            return Success;
+        }
+
+        if (argument == "--json")
+        {
+            json = true;
+        }
+        else if (argument == "--set" && has_value)
+        {
+            assignments.emplace_back(argv[++index]);
+        }
+        else if (argument == "--input" && has_value)
+        {
+            input_paths.emplace_back(argv[++index]);
+        }
+        else if (argument == "--steps" && has_value)
+        {
+            const std::string_view value = argv[++index];
+            if (!parse_number(value, max_steps))
+            {
+                fmt::print(stderr, "Invalid number of steps '{}'\n", value);
+                return Error;
+            }
+        }
+        else if (argument == "--memory" && has_value)
+        {
+            const std::string_view value = argv[++index];
+            if (!parse_pair(value, memory_start, memory_size, false) || memory_size == 0u)
+            {
+                fmt::print(stderr, "Invalid memory '{}', expected <start>:<size>\n", value);
+                return Error;
+            }
+        }
+        else if (argument == "--dump" && has_value)
+        {
+            const std::string_view value = argv[++index];
+
+            dlx::MemoryRange range;
+            if (!parse_pair(value, range.address, range.words, true))
+            {
+                fmt::print(stderr, "Invalid memory range '{}', expected <address>[:<n>]\n",
+                           value);
+                return Error;
+            }
+
+            memory_ranges.push_back(range);
+        }
+        else if (argument == "--threads" && has_value)
+        {
+            const std::string_view value = argv[++index];
+            if (!parse_number(value, number_of_threads))
+            {
+                fmt::print(stderr, "Invalid number of threads '{}'\n", value);
+                return Error;
+            }
+        }
+        else if (!argument.empty() && argument.front() != '-' && program_path.empty())
+        {
+            program_path = argument;
+        }
+        else
+        {
+            fmt::print(stderr, "Unexpected argument '{}'\n\n", argument);
+            print_usage();
+            return Error;
+        }
+    }
+
+    if (program_path.empty())
+    {
+        print_usage();
+        return Error;
+    }
+
+    std::optional<std::string> source = read_file(program_path);
+    if (!source)
+    {
+        fmt::print(stderr, "Failed to read '{}'\n", program_path);
+        return Error;
+    }
+
+    const dlx::ParsedProgram program = dlx::Parser::ParseOwned(phi::move(*source));
+    if (!program.m_ParseErrors.empty())
+    {
+        fmt::print(stderr, "Failed to parse '{}':\n", program_path);
+        for (const dlx::ParseError& error : program.m_ParseErrors)
+        {
+            fmt::print(stderr, "  {}\n", error.ConstructMessage());
+        }
+
+        return Error;
+    }
+
+    // Build one job per input file or a single one from the command line
+    dlx::BatchJob base_job;
+    base_job.memory_starting_address = memory_start;
+    base_job.memory_size             = memory_size;
+    base_job.max_number_of_steps     = max_steps;
+
+    std::vector<dlx::BatchJob> jobs(input_paths.empty() ? 1u : input_paths.size(), base_job);
+    std::string                error;
+
+    for (phi::size_t job_index{0u}; job_index < input_paths.size(); ++job_index)
+    {
+        const std::string&         path    = input_paths[job_index];
+        std::optional<std::string> content = read_file(path);
+
+        if (!content)
+        {
+            fmt::print(stderr, "Failed to read '{}'\n", path);
+            return Error;
+        }
+
+        if (!dlx::ApplyBatchAssignments(jobs[job_index], *content, error))
+        {
+            fmt::print(stderr, "Invalid input '{}': {}\n", path, error);
+            return Error;
+        }
+    }
+
+    for (dlx::BatchJob& job : jobs)
+    {
+        for (const std::string& assignment : assignments)
+        {
+            if (!dlx::ApplyBatchAssignment(job, assignment, error))
+            {
+                fmt::print(stderr, "Invalid assignment '{}': {}\n", assignment, error);
+                return Error;
+            }
+        }
+    }
+
+    // No need for more threads than runs
+    if (number_of_threads == 0u)
+    {
+        number_of_threads =
+                std::max(phi::size_t{std::thread::hardware_concurrency()}, phi::size_t{1u});
+    }
+    number_of_threads = std::min(number_of_threads, jobs.size());
+
+    dlx::BatchRunner                    runner{number_of_threads};
+    const std::vector<dlx::BatchResult> results = runner.Run(program, jobs);
+
+    int exit_code{Success};
+    for (phi::size_t job_index{0u}; job_index < jobs.size(); ++job_index)
+    {
+        const dlx::BatchJob&    job    = jobs[job_index];
+        const dlx::BatchResult& result = results[job_index];
+        const std::string_view  input =
+                input_paths.empty() ? std::string_view{} : std::string_view{input_paths[job_index]};
+
+        if (json)
+        {
+            fmt::print("{}\n", dlx::FormatBatchResultJson(job, result, memory_ranges, input));
+        }
+        else
+        {
+            if (!input.empty())
+            {
+                fmt::print("{}Input: {}\n\n", job_index == 0u ? "" : "\n", input);
+            }
+
+            fmt::print("{}", dlx::FormatBatchResult(job, result, memory_ranges));
+        }
+
+        if (dlx::GetBatchStatus(job, result) != dlx::BatchStatus::Halted)
+        {
+            exit_code = Failed;
+        }
+    }
+
+    return exit_code;
+}
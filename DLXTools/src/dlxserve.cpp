@@ -0,0 +1,1027 @@
+#include <DLX/BatchFormat.hpp>
+#include <DLX/BatchRunner.hpp>
+#include <DLX/ParseError.hpp>
+#include <DLX/ParsedProgram.hpp>
+#include <DLX/ProcessorPool.hpp>
+#include <DLX/ProgramCache.hpp>
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/move.hpp>
+#include <phi/core/types.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
+PHI_MSVC_SUPPRESS_WARNING_WITH_PUSH(5262)
+
+#include <fmt/core.h>
+
+PHI_MSVC_SUPPRESS_WARNING_POP()
+PHI_GCC_SUPPRESS_WARNING_POP()
+
+// Exit codes
+static constexpr const int Success{0};
+static constexpr const int Error{1};
+
+static constexpr const phi::size_t MaximumLineLength{256u};
+static constexpr const phi::size_t MaximumJobIdLength{64u};
+static constexpr const phi::size_t MaximumDumpWords{65536u};
+
+static void print_usage() noexcept
+{
+    std::fputs(
+            "Usage: dlxserve [options]\n"
+            "\n"
+            "Runs DLX programs for clients connecting to a Unix domain socket. Parsed programs\n"
+            "are cached and every run executes on a pool of preallocated processors.\n"
+            "\n"
+            "Options:\n"
+            "  --socket <path>        Path of the socket (default dlxserve.sock)\n"
+            "  --threads <n>          Worker threads (default one per hardware thread)\n"
+            "  --queue <n>            Runs waiting for a worker before clients are blocked\n"
+            "                         (default 1024)\n"
+            "  --pending <n>          Unfinished runs per client before its requests aren't\n"
+            "                         read anymore (default 256)\n"
+            "  --cache <n>            Number of parsed programs kept (default 256)\n"
+            "  --max-steps <n>        Step limit of every run (default 1000000, 0 for none)\n"
+            "  --max-memory <n>       Largest memory of a run in bytes (default 1048576)\n"
+            "  --max-source <n>       Largest program source or input in bytes (default\n"
+            "                         1048576)\n"
+            "  --max-connections <n>  Number of clients served at once (default 64)\n"
+            "  -h, --help             Show this help\n"
+            "\n"
+            "Requests, one line each:\n"
+            "  JOB <id>               Starts a job. The id consists of up to 64 letters, digits\n"
+            "                         and '_', '-', '.' or ':'\n"
+            "  STEPS <n>              Step limit, at most --max-steps (default --max-steps)\n"
+            "  MEMORY <start>:<size>  Memory of the processor (default 1000:1000)\n"
+            "  DUMP <address>[:<n>]   Memory words reported after every run, may be repeated\n"
+            "  SOURCE <bytes>         Followed by the program source\n"
+            "  INPUT <bytes>          Followed by initial values in the format of\n"
+            "                         dlxrun --input. Every input is one run, without any the\n"
+            "                         program runs once.\n"
+            "  END                    Ends the job\n"
+            "\n"
+            "STEPS, MEMORY, DUMP and SOURCE have to come before the first INPUT. Runs start as\n"
+            "soon as their input was received.\n"
+            "\n"
+            "Responses, one JSON object per line in the order the runs finish:\n"
+            "  {\"job\":<id>,\"run\":<n>,\"result\":<run>}  Result of a run like dlxrun --json\n"
+            "  {\"job\":<id>,\"run\":<n>,\"error\":<text>}   Invalid input of a run\n"
+            "  {\"job\":<id>,\"done\":true,\"runs\":<n>}     After the last run of a job\n"
+            "  {\"job\":<id>,\"error\":<text>}            The job was rejected\n"
+            "  {\"error\":<text>}                       Invalid request, closes the connection\n",
+            stdout);
+}
+
+template <typename T>
+[[nodiscard]] static phi::boolean parse_number(std::string_view text, T& value) noexcept
+{
+    const char* end = text.data() + text.size();
+
+    const std::from_chars_result result = std::from_chars(text.data(), end, value);
+    return !text.empty() && result.ec == std::errc{} && result.ptr == end;
+}
+
+// Parses "<first>:<second>" where ":<second>" may be omitted if second_optional is set
+[[nodiscard]] static phi::boolean parse_pair(std::string_view text, phi::uint32_t& first,
+                                             phi::uint32_t& second,
+                                             phi::boolean   second_optional) noexcept
+{
+    const phi::size_t colon = text.find(':');
+    if (colon == std::string_view::npos)
+    {
+        return second_optional && parse_number(text, first);
+    }
+
+    return parse_number(text.substr(0u, colon), first) &&
+           parse_number(text.substr(colon + 1u), second);
+}
+
+[[nodiscard]] static phi::boolean is_valid_job_id(std::string_view id) noexcept
+{
+    if (id.empty() || id.size() > MaximumJobIdLength)
+    {
+        return false;
+    }
+
+    for (const char character : id)
+    {
+        const phi::boolean valid = (character >= 'a' && character <= 'z') ||
+                                   (character >= 'A' && character <= 'Z') ||
+                                   (character >= '0' && character <= '9') || character == '_' ||
+                                   character == '-' || character == '.' || character == ':';
+        if (!valid)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+[[nodiscard]] static phi::boolean write_all(int fd, std::string_view data) noexcept
+{
+    while (!data.empty())
+    {
+        const ssize_t written = ::write(fd, data.data(), data.size());
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            return false;
+        }
+
+        data.remove_prefix(static_cast<phi::size_t>(written));
+    }
+
+    return true;
+}
+
+enum class ReadResult
+{
+    Ok,
+    EndOfStream,
+    LineTooLong,
+};
+
+// Buffered reads of request lines and the data blocks following them
+class SocketReader
+{
+public:
+    explicit SocketReader(int fd) noexcept
+        : m_Fd{fd}
+    {}
+
+    // Reads up to the next '\n' which isn't included in the line
+    [[nodiscard]] ReadResult ReadLine(std::string& line) noexcept
+    {
+        line.clear();
+
+        while (true)
+        {
+            const char* begin   = m_Buffer.data() + m_Begin;
+            const char* newline =
+                    static_cast<const char*>(std::memchr(begin, '\n', m_End - m_Begin));
+
+            if (newline != nullptr)
+            {
+                line.append(begin, static_cast<phi::size_t>(newline - begin));
+                m_Begin += static_cast<phi::size_t>(newline - begin) + 1u;
+                break;
+            }
+
+            line.append(begin, m_End - m_Begin);
+            m_Begin = m_End;
+
+            if (line.size() > MaximumLineLength)
+            {
+                return ReadResult::LineTooLong;
+            }
+
+            if (!Fill())
+            {
+                return ReadResult::EndOfStream;
+            }
+        }
+
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+
+        return line.size() > MaximumLineLength ? ReadResult::LineTooLong : ReadResult::Ok;
+    }
+
+    // Reads exactly size bytes
+    [[nodiscard]] phi::boolean Read(phi::size_t size, std::string& data) noexcept
+    {
+        data.clear();
+        data.reserve(size);
+
+        while (data.size() < size)
+        {
+            if (m_Begin == m_End && !Fill())
+            {
+                return false;
+            }
+
+            const phi::size_t count = std::min(size - data.size(), m_End - m_Begin);
+            data.append(m_Buffer.data() + m_Begin, count);
+            m_Begin += count;
+        }
+
+        return true;
+    }
+
+private:
+    [[nodiscard]] phi::boolean Fill() noexcept
+    {
+        while (true)
+        {
+            const ssize_t received = ::read(m_Fd, m_Buffer.data(), m_Buffer.size());
+            if (received < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            if (received <= 0)
+            {
+                return false;
+            }
+
+            m_Begin = 0u;
+            m_End   = static_cast<phi::size_t>(received);
+            return true;
+        }
+    }
+
+    int                     m_Fd;
+    std::array<char, 65536> m_Buffer{};
+    phi::size_t             m_Begin{0u};
+    phi::size_t             m_End{0u};
+};
+
+struct ServerConfig
+{
+    std::string   socket_path{"dlxserve.sock"};
+    phi::size_t   number_of_threads{0u};
+    phi::size_t   queue_capacity{dlx::ProcessorPool::DefaultQueueCapacity};
+    phi::size_t   max_pending_runs{256u};
+    phi::size_t   cache_capacity{dlx::ProgramCache::DefaultCapacity};
+    phi::uint64_t max_steps{1'000'000u};
+    phi::uint32_t max_memory{1u << 20u};
+    phi::size_t   max_source{1u << 20u};
+    phi::size_t   max_connections{64u};
+};
+
+struct Job
+{
+    std::string id;
+
+    // Memory and step limit of every run without any initial values
+    dlx::BatchJob                 settings;
+    std::vector<dlx::MemoryRange> memory_ranges;
+
+    // Guarded by the mutex of the connection
+    phi::size_t  submitted_runs{0u};
+    phi::size_t  finished_runs{0u};
+    phi::boolean ended{false};
+};
+
+struct OutputLine
+{
+    std::string  text;
+    phi::boolean finishes_run;
+};
+
+// Requests are read on the thread of the connection while a writer thread sends the responses
+// pushed by the workers. Only max_pending_runs runs may be unfinished or unsent at once, so a
+// client which doesn't read its responses stops being served instead of piling them up.
+class Connection
+{
+public:
+    explicit Connection(int fd) noexcept
+        : m_Fd{fd}
+    {}
+
+    [[nodiscard]] int GetFd() const noexcept
+    {
+        return m_Fd;
+    }
+
+    // Waits for a free run slot. Returns false once the connection was closed.
+    [[nodiscard]] phi::boolean BeginRun(Job& job, phi::size_t max_pending_runs) noexcept
+    {
+        std::unique_lock<std::mutex> lock{m_Mutex};
+        m_Changed.wait(lock, [&] { return m_Closed || m_PendingRuns < max_pending_runs; });
+
+        if (m_Closed)
+        {
+            return false;
+        }
+
+        ++m_PendingRuns;
+        ++job.submitted_runs;
+        return true;
+    }
+
+    // Reverts BeginRun for a run which couldn't be submitted
+    void CancelRun(Job& job) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_Mutex};
+            --m_PendingRuns;
+            --job.submitted_runs;
+        }
+        m_Changed.notify_all();
+    }
+
+    void FinishRun(Job& job, std::string line) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_Mutex};
+            ++job.finished_runs;
+
+            if (m_Closed)
+            {
+                --m_PendingRuns;
+            }
+            else
+            {
+                m_Output.push_back(OutputLine{phi::move(line), true});
+                PushDoneIfFinished(job);
+            }
+        }
+        m_Changed.notify_all();
+    }
+
+    void EndJob(Job& job) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_Mutex};
+            job.ended = true;
+            PushDoneIfFinished(job);
+        }
+        m_Changed.notify_all();
+    }
+
+    void Send(std::string line) noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_Mutex};
+            if (!m_Closed)
+            {
+                m_Output.push_back(OutputLine{phi::move(line), false});
+            }
+        }
+        m_Changed.notify_all();
+    }
+
+    // No further requests will be read, the writer stops once all runs were sent
+    void EndReading() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_Mutex};
+            m_ReadingEnded = true;
+        }
+        m_Changed.notify_all();
+    }
+
+    // Drops all unsent responses and wakes up the reader and writer
+    void Close() noexcept
+    {
+        {
+            std::lock_guard<std::mutex> lock{m_Mutex};
+            CloseLocked();
+        }
+        m_Changed.notify_all();
+
+        ::shutdown(m_Fd, SHUT_RDWR);
+    }
+
+    void WriterMain() noexcept
+    {
+        std::deque<OutputLine> lines;
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock{m_Mutex};
+                m_Changed.wait(lock, [this] {
+                    return m_Closed || !m_Output.empty() || (m_ReadingEnded && m_PendingRuns == 0u);
+                });
+
+                if (m_Closed || m_Output.empty())
+                {
+                    return;
+                }
+
+                lines.swap(m_Output);
+            }
+
+            std::string text;
+            phi::size_t finished_runs{0u};
+            for (OutputLine& line : lines)
+            {
+                text.append(line.text);
+                finished_runs += line.finishes_run ? 1u : 0u;
+            }
+            lines.clear();
+
+            const phi::boolean written = write_all(m_Fd, text);
+
+            {
+                std::lock_guard<std::mutex> lock{m_Mutex};
+                m_PendingRuns -= finished_runs;
+
+                if (!written)
+                {
+                    CloseLocked();
+                }
+            }
+            m_Changed.notify_all();
+        }
+    }
+
+    std::atomic<phi::boolean> finished{false};
+
+private:
+    void PushDoneIfFinished(Job& job) noexcept
+    {
+        if (job.ended && job.finished_runs == job.submitted_runs)
+        {
+            m_Output.push_back(OutputLine{fmt::format("{{\"job\":{},\"done\":true,\"runs\":{}}}\n",
+                                                      dlx::FormatJsonString(job.id),
+                                                      job.submitted_runs),
+                                          false});
+        }
+    }
+
+    void CloseLocked() noexcept
+    {
+        m_Closed = true;
+
+        for (const OutputLine& line : m_Output)
+        {
+            m_PendingRuns -= line.finishes_run ? 1u : 0u;
+        }
+        m_Output.clear();
+    }
+
+    int m_Fd;
+
+    std::mutex              m_Mutex;
+    std::condition_variable m_Changed;
+    std::deque<OutputLine>  m_Output;
+    phi::size_t             m_PendingRuns{0u};
+    phi::boolean            m_ReadingEnded{false};
+    phi::boolean            m_Closed{false};
+};
+
+class Server
+{
+public:
+    explicit Server(const ServerConfig& config) noexcept
+        : m_Config{config}
+        , m_Cache{config.cache_capacity}
+        , m_Pool{config.number_of_threads, config.queue_capacity}
+    {}
+
+    [[nodiscard]] phi::size_t GetNumberOfThreads() const noexcept
+    {
+        return m_Pool.GetNumberOfThreads();
+    }
+
+    void Serve(const std::shared_ptr<Connection>& connection) noexcept
+    {
+        std::thread writer{&Connection::WriterMain, connection.get()};
+
+        const std::string error = ReadRequests(connection);
+        if (!error.empty())
+        {
+            connection->Send(fmt::format("{{\"error\":{}}}\n", dlx::FormatJsonString(error)));
+        }
+
+        connection->EndReading();
+        writer.join();
+
+        ::close(connection->GetFd());
+        connection->finished.store(true, std::memory_order_release);
+    }
+
+    // Finishes the queued runs, connections have to be closed first
+    void Shutdown() noexcept
+    {
+        m_Pool.Shutdown();
+    }
+
+private:
+    // Returns a description of an invalid request or an empty string once the client is done
+    [[nodiscard]] std::string ReadRequests(const std::shared_ptr<Connection>& connection) noexcept
+    {
+        SocketReader reader{connection->GetFd()};
+        std::string  line;
+        std::string  data;
+
+        std::shared_ptr<Job>     job;
+        dlx::SharedParsedProgram program;
+        std::string              rejection;
+        phi::size_t              dump_words{0u};
+        phi::size_t              number_of_inputs{0u};
+
+        while (true)
+        {
+            const ReadResult result = reader.ReadLine(line);
+            if (result == ReadResult::EndOfStream)
+            {
+                return job ? "Connection closed inside of a job" : std::string{};
+            }
+
+            if (result == ReadResult::LineTooLong)
+            {
+                return "Request line too long";
+            }
+
+            const phi::size_t      space = line.find(' ');
+            const std::string_view command  = std::string_view{line}.substr(0u, space);
+            const std::string_view argument =
+                    space == std::string::npos ? std::string_view{} :
+                                                 std::string_view{line}.substr(space + 1u);
+
+            if (line.empty())
+            {
+                continue;
+            }
+
+            if (command == "JOB")
+            {
+                if (job)
+                {
+                    return "JOB inside of a job";
+                }
+
+                if (!is_valid_job_id(argument))
+                {
+                    return fmt::format("Invalid job id '{}'", argument);
+                }
+
+                job     = std::make_shared<Job>();
+                job->id = argument;
+                job->settings.max_number_of_steps = m_Config.max_steps;
+                if (job->settings.memory_size > m_Config.max_memory)
+                {
+                    job->settings.memory_size = m_Config.max_memory;
+                }
+
+                program = nullptr;
+                rejection.clear();
+                dump_words       = 0u;
+                number_of_inputs = 0u;
+                continue;
+            }
+
+            if (!job)
+            {
+                return fmt::format("{} outside of a job", command);
+            }
+
+            if (command == "SOURCE" || command == "INPUT")
+            {
+                phi::size_t size{0u};
+                if (!parse_number(argument, size) || size > m_Config.max_source)
+                {
+                    return fmt::format("Invalid {} size '{}'", command, argument);
+                }
+
+                if (!reader.Read(size, data))
+                {
+                    return "Connection closed inside of a job";
+                }
+
+                if (!rejection.empty())
+                {
+                    continue;
+                }
+
+                if (command == "SOURCE")
+                {
+                    rejection = LoadProgram(data, program, number_of_inputs);
+                }
+                else if (!program)
+                {
+                    rejection = "INPUT before SOURCE";
+                }
+                else if (!SubmitRun(connection, job, program, number_of_inputs++, data))
+                {
+                    return "Server shutting down";
+                }
+            }
+            else if (command == "END")
+            {
+                if (rejection.empty() && !program)
+                {
+                    rejection = "Missing SOURCE";
+                }
+
+                if (!rejection.empty())
+                {
+                    connection->Send(fmt::format("{{\"job\":{},\"error\":{}}}\n",
+                                                 dlx::FormatJsonString(job->id),
+                                                 dlx::FormatJsonString(rejection)));
+                }
+                else
+                {
+                    // Without inputs the program runs once from a cleared processor
+                    if (number_of_inputs == 0u &&
+                        !SubmitRun(connection, job, program, number_of_inputs++, {}))
+                    {
+                        return "Server shutting down";
+                    }
+
+                    connection->EndJob(*job);
+                }
+
+                job     = nullptr;
+                program = nullptr;
+            }
+            else if (command == "STEPS" || command == "MEMORY" || command == "DUMP")
+            {
+                if (!rejection.empty())
+                {
+                    continue;
+                }
+
+                if (number_of_inputs != 0u)
+                {
+                    rejection = fmt::format("{} after INPUT", command);
+                }
+                else
+                {
+                    rejection = ApplySetting(*job, command, argument, dump_words);
+                }
+            }
+            else
+            {
+                return fmt::format("Unknown request '{}'", command);
+            }
+        }
+    }
+
+    // Returns why the job is rejected or an empty string
+    [[nodiscard]] std::string ApplySetting(Job& job, std::string_view command,
+                                           std::string_view argument,
+                                           phi::size_t&     dump_words) const noexcept
+    {
+        if (command == "STEPS")
+        {
+            phi::uint64_t steps{0u};
+            if (!parse_number(argument, steps))
+            {
+                return fmt::format("Invalid step limit '{}'", argument);
+            }
+
+            if (m_Config.max_steps != 0u && (steps == 0u || steps > m_Config.max_steps))
+            {
+                return fmt::format("Step limit {} exceeds the maximum of {}", steps,
+                                   m_Config.max_steps);
+            }
+
+            job.settings.max_number_of_steps = steps;
+            return {};
+        }
+
+        if (command == "MEMORY")
+        {
+            phi::uint32_t start{0u};
+            phi::uint32_t size{0u};
+            if (!parse_pair(argument, start, size, false) || size == 0u ||
+                phi::uint64_t{start} + size > phi::uint64_t{1u} << 32u)
+            {
+                return fmt::format("Invalid memory '{}'", argument);
+            }
+
+            if (size > m_Config.max_memory)
+            {
+                return fmt::format("Memory size {} exceeds the maximum of {}", size,
+                                   m_Config.max_memory);
+            }
+
+            job.settings.memory_starting_address = start;
+            job.settings.memory_size             = size;
+            return {};
+        }
+
+        dlx::MemoryRange range;
+        if (!parse_pair(argument, range.address, range.words, true))
+        {
+            return fmt::format("Invalid memory range '{}'", argument);
+        }
+
+        dump_words += range.words;
+        if (dump_words > MaximumDumpWords)
+        {
+            return fmt::format("More than {} memory words to report", MaximumDumpWords);
+        }
+
+        job.memory_ranges.push_back(range);
+        return {};
+    }
+
+    // Returns why the job is rejected or an empty string
+    [[nodiscard]] std::string LoadProgram(const std::string&        source,
+                                          dlx::SharedParsedProgram& program,
+                                          phi::size_t               number_of_inputs) noexcept
+    {
+        if (program || number_of_inputs != 0u)
+        {
+            return "SOURCE may only be sent once";
+        }
+
+        program = m_Cache.Get(source);
+
+        if (!program->m_ParseErrors.empty())
+        {
+            std::string message{"Failed to parse the program:"};
+            for (const dlx::ParseError& error : program->m_ParseErrors)
+            {
+                message.append(fmt::format(" {};", error.ConstructMessage()));
+            }
+            message.pop_back();
+
+            program = nullptr;
+            return message;
+        }
+
+        return {};
+    }
+
+    // Returns false if the server is shutting down
+    [[nodiscard]] phi::boolean SubmitRun(const std::shared_ptr<Connection>& connection,
+                                         const std::shared_ptr<Job>&        job,
+                                         const dlx::SharedParsedProgram&    program,
+                                         phi::size_t run, std::string_view input) noexcept
+    {
+        if (!connection->BeginRun(*job, m_Config.max_pending_runs))
+        {
+            return false;
+        }
+
+        dlx::BatchJob batch_job = job->settings;
+        std::string   error;
+
+        if (!dlx::ApplyBatchAssignments(batch_job, input, error))
+        {
+            connection->FinishRun(*job, fmt::format("{{\"job\":{},\"run\":{},\"error\":{}}}\n",
+                                                    dlx::FormatJsonString(job->id), run,
+                                                    dlx::FormatJsonString(error)));
+            return true;
+        }
+
+        const phi::boolean submitted = m_Pool.Submit(
+                program, phi::move(batch_job),
+                [connection, job, run](const dlx::BatchResult& result) {
+                    connection->FinishRun(
+                            *job, fmt::format("{{\"job\":{},\"run\":{},\"result\":{}}}\n",
+                                              dlx::FormatJsonString(job->id), run,
+                                              dlx::FormatBatchResultJson(job->settings, result,
+                                                                         job->memory_ranges)));
+                });
+
+        if (!submitted)
+        {
+            connection->CancelRun(*job);
+        }
+
+        return submitted;
+    }
+
+    const ServerConfig& m_Config;
+    dlx::ProgramCache   m_Cache;
+    dlx::ProcessorPool  m_Pool;
+};
+
+// Written to by the signal handler to wake up the accept loop
+static int shutdown_pipe[2]{-1, -1};
+
+extern "C" void handle_signal(int /*signal*/)
+{
+    const char byte{0};
+    (void)!::write(shutdown_pipe[1], &byte, 1u);
+}
+
+[[nodiscard]] static int create_socket(const std::string& path) noexcept
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        fmt::print(stderr, "Socket path '{}' is too long\n", path);
+        return -1;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1u);
+
+    // Replace a socket left behind by a previous server but nothing else
+    struct stat status;
+    if (::stat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode))
+    {
+        ::unlink(path.c_str());
+    }
+
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+    {
+        fmt::print(stderr, "Failed to create a socket: {}\n", std::strerror(errno));
+        return -1;
+    }
+
+    if (::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(fd, SOMAXCONN) != 0)
+    {
+        fmt::print(stderr, "Failed to listen on '{}': {}\n", path, std::strerror(errno));
+        ::close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+struct ConnectionThread
+{
+    std::shared_ptr<Connection> connection;
+    std::thread                 thread;
+};
+
+int main(int argc, char* argv[])
+{
+    ServerConfig config;
+
+    for (int index{1}; index < argc; ++index)
+    {
+        const std::string_view argument  = argv[index];
+        const phi::boolean     has_value = index + 1 < argc;
+
+        if (argument == "-h" || argument == "--help")
+        {
+            print_usage();
+            return Success;
+        }
+
+        if (!has_value)
+        {
+            fmt::print(stderr, "Unexpected argument '{}'\n\n", argument);
+            print_usage();
+            return Error;
+        }
+
+        const std::string_view value = argv[++index];
+        phi::boolean           valid{true};
+
+        if (argument == "--socket")
+        {
+            config.socket_path = value;
+            valid              = !value.empty();
+        }
+        else if (argument == "--threads")
+        {
+            valid = parse_number(value, config.number_of_threads);
+        }
+        else if (argument == "--queue")
+        {
+            valid = parse_number(value, config.queue_capacity) && config.queue_capacity != 0u;
+        }
+        else if (argument == "--pending")
+        {
+            valid = parse_number(value, config.max_pending_runs) && config.max_pending_runs != 0u;
+        }
+        else if (argument == "--cache")
+        {
+            valid = parse_number(value, config.cache_capacity) && config.cache_capacity != 0u;
+        }
+        else if (argument == "--max-steps")
+        {
+            valid = parse_number(value, config.max_steps);
+        }
+        else if (argument == "--max-memory")
+        {
+            valid = parse_number(value, config.max_memory) && config.max_memory != 0u;
+        }
+        else if (argument == "--max-source")
+        {
+            valid = parse_number(value, config.max_source);
+        }
+        else if (argument == "--max-connections")
+        {
+            valid = parse_number(value, config.max_connections) && config.max_connections != 0u;
+        }
+        else
+        {
+            fmt::print(stderr, "Unexpected argument '{}'\n\n", argument);
+            print_usage();
+            return Error;
+        }
+
+        if (!valid)
+        {
+            fmt::print(stderr, "Invalid value '{}' for {}\n", value, argument);
+            return Error;
+        }
+    }
+
+    if (::pipe(shutdown_pipe) != 0)
+    {
+        fmt::print(stderr, "Failed to create a pipe: {}\n", std::strerror(errno));
+        return Error;
+    }
+
+    // Failed writes to clients which went away are handled where they happen
+    std::signal(SIGPIPE, SIG_IGN);
+    std::signal(SIGINT, handle_signal);
+    std::signal(SIGTERM, handle_signal);
+
+    const int listen_fd = create_socket(config.socket_path);
+    if (listen_fd < 0)
+    {
+        return Error;
+    }
+
+    Server server{config};
+    fmt::print(stderr, "Listening on '{}' with {} threads\n", config.socket_path,
+               server.GetNumberOfThreads());
+
+    std::vector<ConnectionThread> connections;
+
+    while (true)
+    {
+        pollfd poll_fds[2]{{listen_fd, POLLIN, 0}, {shutdown_pipe[0], POLLIN, 0}};
+        if (::poll(poll_fds, 2u, -1) < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            fmt::print(stderr, "Failed to wait for connections: {}\n", std::strerror(errno));
+            break;
+        }
+
+        if (poll_fds[1].revents != 0)
+        {
+            break;
+        }
+
+        const int fd = ::accept(listen_fd, nullptr, nullptr);
+        if (fd < 0)
+        {
+            continue;
+        }
+
+        // Join the threads of closed connections
+        for (phi::size_t index{0u}; index < connections.size();)
+        {
+            if (connections[index].connection->finished.load(std::memory_order_acquire))
+            {
+                connections[index].thread.join();
+                connections[index] = phi::move(connections.back());
+                connections.pop_back();
+            }
+            else
+            {
+                ++index;
+            }
+        }
+
+        if (connections.size() >= config.max_connections)
+        {
+            (void)write_all(fd, "{\"error\":\"Too many connections\"}\n");
+            ::close(fd);
+            continue;
+        }
+
+        std::shared_ptr<Connection> connection = std::make_shared<Connection>(fd);
+        std::thread                 thread{&Server::Serve, &server, connection};
+        connections.push_back(ConnectionThread{phi::move(connection), phi::move(thread)});
+    }
+
+    ::close(listen_fd);
+    ::unlink(config.socket_path.c_str());
+
+    // Stop reading requests, then let the queued runs finish before joining the readers which
+    // may be blocked on the full queue
+    for (ConnectionThread& connection_thread : connections)
+    {
+        connection_thread.connection->Close();
+    }
+    server.Shutdown();
+
+    for (ConnectionThread& connection_thread : connections)
+    {
+        connection_thread.thread.join();
+    }
+
+    return Success;
+}
@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include <DLX/BatchRunner.hpp>
+#include <DLX/Parser.hpp>
+#include <DLX/RegisterNames.hpp>
+#include <phi/core/types.hpp>
+
+PHI_CLANG_SUPPRESS_WARNING("-Wglobal-constructors")
+
+// Counts to a different value for every job. Should scale with the number of threads.
+static void BM_BatchRunnerCountWithLoop(benchmark::State& state)
+{
+    static constexpr const char program_source[] = R"dlx(
+loop:
+    SLT R2 R1 R3
+    BEQZ R2 end
+    ADDI R1 R1 #1
+    J loop
+end:
+    HALT
+)dlx";
+
+    static constexpr const phi::size_t number_of_jobs = 512u;
+
+    auto prog = dlx::Parser::Parse(program_source);
+
+    std::vector<dlx::BatchJob> jobs(number_of_jobs);
+    for (phi::size_t index{0u}; index < number_of_jobs; ++index)
+    {
+        jobs[index].int_registers[3u]   = static_cast<phi::int32_t>(1000u + index * 10u);
+        jobs[index].max_number_of_steps = 0u;
+    }
+
+    dlx::BatchRunner runner{static_cast<phi::size_t>(state.range(0))};
+
+    for (auto _ : state)
+    {
+        std::vector<dlx::BatchResult> results = runner.Run(prog, jobs);
+        benchmark::DoNotOptimize(results.data());
+    }
+
+    state.SetItemsProcessed(static_cast<phi::int64_t>(state.iterations() * number_of_jobs));
+}
+BENCHMARK(BM_BatchRunnerCountWithLoop)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
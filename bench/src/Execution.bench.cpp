@@ -1,8 +1,13 @@
 #include <benchmark/benchmark.h>
 
+#include <DLX/BranchPredictor.hpp>
+#include <DLX/CacheSimulator.hpp>
+#include <DLX/OutOfOrderModel.hpp>
 #include <DLX/Parser.hpp>
+#include <DLX/PipelineModel.hpp>
 #include <DLX/Processor.hpp>
 #include <phi/algorithm/string_length.hpp>
+#include <phi/core/observer_ptr.hpp>
 #include <phi/core/types.hpp>
 
 PHI_CLANG_SUPPRESS_WARNING("-Wglobal-constructors")
@@ -47,10 +52,23 @@ static void BM_ProcessorCountWithADDI(benchmark::State& state)
 }
 BENCHMARK(BM_ProcessorCountWithADDI)->RangeMultiplier(2)->Range(8, 8 << 17)->Complexity();
 
-static void BM_ProcessorCountWithLoop(benchmark::State& state)
-{
-    static constexpr const char program_source[] = R"dlx(
+// Counts R1 up to the value in R3
+static constexpr const char count_loop_source[] = R"dlx(
+loop:
+    SLT R2 R1 R3
+    BEQZ R2 end
+    ADDI R1 R1 #1
+    J loop
+end:
+    HALT
+)dlx";
+
+// Same as count_loop_source but loading a word from a 512 byte buffer in every iteration
+static constexpr const char count_loop_with_load_source[] = R"dlx(
 loop:
+    LW R4 1000(R5)
+    ADDI R5 R5 #4
+    ANDI R5 R5 #511
     SLT R2 R1 R3
     BEQZ R2 end
     ADDI R1 R1 #1
@@ -59,13 +77,34 @@ end:
     HALT
 )dlx";
 
+// Never halts so the number of steps has to be limited
+static constexpr const char infinite_loop_source[] = R"dlx(
+loop:
+    J loop
+)dlx";
+
+enum class LoopExecution
+{
+    // ExecuteCurrentProgram using the threaded dispatch loop
+    Program,
+    // ExecuteStep until the processor halts
+    Stepped,
+};
+
+// Runs a loop program with state.range(0) as the end value in R3. The setup is called with the
+// processor before the program is loaded and is the only difference between most benchmarks.
+template <typename ProcessorT, typename SetupT>
+static void run_loop(benchmark::State& state, const char* program_source, LoopExecution execution,
+                     SetupT setup)
+{
     phi::int64_t count = state.range(0);
 
     // Parse it
     auto prog = dlx::Parser::Parse(program_source);
 
-    dlx::Processor proc;
+    ProcessorT proc;
     proc.SetMaxNumberOfSteps(0u); // Allow unlimited number of steps
+    setup(proc);
     proc.LoadProgram(prog);
 
     // Set end value
@@ -74,44 +113,201 @@ end:
     for (auto _ : state)
     {
         // Actual execution
-        proc.ExecuteCurrentProgram();
+        if (execution == LoopExecution::Program)
+        {
+            proc.ExecuteCurrentProgram();
+        }
+        else
+        {
+            // Resets the program counter and everything set up for the program
+            state.PauseTiming();
+            proc.LoadProgram(prog);
+            state.ResumeTiming();
+
+            while (!proc.IsHalted())
+            {
+                proc.ExecuteStep();
+            }
+        }
 
         auto res = proc.IntRegisterGetSignedValue(dlx::IntRegisterID::R1);
         benchmark::DoNotOptimize(res);
 
+        // Reset the counter and the offset of the loaded word
         proc.IntRegisterSetSignedValue(dlx::IntRegisterID::R1, 0);
+        proc.IntRegisterSetSignedValue(dlx::IntRegisterID::R5, 0);
         benchmark::ClobberMemory();
     }
 
     state.SetItemsProcessed(count);
     state.SetComplexityN(count);
 }
+
+static void BM_ProcessorCountWithLoop(benchmark::State& state)
+{
+    run_loop<dlx::Processor>(state, count_loop_source, LoopExecution::Program,
+                             [](dlx::Processor&) {});
+}
 BENCHMARK(BM_ProcessorCountWithLoop)->RangeMultiplier(2)->Range(8, 8 << 17)->Complexity();
 
+// Same as BM_ProcessorCountWithLoop but without tracking register value types
+static void BM_ProcessorCountWithLoopFast(benchmark::State& state)
+{
+    run_loop<dlx::FastProcessor>(state, count_loop_source, LoopExecution::Program,
+                                 [](dlx::FastProcessor&) {});
+}
+BENCHMARK(BM_ProcessorCountWithLoopFast)->RangeMultiplier(2)->Range(8, 8 << 17)->Complexity();
+
+// Same as BM_ProcessorCountWithLoop but with the loop compiled to native code
+static void BM_ProcessorCountWithLoopJIT(benchmark::State& state)
+{
+    run_loop<dlx::Processor>(state, count_loop_source, LoopExecution::Program,
+                             [](dlx::Processor& proc) { proc.SetJITEnabled(true); });
+}
+BENCHMARK(BM_ProcessorCountWithLoopJIT)->RangeMultiplier(2)->Range(8, 8 << 17)->Complexity();
+
+// Same as BM_ProcessorCountWithLoop but executing one step at a time to measure the overhead of the
+// threaded dispatch loop used by ExecuteCurrentProgram
+static void BM_ProcessorCountWithLoopStepped(benchmark::State& state)
+{
+    run_loop<dlx::Processor>(state, count_loop_source, LoopExecution::Stepped,
+                             [](dlx::Processor&) {});
+}
+BENCHMARK(BM_ProcessorCountWithLoopStepped)->RangeMultiplier(2)->Range(8, 8 << 17)->Complexity();
+
+// Same as BM_ProcessorCountWithLoopStepped but counting every executed instruction in the profile
+static void BM_ProcessorCountWithLoopProfiled(benchmark::State& state)
+{
+    run_loop<dlx::Processor>(state, count_loop_source, LoopExecution::Stepped,
+                             [](dlx::Processor& proc) { proc.SetProfilingEnabled(true); });
+}
+BENCHMARK(BM_ProcessorCountWithLoopProfiled)->RangeMultiplier(2)->Range(8, 8 << 17)->Complexity();
+
+// Same as BM_ProcessorCountWithLoopStepped but timing every executed instruction in the pipeline
+// model
+static void BM_ProcessorCountWithLoopPipelined(benchmark::State& state)
+{
+    dlx::PipelineModel model;
+
+    run_loop<dlx::Processor>(
+            state, count_loop_source, LoopExecution::Stepped, [&](dlx::Processor& proc) {
+                proc.SetPipelineModel(phi::observer_ptr<dlx::PipelineModel>{&model});
+            });
+}
+BENCHMARK(BM_ProcessorCountWithLoopPipelined)->RangeMultiplier(2)->Range(8, 8 << 17)->Complexity();
+
+// Same as BM_ProcessorCountWithLoopPipelined but with the control stalls decided by a branch
+// predictor
+static void BM_ProcessorCountWithLoopPredicted(benchmark::State& state)
+{
+    dlx::PipelineModel   model;
+    dlx::BranchPredictor predictor;
+
+    run_loop<dlx::Processor>(
+            state, count_loop_source, LoopExecution::Stepped, [&](dlx::Processor& proc) {
+                proc.SetPipelineModel(phi::observer_ptr<dlx::PipelineModel>{&model});
+                proc.SetBranchPredictor(phi::observer_ptr<dlx::BranchPredictor>{&predictor});
+            });
+}
+BENCHMARK(BM_ProcessorCountWithLoopPredicted)->RangeMultiplier(2)->Range(8, 8 << 17)->Complexity();
+
+// Same as BM_ProcessorCountWithLoopStepped but retiring every executed instruction into the
+// Tomasulo model
+static void BM_ProcessorCountWithLoopOutOfOrder(benchmark::State& state)
+{
+    dlx::OutOfOrderModel model;
+
+    run_loop<dlx::Processor>(
+            state, count_loop_source, LoopExecution::Stepped, [&](dlx::Processor& proc) {
+                proc.SetOutOfOrderModel(phi::observer_ptr<dlx::OutOfOrderModel>{&model});
+            });
+}
+BENCHMARK(BM_ProcessorCountWithLoopOutOfOrder)->RangeMultiplier(2)->Range(8, 8 << 17)->Complexity();
+
+// Same as BM_ProcessorCountWithLoopStepped but loading a word in every iteration while simulating
+// the cache hierarchy
+static void BM_ProcessorCountWithLoopCached(benchmark::State& state)
+{
+    dlx::CacheSimulator simulator;
+
+    run_loop<dlx::Processor>(
+            state, count_loop_with_load_source, LoopExecution::Stepped, [&](dlx::Processor& proc) {
+                proc.SetCacheSimulator(phi::observer_ptr<dlx::CacheSimulator>{&simulator});
+            });
+}
+BENCHMARK(BM_ProcessorCountWithLoopCached)->RangeMultiplier(2)->Range(8, 8 << 17)->Complexity();
+
+// Same as BM_ProcessorCountWithLoopCached but also classifying every miss. The ratio of both is
+// the overhead of the shadow caches.
+static void BM_ProcessorCountWithLoopCachedClassified(benchmark::State& state)
+{
+    dlx::CacheHierarchyConfig config;
+    config.classify_misses = true;
+
+    dlx::CacheSimulator simulator{config};
+
+    run_loop<dlx::Processor>(
+            state, count_loop_with_load_source, LoopExecution::Stepped, [&](dlx::Processor& proc) {
+                proc.SetCacheSimulator(phi::observer_ptr<dlx::CacheSimulator>{&simulator});
+            });
+}
+BENCHMARK(BM_ProcessorCountWithLoopCachedClassified)
+        ->RangeMultiplier(2)
+        ->Range(8, 8 << 17)
+        ->Complexity();
+
 static void BM_ProcessorInfiniteLoop(benchmark::State& state)
+{
+    // Limit number of executions
+    const phi::uint64_t max_steps = static_cast<phi::uint64_t>(state.range(0));
+
+    run_loop<dlx::Processor>(
+            state, infinite_loop_source, LoopExecution::Program,
+            [&](dlx::Processor& proc) { proc.SetMaxNumberOfSteps(max_steps); });
+}
+BENCHMARK(BM_ProcessorInfiniteLoop)->RangeMultiplier(2)->Range(8, 8 << 17)->Complexity();
+
+// Same as BM_ProcessorInfiniteLoop but executing one step at a time
+static void BM_ProcessorInfiniteLoopStepped(benchmark::State& state)
+{
+    // Limit number of executions
+    const phi::uint64_t max_steps = static_cast<phi::uint64_t>(state.range(0));
+
+    run_loop<dlx::Processor>(
+            state, infinite_loop_source, LoopExecution::Stepped,
+            [&](dlx::Processor& proc) { proc.SetMaxNumberOfSteps(max_steps); });
+}
+BENCHMARK(BM_ProcessorInfiniteLoopStepped)->RangeMultiplier(2)->Range(8, 8 << 17)->Complexity();
+
+// Resetting to a prepared state should only depend on the memory touched by the program
+static void BM_ProcessorRestoreSnapshot(benchmark::State& state)
 {
     static constexpr const char program_source[] = R"dlx(
-loop:
-    J loop
+    ADDI R1 R1 #1
+    SW 1000(R0) R1
+    HALT
 )dlx";
 
-    phi::int64_t count = state.range(0);
+    const phi::int64_t memory_size = state.range(0);
 
     // Parse it
     auto prog = dlx::Parser::Parse(program_source);
 
     dlx::Processor proc;
-    proc.SetMaxNumberOfSteps(static_cast<phi::uint64_t>(count)); // Limit number of executions
     proc.LoadProgram(prog);
+    proc.GetMemory().Resize(static_cast<phi::size_t>(memory_size));
+
+    const dlx::ProcessorSnapshot snapshot = proc.Snapshot();
 
     for (auto _ : state)
     {
-        // Actual execution
         proc.ExecuteCurrentProgram();
+
+        proc.Restore(snapshot);
+
         benchmark::ClobberMemory();
     }
 
-    state.SetItemsProcessed(count);
-    state.SetComplexityN(count);
+    state.SetComplexityN(memory_size);
 }
-BENCHMARK(BM_ProcessorInfiniteLoop)->RangeMultiplier(2)->Range(8, 8 << 17)->Complexity();
+BENCHMARK(BM_ProcessorRestoreSnapshot)->RangeMultiplier(8)->Range(1 << 10, 1 << 26)->Complexity();
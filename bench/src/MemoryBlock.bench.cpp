@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+
+#include <DLX/MemoryBlock.hpp>
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/types.hpp>
+
+PHI_CLANG_SUPPRESS_WARNING("-Wglobal-constructors")
+
+static constexpr const phi::size_t MemoryStart{1000u};
+
+static void BM_MemoryBlockLoadStoreWord(benchmark::State& state)
+{
+    const phi::size_t memory_size = static_cast<phi::size_t>(state.range(0));
+
+    dlx::MemoryBlock mem{MemoryStart, memory_size};
+
+    for (auto _ : state)
+    {
+        for (phi::size_t address{MemoryStart}; address < MemoryStart + memory_size; address += 4u)
+        {
+            const phi::i32 value = mem.LoadWord(address).value();
+            mem.StoreWord(address, value + 1);
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MemoryBlockLoadStoreWord)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+static void BM_MemoryBlockLoadStoreWordFast(benchmark::State& state)
+{
+    const phi::size_t memory_size = static_cast<phi::size_t>(state.range(0));
+
+    dlx::MemoryBlock mem{MemoryStart, memory_size};
+
+    for (auto _ : state)
+    {
+        for (phi::size_t address{MemoryStart}; address < MemoryStart + memory_size; address += 4u)
+        {
+            phi::int32_t value;
+            if (mem.Load(address, value) == dlx::MemoryAccessResult::Success)
+            {
+                benchmark::DoNotOptimize(mem.Store(address, value + 1));
+            }
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MemoryBlockLoadStoreWordFast)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+static void BM_MemoryBlockLoadStoreWordPaged(benchmark::State& state)
+{
+    const phi::size_t memory_size = static_cast<phi::size_t>(state.range(0));
+
+    dlx::MemoryBlock mem{0u, 0u};
+    mem.SetPaged(true);
+
+    for (auto _ : state)
+    {
+        for (phi::size_t address{0u}; address < memory_size; address += 4u)
+        {
+            phi::int32_t value;
+            if (mem.Load(address, value) == dlx::MemoryAccessResult::Success)
+            {
+                benchmark::DoNotOptimize(mem.Store(address, value + 1));
+            }
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MemoryBlockLoadStoreWordPaged)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
+
+static void BM_MemoryBlockLoadStoreWordGuarded(benchmark::State& state)
+{
+    const phi::size_t memory_size = static_cast<phi::size_t>(state.range(0));
+
+    dlx::MemoryBlock mem{MemoryStart, memory_size};
+    if (!mem.SetGuarded(true))
+    {
+        state.SkipWithError("Guarded memory is not supported");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        for (phi::size_t address{MemoryStart}; address < MemoryStart + memory_size; address += 4u)
+        {
+            phi::int32_t value;
+            if (mem.Load(address, value) == dlx::MemoryAccessResult::Success)
+            {
+                benchmark::DoNotOptimize(mem.Store(address, value + 1));
+            }
+        }
+
+        benchmark::ClobberMemory();
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MemoryBlockLoadStoreWordGuarded)->RangeMultiplier(8)->Range(1 << 10, 1 << 20);
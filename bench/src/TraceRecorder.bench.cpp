@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include <DLX/Parser.hpp>
+#include <DLX/Processor.hpp>
+#include <DLX/TraceRecorder.hpp>
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/types.hpp>
+#include <filesystem>
+#include <string>
+
+PHI_CLANG_SUPPRESS_WARNING("-Wglobal-constructors")
+
+// Touches registers and memory every iteration so every trace hook is exercised
+static constexpr const char program_source[] = R"dlx(
+loop:
+    ADDI R1 R1 #1
+    SW 1000(R0) R1
+    LW R2 1000(R0)
+    J loop
+)dlx";
+
+// Executes the given number of steps per iteration so the items per second are the executed
+// instructions per second
+static void RunProgram(benchmark::State& state, phi::observer_ptr<dlx::TraceWriter> writer)
+{
+    const phi::size_t steps = static_cast<phi::size_t>(state.range(0));
+
+    auto prog = dlx::Parser::Parse(program_source);
+
+    dlx::Processor proc;
+    proc.SetMaxNumberOfSteps(0u); // Allow unlimited number of steps
+    proc.SetTraceWriter(writer);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        proc.LoadProgram(prog);
+        state.ResumeTiming();
+
+        auto reason = proc.RunUntilBreak(steps);
+        benchmark::DoNotOptimize(reason);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_ProcessorStepsWithoutTracing(benchmark::State& state)
+{
+    RunProgram(state, phi::observer_ptr<dlx::TraceWriter>{});
+}
+BENCHMARK(BM_ProcessorStepsWithoutTracing)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+static void BM_ProcessorStepsWithTracing(benchmark::State& state)
+{
+    const std::string path =
+            std::filesystem::temp_directory_path().string() + "/dlxlib_trace_benchmark";
+
+    dlx::TraceWriter writer;
+    if (!writer.Open(path))
+    {
+        state.SkipWithError("Failed to open the trace file");
+        return;
+    }
+
+    RunProgram(state, phi::observer_ptr<dlx::TraceWriter>{&writer});
+
+    writer.Close();
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_ProcessorStepsWithTracing)->RangeMultiplier(8)->Range(1 << 10, 1 << 19);
+
+// Cost of the writer alone
+static void BM_TraceWriterAppend(benchmark::State& state)
+{
+    const std::string path =
+            std::filesystem::temp_directory_path().string() + "/dlxlib_trace_benchmark";
+
+    dlx::TraceWriter writer;
+    if (!writer.Open(path))
+    {
+        state.SkipWithError("Failed to open the trace file");
+        return;
+    }
+
+    dlx::TraceRecord record;
+
+    for (auto _ : state)
+    {
+        ++record.step;
+        writer.Append(record);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<phi::int64_t>(sizeof(dlx::TraceRecord)));
+
+    writer.Close();
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_TraceWriterAppend);
@@ -0,0 +1,213 @@
+#include <phi/test/test_macros.hpp>
+
+#include <DLX/BatchFormat.hpp>
+#include <DLX/BatchRunner.hpp>
+#include <DLX/Parser.hpp>
+#include <DLX/Processor.hpp>
+#include <phi/core/types.hpp>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static phi::int32_t GetImageWord(const dlx::BatchJob& job, phi::size_t offset)
+{
+    phi::int32_t word{0};
+    REQUIRE(offset + sizeof(word) <= job.memory_image.size());
+    std::memcpy(&word, job.memory_image.data() + offset, sizeof(word));
+
+    return word;
+}
+
+TEST_CASE("ApplyBatchAssignment")
+{
+    dlx::BatchJob job;
+    std::string   error;
+
+    SECTION("Registers")
+    {
+        CHECK(dlx::ApplyBatchAssignment(job, "R1 = 42", error));
+        CHECK(dlx::ApplyBatchAssignment(job, "r2=-7", error));
+        CHECK(dlx::ApplyBatchAssignment(job, "  R31 =\t0xFFFFFFFF ", error));
+        CHECK(dlx::ApplyBatchAssignment(job, "R3 = -2147483648", error));
+        CHECK(dlx::ApplyBatchAssignment(job, "F1 = 1.5", error));
+        CHECK(dlx::ApplyBatchAssignment(job, "FPSR = 1", error));
+
+        CHECK(job.int_registers[1u] == 42);
+        CHECK(job.int_registers[2u] == -7);
+        CHECK(job.int_registers[31u] == -1);
+        CHECK(job.int_registers[3u] == -2147483647 - 1);
+        CHECK(job.float_registers[1u] == 1.5f);
+        CHECK(job.fpsr);
+
+        // The same layout as FloatRegisterSetDoubleValue
+        CHECK(dlx::ApplyBatchAssignment(job, "D4 = 2.5", error));
+
+        dlx::Processor processor;
+        for (phi::size_t index{0u}; index < 32u; ++index)
+        {
+            processor.FloatRegisterSetFloatValue(static_cast<dlx::FloatRegisterID>(index),
+                                                 job.float_registers[index]);
+        }
+        CHECK(processor.FloatRegisterGetDoubleValue(dlx::FloatRegisterID::F4).unsafe() == 2.5);
+    }
+
+    SECTION("Memory")
+    {
+        job.memory_starting_address = 1000u;
+        job.memory_size             = 32u;
+
+        CHECK(dlx::ApplyBatchAssignment(job, "M[1004] = 7", error));
+        CHECK(job.memory_image.size() == 8u);
+        CHECK(GetImageWord(job, 4u) == 7);
+        CHECK(GetImageWord(job, 0u) == 0);
+
+        CHECK(dlx::ApplyBatchAssignment(job, "m[ 0x3E8 ] = -1", error));
+        CHECK(GetImageWord(job, 0u) == -1);
+
+        CHECK(dlx::ApplyBatchAssignment(job, "MF[1008] = 0.25", error));
+        CHECK(dlx::ApplyBatchAssignment(job, "MD[1024] = 3.5", error));
+        CHECK(job.memory_image.size() == 32u);
+
+        float  float_value{0.0f};
+        double double_value{0.0};
+        std::memcpy(&float_value, job.memory_image.data() + 8u, sizeof(float_value));
+        std::memcpy(&double_value, job.memory_image.data() + 24u, sizeof(double_value));
+        CHECK(float_value == 0.25f);
+        CHECK(double_value == 3.5);
+    }
+
+    SECTION("Errors")
+    {
+        job.memory_size = 16u;
+
+        CHECK_FALSE(dlx::ApplyBatchAssignment(job, "R1", error));
+        CHECK(error == "Expected '<target> = <value>' but got 'R1'");
+
+        CHECK_FALSE(dlx::ApplyBatchAssignment(job, "R32 = 1", error));
+        CHECK(error == "Unknown register or memory location 'R32'");
+
+        CHECK_FALSE(dlx::ApplyBatchAssignment(job, "R1 = 4294967296", error));
+        CHECK(error == "Invalid word '4294967296'");
+
+        CHECK_FALSE(dlx::ApplyBatchAssignment(job, "R1 = -2147483649", error));
+        CHECK_FALSE(dlx::ApplyBatchAssignment(job, "R1 = 1x", error));
+        CHECK_FALSE(dlx::ApplyBatchAssignment(job, "R1 =", error));
+        CHECK_FALSE(dlx::ApplyBatchAssignment(job, "F1 = one", error));
+        CHECK_FALSE(dlx::ApplyBatchAssignment(job, "FPSR = 2", error));
+
+        CHECK_FALSE(dlx::ApplyBatchAssignment(job, "D3 = 1.0", error));
+        CHECK(error == "Double register 'D3' must be even");
+
+        CHECK_FALSE(dlx::ApplyBatchAssignment(job, "M[1016] = 1", error));
+        CHECK(error == "Address 1016 is outside of the memory [1000, 1016)");
+
+        CHECK_FALSE(dlx::ApplyBatchAssignment(job, "M[999] = 1", error));
+        CHECK_FALSE(dlx::ApplyBatchAssignment(job, "MD[1012] = 1", error));
+
+        CHECK_FALSE(dlx::ApplyBatchAssignment(job, "M[1002] = 1", error));
+        CHECK(error == "Address 1002 is misaligned for a 4 byte value");
+
+        CHECK_FALSE(dlx::ApplyBatchAssignment(job, "M[abc] = 1", error));
+        CHECK_FALSE(dlx::ApplyBatchAssignment(job, "MX[1000] = 1", error));
+
+        // Nothing was changed
+        CHECK(job.int_registers[1u] == 0);
+        CHECK(job.memory_image.empty());
+    }
+}
+
+TEST_CASE("ApplyBatchAssignments")
+{
+    dlx::BatchJob job;
+    std::string   error;
+
+    CHECK(dlx::ApplyBatchAssignments(job, "# Initial state\nR1 = 1\n\n  R2 = 2 # two\r\nR3=3",
+                                     error));
+    CHECK(job.int_registers[1u] == 1);
+    CHECK(job.int_registers[2u] == 2);
+    CHECK(job.int_registers[3u] == 3);
+
+    CHECK(dlx::ApplyBatchAssignments(job, "", error));
+
+    CHECK_FALSE(dlx::ApplyBatchAssignments(job, "R4 = 4\n\nR5 = five\nR6 = 6\n", error));
+    CHECK(error == "Line 3: Invalid word 'five'");
+    CHECK(job.int_registers[4u] == 4);
+    CHECK(job.int_registers[6u] == 0);
+}
+
+TEST_CASE("FormatBatchResult")
+{
+    const dlx::ParsedProgram program = dlx::Parser::Parse(R"(
+        LW R2 1000(R0)
+        ADD R2 R2 R1
+        SW 1004(R0) R2
+    loop:
+        J loop
+    )");
+    REQUIRE(program.m_ParseErrors.empty());
+
+    dlx::BatchJob job;
+    job.memory_size         = 8u;
+    job.max_number_of_steps = 50u;
+
+    std::string error;
+    REQUIRE(dlx::ApplyBatchAssignments(job, "R1 = 5\nM[1000] = -3\nF2 = 0.5", error));
+
+    dlx::BatchRunner                    runner{1u};
+    const std::vector<dlx::BatchResult> results = runner.Run(program, {job});
+    REQUIRE(results.size() == 1u);
+
+    const dlx::BatchResult& result = results[0u];
+    CHECK(dlx::GetBatchStatus(job, result) == dlx::BatchStatus::StepLimit);
+
+    const std::vector<dlx::MemoryRange> ranges{{1000u, 2u}, {1006u, 1u}};
+
+    const std::string text = dlx::FormatBatchResult(job, result, ranges);
+    CHECK(text.find("Status           Step limit\n") != std::string::npos);
+    CHECK(text.find("Exception              None\n") != std::string::npos);
+    CHECK(text.find("Steps                    50\n") != std::string::npos);
+    CHECK(text.find("R0             0  R1             5  R2             2  R3             0\n") !=
+          std::string::npos);
+    CHECK(text.find("F0             0  F1             0  F2           0.5") != std::string::npos);
+    CHECK(text.find("[1000]          -3\n[1004]           2\n[1006]           -\n") !=
+          std::string::npos);
+
+    const std::string json = dlx::FormatBatchResultJson(job, result, ranges, "a \"b\"\n");
+    CHECK(json.find("{\"input\":\"a \\\"b\\\"\\u000a\",\"status\":\"step_limit\","
+                    "\"exception\":\"None\",\"steps\":50,\"program_counter\":3,"
+                    "\"int_registers\":[0,5,2,0,") == 0u);
+    CHECK(json.find("\"float_registers\":[0,0,0.5,0,") != std::string::npos);
+    CHECK(json.find("\"fpsr\":false,\"memory\":[{\"address\":1000,\"words\":[-3,2]},"
+                    "{\"address\":1006,\"words\":[null]}]}") != std::string::npos);
+    CHECK(json.find('\n') == std::string::npos);
+
+    CHECK(dlx::FormatBatchResultJson(job, result, {}).find("{\"status\"") == 0u);
+}
+
+TEST_CASE("GetBatchStatus")
+{
+    dlx::BatchJob    job;
+    dlx::BatchResult result;
+
+    job.max_number_of_steps = 10u;
+    result.step_count       = 3u;
+    CHECK(dlx::GetBatchStatus(job, result) == dlx::BatchStatus::Halted);
+
+    result.last_raised_exception = dlx::Exception::Overflow;
+    CHECK(dlx::GetBatchStatus(job, result) == dlx::BatchStatus::Halted);
+
+    result.last_raised_exception = dlx::Exception::DivideByZero;
+    CHECK(dlx::GetBatchStatus(job, result) == dlx::BatchStatus::Exception);
+
+    result.last_raised_exception = dlx::Exception::None;
+    result.step_count            = 10u;
+    CHECK(dlx::GetBatchStatus(job, result) == dlx::BatchStatus::StepLimit);
+
+    result.last_raised_exception = dlx::Exception::Halt;
+    CHECK(dlx::GetBatchStatus(job, result) == dlx::BatchStatus::Halted);
+
+    // No limit
+    job.max_number_of_steps      = 0u;
+    result.last_raised_exception = dlx::Exception::None;
+    CHECK(dlx::GetBatchStatus(job, result) == dlx::BatchStatus::Halted);
+}
@@ -0,0 +1,241 @@
+#include <phi/test/test_macros.hpp>
+
+#include <DLX/BatchRunner.hpp>
+#include <DLX/Parser.hpp>
+#include <DLX/Processor.hpp>
+#include <DLX/RegisterNames.hpp>
+#include <phi/core/types.hpp>
+#include <thread>
+
+static dlx::BatchJob MakeJob(phi::size_t index)
+{
+    dlx::BatchJob job;
+    job.int_registers[1u] = static_cast<phi::int32_t>(index);
+    job.int_registers[2u] = static_cast<phi::int32_t>(index % 7u);
+    job.memory_size       = 16u;
+    job.memory_image      = {static_cast<phi::uint8_t>(index), 0u, 0u, 0u};
+
+    return job;
+}
+
+TEST_CASE("BatchRunner")
+{
+    // Divides by zero for every seventh job
+    dlx::ParsedProgram program = dlx::Parser::Parse(R"(
+        LW R3 1000(R0)
+        ADD R3 R3 R1
+        SW 1004(R0) R3
+        DIV R4 R1 R2
+    loop:
+        SUBI R1 R1 #1
+        BNEZ R1 loop
+        HALT
+    )");
+    REQUIRE(program.m_ParseErrors.empty());
+
+    std::vector<dlx::BatchJob> jobs;
+    for (phi::size_t index{0u}; index < 200u; ++index)
+    {
+        jobs.push_back(MakeJob(index));
+    }
+
+    dlx::BatchRunner runner{4u};
+    CHECK(runner.GetNumberOfThreads() == 4u);
+
+    // Run multiple batches with the same workers
+    for (phi::size_t batch{0u}; batch < 3u; ++batch)
+    {
+        const std::vector<dlx::BatchResult> results = runner.Run(program, jobs);
+        REQUIRE(results.size() == jobs.size());
+
+        for (phi::size_t index{0u}; index < jobs.size(); ++index)
+        {
+            const dlx::BatchJob&    job    = jobs[index];
+            const dlx::BatchResult& result = results[index];
+
+            // Execute the same job serially
+            dlx::Processor processor;
+            processor.LoadProgram(program);
+            for (phi::size_t id{1u}; id < 32u; ++id)
+            {
+                processor.IntRegisterSetSignedValue(static_cast<dlx::IntRegisterID>(id),
+                                                    job.int_registers[id]);
+            }
+            processor.GetMemory().Resize(job.memory_size);
+            processor.GetMemory().StoreUnsignedWord(1000u, static_cast<phi::uint32_t>(index % 256u));
+            processor.ExecuteCurrentProgram();
+
+            CHECK(result.step_count == processor.GetCurrentStepCount());
+            CHECK(result.program_counter == processor.GetProgramCounter());
+            CHECK(result.last_raised_exception == processor.GetLastRaisedException());
+
+            for (phi::size_t id{0u}; id < 32u; ++id)
+            {
+                CHECK(result.int_registers[id] ==
+                      processor.IntRegisterGetSignedValue(static_cast<dlx::IntRegisterID>(id))
+                              .unsafe());
+            }
+
+            REQUIRE(result.memory.size() == 16u);
+            CHECK(result.memory[4u] ==
+                  processor.GetMemory().LoadUnsignedByte(1004u).value().unsafe());
+        }
+
+        CHECK(results[7u].last_raised_exception == dlx::Exception::DivideByZero);
+        CHECK(results[8u].last_raised_exception == dlx::Exception::Halt);
+    }
+}
+
+TEST_CASE("BatchRunner step limit")
+{
+    dlx::ParsedProgram program = dlx::Parser::Parse(R"(
+    loop:
+        ADDI R1 R1 #1
+        J loop
+    )");
+    REQUIRE(program.m_ParseErrors.empty());
+
+    std::vector<dlx::BatchJob> jobs(3u);
+    jobs[0u].max_number_of_steps = 1u;
+    jobs[1u].max_number_of_steps = 10u;
+    jobs[2u].max_number_of_steps = 101u;
+
+    dlx::BatchRunner runner{2u};
+
+    const std::vector<dlx::BatchResult> results = runner.Run(program, jobs);
+    REQUIRE(results.size() == 3u);
+
+    CHECK(results[0u].step_count == 1u);
+    CHECK(results[0u].int_registers[1u] == 1);
+    CHECK(results[1u].step_count == 10u);
+    CHECK(results[1u].int_registers[1u] == 5);
+    CHECK(results[2u].step_count == 101u);
+    CHECK(results[2u].int_registers[1u] == 51);
+}
+
+TEST_CASE("BatchRunner concurrent runs")
+{
+    // Runs for more steps than the default limit
+    dlx::ParsedProgram countdown = dlx::Parser::Parse(R"(
+    loop:
+        SUBI R1 R1 #1
+        BNEZ R1 loop
+        HALT
+    )");
+    REQUIRE(countdown.m_ParseErrors.empty());
+
+    dlx::ParsedProgram add = dlx::Parser::Parse("ADDI R2 R1 #5");
+    REQUIRE(add.m_ParseErrors.empty());
+
+    std::vector<dlx::BatchJob> countdown_jobs(20u);
+    for (dlx::BatchJob& job : countdown_jobs)
+    {
+        job.int_registers[1u]   = 6'000;
+        job.max_number_of_steps = 0u;
+    }
+
+    std::vector<dlx::BatchJob> add_jobs;
+    for (phi::size_t index{0u}; index < 100u; ++index)
+    {
+        add_jobs.push_back(MakeJob(index));
+    }
+
+    dlx::BatchRunner runner{4u};
+
+    std::vector<dlx::BatchResult> countdown_results;
+    std::thread                   thread{[&] {
+        for (phi::size_t batch{0u}; batch < 10u; ++batch)
+        {
+            countdown_results = runner.Run(countdown, countdown_jobs);
+        }
+    }};
+
+    std::vector<dlx::BatchResult> add_results;
+    for (phi::size_t batch{0u}; batch < 10u; ++batch)
+    {
+        add_results = runner.Run(add, add_jobs);
+    }
+
+    thread.join();
+
+    REQUIRE(countdown_results.size() == countdown_jobs.size());
+    for (const dlx::BatchResult& result : countdown_results)
+    {
+        CHECK(result.last_raised_exception == dlx::Exception::Halt);
+        CHECK(result.step_count == 12'000u);
+        CHECK(result.int_registers[1u] == 0);
+    }
+
+    REQUIRE(add_results.size() == add_jobs.size());
+    for (phi::size_t index{0u}; index < add_jobs.size(); ++index)
+    {
+        CHECK(add_results[index].int_registers[2u] == static_cast<phi::int32_t>(index) + 5);
+    }
+}
+
+TEST_CASE("BatchRunner more threads than jobs")
+{
+    dlx::ParsedProgram program = dlx::Parser::Parse("ADDI R1 R1 #5");
+    REQUIRE(program.m_ParseErrors.empty());
+
+    std::vector<dlx::BatchJob> jobs(2u);
+    jobs[1u].int_registers[1u] = 10;
+
+    dlx::BatchRunner runner{8u};
+
+    const std::vector<dlx::BatchResult> results = runner.Run(program, jobs);
+    REQUIRE(results.size() == 2u);
+
+    CHECK(results[0u].int_registers[1u] == 5);
+    CHECK(results[1u].int_registers[1u] == 15);
+}
+
+TEST_CASE("BatchRunner memory image larger than the memory")
+{
+    dlx::ParsedProgram program = dlx::Parser::Parse("ADDI R1 R1 #5");
+    REQUIRE(program.m_ParseErrors.empty());
+
+    std::vector<dlx::BatchJob> jobs(2u);
+    jobs[0u].memory_size       = 4u;
+    jobs[0u].memory_image      = {1u, 2u, 3u, 4u};
+    jobs[1u].memory_size       = 4u;
+    jobs[1u].memory_image      = {1u, 2u, 3u, 4u, 5u};
+    jobs[1u].int_registers[1u] = 3;
+    CHECK(dlx::IsBatchJobValid(jobs[0u]));
+    CHECK_FALSE(dlx::IsBatchJobValid(jobs[1u]));
+
+    dlx::BatchRunner runner{1u};
+
+    const std::vector<dlx::BatchResult> results = runner.Run(program, jobs);
+    REQUIRE(results.size() == 2u);
+
+    CHECK(results[0u].int_registers[1u] == 5);
+    CHECK(results[0u].memory.size() == 4u);
+
+    // Not executed
+    CHECK(results[1u].last_raised_exception == dlx::Exception::AddressOutOfBounds);
+    CHECK(results[1u].step_count == 0u);
+    CHECK(results[1u].int_registers[1u] == 3);
+    CHECK(results[1u].memory.empty());
+}
+
+TEST_CASE("BatchRunner empty batch")
+{
+    dlx::ParsedProgram program = dlx::Parser::Parse("ADDI R1 R1 #5");
+    REQUIRE(program.m_ParseErrors.empty());
+
+    dlx::BatchRunner runner;
+    CHECK(runner.GetNumberOfThreads() > 0u);
+
+    CHECK(runner.Run(program, {}).empty());
+}
+
+TEST_CASE("BatchRunner parse errors")
+{
+    dlx::ParsedProgram program = dlx::Parser::Parse("ADD R1");
+    REQUIRE_FALSE(program.m_ParseErrors.empty());
+
+    dlx::BatchRunner runner{1u};
+
+    CHECK(runner.Run(program, std::vector<dlx::BatchJob>(3u)).empty());
+}
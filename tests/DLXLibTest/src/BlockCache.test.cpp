@@ -0,0 +1,95 @@
+#include <phi/test/test_macros.hpp>
+
+#include <DLX/BlockCache.hpp>
+#include <DLX/DecodedProgram.hpp>
+#include <DLX/OpCode.hpp>
+#include <DLX/Parser.hpp>
+#include <phi/core/types.hpp>
+
+TEST_CASE("MatchSuperinstruction")
+{
+    dlx::ParsedProgram program = dlx::Parser::Parse("loop:\n"
+                                                    "SLT R1 R2 R3\n"
+                                                    "BEQZ R1 loop\n"
+                                                    "ADDI R2 R2 #1\n"
+                                                    "J loop\n"
+                                                    "LW R1 1000(R0)\n"
+                                                    "ADD R1 R1 R2\n"
+                                                    "SW 1000(R0) R1\n"
+                                                    "LW R1 1000(R0)\n"
+                                                    "ADD R1 R1 R2\n");
+    REQUIRE(program.m_ParseErrors.empty());
+
+    const dlx::DecodedProgram decoded = dlx::DecodeProgram(program);
+
+    CHECK(dlx::MatchSuperinstruction(decoded, 0u, 1u).value() == dlx::Superinstruction::SLT_BEQZ);
+    CHECK(dlx::MatchSuperinstruction(decoded, 2u, 3u).value() == dlx::Superinstruction::ADDI_J);
+    CHECK(dlx::MatchSuperinstruction(decoded, 4u, 8u).value() ==
+          dlx::Superinstruction::LW_ADD_SW);
+
+    // Sequences may not cross the end of a block
+    CHECK_FALSE(dlx::MatchSuperinstruction(decoded, 0u, 0u).has_value());
+    CHECK_FALSE(dlx::MatchSuperinstruction(decoded, 7u, 8u).has_value());
+    CHECK_FALSE(dlx::MatchSuperinstruction(decoded, 1u, 1u).has_value());
+
+    CHECK(dlx::GetSuperinstructionLength(dlx::Superinstruction::SLT_BEQZ) == 2u);
+    CHECK(dlx::GetSuperinstructionLength(dlx::Superinstruction::ADDI_J) == 2u);
+    CHECK(dlx::GetSuperinstructionLength(dlx::Superinstruction::LW_ADD_SW) == 3u);
+}
+
+TEST_CASE("BlockCache")
+{
+    dlx::ParsedProgram program = dlx::Parser::Parse("ADDI R3 R0 #10\n"
+                                                    "loop:\n"
+                                                    "SLT R2 R1 R3\n"
+                                                    "BEQZ R2 end\n"
+                                                    "LW R4 1000(R0)\n"
+                                                    "ADD R4 R4 R1\n"
+                                                    "SW 1000(R0) R4\n"
+                                                    "ADDI R1 R1 #1\n"
+                                                    "J loop\n"
+                                                    "end:\n"
+                                                    "HALT\n");
+    REQUIRE(program.m_ParseErrors.empty());
+
+    const dlx::DecodedProgram decoded = dlx::DecodeProgram(program);
+
+    dlx::BlockCache cache;
+    cache.Reset(decoded.m_Instructions.size());
+    CHECK(cache.GetNumberOfCachedBlocks() == 0u);
+
+    // ADDI followed by SLT + BEQZ
+    const dlx::BlockOperation* operation = cache.GetBlock(decoded, 0u);
+    CHECK(operation[0].handler == static_cast<phi::uint32_t>(dlx::OpCode::ADDI));
+    CHECK(operation[0].index == 0u);
+    CHECK(operation[0].instruction == &decoded.m_Instructions[0u]);
+    CHECK(operation[1].handler ==
+          dlx::BlockOperation::FirstSuperinstructionHandler +
+                  static_cast<phi::uint32_t>(dlx::Superinstruction::SLT_BEQZ));
+    CHECK(operation[1].index == 1u);
+    CHECK(operation[2].handler == dlx::BlockOperation::EndOfBlockHandler);
+
+    // LW + ADD + SW followed by ADDI + J
+    operation = cache.GetBlock(decoded, 3u);
+    CHECK(operation[0].handler ==
+          dlx::BlockOperation::FirstSuperinstructionHandler +
+                  static_cast<phi::uint32_t>(dlx::Superinstruction::LW_ADD_SW));
+    CHECK(operation[0].index == 3u);
+    CHECK(operation[1].handler ==
+          dlx::BlockOperation::FirstSuperinstructionHandler +
+                  static_cast<phi::uint32_t>(dlx::Superinstruction::ADDI_J));
+    CHECK(operation[1].index == 6u);
+    CHECK(operation[2].handler == dlx::BlockOperation::EndOfBlockHandler);
+
+    CHECK(cache.GetNumberOfCachedBlocks() == 2u);
+    CHECK(cache.GetNumberOfFusedOperations() == 3u);
+
+    // Cached blocks are reused
+    operation = cache.GetBlock(decoded, 0u);
+    CHECK(operation[0].index == 0u);
+    CHECK(cache.GetNumberOfCachedBlocks() == 2u);
+
+    cache.Reset(decoded.m_Instructions.size());
+    CHECK(cache.GetNumberOfCachedBlocks() == 0u);
+    CHECK(cache.GetNumberOfFusedOperations() == 0u);
+}
@@ -0,0 +1,351 @@
+#include <phi/test/test_macros.hpp>
+
+#include <DLX/BranchPredictor.hpp>
+#include <DLX/Parser.hpp>
+#include <DLX/PipelineModel.hpp>
+#include <DLX/Processor.hpp>
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/types.hpp>
+#include <string>
+
+// Sums up 10 + 9 + ... + 1 taking the branch back 9 times
+static constexpr const char loop_source[] = R"(
+    ADDI R1 R0 #10
+loop:
+    ADD R2 R2 R1
+    SUBI R1 R1 #1
+    BNEZ R1 loop
+    SW 1000(R0) R2
+    HALT
+)";
+
+// The inner branch is taken 3 times and then falls through, 3 times in a row
+static constexpr const char nested_source[] = R"(
+    ADDI R2 R0 #3
+outer:
+    ADDI R1 R0 #4
+inner:
+    SUBI R1 R1 #1
+    BNEZ R1 inner
+    SUBI R2 R2 #1
+    BNEZ R2 outer
+    HALT
+)";
+
+// The branch at index 2 alternates between falling through and being taken
+static constexpr const char alternating_source[] = R"(
+    ADDI R2 R0 #20
+loop:
+    XORI R3 R3 #1
+    BEQZ R3 skip
+    ADDI R4 R4 #1
+skip:
+    SUBI R2 R2 #1
+    BNEZ R2 loop
+    HALT
+)";
+
+static constexpr const char call_source[] = R"(
+    JAL func
+    JAL func
+    HALT
+func:
+    JR R31
+)";
+
+[[nodiscard]] static dlx::BranchPredictor run(const char*                       source,
+                                              const dlx::BranchPredictorConfig& config)
+{
+    const dlx::ParsedProgram program = dlx::Parser::Parse(source);
+    REQUIRE(program.m_ParseErrors.empty());
+
+    dlx::BranchPredictor predictor{config};
+    REQUIRE(predictor.GetConfig().type == config.type);
+
+    dlx::Processor processor;
+    processor.SetBranchPredictor(phi::observer_ptr<dlx::BranchPredictor>{&predictor});
+    REQUIRE(processor.LoadProgram(program));
+    processor.ExecuteCurrentProgram();
+
+    return predictor;
+}
+
+[[nodiscard]] static dlx::BranchPredictorConfig make_config(dlx::BranchPredictorType type,
+                                                            phi::uint32_t btb_entries = 64u)
+{
+    dlx::BranchPredictorConfig config;
+    config.type        = type;
+    config.btb_entries = btb_entries;
+
+    return config;
+}
+
+TEST_CASE("BranchPredictorConfig")
+{
+    dlx::BranchPredictorConfig config;
+    CHECK(config.IsValid());
+
+    config.btb_entries = 48u;
+    CHECK_FALSE(config.IsValid());
+
+    config.btb_entries = 0u;
+    CHECK(config.IsValid());
+
+    config.history_bits = 12u;
+    CHECK_FALSE(config.IsValid());
+
+    config.table_bits = 21u;
+    CHECK_FALSE(config.IsValid());
+
+    config.table_bits = 12u;
+    CHECK(config.IsValid());
+
+    dlx::BranchPredictor predictor;
+    CHECK_FALSE(predictor.SetConfig(dlx::BranchPredictorConfig{dlx::BranchPredictorType::GShare,
+                                                               4u, 8u}));
+    CHECK(predictor.GetConfig().type == dlx::BranchPredictorType::TwoBit);
+}
+
+TEST_CASE("BranchPredictor static")
+{
+    SECTION("AlwaysNotTaken")
+    {
+        const dlx::BranchPredictor predictor =
+                run(loop_source, make_config(dlx::BranchPredictorType::AlwaysNotTaken));
+
+        const dlx::BranchProfile& branch = predictor.GetBranches()[3];
+        CHECK(branch.executed == 10u);
+        CHECK(branch.taken == 9u);
+        CHECK(branch.mispredictions == 9u);
+        CHECK(branch.misfetches == 0u);
+        CHECK(branch.penalty_cycles == 9u);
+        CHECK(branch.GetAccuracy() == 0.1);
+
+        CHECK(predictor.GetBranches()[1].executed == 0u);
+    }
+
+    SECTION("AlwaysTaken")
+    {
+        // Without a target buffer every taken branch waits for its target to be decoded
+        dlx::BranchPredictor predictor =
+                run(loop_source, make_config(dlx::BranchPredictorType::AlwaysTaken, 0u));
+
+        dlx::BranchProfile branch = predictor.GetBranches()[3];
+        CHECK(branch.mispredictions == 1u);
+        CHECK(branch.misfetches == 9u);
+        CHECK(branch.penalty_cycles == 10u);
+
+        predictor = run(loop_source, make_config(dlx::BranchPredictorType::AlwaysTaken));
+
+        branch = predictor.GetBranches()[3];
+        CHECK(branch.mispredictions == 1u);
+        CHECK(branch.misfetches == 1u);
+        CHECK(branch.penalty_cycles == 2u);
+        CHECK(branch.GetAccuracy() == 0.8);
+    }
+
+    SECTION("BackwardTaken")
+    {
+        const dlx::BranchPredictor predictor =
+                run(alternating_source, make_config(dlx::BranchPredictorType::BackwardTaken));
+
+        // The forward branch is predicted not taken and the backward one taken
+        CHECK(predictor.GetBranches()[2].executed == 20u);
+        CHECK(predictor.GetBranches()[2].mispredictions == 10u);
+        CHECK(predictor.GetBranches()[5].mispredictions == 1u);
+        CHECK(predictor.GetBranches()[5].misfetches == 1u);
+    }
+
+    SECTION("Execute resolution")
+    {
+        dlx::BranchPredictorConfig config = make_config(dlx::BranchPredictorType::AlwaysNotTaken);
+        config.branch_resolution          = dlx::BranchResolution::Execute;
+
+        const dlx::BranchPredictor predictor = run(loop_source, config);
+        CHECK(predictor.GetTotals().penalty_cycles == 18u);
+    }
+}
+
+TEST_CASE("BranchPredictor dynamic")
+{
+    SECTION("OneBit")
+    {
+        const dlx::BranchPredictor predictor =
+                run(nested_source, make_config(dlx::BranchPredictorType::OneBit));
+
+        // Mispredicts the first and the last iteration of every inner loop
+        CHECK(predictor.GetBranches()[3].executed == 12u);
+        CHECK(predictor.GetBranches()[3].mispredictions == 6u);
+        CHECK(predictor.GetBranches()[5].mispredictions == 2u);
+    }
+
+    SECTION("TwoBit")
+    {
+        const dlx::BranchPredictor predictor =
+                run(nested_source, make_config(dlx::BranchPredictorType::TwoBit));
+
+        // Only the last iteration after the counter is trained
+        CHECK(predictor.GetBranches()[3].mispredictions == 4u);
+        CHECK(predictor.GetBranches()[3].misfetches == 0u);
+        CHECK(predictor.GetBranches()[5].mispredictions == 2u);
+
+        const dlx::BranchProfile totals = predictor.GetTotals();
+        CHECK(totals.executed == 15u);
+        CHECK(totals.taken == 11u);
+        CHECK(totals.mispredictions == 6u);
+        CHECK(totals.penalty_cycles == 6u);
+
+        // Alternating branches are always wrong once taken
+        const dlx::BranchPredictor alternating =
+                run(alternating_source, make_config(dlx::BranchPredictorType::TwoBit));
+        CHECK(alternating.GetBranches()[2].mispredictions == 10u);
+    }
+
+    SECTION("GShare")
+    {
+        // The global history tells the alternating branch apart
+        const dlx::BranchPredictor predictor =
+                run(alternating_source, make_config(dlx::BranchPredictorType::GShare));
+        CHECK(predictor.GetBranches()[2].mispredictions == 4u);
+    }
+
+    SECTION("Tournament")
+    {
+        dlx::BranchPredictor predictor =
+                run(alternating_source, make_config(dlx::BranchPredictorType::Tournament));
+        CHECK(predictor.GetBranches()[2].mispredictions == 5u);
+
+        predictor = run(nested_source, make_config(dlx::BranchPredictorType::Tournament));
+        CHECK(predictor.GetBranches()[3].mispredictions == 4u);
+    }
+}
+
+TEST_CASE("BranchPredictor return address stack")
+{
+    // Calls miss the target buffer once each, returns are predicted by the stack
+    dlx::BranchPredictor predictor = run(call_source, dlx::BranchPredictorConfig{});
+    CHECK(predictor.GetBranches()[0].misfetches == 1u);
+    CHECK(predictor.GetBranches()[1].misfetches == 1u);
+    CHECK(predictor.GetBranches()[3].executed == 2u);
+    CHECK(predictor.GetBranches()[3].misfetches == 0u);
+
+    // The target buffer only remembers the previous return address
+    dlx::BranchPredictorConfig config;
+    config.ras_entries = 0u;
+
+    predictor = run(call_source, config);
+    CHECK(predictor.GetBranches()[3].misfetches == 2u);
+    CHECK(predictor.GetTotals().penalty_cycles == 4u);
+
+    // Overflowing a single entry stack keeps the innermost return address
+    config.ras_entries = 1u;
+    predictor          = run(R"(
+        JAL first
+        HALT
+    first:
+        ADD R1 R31 R0
+        JAL second
+        JR R1
+    second:
+        JR R31
+    )",
+                             config);
+    CHECK(predictor.GetBranches()[5].misfetches == 0u);
+    CHECK(predictor.GetBranches()[4].misfetches == 1u);
+}
+
+TEST_CASE("BranchPredictor report")
+{
+    const dlx::ParsedProgram program = dlx::Parser::Parse(loop_source);
+    REQUIRE(program.m_ParseErrors.empty());
+
+    dlx::BranchPredictor predictor;
+    CHECK(predictor.GetTotals().GetAccuracy() == 0.0);
+
+    dlx::Processor processor;
+    processor.SetBranchPredictor(phi::observer_ptr<dlx::BranchPredictor>{&predictor});
+    REQUIRE(processor.LoadProgram(program));
+
+    CHECK(processor.RunUntilBreak(100u) == dlx::StopReason::Halted);
+
+    const std::string report = predictor.GetReport(program);
+    CHECK(report.find("Branches                 10\n") != std::string::npos);
+    CHECK(report.find("Accuracy             80.00%\n") != std::string::npos);
+    CHECK(report.find("Penalty cycles            2\n") != std::string::npos);
+    CHECK(report.find("Mispredicted") != std::string::npos);
+
+    predictor.Clear();
+    CHECK(predictor.GetTotals().executed == 0u);
+    CHECK(predictor.GetBranches().size() == 6u);
+}
+
+TEST_CASE("Processor branch prediction")
+{
+    const dlx::ParsedProgram program = dlx::Parser::Parse(loop_source);
+    REQUIRE(program.m_ParseErrors.empty());
+
+    dlx::PipelineModel   model;
+    dlx::BranchPredictor predictor;
+
+    SECTION("Pipeline model")
+    {
+        dlx::Processor processor;
+        CHECK_FALSE(processor.GetBranchPredictor());
+
+        processor.SetPipelineModel(phi::observer_ptr<dlx::PipelineModel>{&model});
+        processor.SetBranchPredictor(phi::observer_ptr<dlx::BranchPredictor>{&predictor});
+        CHECK(processor.GetBranchPredictor() == &predictor);
+        REQUIRE(processor.LoadProgram(program));
+
+        processor.ExecuteCurrentProgram();
+        CHECK(model.GetStatistics().control_stalls == 2u);
+        CHECK(model.GetStatistics().control_stalls == predictor.GetTotals().penalty_cycles);
+        CHECK(model.GetStatistics().cycles == 49u);
+
+        // Predicting every branch not taken without a target buffer is the plain pipeline
+        REQUIRE(predictor.SetConfig(make_config(dlx::BranchPredictorType::AlwaysNotTaken, 0u)));
+        processor.ExecuteCurrentProgram();
+        CHECK(model.GetStatistics().control_stalls == 9u);
+        CHECK(model.GetStatistics().cycles == 56u);
+
+        processor.SetBranchPredictor(nullptr);
+        REQUIRE(processor.LoadProgram(program));
+        processor.ExecuteStep();
+        CHECK(predictor.GetTotals().executed == 10u);
+    }
+
+    SECTION("Stepping back")
+    {
+        dlx::Processor processor;
+        processor.SetReverseExecutionEnabled(true);
+        processor.SetBranchPredictor(phi::observer_ptr<dlx::BranchPredictor>{&predictor});
+        REQUIRE(processor.LoadProgram(program));
+
+        CHECK(processor.RunUntilBreak(10u) == dlx::StopReason::StepLimit);
+        CHECK(predictor.GetTotals().executed == 3u);
+
+        CHECK(processor.StepBack(5u) == 5u);
+        CHECK(predictor.GetTotals().executed == 3u);
+
+        processor.ExecuteStep();
+        processor.ExecuteStep();
+        processor.ExecuteStep();
+        CHECK(predictor.GetTotals().executed == 4u);
+    }
+
+    SECTION("FastProcessor")
+    {
+        dlx::FastProcessor processor;
+        processor.SetBranchPredictor(phi::observer_ptr<dlx::BranchPredictor>{&predictor});
+        REQUIRE(processor.LoadProgram(program));
+
+        processor.ExecuteCurrentProgram();
+        CHECK(predictor.GetTotals().executed == 10u);
+        CHECK(predictor.GetTotals().penalty_cycles == 2u);
+
+        // Running again starts with untrained tables
+        processor.ExecuteCurrentProgram();
+        CHECK(predictor.GetTotals().executed == 10u);
+        CHECK(predictor.GetTotals().penalty_cycles == 2u);
+    }
+}
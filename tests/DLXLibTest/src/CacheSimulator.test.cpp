@@ -0,0 +1,402 @@
+#include <phi/test/test_macros.hpp>
+
+#include <DLX/CacheSimulator.hpp>
+#include <DLX/Parser.hpp>
+#include <DLX/Processor.hpp>
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/types.hpp>
+#include <string>
+
+// Copies 16 words from 1000, 1008, ... to 1004, 1012, ...
+static constexpr const char copy_source[] = R"(
+    ADDI R1 R0 #1000
+    ADDI R2 R0 #16
+loop:
+    LW R3 0(R1)
+    SW 4(R1) R3
+    ADDI R1 R1 #8
+    SUBI R2 R2 #1
+    BNEZ R2 loop
+    HALT
+)";
+
+[[nodiscard]] static dlx::Cache make_cache(dlx::CacheReplacementPolicy replacement,
+                                           dlx::CacheWritePolicy       write_policy,
+                                           phi::uint32_t size, phi::uint32_t line_size,
+                                           phi::uint32_t associativity)
+{
+    dlx::CacheConfig config;
+    config.size          = size;
+    config.line_size     = line_size;
+    config.associativity = associativity;
+    config.replacement   = replacement;
+    config.write_policy  = write_policy;
+    REQUIRE(config.IsValid());
+
+    dlx::Cache cache;
+    cache.Reset(config, true, 1u);
+
+    return cache;
+}
+
+TEST_CASE("CacheConfig")
+{
+    dlx::CacheConfig config;
+    CHECK(config.IsValid());
+
+    config.size = 1000u;
+    CHECK_FALSE(config.IsValid());
+
+    config.size      = 1024u;
+    config.line_size = 2u;
+    CHECK_FALSE(config.IsValid());
+
+    config.line_size     = 64u;
+    config.associativity = 32u;
+    CHECK_FALSE(config.IsValid());
+
+    // A single fully associative set
+    config.associativity = 16u;
+    CHECK(config.IsValid());
+
+    config.associativity = 3u;
+    CHECK_FALSE(config.IsValid());
+}
+
+TEST_CASE("Cache")
+{
+    SECTION("LRU")
+    {
+        // Two sets of two ways, addresses 0, 32, 64 and 96 map to the first set
+        dlx::Cache cache = make_cache(dlx::CacheReplacementPolicy::LRU,
+                                      dlx::CacheWritePolicy::WriteBack, 64u, 16u, 2u);
+        CHECK(cache.GetNumberOfSets() == 2u);
+
+        CHECK(cache.Access(0u, false).miss_class == dlx::CacheMissClass::Compulsory);
+        CHECK(cache.Access(32u, false).miss_class == dlx::CacheMissClass::Compulsory);
+        CHECK(cache.Access(4u, false).hit);
+
+        // Evicts 32 which was used least recently
+        CHECK_FALSE(cache.Access(64u, false).hit);
+        CHECK(cache.Contains(0u));
+        CHECK_FALSE(cache.Contains(32u));
+        CHECK(cache.Contains(64u));
+
+        // A fully associative cache of four lines would still hold it
+        const dlx::CacheAccessResult result = cache.Access(32u, false);
+        CHECK_FALSE(result.hit);
+        CHECK(result.allocated);
+        CHECK(result.miss_class == dlx::CacheMissClass::Conflict);
+
+        const dlx::CacheStatistics& statistics = cache.GetStatistics();
+        CHECK(statistics.reads == 5u);
+        CHECK(statistics.GetHits() == 1u);
+        CHECK(statistics.read_misses == 4u);
+        CHECK(statistics.compulsory_misses == 3u);
+        CHECK(statistics.conflict_misses == 1u);
+        CHECK(statistics.GetMissRate() == 0.8);
+
+        cache.Clear();
+        CHECK_FALSE(cache.Contains(0u));
+        CHECK(cache.GetStatistics().GetAccesses() == 0u);
+        CHECK(cache.Access(0u, false).miss_class == dlx::CacheMissClass::Compulsory);
+    }
+
+    SECTION("Capacity misses")
+    {
+        dlx::Cache cache = make_cache(dlx::CacheReplacementPolicy::LRU,
+                                      dlx::CacheWritePolicy::WriteBack, 64u, 16u, 2u);
+
+        for (phi::uint64_t address{0u}; address < 80u; address += 16u)
+        {
+            CHECK(cache.Access(address, false).miss_class == dlx::CacheMissClass::Compulsory);
+        }
+
+        // Five lines don't fit into four
+        CHECK(cache.Access(0u, false).miss_class == dlx::CacheMissClass::Capacity);
+        CHECK(cache.GetStatistics().capacity_misses == 1u);
+    }
+
+    SECTION("PLRU")
+    {
+        // One set of four ways
+        dlx::Cache cache = make_cache(dlx::CacheReplacementPolicy::PLRU,
+                                      dlx::CacheWritePolicy::WriteBack, 64u, 16u, 4u);
+
+        for (phi::uint64_t address{0u}; address < 64u; address += 16u)
+        {
+            CHECK_FALSE(cache.Access(address, false).hit);
+        }
+        CHECK(cache.Access(0u, false).hit);
+
+        // The tree points away from way 0 and then away from way 3
+        CHECK_FALSE(cache.Access(64u, false).hit);
+        CHECK_FALSE(cache.Contains(32u));
+        CHECK(cache.Contains(0u));
+        CHECK(cache.Contains(16u));
+        CHECK(cache.Contains(48u));
+
+        // True LRU evicts the line of way 1 instead
+        dlx::Cache lru = make_cache(dlx::CacheReplacementPolicy::LRU,
+                                    dlx::CacheWritePolicy::WriteBack, 64u, 16u, 4u);
+        for (phi::uint64_t address : {0u, 16u, 32u, 48u, 0u, 64u})
+        {
+            (void)lru.Access(address, false);
+        }
+        CHECK_FALSE(lru.Contains(16u));
+        CHECK(lru.Contains(32u));
+    }
+
+    SECTION("Random")
+    {
+        dlx::Cache first = make_cache(dlx::CacheReplacementPolicy::Random,
+                                      dlx::CacheWritePolicy::WriteBack, 64u, 16u, 4u);
+        dlx::Cache second = make_cache(dlx::CacheReplacementPolicy::Random,
+                                       dlx::CacheWritePolicy::WriteBack, 64u, 16u, 4u);
+
+        // Invalid ways are filled first and the same seed evicts the same lines
+        for (phi::uint64_t address{0u}; address < 1024u; address += 16u)
+        {
+            CHECK(first.Access(address, false).hit == second.Access(address, false).hit);
+        }
+
+        CHECK(first.GetStatistics().read_misses == 64u);
+        CHECK(first.Contains(1008u));
+
+        for (phi::uint64_t address{0u}; address < 1024u; address += 16u)
+        {
+            CHECK(first.Contains(address) == second.Contains(address));
+        }
+    }
+
+    SECTION("Write back")
+    {
+        dlx::Cache cache = make_cache(dlx::CacheReplacementPolicy::LRU,
+                                      dlx::CacheWritePolicy::WriteBack, 16u, 16u, 1u);
+
+        // Write misses allocate the line
+        dlx::CacheAccessResult result = cache.Access(8u, true);
+        CHECK_FALSE(result.hit);
+        CHECK(result.allocated);
+        CHECK(cache.Contains(0u));
+
+        result = cache.Access(16u, false);
+        CHECK(result.write_back);
+        CHECK(result.write_back_address == 0u);
+
+        // Clean lines are dropped
+        result = cache.Access(32u, false);
+        CHECK_FALSE(result.write_back);
+
+        CHECK(cache.GetStatistics().write_backs == 1u);
+        CHECK(cache.GetStatistics().write_misses == 1u);
+    }
+
+    SECTION("Write through")
+    {
+        dlx::Cache cache = make_cache(dlx::CacheReplacementPolicy::LRU,
+                                      dlx::CacheWritePolicy::WriteThrough, 16u, 16u, 1u);
+
+        dlx::CacheAccessResult result = cache.Access(0u, true);
+        CHECK_FALSE(result.hit);
+        CHECK_FALSE(result.allocated);
+        CHECK_FALSE(cache.Contains(0u));
+
+        CHECK_FALSE(cache.Access(0u, false).hit);
+        CHECK(cache.Access(0u, true).hit);
+
+        result = cache.Access(16u, false);
+        CHECK_FALSE(result.write_back);
+        CHECK(cache.GetStatistics().write_backs == 0u);
+    }
+}
+
+TEST_CASE("CacheSimulator")
+{
+    dlx::CacheSimulator simulator;
+
+    dlx::CacheHierarchyConfig config;
+    config.data.size = 1000u;
+    CHECK_FALSE(simulator.SetConfig(config));
+    CHECK(simulator.GetConfig().data.size == 16384u);
+
+    // Disabled caches aren't validated
+    config.data.enabled = false;
+    CHECK(simulator.SetConfig(config));
+
+    simulator.Reset(2u);
+
+    // Everything goes to the unified cache
+    simulator.AccessData(1u, 1000u, 4u, false);
+    CHECK(simulator.GetStatistics(dlx::CacheLevel::Data).GetAccesses() == 0u);
+    CHECK(simulator.GetStatistics(dlx::CacheLevel::Unified).GetAccesses() == 1u);
+    CHECK(simulator.GetInstructions()[1].data_accesses == 1u);
+    CHECK(simulator.GetInstructions()[1].data_misses == 0u);
+    CHECK(simulator.GetInstructions()[1].unified_misses == 1u);
+    CHECK(simulator.GetMemoryReads() == 1u);
+
+    // Misses aren't classified by default
+    CHECK(simulator.GetStatistics(dlx::CacheLevel::Unified).compulsory_misses == 0u);
+
+    dlx::CacheHierarchyConfig classifying;
+    classifying.classify_misses = true;
+    REQUIRE(simulator.SetConfig(classifying));
+    simulator.Reset(2u);
+
+    // Unaligned accesses may touch two lines
+    simulator.AccessData(0u, 30u, 4u, false);
+    CHECK(simulator.GetStatistics(dlx::CacheLevel::Data).read_misses == 2u);
+    CHECK(simulator.GetInstructions()[0].data_misses == 1u);
+    CHECK(simulator.GetInstructions()[0].compulsory_misses == 2u);
+
+    // Instructions are fetched from their own address space
+    simulator.FetchInstruction(0u);
+    simulator.FetchInstruction(1u);
+    CHECK(simulator.GetStatistics(dlx::CacheLevel::Instruction).read_misses == 1u);
+    CHECK(simulator.GetStatistics(dlx::CacheLevel::Unified).read_misses == 2u);
+    CHECK(simulator.GetInstructions()[0].fetch_misses == 1u);
+    CHECK(simulator.GetInstructions()[1].fetch_misses == 0u);
+
+    simulator.Clear();
+    CHECK(simulator.GetStatistics(dlx::CacheLevel::Unified).GetAccesses() == 0u);
+    CHECK(simulator.GetInstructions()[0].fetch_misses == 0u);
+    CHECK(simulator.GetMemoryReads() == 0u);
+}
+
+TEST_CASE("Processor cache simulation")
+{
+    const dlx::ParsedProgram program = dlx::Parser::Parse(copy_source);
+    REQUIRE(program.m_ParseErrors.empty());
+
+    dlx::CacheHierarchyConfig config;
+    config.classify_misses = true;
+
+    dlx::CacheSimulator simulator{config};
+
+    const auto check_run = [&]() {
+        // All 8 instructions fit into one line
+        const dlx::CacheStatistics& instruction =
+                simulator.GetStatistics(dlx::CacheLevel::Instruction);
+        CHECK(instruction.reads == 83u);
+        CHECK(instruction.read_misses == 1u);
+
+        // The words from 1000 to 1127 span the 32 byte lines from 992 to 1151
+        const dlx::CacheStatistics& data = simulator.GetStatistics(dlx::CacheLevel::Data);
+        CHECK(data.reads == 16u);
+        CHECK(data.writes == 16u);
+        CHECK(data.read_misses == 5u);
+        CHECK(data.write_misses == 0u);
+        CHECK(data.compulsory_misses == 5u);
+
+        // Those are part of the 64 byte lines from 960 to 1151
+        const dlx::CacheStatistics& unified = simulator.GetStatistics(dlx::CacheLevel::Unified);
+        CHECK(unified.reads == 6u);
+        CHECK(unified.read_misses == 4u);
+        CHECK(simulator.GetMemoryReads() == 4u);
+        CHECK(simulator.GetMemoryWrites() == 0u);
+
+        const auto& instructions = simulator.GetInstructions();
+        REQUIRE(instructions.size() == 8u);
+        CHECK(instructions[0].fetch_misses == 1u);
+        CHECK(instructions[2].data_accesses == 16u);
+        CHECK(instructions[2].data_misses == 5u);
+        CHECK(instructions[3].data_accesses == 16u);
+        CHECK(instructions[3].data_misses == 0u);
+        CHECK(instructions[4].data_accesses == 0u);
+    };
+
+    SECTION("Stepping")
+    {
+        dlx::Processor processor;
+        CHECK_FALSE(processor.GetCacheSimulator());
+
+        processor.SetCacheSimulator(phi::observer_ptr<dlx::CacheSimulator>{&simulator});
+        CHECK(processor.GetCacheSimulator() == &simulator);
+        REQUIRE(processor.LoadProgram(program));
+        processor.GetMemory().StoreWord(1000u, 7);
+
+        CHECK(processor.RunUntilBreak(1000u) == dlx::StopReason::Halted);
+        check_run();
+
+        // The values are still copied
+        CHECK(processor.GetMemory().LoadWord(1004u).value() == 7);
+
+        const std::string report = simulator.GetReport(program);
+        CHECK(report.find("L1I") != std::string::npos);
+        CHECK(report.find("Memory reads 4, writes 0") != std::string::npos);
+        CHECK(report.find("Compulsory") != std::string::npos);
+
+        processor.SetCacheSimulator(nullptr);
+        REQUIRE(processor.LoadProgram(program));
+        processor.ExecuteStep();
+        CHECK(simulator.GetStatistics(dlx::CacheLevel::Instruction).reads == 83u);
+    }
+
+    SECTION("ExecuteCurrentProgram")
+    {
+        dlx::FastProcessor processor;
+        processor.SetCacheSimulator(phi::observer_ptr<dlx::CacheSimulator>{&simulator});
+        REQUIRE(processor.LoadProgram(program));
+
+        processor.ExecuteCurrentProgram();
+        check_run();
+
+        // Starts with cold caches again
+        processor.ExecuteCurrentProgram();
+        check_run();
+    }
+
+    SECTION("Faulting accesses")
+    {
+        const dlx::ParsedProgram faulting = dlx::Parser::Parse(R"(
+            ADDI R1 R0 #5
+            SW 1000(R0) R1
+            SW 5000(R0) R1
+            LW R2 5000(R0)
+        )");
+        REQUIRE(faulting.m_ParseErrors.empty());
+
+        dlx::Processor processor;
+        processor.SetTracingEnabled(true);
+        processor.SetReverseExecutionEnabled(true);
+        processor.SetCacheSimulator(phi::observer_ptr<dlx::CacheSimulator>{&simulator});
+        REQUIRE(processor.LoadProgram(faulting));
+
+        processor.ExecuteStep();
+        processor.ExecuteStep();
+        CHECK(simulator.GetStatistics(dlx::CacheLevel::Data).writes == 1u);
+
+        // Neither the trace nor the caches see the store which didn't happen
+        processor.ExecuteStep();
+        CHECK(processor.GetLastRaisedException() == dlx::Exception::AddressOutOfBounds);
+        CHECK(processor.GetLastTraceRecord().destination_type == dlx::TraceDestination::None);
+        CHECK(processor.GetLastTraceRecord().flags == dlx::TraceRecord::FlagHalted);
+        CHECK(simulator.GetStatistics(dlx::CacheLevel::Data).writes == 1u);
+        CHECK(simulator.GetInstructions()[2].data_accesses == 0u);
+
+        // Same for the load
+        REQUIRE(processor.LoadProgram(faulting));
+        processor.SetProgramCounter(3u);
+        processor.ExecuteStep();
+        CHECK(processor.GetLastRaisedException() == dlx::Exception::AddressOutOfBounds);
+        CHECK(processor.GetLastTraceRecord().destination_type == dlx::TraceDestination::None);
+        CHECK(processor.GetLastTraceRecord().flags == dlx::TraceRecord::FlagHalted);
+        CHECK(simulator.GetStatistics(dlx::CacheLevel::Data).reads == 0u);
+        CHECK(simulator.GetInstructions()[3].data_accesses == 0u);
+    }
+
+    SECTION("Stepping back")
+    {
+        dlx::Processor processor;
+        processor.SetReverseExecutionEnabled(true);
+        processor.SetCacheSimulator(phi::observer_ptr<dlx::CacheSimulator>{&simulator});
+        REQUIRE(processor.LoadProgram(program));
+
+        CHECK(processor.RunUntilBreak(10u) == dlx::StopReason::StepLimit);
+        CHECK(processor.StepBack(5u) == 5u);
+        CHECK(simulator.GetStatistics(dlx::CacheLevel::Instruction).reads == 10u);
+
+        processor.ExecuteStep();
+        CHECK(simulator.GetStatistics(dlx::CacheLevel::Instruction).reads == 11u);
+    }
+}
@@ -0,0 +1,82 @@
+#include <phi/test/test_macros.hpp>
+
+#include <DLX/DecodedProgram.hpp>
+#include <DLX/InstructionArgument.hpp>
+#include <DLX/InstructionInfo.hpp>
+#include <DLX/InstructionLibrary.hpp>
+#include <DLX/OpCode.hpp>
+#include <DLX/Parser.hpp>
+#include <DLX/RegisterNames.hpp>
+#include <phi/core/types.hpp>
+
+TEST_CASE("DecodedInstruction")
+{
+    STATIC_REQUIRE(sizeof(dlx::DecodedInstruction) <= 24u);
+
+    dlx::DecodedInstruction instruction;
+
+    CHECK(instruction.executor == nullptr);
+    CHECK(instruction.opcode == dlx::OpCode::NONE);
+    CHECK(instruction.jump_point == dlx::InstructionArgument::Label::UnresolvedJumpPoint);
+
+    instruction.immediate = -1;
+    CHECK(instruction.GetSignedImmediate() == -1);
+    CHECK(instruction.GetUnsignedImmediate() == 0xFFFFu);
+}
+
+TEST_CASE("DecodeProgram")
+{
+    dlx::ParsedProgram program = dlx::Parser::Parse("start:\n"
+                                                    "ADDI R1 R2 #-5\n"
+                                                    "ADDF F3 F4 F5\n"
+                                                    "LW R6 12(R7)\n"
+                                                    "SW #1000 R8\n"
+                                                    "BEQZ R1 start\n"
+                                                    "HALT\n");
+    REQUIRE(program.m_ParseErrors.empty());
+
+    const dlx::DecodedProgram decoded = dlx::DecodeProgram(program);
+    REQUIRE(decoded.m_Instructions.size() == program.m_Instructions.size());
+
+    // ADDI
+    const dlx::DecodedInstruction& addi = decoded.m_Instructions[0];
+    CHECK(addi.opcode == dlx::OpCode::ADDI);
+    CHECK(addi.executor == dlx::LookUpInstructionInfo(dlx::OpCode::ADDI).GetExecutor());
+    CHECK(addi.register_access_type ==
+          dlx::LookUpInstructionInfo(dlx::OpCode::ADDI).GetRegisterAccessType());
+    CHECK(addi.GetIntRegister(0u) == dlx::IntRegisterID::R1);
+    CHECK(addi.GetIntRegister(1u) == dlx::IntRegisterID::R2);
+    CHECK(addi.GetSignedImmediate() == -5);
+
+    // ADDF
+    const dlx::DecodedInstruction& addf = decoded.m_Instructions[1];
+    CHECK(addf.opcode == dlx::OpCode::ADDF);
+    CHECK(addf.GetFloatRegister(0u) == dlx::FloatRegisterID::F3);
+    CHECK(addf.GetFloatRegister(1u) == dlx::FloatRegisterID::F4);
+    CHECK(addf.GetFloatRegister(2u) == dlx::FloatRegisterID::F5);
+
+    // LW with address displacement
+    const dlx::DecodedInstruction& lw = decoded.m_Instructions[2];
+    CHECK(lw.opcode == dlx::OpCode::LW);
+    CHECK(lw.GetIntRegister(0u) == dlx::IntRegisterID::R6);
+    CHECK(lw.GetIntRegister(1u) == dlx::IntRegisterID::R7);
+    CHECK(lw.GetSignedImmediate() == 12);
+
+    // SW with immediate address
+    const dlx::DecodedInstruction& sw = decoded.m_Instructions[3];
+    CHECK(sw.opcode == dlx::OpCode::SW);
+    CHECK(sw.GetIntRegister(0u) == dlx::IntRegisterID::None);
+    CHECK(sw.GetSignedImmediate() == 1000);
+    CHECK(sw.GetIntRegister(1u) == dlx::IntRegisterID::R8);
+
+    // BEQZ
+    const dlx::DecodedInstruction& beqz = decoded.m_Instructions[4];
+    CHECK(beqz.opcode == dlx::OpCode::BEQZ);
+    CHECK(beqz.GetIntRegister(0u) == dlx::IntRegisterID::R1);
+    CHECK(beqz.jump_point == 0u);
+
+    // HALT
+    const dlx::DecodedInstruction& halt = decoded.m_Instructions[5];
+    CHECK(halt.opcode == dlx::OpCode::HALT);
+    CHECK(halt.executor != nullptr);
+}
@@ -0,0 +1,166 @@
+#include <phi/test/test_macros.hpp>
+
+#include <DLX/ExecutionProfile.hpp>
+#include <DLX/Parser.hpp>
+#include <DLX/Processor.hpp>
+#include <phi/core/types.hpp>
+#include <string>
+#include <vector>
+
+// Sums up 10 + 9 + ... + 1 so the loop body on lines 4 to 6 is executed 10 times
+static constexpr const char loop_source[] = R"(
+    ADDI R1 R0 #10
+loop:
+    ADD R2 R2 R1
+    SUBI R1 R1 #1
+    BNEZ R1 loop
+    SW 1000(R0) R2
+    HALT
+)";
+
+TEST_CASE("ExecutionProfile")
+{
+    dlx::ExecutionProfile profile;
+    CHECK(profile.GetInstructions().empty());
+    CHECK(profile.GetTotalExecuted() == 0u);
+
+    profile.Reset(3u);
+    REQUIRE(profile.GetInstructions().size() == 3u);
+
+    profile.Record(0u, false, false);
+    profile.Record(2u, true, false);
+    profile.Record(2u, false, true);
+    profile.Record(1u, false, true);
+    profile.Record(2u, true, false);
+
+    CHECK(profile.GetTotalExecuted() == 5u);
+    CHECK(profile.GetInstructions()[0].executed == 1u);
+    CHECK(profile.GetInstructions()[2].executed == 3u);
+    CHECK(profile.GetInstructions()[2].taken_branches == 2u);
+    CHECK(profile.GetInstructions()[2].memory_accesses == 1u);
+    CHECK(profile.GetInstructions()[1].memory_accesses == 1u);
+
+    // Ties are ordered by their index
+    CHECK(profile.GetHotInstructions() == std::vector<phi::uint32_t>{2u, 0u, 1u});
+
+    profile.Clear();
+    CHECK(profile.GetInstructions().size() == 3u);
+    CHECK(profile.GetTotalExecuted() == 0u);
+    CHECK(profile.GetInstructions()[2].executed == 0u);
+    CHECK(profile.GetHotInstructions().empty());
+}
+
+TEST_CASE("ExecutionProfile GetHotLines")
+{
+    const dlx::ParsedProgram program = dlx::Parser::Parse(loop_source);
+    REQUIRE(program.m_ParseErrors.empty());
+
+    dlx::Processor processor;
+    processor.SetProfilingEnabled(true);
+    REQUIRE(processor.LoadProgram(program));
+    processor.ExecuteCurrentProgram();
+
+    const dlx::ExecutionProfile& profile = processor.GetProfile();
+
+    // HALT is counted as well
+    CHECK(profile.GetTotalExecuted() == 33u);
+
+    const std::vector<dlx::LineProfile> lines = profile.GetHotLines(program);
+    REQUIRE(lines.size() == 6u);
+    CHECK(lines[0].line == 4u);
+    CHECK(lines[0].counters.executed == 10u);
+    CHECK(lines[1].line == 5u);
+    CHECK(lines[2].line == 6u);
+    CHECK(lines[2].counters.taken_branches == 9u);
+    CHECK(lines[3].line == 2u);
+    CHECK(lines[3].counters.executed == 1u);
+    CHECK(lines[4].line == 7u);
+    CHECK(lines[4].counters.memory_accesses == 1u);
+    CHECK(lines[5].line == 8u);
+
+    const std::string report = profile.GetReport(program, 2u);
+    CHECK(report.find("Executed 33 instructions") != std::string::npos);
+    CHECK(report.find("(4 more lines)") != std::string::npos);
+}
+
+TEST_CASE("Processor profiling")
+{
+    const dlx::ParsedProgram program = dlx::Parser::Parse(loop_source);
+    REQUIRE(program.m_ParseErrors.empty());
+
+    SECTION("Disabled by default")
+    {
+        dlx::Processor processor;
+        CHECK_FALSE(processor.IsProfilingEnabled());
+
+        REQUIRE(processor.LoadProgram(program));
+        processor.ExecuteCurrentProgram();
+
+        CHECK(processor.GetProfile().GetInstructions().size() == 6u);
+        CHECK(processor.GetProfile().GetTotalExecuted() == 0u);
+    }
+
+    SECTION("Stepping")
+    {
+        dlx::Processor processor;
+        processor.SetProfilingEnabled(true);
+        CHECK(processor.IsProfilingEnabled());
+        REQUIRE(processor.LoadProgram(program));
+
+        // Up to the first taken branch
+        for (phi::size_t step{0u}; step < 4u; ++step)
+        {
+            processor.ExecuteStep();
+        }
+
+        const dlx::ExecutionProfile& profile = processor.GetProfile();
+        CHECK(profile.GetTotalExecuted() == 4u);
+        CHECK(profile.GetInstructions()[3].executed == 1u);
+        CHECK(profile.GetInstructions()[3].taken_branches == 1u);
+
+        CHECK(processor.RunUntilBreak(100u) == dlx::StopReason::Halted);
+        CHECK(profile.GetTotalExecuted() == 33u);
+        CHECK(profile.GetInstructions()[1].executed == 10u);
+        CHECK(profile.GetInstructions()[3].taken_branches == 9u);
+        CHECK(profile.GetInstructions()[4].memory_accesses == 1u);
+
+        processor.ClearProfile();
+        CHECK(profile.GetTotalExecuted() == 0u);
+
+        REQUIRE(processor.LoadProgram(program));
+        processor.SetProfilingEnabled(false);
+        processor.ExecuteStep();
+        CHECK(profile.GetTotalExecuted() == 0u);
+    }
+
+    SECTION("Stepping back")
+    {
+        dlx::Processor processor;
+        processor.SetProfilingEnabled(true);
+        processor.SetReverseExecutionEnabled(true);
+        REQUIRE(processor.LoadProgram(program));
+
+        CHECK(processor.RunUntilBreak(10u) == dlx::StopReason::StepLimit);
+        CHECK(processor.StepBack(5u) == 5u);
+
+        // The undone steps keep their counts and replaying doesn't count them twice
+        CHECK(processor.GetProfile().GetTotalExecuted() == 10u);
+
+        processor.ExecuteStep();
+        CHECK(processor.GetProfile().GetTotalExecuted() == 11u);
+    }
+
+    SECTION("FastProcessor")
+    {
+        dlx::FastProcessor processor;
+        processor.SetProfilingEnabled(true);
+        REQUIRE(processor.LoadProgram(program));
+        processor.ExecuteCurrentProgram();
+
+        CHECK(processor.GetProfile().GetTotalExecuted() == 33u);
+
+        // Running again starts a new profile
+        processor.ExecuteCurrentProgram();
+        CHECK(processor.GetProfile().GetTotalExecuted() == 33u);
+    }
+}
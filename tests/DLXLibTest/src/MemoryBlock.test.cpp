@@ -2,8 +2,11 @@
 #include <phi/test/test_macros.hpp>
 
 #include <DLX/MemoryBlock.hpp>
+#include <phi/compiler_support/warning.hpp>
 #include <vector>
 
+PHI_CLANG_AND_GCC_SUPPRESS_WARNING("-Wfloat-equal")
+
 TEST_CASE("MemoryBlock")
 {
     dlx::MemoryBlock mem{1000u, 20u};
@@ -101,3 +104,279 @@ TEST_CASE("Resize")
     mem.Resize(7u);
     CHECK(mem.GetSize() == 7u);
 }
+
+TEST_CASE("Dirty pages")
+{
+    constexpr phi::size_t page_size = dlx::MemoryBlock::PageSize;
+
+    dlx::MemoryBlock mem{1000u, page_size * 70u + 1u};
+    CHECK(mem.GetNumberOfPages() == 71u);
+
+    // New memory is dirty
+    CHECK(mem.GetNumberOfDirtyPages() == 71u);
+
+    mem.ClearDirtyPages();
+    CHECK(mem.GetNumberOfDirtyPages() == 0u);
+
+    // Loading doesn't dirty pages
+    CHECK(mem.LoadWord(1000u).has_value());
+    CHECK(mem.GetNumberOfDirtyPages() == 0u);
+
+    CHECK(mem.StoreByte(1000u, 1));
+    CHECK(mem.IsPageDirty(0u));
+    CHECK(mem.GetNumberOfDirtyPages() == 1u);
+
+    // Last page in the second bitmap word
+    CHECK(mem.StoreUnsignedByte(1000u + page_size * 70u, 2u));
+    CHECK(mem.IsPageDirty(70u));
+    CHECK(mem.GetNumberOfDirtyPages() == 2u);
+
+    // Unaligned stores may touch two pages
+    CHECK(mem.StoreHalfWord(1000u + page_size * 3u - 1u, 3));
+    CHECK(mem.IsPageDirty(2u));
+    CHECK(mem.IsPageDirty(3u));
+    CHECK_FALSE(mem.IsPageDirty(4u));
+    CHECK(mem.GetNumberOfDirtyPages() == 4u);
+
+    // Failed stores don't dirty pages
+    CHECK_FALSE(mem.StoreWord(0u, 4));
+    CHECK(mem.GetNumberOfDirtyPages() == 4u);
+
+    // Restoring
+    dlx::MemoryBlock original{1000u, page_size * 70u + 1u};
+    mem.RestoreDirtyPages(original);
+    CHECK(mem.GetNumberOfDirtyPages() == 0u);
+    CHECK(mem.LoadByte(1000u).value() == 0);
+    CHECK(mem.LoadUnsignedByte(1000u + page_size * 70u).value() == 0u);
+    CHECK(mem.LoadByte(1000u + page_size * 3u - 1u).value() == 0);
+    CHECK(mem.LoadByte(1000u + page_size * 3u).value() == 0);
+
+    // Modifications that can touch everything
+    mem.Clear();
+    CHECK(mem.GetNumberOfDirtyPages() == 71u);
+
+    mem.ClearDirtyPages();
+    (void)mem.GetRawMemory();
+    CHECK(mem.GetNumberOfDirtyPages() == 71u);
+
+    mem.ClearDirtyPages();
+    mem.Resize(page_size * 2u);
+    CHECK(mem.GetNumberOfPages() == 2u);
+    CHECK(mem.GetNumberOfDirtyPages() == 2u);
+}
+
+TEST_CASE("Paged memory")
+{
+    constexpr phi::size_t page_size = dlx::MemoryBlock::PageSize;
+
+    dlx::MemoryBlock mem{1000u, 10u};
+    mem.StoreByte(1000u, 5);
+
+    mem.SetPaged(true);
+    CHECK(mem.IsPaged());
+    CHECK(mem.GetStartingAddress() == 0u);
+    CHECK(mem.GetSize() == 0u);
+    CHECK(mem.GetNumberOfPages() == 0u);
+    CHECK(mem.GetRawMemory().empty());
+
+    // The whole 32-bit address space is valid
+    CHECK(mem.IsAddressValid(0u, 1u));
+    CHECK(mem.IsAddressValid(0xFFFFFFFCu, 4u));
+    CHECK(mem.IsAddressValid(0xFFFFFFFFu, 1u));
+    CHECK_FALSE(mem.IsAddressValid(0xFFFFFFFFu, 2u));
+
+    // Reading untouched memory returns zero without allocating
+    CHECK(mem.LoadWord(0x80000000u).value() == 0);
+    CHECK(mem.LoadDouble(0x12345678u).value() == 0.0);
+    CHECK(mem.GetNumberOfPages() == 0u);
+
+    // Pages are allocated on the first write
+    CHECK(mem.StoreWord(0xFFFFFFFCu, 42));
+    CHECK(mem.GetNumberOfPages() == 1u);
+    CHECK(mem.GetSize() == page_size);
+    CHECK(mem.LoadWord(0xFFFFFFFCu).value() == 42);
+    CHECK(mem.LoadUnsignedByte(0xFFFFFFF8u).value() == 0u);
+
+    CHECK(mem.StoreWord(0xFFFFFFF8u, 7));
+    CHECK(mem.GetNumberOfPages() == 1u);
+
+    CHECK(mem.StoreDouble(16u, 1.5));
+    CHECK(mem.StoreFloat(0x40000000u, 2.5f));
+    CHECK(mem.StoreUnsignedHalfWord(0x40000010u, 65535u));
+    CHECK(mem.GetNumberOfPages() == 3u);
+    CHECK(mem.LoadDouble(16u).value() == 1.5);
+    CHECK(mem.LoadFloat(0x40000000u).value() == 2.5f);
+    CHECK(mem.LoadHalfWord(0x40000010u).value() == -1);
+    CHECK(mem.LoadWord(0xFFFFFFFCu).value() == 42);
+
+    // Unaligned stores spanning two pages
+    CHECK(mem.StoreUnsignedWord(page_size * 10u - 2u, 0x11223344u));
+    CHECK(mem.GetNumberOfPages() == 5u);
+    CHECK(mem.LoadUnsignedHalfWord(page_size * 10u - 2u).value() == 0x3344u);
+    CHECK(mem.LoadUnsignedHalfWord(page_size * 10u).value() == 0x1122u);
+
+    // Out of bounds
+    CHECK_FALSE(mem.StoreWord(0xFFFFFFFEu, 1));
+    CHECK_FALSE(mem.LoadWord(0xFFFFFFFEu).has_value());
+
+    // Restoring only the dirty pages
+    mem.ClearDirtyPages();
+    const dlx::MemoryBlock copy = mem;
+
+    CHECK(mem.StoreWord(0xFFFFFFFCu, 43));
+    CHECK(mem.StoreWord(0x70000000u, 44));
+    CHECK(mem.GetNumberOfPages() == 6u);
+    CHECK(mem.GetNumberOfDirtyPages() == 2u);
+
+    mem.RestoreDirtyPages(copy);
+    CHECK(mem.GetNumberOfPages() == 5u);
+    CHECK(mem.GetNumberOfDirtyPages() == 0u);
+    CHECK(mem.LoadWord(0xFFFFFFFCu).value() == 42);
+    CHECK(mem.LoadWord(0x70000000u).value() == 0);
+
+    // Copies are deep and drop the additional pages of the destination
+    dlx::MemoryBlock other{0u, 0u};
+    other.SetPaged(true);
+    for (phi::uint32_t page{0u}; page < 300u; ++page)
+    {
+        CHECK(other.StoreUnsignedWord(page * page_size * 7u, page));
+    }
+    CHECK(other.GetNumberOfPages() == 300u);
+
+    // Allocating new pages keeps the values of the earlier ones
+    for (phi::uint32_t page{0u}; page < 300u; ++page)
+    {
+        CHECK(other.LoadUnsignedWord(page * page_size * 7u).value() == page);
+    }
+
+    other = mem;
+    CHECK(other.GetNumberOfPages() == 5u);
+    CHECK(other.LoadWord(0xFFFFFFFCu).value() == 42);
+    CHECK(other.LoadWord(page_size * 7u).value() == 0);
+
+    CHECK(other.StoreWord(0xFFFFFFFCu, 1));
+    CHECK(mem.LoadWord(0xFFFFFFFCu).value() == 42);
+
+    // Clear frees all pages
+    mem.Clear();
+    CHECK(mem.GetNumberOfPages() == 0u);
+    CHECK(mem.LoadWord(0xFFFFFFFCu).value() == 0);
+
+    // Restoring after clearing copies everything
+    mem.RestoreDirtyPages(copy);
+    CHECK(mem.GetNumberOfPages() == 5u);
+    CHECK(mem.LoadWord(0xFFFFFFFCu).value() == 42);
+
+    // Contiguous memory can't be resized or moved while paged
+    mem.Resize(100u);
+    mem.SetStartingAddress(100u);
+    CHECK(mem.GetStartingAddress() == 0u);
+    CHECK(mem.GetNumberOfPages() == 5u);
+
+    mem.SetPaged(false);
+    CHECK_FALSE(mem.IsPaged());
+    CHECK(mem.GetSize() == 0u);
+    CHECK_FALSE(mem.IsAddressValid(0u, 1u));
+}
+
+TEST_CASE("MemoryBlock::Load/Store")
+{
+    dlx::MemoryBlock mem{1000u, 16u};
+
+    phi::int32_t  word{0};
+    phi::uint8_t  byte{0u};
+    double        dbl{0.0};
+    phi::uint16_t half{0u};
+
+    CHECK(mem.Store(1000u, phi::int32_t{-5}) == dlx::MemoryAccessResult::Success);
+    CHECK(mem.Load(1000u, word) == dlx::MemoryAccessResult::Success);
+    CHECK(word == -5);
+    CHECK(mem.LoadWord(1000u).value() == -5);
+
+    CHECK(mem.Store(1008u, 2.5) == dlx::MemoryAccessResult::Success);
+    CHECK(mem.Load(1008u, dbl) == dlx::MemoryAccessResult::Success);
+    CHECK(dbl == 2.5);
+
+    CHECK(mem.Store(1015u, phi::uint8_t{200u}) == dlx::MemoryAccessResult::Success);
+    CHECK(mem.Load(1015u, byte) == dlx::MemoryAccessResult::Success);
+    CHECK(byte == 200u);
+
+    // Stores don't need to be aligned but loads do
+    CHECK(mem.Store(1005u, phi::uint16_t{0x1234u}) == dlx::MemoryAccessResult::Success);
+    CHECK(mem.Load(1005u, half) == dlx::MemoryAccessResult::Misaligned);
+    CHECK(mem.LoadUnsignedByte(1005u).value() == 0x34u);
+
+    // Before the starting address
+    word = 7;
+    CHECK(mem.Load(999u, word) == dlx::MemoryAccessResult::OutOfBounds);
+    CHECK(mem.Load(0u, word) == dlx::MemoryAccessResult::OutOfBounds);
+    CHECK(mem.Store(996u, phi::int32_t{1}) == dlx::MemoryAccessResult::OutOfBounds);
+    CHECK(word == 7);
+
+    // Past the end
+    CHECK(mem.Load(1016u, byte) == dlx::MemoryAccessResult::OutOfBounds);
+    CHECK(mem.Load(1014u, word) == dlx::MemoryAccessResult::OutOfBounds);
+    CHECK(mem.Store(1012u, 1.0) == dlx::MemoryAccessResult::OutOfBounds);
+    CHECK(mem.Store(0xFFFFFFFFu, phi::int32_t{1}) == dlx::MemoryAccessResult::OutOfBounds);
+
+    // Memory smaller than the value
+    dlx::MemoryBlock tiny{0u, 2u};
+    CHECK(tiny.Load(0u, word) == dlx::MemoryAccessResult::OutOfBounds);
+    CHECK(tiny.Store(0u, phi::int32_t{1}) == dlx::MemoryAccessResult::OutOfBounds);
+    CHECK(tiny.Store(0u, phi::int16_t{1}) == dlx::MemoryAccessResult::Success);
+
+    dlx::MemoryBlock empty{0u, 0u};
+    CHECK(empty.Load(0u, byte) == dlx::MemoryAccessResult::OutOfBounds);
+
+    // Paged mode
+    mem.SetPaged(true);
+    CHECK(mem.Store(0xFFFFFFFCu, phi::int32_t{9}) == dlx::MemoryAccessResult::Success);
+    CHECK(mem.Load(0xFFFFFFFCu, word) == dlx::MemoryAccessResult::Success);
+    CHECK(word == 9);
+    CHECK(mem.Load(0xFFFFFFFDu, byte) == dlx::MemoryAccessResult::Success);
+    CHECK(mem.Load(0xFFFFFFFEu, half) == dlx::MemoryAccessResult::Success);
+    CHECK(mem.Load(0xFFFFFFFEu, word) == dlx::MemoryAccessResult::OutOfBounds);
+    CHECK(mem.Load(2u, word) == dlx::MemoryAccessResult::Misaligned);
+}
+
+TEST_CASE("Guarded memory copies")
+{
+    dlx::MemoryBlock mem{1000u, 100u};
+    if (!mem.SetGuarded(true))
+    {
+        CHECK_FALSE(dlx::GuardedRegion::IsSupported());
+        return;
+    }
+    CHECK(mem.StoreWord(1000u, 5));
+
+    dlx::MemoryBlock copy = mem;
+    CHECK(copy.IsGuarded());
+    CHECK(copy.GetGuardedRegion().GetData() != mem.GetGuardedRegion().GetData());
+    CHECK(copy.LoadWord(1000u).value() == 5);
+
+    // Copying memory of the same size reuses the reservation
+    const phi::uint8_t* data = copy.GetGuardedRegion().GetData();
+    CHECK(mem.StoreWord(1004u, 6));
+    copy = mem;
+    CHECK(copy.GetGuardedRegion().GetData() == data);
+    CHECK(copy.LoadWord(1004u).value() == 6);
+
+    // Other sizes need a new region
+    mem.Resize(200u);
+    copy = mem;
+    CHECK(copy.GetSize() == 200u);
+    CHECK(copy.LoadWord(1004u).value() == 6);
+
+    // Copying unguarded memory releases the region
+    const dlx::MemoryBlock unguarded{1000u, 16u};
+    copy = unguarded;
+    CHECK_FALSE(copy.IsGuarded());
+    CHECK_FALSE(copy.GetGuardedRegion().IsValid());
+    CHECK(copy.GetSize() == 16u);
+
+    // Copying an invalid region releases the destination
+    dlx::GuardedRegion region{64u};
+    REQUIRE(region.IsValid());
+    CHECK(region.CopyFrom(dlx::GuardedRegion{}));
+    CHECK_FALSE(region.IsValid());
+}
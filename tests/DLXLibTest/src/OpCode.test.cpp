@@ -273,3 +273,19 @@ TEST_CASE("StringToOpCode")
     CHECK(dlx::StringToOpCode("MXXXXXX") == dlx::OpCode::NONE);
     CHECK(dlx::StringToOpCode("XXXXXXX") == dlx::OpCode::NONE);
 }
+
+TEST_CASE("IsMemoryAccessInstruction")
+{
+    STATIC_REQUIRE(dlx::IsMemoryAccessInstruction(dlx::OpCode::LW));
+    STATIC_REQUIRE(dlx::IsMemoryAccessInstruction(dlx::OpCode::LBU));
+    STATIC_REQUIRE(dlx::IsMemoryAccessInstruction(dlx::OpCode::LD));
+    STATIC_REQUIRE(dlx::IsMemoryAccessInstruction(dlx::OpCode::SW));
+    STATIC_REQUIRE(dlx::IsMemoryAccessInstruction(dlx::OpCode::SHU));
+    STATIC_REQUIRE(dlx::IsMemoryAccessInstruction(dlx::OpCode::SF));
+
+    // LHI only loads an immediate value
+    STATIC_REQUIRE(!dlx::IsMemoryAccessInstruction(dlx::OpCode::LHI));
+    STATIC_REQUIRE(!dlx::IsMemoryAccessInstruction(dlx::OpCode::ADD));
+    STATIC_REQUIRE(!dlx::IsMemoryAccessInstruction(dlx::OpCode::J));
+    STATIC_REQUIRE(!dlx::IsMemoryAccessInstruction(dlx::OpCode::NONE));
+}
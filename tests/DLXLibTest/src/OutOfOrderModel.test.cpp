@@ -0,0 +1,349 @@
+#include <phi/test/test_macros.hpp>
+
+#include <DLX/OutOfOrderModel.hpp>
+#include <DLX/Parser.hpp>
+#include <DLX/Processor.hpp>
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/types.hpp>
+#include <string>
+#include <vector>
+
+// The classic Tomasulo example
+static constexpr const char tomasulo_source[] = R"(
+    LD F6 1000(R0)
+    LD F2 1008(R0)
+    MULTD F0 F2 F4
+    SUBD F8 F2 F6
+    DIVD F10 F0 F6
+    ADDD F6 F8 F2
+    HALT
+)";
+
+static constexpr const char loop_source[] = R"(
+    ADDI R1 R0 #2
+loop:
+    SUBI R1 R1 #1
+    BNEZ R1 loop
+    HALT
+)";
+
+// The timing doesn't depend on the values but divisions by zero stop the program
+static void load_operands(dlx::Processor& processor)
+{
+    for (unsigned index = 0u; index < 32u; ++index)
+    {
+        processor.FloatRegisterSetFloatValue(static_cast<dlx::FloatRegisterID>(index), 1.0f);
+    }
+
+    processor.ClearMemory();
+    processor.GetMemory().StoreDouble(1000u, 2.0);
+    processor.GetMemory().StoreDouble(1008u, 4.0);
+}
+
+[[nodiscard]] static dlx::OutOfOrderModel run(const char*                  source,
+                                              const dlx::OutOfOrderConfig& config = {})
+{
+    const dlx::ParsedProgram program = dlx::Parser::Parse(source);
+    REQUIRE(program.m_ParseErrors.empty());
+
+    dlx::OutOfOrderModel model{config};
+
+    dlx::Processor processor;
+    processor.SetOutOfOrderModel(phi::observer_ptr<dlx::OutOfOrderModel>{&model});
+    REQUIRE(processor.LoadProgram(program));
+    load_operands(processor);
+    processor.ExecuteCurrentProgram();
+
+    return model;
+}
+
+static void check_record(const dlx::OutOfOrderRecord& record, phi::uint64_t issue,
+                         phi::uint64_t execute_start, phi::uint64_t execute_end,
+                         phi::uint64_t write)
+{
+    CHECK(record.issue == issue);
+    CHECK(record.execute_start == execute_start);
+    CHECK(record.execute_end == execute_end);
+    CHECK(record.write == write);
+}
+
+TEST_CASE("OutOfOrderConfig")
+{
+    dlx::OutOfOrderConfig config;
+    CHECK(config.IsValid());
+
+    config.units[0u].stations = 0u;
+    CHECK_FALSE(config.IsValid());
+
+    config.units[0u].stations = 17u;
+    CHECK_FALSE(config.IsValid());
+
+    config.units[0u].stations = 16u;
+    config.units[0u].units    = 0u;
+    CHECK_FALSE(config.IsValid());
+
+    config.units[0u].units    = 16u;
+    config.common_data_buses = 0u;
+    CHECK_FALSE(config.IsValid());
+
+    config.common_data_buses = 2u;
+    CHECK(config.IsValid());
+
+    dlx::OutOfOrderModel model;
+    config.history = dlx::OutOfOrderConfig::MaximumHistory + 1u;
+    CHECK_FALSE(model.SetConfig(config));
+    CHECK(model.GetConfig().common_data_buses == 1u);
+
+    CHECK(dlx::GetOutOfOrderUnit(dlx::OpCode::LD) == dlx::OutOfOrderUnit::Load);
+    CHECK(dlx::GetOutOfOrderUnit(dlx::OpCode::SB) == dlx::OutOfOrderUnit::Store);
+    CHECK(dlx::GetOutOfOrderUnit(dlx::OpCode::DIVD) == dlx::OutOfOrderUnit::FloatDivide);
+    CHECK(dlx::GetOutOfOrderUnit(dlx::OpCode::BNEZ) == dlx::OutOfOrderUnit::Integer);
+}
+
+TEST_CASE("OutOfOrderModel")
+{
+    SECTION("Renaming")
+    {
+        const dlx::OutOfOrderModel model = run(tomasulo_source);
+
+        const std::vector<dlx::OutOfOrderRecord> records = model.GetHistory();
+        REQUIRE(records.size() == 7u);
+
+        check_record(records[0], 1u, 2u, 2u, 3u);
+        check_record(records[1], 2u, 3u, 3u, 4u);
+
+        // Waits for F2 from the common data bus
+        check_record(records[2], 3u, 5u, 11u, 12u);
+        check_record(records[3], 4u, 5u, 8u, 9u);
+        check_record(records[4], 5u, 13u, 37u, 38u);
+
+        // Overwrites F6 while the division still waits, completing long before it
+        check_record(records[5], 6u, 10u, 13u, 14u);
+        check_record(records[6], 7u, 8u, 8u, 0u);
+        CHECK(records[6].index == 6u);
+
+        const dlx::OutOfOrderStatistics& statistics = model.GetStatistics();
+        CHECK(statistics.instructions == 7u);
+        CHECK(statistics.cycles == 38u);
+        CHECK(statistics.operand_waits == 11u);
+        CHECK(statistics.station_stalls == 0u);
+        CHECK(statistics.bus_waits == 0u);
+        CHECK(statistics.GetIPC() == 7.0 / 38.0);
+        CHECK(statistics.busy_cycles[static_cast<phi::size_t>(
+                      dlx::OutOfOrderUnit::FloatDivide)] == 25u);
+    }
+
+    SECTION("Common data bus")
+    {
+        const char source[] = R"(
+            MULTF F1 F2 F3
+            NOP
+            NOP
+            ADDF F4 F5 F6
+            HALT
+        )";
+
+        // Both results are ready for cycle 9
+        dlx::OutOfOrderModel model = run(source);
+        CHECK(model.GetHistory()[3].write == 10u);
+        CHECK(model.GetStatistics().bus_waits == 1u);
+        CHECK(model.GetStatistics().cycles == 10u);
+
+        dlx::OutOfOrderConfig config;
+        config.common_data_buses = 2u;
+
+        model = run(source, config);
+        CHECK(model.GetHistory()[3].write == 9u);
+        CHECK(model.GetStatistics().bus_waits == 0u);
+    }
+
+    SECTION("Stations and units")
+    {
+        const char source[] = R"(
+            DIVF F1 F2 F3
+            DIVF F4 F5 F6
+            DIVF F7 F8 F9
+            HALT
+        )";
+
+        // The third division waits for a station and all of them for the unit
+        dlx::OutOfOrderModel model = run(source);
+
+        std::vector<dlx::OutOfOrderRecord> records = model.GetHistory();
+        check_record(records[0], 1u, 2u, 26u, 27u);
+        check_record(records[1], 2u, 27u, 51u, 52u);
+        check_record(records[2], 28u, 52u, 76u, 77u);
+        check_record(records[3], 29u, 30u, 30u, 0u);
+
+        CHECK(model.GetStatistics().station_stalls == 25u);
+        CHECK(model.GetStatistics().unit_waits == 47u);
+        CHECK(model.GetStatistics().cycles == 77u);
+
+        dlx::OutOfOrderConfig config;
+        auto& divide = config.units[static_cast<phi::size_t>(dlx::OutOfOrderUnit::FloatDivide)];
+        divide.units     = 2u;
+
+        model   = run(source, config);
+        records = model.GetHistory();
+        check_record(records[1], 2u, 3u, 27u, 28u);
+        check_record(records[2], 28u, 29u, 53u, 54u);
+
+        divide.pipelined = true;
+        divide.stations  = 3u;
+
+        model   = run(source, config);
+        records = model.GetHistory();
+        check_record(records[2], 3u, 4u, 28u, 29u);
+        CHECK(model.GetStatistics().bus_waits == 0u);
+        CHECK(model.GetStatistics().cycles == 29u);
+    }
+
+    SECTION("Branches")
+    {
+        const dlx::OutOfOrderModel model = run(loop_source);
+
+        const std::vector<dlx::OutOfOrderRecord> records = model.GetHistory();
+        REQUIRE(records.size() == 6u);
+        check_record(records[2], 3u, 6u, 6u, 0u);
+
+        // Nothing issues before the branch executed
+        check_record(records[3], 7u, 8u, 8u, 9u);
+        check_record(records[5], 11u, 12u, 12u, 0u);
+
+        CHECK(model.GetStatistics().branch_stalls == 5u);
+        CHECK(model.GetStatistics().operand_waits == 4u);
+        CHECK(model.GetStatistics().cycles == 12u);
+    }
+
+    SECTION("Memory order")
+    {
+        const dlx::OutOfOrderModel model = run(R"(
+            SW 1000(R0) R1
+            LW R2 1000(R0)
+            LW R3 1004(R0)
+            HALT
+        )");
+
+        // The first load waits for the store, the second one only for the load unit
+        const std::vector<dlx::OutOfOrderRecord> records = model.GetHistory();
+        check_record(records[0], 1u, 2u, 2u, 3u);
+        check_record(records[1], 2u, 4u, 4u, 5u);
+        check_record(records[2], 3u, 5u, 5u, 6u);
+
+        CHECK(model.GetStatistics().memory_order_waits == 1u);
+        CHECK(model.GetStatistics().unit_waits == 1u);
+    }
+
+    SECTION("Long runs")
+    {
+        // Every iteration takes 4 cycles
+        const dlx::OutOfOrderModel model = run(R"(
+            ADDI R1 R0 #4000
+        loop:
+            SUBI R1 R1 #1
+            BNEZ R1 loop
+            HALT
+        )");
+
+        CHECK(model.GetStatistics().instructions == 8002u);
+        CHECK(model.GetStatistics().cycles == 16004u);
+        CHECK(model.GetHistory().size() == 64u);
+        CHECK(model.GetHistory().back().issue == 16003u);
+    }
+}
+
+TEST_CASE("OutOfOrderModel report")
+{
+    const dlx::ParsedProgram program = dlx::Parser::Parse(tomasulo_source);
+    REQUIRE(program.m_ParseErrors.empty());
+
+    dlx::OutOfOrderConfig config;
+    config.history = 2u;
+
+    dlx::OutOfOrderModel model{config};
+    CHECK(model.GetStatistics().GetIPC() == 0.0);
+    CHECK(model.GetHistory().empty());
+
+    dlx::Processor processor;
+    processor.SetOutOfOrderModel(phi::observer_ptr<dlx::OutOfOrderModel>{&model});
+    REQUIRE(processor.LoadProgram(program));
+    load_operands(processor);
+    processor.ExecuteCurrentProgram();
+
+    // Only the last two instructions are kept
+    const std::vector<dlx::OutOfOrderRecord> records = model.GetHistory();
+    REQUIRE(records.size() == 2u);
+    CHECK(records[0].index == 5u);
+    CHECK(records[1].index == 6u);
+
+    const std::string report = model.GetReport(program);
+    CHECK(report.find("Cycles                   38\n") != std::string::npos);
+    CHECK(report.find("IPC                   0.184\n") != std::string::npos);
+    CHECK(report.find("Operands               11\n") != std::string::npos);
+    CHECK(report.find("  Float divide       65.79%\n") != std::string::npos);
+    CHECK(report.find("         7          8          8          -  ") != std::string::npos);
+
+    model.Clear();
+    CHECK(model.GetStatistics().instructions == 0u);
+    CHECK(model.GetHistory().empty());
+}
+
+TEST_CASE("Processor out of order model")
+{
+    const dlx::ParsedProgram program = dlx::Parser::Parse(loop_source);
+    REQUIRE(program.m_ParseErrors.empty());
+
+    dlx::OutOfOrderModel model;
+
+    SECTION("Stepping")
+    {
+        dlx::Processor processor;
+        CHECK_FALSE(processor.GetOutOfOrderModel());
+
+        processor.SetOutOfOrderModel(phi::observer_ptr<dlx::OutOfOrderModel>{&model});
+        CHECK(processor.GetOutOfOrderModel() == &model);
+        REQUIRE(processor.LoadProgram(program));
+
+        CHECK(processor.RunUntilBreak(100u) == dlx::StopReason::Halted);
+        CHECK(model.GetStatistics().instructions == 6u);
+        CHECK(model.GetStatistics().cycles == 12u);
+
+        // Loading starts a new run
+        REQUIRE(processor.LoadProgram(program));
+        CHECK(model.GetStatistics().instructions == 0u);
+
+        processor.SetOutOfOrderModel(nullptr);
+        processor.ExecuteStep();
+        CHECK(model.GetStatistics().instructions == 0u);
+    }
+
+    SECTION("Stepping back")
+    {
+        dlx::Processor processor;
+        processor.SetReverseExecutionEnabled(true);
+        processor.SetOutOfOrderModel(phi::observer_ptr<dlx::OutOfOrderModel>{&model});
+        REQUIRE(processor.LoadProgram(program));
+
+        CHECK(processor.RunUntilBreak(4u) == dlx::StopReason::StepLimit);
+        CHECK(processor.StepBack(2u) == 2u);
+        CHECK(model.GetStatistics().instructions == 4u);
+
+        processor.ExecuteStep();
+        CHECK(model.GetStatistics().instructions == 5u);
+    }
+
+    SECTION("FastProcessor")
+    {
+        dlx::FastProcessor processor;
+        processor.SetOutOfOrderModel(phi::observer_ptr<dlx::OutOfOrderModel>{&model});
+        REQUIRE(processor.LoadProgram(program));
+        processor.ExecuteCurrentProgram();
+
+        CHECK(model.GetStatistics().cycles == 12u);
+
+        // Running again starts a new run
+        processor.ExecuteCurrentProgram();
+        CHECK(model.GetStatistics().instructions == 6u);
+        CHECK(model.GetStatistics().cycles == 12u);
+    }
+}
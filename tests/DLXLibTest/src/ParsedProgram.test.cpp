@@ -1,8 +1,12 @@
 #include <phi/test/test_macros.hpp>
 
+#include <DLX/InstructionArgument.hpp>
 #include <DLX/ParseError.hpp>
 #include <DLX/ParsedProgram.hpp>
 #include <DLX/Parser.hpp>
+#include <DLX/Token.hpp>
+#include <string>
+#include <utility>
 
 TEST_CASE("ParsedProgram::GetDump()")
 {
@@ -25,3 +29,39 @@ TEST_CASE("ParsedProgram::GetDump()")
     str = prog.GetDump();
     CHECK(!str.empty());
 }
+
+TEST_CASE("ParsedProgram owned source")
+{
+    dlx::ParsedProgram prog;
+
+    {
+        std::string source = "loop: ADDI R1 R1 #1\nJ loop";
+
+        dlx::ParsedProgram parsed = dlx::Parser::ParseOwned(source);
+
+        // Destroy the original source
+        source.assign(source.size(), 'X');
+
+        prog = std::move(parsed);
+    }
+
+    REQUIRE(prog.m_Source);
+    CHECK(prog.IsValid());
+    CHECK(prog.m_JumpData.find("loop") != prog.m_JumpData.end());
+    CHECK(prog.m_Tokens.find_first_token_of_type(dlx::Token::Type::LabelIdentifier)->GetText() ==
+          "loop:");
+
+    // Copies share the source
+    const dlx::ParsedProgram copy = prog;
+    CHECK(copy.m_Source == prog.m_Source);
+    CHECK(copy.m_Instructions.at(1u).GetArg1().AsLabel().label_name == "loop");
+
+    // Shared
+    dlx::SharedParsedProgram shared = dlx::Parser::ParseShared("ADD R1 R2 R3");
+    REQUIRE(shared);
+    CHECK(shared->IsValid());
+    CHECK(shared->m_Source);
+
+    // Borrowed source
+    CHECK_FALSE(dlx::Parser::Parse("ADD R1 R2 R3").m_Source);
+}
@@ -265,6 +265,28 @@ TEST_CASE("Parser - Jump labels")
     CHECK(res.m_JumpData.at("c") == 2u);
 }
 
+TEST_CASE("Parser - Resolves jump labels")
+{
+    res = dlx::Parser::Parse("start: NOP\nJ end\nBEQZ R1 start\nend: HALT");
+    REQUIRE(res.m_ParseErrors.empty());
+    REQUIRE(res.m_Instructions.size() == 4u);
+    CHECK_FALSE(res.m_HasUnresolvedLabels);
+
+    CHECK(res.m_Instructions.at(1).GetArg1().AsLabel().label_name == "end");
+    CHECK(res.m_Instructions.at(1).GetArg1().AsLabel().jump_point == 3u);
+
+    CHECK(res.m_Instructions.at(2).GetArg2().AsLabel().label_name == "start");
+    CHECK(res.m_Instructions.at(2).GetArg2().AsLabel().jump_point == 0u);
+
+    res = dlx::Parser::Parse("J unknown");
+    REQUIRE(res.m_ParseErrors.empty());
+    REQUIRE(res.m_Instructions.size() == 1u);
+    CHECK(res.m_HasUnresolvedLabels);
+
+    CHECK(res.m_Instructions.at(0).GetArg1().AsLabel().jump_point ==
+          dlx::InstructionArgument::Label::UnresolvedJumpPoint);
+}
+
 // Correct instruction
 TEST_CASE("Parser - Is case insensitive")
 {
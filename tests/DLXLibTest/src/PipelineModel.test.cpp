@@ -0,0 +1,346 @@
+#include <phi/test/test_macros.hpp>
+
+#include <DLX/DecodedProgram.hpp>
+#include <DLX/Parser.hpp>
+#include <DLX/PipelineModel.hpp>
+#include <DLX/Processor.hpp>
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/types.hpp>
+#include <string>
+
+// Sums up 10 + 9 + ... + 1 taking the branch back 9 times
+static constexpr const char loop_source[] = R"(
+    ADDI R1 R0 #10
+loop:
+    ADD R2 R2 R1
+    SUBI R1 R1 #1
+    BNEZ R1 loop
+    SW 1000(R0) R2
+    HALT
+)";
+
+[[nodiscard]] static dlx::PipelineStatistics run(const char*                source,
+                                                 const dlx::PipelineConfig& config = {})
+{
+    const dlx::ParsedProgram program = dlx::Parser::Parse(source);
+    REQUIRE(program.m_ParseErrors.empty());
+
+    dlx::PipelineModel model{config};
+
+    dlx::Processor processor;
+    processor.SetPipelineModel(phi::observer_ptr<dlx::PipelineModel>{&model});
+    REQUIRE(processor.LoadProgram(program));
+    processor.ExecuteCurrentProgram();
+
+    return model.GetStatistics();
+}
+
+TEST_CASE("PipelineModel precompute")
+{
+    const dlx::ParsedProgram program = dlx::Parser::Parse(R"(
+        ADD R1 R2 R3
+        SD 8(R2) F4
+        LD F2 0(R1)
+        EQD F0 F2
+        BFPT end
+        JAL end
+        ADDI R0 R1 #1
+    end:
+        HALT
+    )");
+    REQUIRE(program.m_ParseErrors.empty());
+
+    dlx::PipelineModel model;
+    model.Load(dlx::DecodeProgram(program));
+
+    const auto& instructions = model.GetInstructions();
+    REQUIRE(instructions.size() == 8u);
+
+    constexpr phi::uint8_t none = dlx::PipelineModel::NoSlot;
+
+    // ADD R1 R2 R3
+    CHECK(instructions[0].sources == std::array<phi::uint8_t, 4u>{2u, 2u, 3u, 3u});
+    CHECK(instructions[0].destinations == std::array<phi::uint8_t, 2u>{1u, 1u});
+    CHECK(instructions[0].flags == 0u);
+
+    // SD 8(R2) F4
+    CHECK(instructions[1].sources == std::array<phi::uint8_t, 4u>{2u, 2u, 36u, 37u});
+    CHECK(instructions[1].destinations == std::array<phi::uint8_t, 2u>{none, none});
+    CHECK(instructions[1].flags == dlx::PipelineInstruction::FlagStore);
+
+    // LD F2 0(R1)
+    CHECK(instructions[2].sources == std::array<phi::uint8_t, 4u>{1u, 1u, none, none});
+    CHECK(instructions[2].destinations == std::array<phi::uint8_t, 2u>{34u, 35u});
+    CHECK(instructions[2].flags == dlx::PipelineInstruction::FlagLoad);
+
+    // EQD F0 F2
+    CHECK(instructions[3].sources == std::array<phi::uint8_t, 4u>{32u, 33u, 34u, 35u});
+    CHECK(instructions[3].destinations == std::array<phi::uint8_t, 2u>{64u, 64u});
+    CHECK(instructions[3].latency == 4u);
+
+    // BFPT end
+    CHECK(instructions[4].sources == std::array<phi::uint8_t, 4u>{64u, 64u, none, none});
+    CHECK(instructions[4].taken_penalty == 1u);
+    CHECK(instructions[4].flags == dlx::PipelineInstruction::FlagEarlyOperands);
+
+    // JAL end
+    CHECK(instructions[5].destinations == std::array<phi::uint8_t, 2u>{31u, 31u});
+
+    // Writing R0 has no effect
+    CHECK(instructions[6].destinations == std::array<phi::uint8_t, 2u>{none, none});
+
+    CHECK(instructions[7].taken_penalty == 0u);
+}
+
+TEST_CASE("PipelineModel hazards")
+{
+    SECTION("No hazards")
+    {
+        const dlx::PipelineStatistics statistics = run(R"(
+            ADDI R1 R0 #1
+            ADDI R2 R0 #2
+            ADDI R3 R0 #3
+            HALT
+        )");
+
+        // Filling and draining the pipeline takes 4 cycles
+        CHECK(statistics.instructions == 4u);
+        CHECK(statistics.cycles == 8u);
+        CHECK(statistics.GetTotalStalls() == 0u);
+        CHECK(statistics.GetCPI() == 2.0);
+    }
+
+    SECTION("Forwarding")
+    {
+        const char source[] = R"(
+            ADDI R1 R0 #1
+            ADD R2 R1 R1
+            HALT
+        )";
+
+        dlx::PipelineStatistics statistics = run(source);
+        CHECK(statistics.cycles == 7u);
+        CHECK(statistics.GetTotalStalls() == 0u);
+
+        // Waits until the value is written back
+        dlx::PipelineConfig config;
+        config.forwarding = false;
+
+        statistics = run(source, config);
+        CHECK(statistics.cycles == 9u);
+        CHECK(statistics.data_stalls == 2u);
+    }
+
+    SECTION("Load use")
+    {
+        dlx::PipelineStatistics statistics = run(R"(
+            LW R1 1000(R0)
+            ADD R2 R1 R1
+            HALT
+        )");
+        CHECK(statistics.cycles == 8u);
+        CHECK(statistics.load_use_stalls == 1u);
+        CHECK(statistics.data_stalls == 0u);
+
+        // The stored value is forwarded to the memory stage
+        statistics = run(R"(
+            LW R1 1000(R0)
+            SW 1004(R0) R1
+            HALT
+        )");
+        CHECK(statistics.cycles == 7u);
+        CHECK(statistics.GetTotalStalls() == 0u);
+    }
+
+    SECTION("Multi cycle latency")
+    {
+        dlx::PipelineStatistics statistics = run(R"(
+            ADDI R2 R0 #3
+            MULT R1 R2 R2
+            ADD R3 R1 R0
+            HALT
+        )");
+        CHECK(statistics.cycles == 14u);
+        CHECK(statistics.data_stalls == 6u);
+
+        // The second half of a double register is waited for as well
+        statistics = run(R"(
+            MULTD F2 F4 F6
+            ADDF F0 F3 F3
+            HALT
+        )");
+        CHECK(statistics.data_stalls == 6u);
+
+        dlx::PipelineConfig config;
+        config.latencies[static_cast<phi::size_t>(dlx::OpCode::MULT)] = 2u;
+
+        statistics = run(R"(
+            ADDI R2 R0 #3
+            MULT R1 R2 R2
+            ADD R3 R1 R0
+            HALT
+        )",
+                         config);
+        CHECK(statistics.cycles == 9u);
+        CHECK(statistics.data_stalls == 1u);
+    }
+
+    SECTION("Structural")
+    {
+        const char source[] = R"(
+            ADDI R2 R0 #6
+            DIVI R1 R2 #3
+            DIVI R3 R2 #2
+            HALT
+        )";
+
+        // The second division waits for the first one and completes last
+        dlx::PipelineStatistics statistics = run(source);
+        CHECK(statistics.structural_stalls == 24u);
+        CHECK(statistics.cycles == 55u);
+
+        dlx::PipelineConfig config;
+        config.pipelined_units[static_cast<phi::size_t>(dlx::PipelineUnit::IntegerDivide)] = true;
+
+        statistics = run(source, config);
+        CHECK(statistics.structural_stalls == 0u);
+        CHECK(statistics.cycles == 31u);
+    }
+
+    SECTION("Write after write")
+    {
+        const dlx::PipelineStatistics statistics = run(R"(
+            MULTF F1 F2 F3
+            ADDF F1 F4 F5
+            HALT
+        )");
+        CHECK(statistics.write_after_write_stalls == 3u);
+        CHECK(statistics.cycles == 12u);
+    }
+
+    SECTION("Control")
+    {
+        dlx::PipelineStatistics statistics = run(loop_source);
+        CHECK(statistics.instructions == 33u);
+        CHECK(statistics.control_stalls == 9u);
+
+        // The branch needs the counter in the decode stage
+        CHECK(statistics.data_stalls == 10u);
+        CHECK(statistics.cycles == 56u);
+
+        dlx::PipelineConfig config;
+        config.branch_resolution = dlx::BranchResolution::Execute;
+
+        statistics = run(loop_source, config);
+        CHECK(statistics.control_stalls == 18u);
+        CHECK(statistics.data_stalls == 0u);
+        CHECK(statistics.cycles == 55u);
+
+        // Jumps and the floating point status register
+        statistics = run(R"(
+            EQF F0 F0
+            BFPT end
+            JAL end
+        end:
+            HALT
+        )");
+        CHECK(statistics.instructions == 3u);
+        CHECK(statistics.data_stalls == 4u);
+        CHECK(statistics.control_stalls == 1u);
+        CHECK(statistics.cycles == 12u);
+
+        statistics = run(R"(
+            JAL func
+            HALT
+        func:
+            JR R31
+        )");
+        CHECK(statistics.control_stalls == 2u);
+        CHECK(statistics.data_stalls == 0u);
+        CHECK(statistics.cycles == 9u);
+    }
+}
+
+TEST_CASE("PipelineModel report")
+{
+    dlx::PipelineModel model;
+    CHECK(model.GetStatistics().cycles == 0u);
+    CHECK(model.GetStatistics().GetCPI() == 0.0);
+
+    const dlx::ParsedProgram program = dlx::Parser::Parse(loop_source);
+    REQUIRE(program.m_ParseErrors.empty());
+
+    model.Load(dlx::DecodeProgram(program));
+    model.Retire(0u, false);
+    model.Retire(1u, false);
+
+    const std::string report = model.GetReport();
+    CHECK(report.find("Cycles                    6\n") != std::string::npos);
+    CHECK(report.find("CPI                   3.000\n") != std::string::npos);
+    CHECK(report.find("Control") != std::string::npos);
+
+    model.Clear();
+    CHECK(model.GetStatistics().instructions == 0u);
+    CHECK(model.GetInstructions().size() == 6u);
+}
+
+TEST_CASE("Processor pipeline model")
+{
+    const dlx::ParsedProgram program = dlx::Parser::Parse(loop_source);
+    REQUIRE(program.m_ParseErrors.empty());
+
+    dlx::PipelineModel model;
+
+    SECTION("Stepping")
+    {
+        dlx::Processor processor;
+        CHECK_FALSE(processor.GetPipelineModel());
+
+        REQUIRE(processor.LoadProgram(program));
+        processor.SetPipelineModel(phi::observer_ptr<dlx::PipelineModel>{&model});
+        CHECK(processor.GetPipelineModel() == &model);
+        CHECK(model.GetInstructions().size() == 6u);
+
+        CHECK(processor.RunUntilBreak(100u) == dlx::StopReason::Halted);
+        CHECK(model.GetStatistics().instructions == 33u);
+        CHECK(model.GetStatistics().cycles == 56u);
+
+        // Loading starts a new run
+        REQUIRE(processor.LoadProgram(program));
+        CHECK(model.GetStatistics().instructions == 0u);
+
+        processor.SetPipelineModel(nullptr);
+        processor.ExecuteStep();
+        CHECK(model.GetStatistics().instructions == 0u);
+    }
+
+    SECTION("Stepping back")
+    {
+        dlx::Processor processor;
+        processor.SetReverseExecutionEnabled(true);
+        processor.SetPipelineModel(phi::observer_ptr<dlx::PipelineModel>{&model});
+        REQUIRE(processor.LoadProgram(program));
+
+        CHECK(processor.RunUntilBreak(10u) == dlx::StopReason::StepLimit);
+        CHECK(processor.StepBack(5u) == 5u);
+        CHECK(model.GetStatistics().instructions == 10u);
+
+        processor.ExecuteStep();
+        CHECK(model.GetStatistics().instructions == 11u);
+    }
+
+    SECTION("FastProcessor")
+    {
+        dlx::FastProcessor processor;
+        processor.SetPipelineModel(phi::observer_ptr<dlx::PipelineModel>{&model});
+        REQUIRE(processor.LoadProgram(program));
+        processor.ExecuteCurrentProgram();
+
+        CHECK(model.GetStatistics().cycles == 56u);
+
+        // Running again starts a new run
+        processor.ExecuteCurrentProgram();
+        CHECK(model.GetStatistics().instructions == 33u);
+        CHECK(model.GetStatistics().cycles == 56u);
+    }
+}
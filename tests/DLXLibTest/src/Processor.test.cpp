@@ -1,10 +1,15 @@
 #include <phi/test/test_macros.hpp>
 
+#include <DLX/JITCompiler.hpp>
 #include <DLX/Parser.hpp>
 #include <DLX/Processor.hpp>
 #include <DLX/RegisterNames.hpp>
 #include <phi/compiler_support/warning.hpp>
 #include <phi/core/types.hpp>
+#include <array>
+#include <bit>
+#include <thread>
+#include <vector>
 
 PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
 
@@ -3375,9 +3380,14 @@ TEST_CASE("Jump to non existing label")
     // J
     res = dlx::Parser::Parse("J label");
     REQUIRE(res.m_ParseErrors.empty());
+    CHECK(res.m_HasUnresolvedLabels);
 
     proc.LoadProgram(res);
 
+    // Unknown labels are reported when loading the program
+    CHECK(proc.IsHalted());
+    CHECK(proc.GetLastRaisedException() == dlx::Exception::UnknownLabel);
+
     proc.ExecuteCurrentProgram();
 
     CHECK(proc.IsHalted());
@@ -3393,6 +3403,21 @@ TEST_CASE("Jump to non existing label")
 
     CHECK(proc.IsHalted());
     CHECK(proc.GetLastRaisedException() == dlx::Exception::UnknownLabel);
+
+    // Nothing is executed before the unknown label is reported
+    res = dlx::Parser::Parse("ADDI R1 R0 #5\nBEQZ R0 label");
+    REQUIRE(res.m_ParseErrors.empty());
+
+    proc.LoadProgram(res);
+
+    proc.IntRegisterSetSignedValue(dlx::IntRegisterID::R1, 0);
+
+    proc.ExecuteCurrentProgram();
+
+    CHECK(proc.IsHalted());
+    CHECK(proc.GetLastRaisedException() == dlx::Exception::UnknownLabel);
+    CHECK(proc.GetCurrentStepCount() == 0u);
+    CHECK(proc.IntRegisterGetSignedValue(dlx::IntRegisterID::R1) == 0);
 }
 
 TEST_CASE("Invalid jump register")
@@ -4519,6 +4544,288 @@ TEST_CASE("Empty source code")
     CHECK(processor.IsHalted());
 }
 
+[[nodiscard]] static std::vector<phi::uint8_t> GetMemoryBytes(const dlx::MemoryBlock& memory)
+{
+    std::vector<phi::uint8_t> bytes;
+    bytes.reserve(memory.GetSize().unsafe());
+
+    const phi::usize end_address = memory.GetStartingAddress() + memory.GetSize();
+    for (phi::usize address = memory.GetStartingAddress(); address < end_address; ++address)
+    {
+        bytes.emplace_back(memory.LoadUnsignedByte(address).value().unsafe());
+    }
+
+    return bytes;
+}
+
+// The checked processor stepping through the program is the reference for every execution mode
+template <typename ProcessorT>
+static void CheckProcessorsMatch(const ProcessorT& processor, const dlx::Processor& expected)
+{
+    CHECK(processor.IsHalted());
+    CHECK(processor.GetProgramCounter() == expected.GetProgramCounter());
+    CHECK(processor.GetNextProgramCounter() == expected.GetNextProgramCounter());
+    CHECK(processor.GetCurrentStepCount() == expected.GetCurrentStepCount());
+    CHECK(processor.GetLastRaisedException() == expected.GetLastRaisedException());
+    CHECK(processor.GetFPSRValue() == expected.GetFPSRValue());
+
+    for (phi::size_t i{0u}; i < 32u; ++i)
+    {
+        const dlx::IntRegisterID id = static_cast<dlx::IntRegisterID>(i);
+
+        CHECK(processor.GetIntRegister(id).GetSignedValue() ==
+              expected.GetIntRegister(id).GetSignedValue());
+    }
+
+    // Compared bitwise so NaNs and signed zeros have to match as well
+    for (phi::size_t i{0u}; i < 32u; ++i)
+    {
+        const dlx::FloatRegisterID id = static_cast<dlx::FloatRegisterID>(i);
+
+        CHECK(std::bit_cast<phi::uint32_t>(processor.GetFloatRegister(id).GetValue().unsafe()) ==
+              std::bit_cast<phi::uint32_t>(expected.GetFloatRegister(id).GetValue().unsafe()));
+    }
+
+    CHECK(processor.GetMemory().GetStartingAddress() == expected.GetMemory().GetStartingAddress());
+    CHECK(GetMemoryBytes(processor.GetMemory()) == GetMemoryBytes(expected.GetMemory()));
+}
+
+template <typename ProcessorT>
+static void CheckExecutionModesMatch(phi::string_view source, phi::usize max_steps)
+{
+    dlx::ParsedProgram program = dlx::Parser::Parse(source);
+    REQUIRE(program.m_ParseErrors.empty());
+
+    dlx::Processor stepped;
+    ProcessorT     threaded;
+    ProcessorT     jit;
+    ProcessorT     guarded_stepped;
+    ProcessorT     guarded;
+    ProcessorT     guarded_jit;
+
+    stepped.SetMaxNumberOfSteps(max_steps);
+    threaded.SetMaxNumberOfSteps(max_steps);
+    jit.SetMaxNumberOfSteps(max_steps);
+    jit.SetJITEnabled(true);
+    guarded_stepped.SetMaxNumberOfSteps(max_steps);
+    guarded.SetMaxNumberOfSteps(max_steps);
+    guarded_jit.SetMaxNumberOfSteps(max_steps);
+    guarded_jit.SetJITEnabled(true);
+
+    CHECK(guarded_stepped.GetMemory().SetGuarded(true) == dlx::GuardedRegion::IsSupported());
+    CHECK(guarded.GetMemory().SetGuarded(true) == dlx::GuardedRegion::IsSupported());
+    CHECK(guarded_jit.GetMemory().SetGuarded(true) == dlx::GuardedRegion::IsSupported());
+
+    stepped.LoadProgram(program);
+    threaded.LoadProgram(program);
+    jit.LoadProgram(program);
+    guarded_stepped.LoadProgram(program);
+    guarded.LoadProgram(program);
+    guarded_jit.LoadProgram(program);
+
+    while (!stepped.IsHalted())
+    {
+        stepped.ExecuteStep();
+    }
+
+    while (!guarded_stepped.IsHalted())
+    {
+        guarded_stepped.ExecuteStep();
+    }
+
+    threaded.ExecuteCurrentProgram();
+    jit.ExecuteCurrentProgram();
+    guarded.ExecuteCurrentProgram();
+    guarded_jit.ExecuteCurrentProgram();
+
+    CheckProcessorsMatch(threaded, stepped);
+    CheckProcessorsMatch(jit, stepped);
+    CheckProcessorsMatch(guarded_stepped, stepped);
+    CheckProcessorsMatch(guarded, stepped);
+    CheckProcessorsMatch(guarded_jit, stepped);
+}
+
+template <typename ProcessorT>
+static void CheckExecuteCurrentProgramMatches()
+{
+    static constexpr const char loop_source[] = R"(
+        ADDI R3 R0 #100
+    loop:
+        SLT R2 R1 R3
+        BEQZ R2 end
+        ADDI R1 R1 #1
+        SW 1000(R0) R1
+        J loop
+    end:
+        HALT
+    )";
+
+    // Unlimited and step limits ending before, inside and at the end of a block
+    CheckExecutionModesMatch<ProcessorT>(loop_source, 0u);
+    CheckExecutionModesMatch<ProcessorT>(loop_source, 1u);
+    CheckExecutionModesMatch<ProcessorT>(loop_source, 2u);
+    CheckExecutionModesMatch<ProcessorT>(loop_source, 4u);
+    CheckExecutionModesMatch<ProcessorT>(loop_source, 7u);
+    CheckExecutionModesMatch<ProcessorT>(loop_source, 50u);
+    CheckExecutionModesMatch<ProcessorT>(loop_source, 10'000u);
+
+    // Running of the end of the program
+    CheckExecutionModesMatch<ProcessorT>("ADDI R1 R0 #1\nADDI R2 R1 #2\nADDI R3 R2 #3", 0u);
+
+    // Halting in the middle of a block
+    CheckExecutionModesMatch<ProcessorT>("ADDI R1 R0 #1\nDIVI R2 R1 #0\nADDI R3 R0 #3", 0u);
+    CheckExecutionModesMatch<ProcessorT>("ADDI R1 R0 #1\nLW R2 #-4\nADDI R3 R0 #3", 0u);
+    CheckExecutionModesMatch<ProcessorT>("ADDI R1 R0 #1\nTRAP #1\nADDI R3 R0 #3", 0u);
+
+    // Subroutine calls and register jumps
+    CheckExecutionModesMatch<ProcessorT>(R"(
+        JAL function
+        ADDI R2 R1 #5
+        HALT
+    function:
+        ADDI R1 R0 #7
+        JR R31
+    )",
+                                         0u);
+
+    // Jumping to an invalid address
+    CheckExecutionModesMatch<ProcessorT>("ADDI R1 R0 #50\nJR R1\nADDI R2 R0 #1", 0u);
+
+    // Superinstructions including step limits and halting inside of them
+    static constexpr const char fused_source[] = R"(
+        ADDI R3 R0 #10
+    loop:
+        SLT R2 R1 R3
+        BEQZ R2 end
+        LW R4 1000(R0)
+        ADD R4 R4 R1
+        SW 1000(R0) R4
+        ADDI R1 R1 #1
+        J loop
+    end:
+        HALT
+    )";
+
+    CheckExecutionModesMatch<ProcessorT>(fused_source, 0u);
+    CheckExecutionModesMatch<ProcessorT>(fused_source, 2u);
+    CheckExecutionModesMatch<ProcessorT>(fused_source, 5u);
+    CheckExecutionModesMatch<ProcessorT>(fused_source, 9u);
+    CheckExecutionModesMatch<ProcessorT>(fused_source, 31u);
+
+    CheckExecutionModesMatch<ProcessorT>("ADDI R1 R0 #-4\nLW R2 0(R1)\nADD R2 R2 R2\nSW 0(R0) R2", 0u);
+    CheckExecutionModesMatch<ProcessorT>("ADDI R1 R0 #-4\nLW R2 0(R0)\nADD R2 R2 R2\nSW 0(R1) R2", 0u);
+
+    // Float registers and stores of every width
+    static constexpr const char float_source[] = R"(
+        ADDI R1 R0 #3
+        MOVI2FP F1 R1
+        CVTI2F F2 F1
+        ADDF F3 F2 F2
+        MULTF F4 F3 F2
+        SF 1000(R0) F4
+        LF F5 1000(R0)
+        DIVF F6 F5 F2
+        CVTF2D F8 F6
+        ADDD F10 F8 F8
+        SD 1008(R0) F10
+        SUBI R2 R0 #2
+        SB 1016(R0) R2
+        SH 1018(R0) R2
+        LTF F2 F3
+        BFPF end
+        SW 1020(R0) R1
+    end:
+        HALT
+    )";
+
+    CheckExecutionModesMatch<ProcessorT>(float_source, 0u);
+    CheckExecutionModesMatch<ProcessorT>(float_source, 6u);
+    CheckExecutionModesMatch<ProcessorT>(float_source, 13u);
+}
+
+template <typename ProcessorT>
+static void CheckJITMatches()
+{
+    ProcessorT processor;
+    processor.SetJITEnabled(true);
+    CHECK(processor.IsJITEnabled() == dlx::JITCompiler::IsSupported());
+
+    // Native arithmetic with overflow and underflow in the middle of a block
+    CheckExecutionModesMatch<ProcessorT>(R"(
+        LHI R1 #32767
+        ORI R1 R1 #32767
+        LHI R20 #-32768
+        ADDI R2 R1 #-1
+        SUBI R3 R20 #1
+        ADD R4 R1 R1
+        SUB R5 R20 R1
+        ADDU R6 R20 R20
+        ADDUI R7 R6 #-1
+        SUBU R8 R0 R1
+        SUBUI R9 R0 #1
+        AND R10 R1 R2
+        ANDI R11 R1 #255
+        XOR R12 R1 R2
+        XORI R13 R1 #-1
+        OR R14 R3 R0
+        SLT R15 R2 R1
+        SLTI R16 R1 #-5
+        NOP
+        ADDI R0 R1 #1
+        SW 1000(R0) R4
+    )",
+                                         0u);
+
+    // Native branches and step limits inside compiled blocks
+    static constexpr const char countdown_source[] = R"(
+        ADDI R1 R0 #20
+    loop:
+        SUBI R1 R1 #1
+        ADDI R2 R2 #3
+        BNEZ R1 loop
+        J end
+        ADDI R3 R0 #1
+    end:
+        ADDI R4 R2 #0
+    )";
+
+    CheckExecutionModesMatch<ProcessorT>(countdown_source, 0u);
+    CheckExecutionModesMatch<ProcessorT>(countdown_source, 3u);
+    CheckExecutionModesMatch<ProcessorT>(countdown_source, 11u);
+    CheckExecutionModesMatch<ProcessorT>(countdown_source, 63u);
+
+    // Unknown labels are raised by the executor
+    CheckExecutionModesMatch<ProcessorT>("ADDI R1 R0 #1\nJ unknown", 0u);
+
+    // Compiled blocks are reused and dropped when loading a new program
+    if (dlx::JITCompiler::IsSupported())
+    {
+        dlx::ParsedProgram program = dlx::Parser::Parse(countdown_source);
+        REQUIRE(program.m_ParseErrors.empty());
+
+        processor.LoadProgram(program);
+        processor.ExecuteCurrentProgram();
+
+        CHECK(processor.GetJITCompiler().GetNumberOfCompiledBlocks() == 4u);
+        CHECK(processor.IntRegisterGetSignedValue(dlx::IntRegisterID::R4) == 60);
+
+        processor.LoadProgram(program);
+        CHECK(processor.GetJITCompiler().GetNumberOfCompiledBlocks() == 0u);
+    }
+}
+
+TEST_CASE("ExecuteCurrentProgram matches ExecuteStep")
+{
+    CheckExecuteCurrentProgramMatches<dlx::Processor>();
+    CheckExecuteCurrentProgramMatches<dlx::FastProcessor>();
+}
+
+TEST_CASE("JIT matches ExecuteStep")
+{
+    CheckJITMatches<dlx::Processor>();
+    CheckJITMatches<dlx::FastProcessor>();
+}
+
 TEST_CASE("Processor::LoadProgram")
 {
     // Parser errors
@@ -4548,6 +4855,517 @@ TEST_CASE("Processor::LoadProgram")
     CHECK(proc.LoadProgram(res));
 }
 
+TEST_CASE("Processor::LoadProgram shared")
+{
+    // Parser errors
+    CHECK_FALSE(proc.LoadProgram(dlx::Parser::ParseShared("This has errors")));
+
+    dlx::SharedParsedProgram program = dlx::Parser::ParseShared(R"(
+    loop:
+        ADDI R1 R1 #1
+        SLTI R2 R1 #10
+        BNEZ R2 loop
+        HALT
+    )");
+    REQUIRE(program->IsValid());
+
+    // Multiple processors can use the same program at once
+    dlx::Processor other;
+    CHECK(proc.LoadProgram(program));
+    CHECK(other.LoadProgram(program));
+    CHECK(proc.GetCurrentProgram() == other.GetCurrentProgram());
+
+    // The processors keep the program alive
+    program.reset();
+
+    proc.ExecuteCurrentProgram();
+    other.ExecuteCurrentProgram();
+
+    CHECK(proc.GetLastRaisedException() == dlx::Exception::Halt);
+    CHECK(proc.IntRegisterGetSignedValue(dlx::IntRegisterID::R1) == 10);
+    CHECK(other.GetLastRaisedException() == dlx::Exception::Halt);
+    CHECK(other.IntRegisterGetSignedValue(dlx::IntRegisterID::R1) == 10);
+    CHECK_FALSE(proc.GetCurrentProgramDump().empty());
+}
+
+TEST_CASE("Processor::Snapshot")
+{
+    res = dlx::Parser::Parse(R"(
+        LW R2 1000(R0)
+        ADDI R2 R2 #1
+        SW 1000(R0) R2
+        SW 1996(R0) R2
+        ADDF F1 F1 F2
+        HALT
+    )");
+    REQUIRE(res.m_ParseErrors.empty());
+
+    proc.LoadProgram(res);
+    proc.ClearRegisters();
+    proc.GetMemory().Resize(1000u);
+    proc.GetMemory().Clear();
+    proc.GetMemory().StoreWord(1000u, 41);
+    proc.IntRegisterSetSignedValue(dlx::IntRegisterID::R1, 7);
+    proc.FloatRegisterSetFloatValue(dlx::FloatRegisterID::F2, 1.5f);
+
+    const dlx::ProcessorSnapshot snapshot = proc.Snapshot();
+    CHECK(proc.GetMemory().GetNumberOfDirtyPages() == 0u);
+
+    for (int run{0}; run < 3; ++run)
+    {
+        proc.ExecuteCurrentProgram();
+
+        // HALT isn't counted as a step
+        CHECK(proc.IsHalted());
+        CHECK(proc.GetCurrentStepCount() == 5u);
+        CHECK(proc.IntRegisterGetSignedValue(dlx::IntRegisterID::R2) == 42);
+        CHECK(proc.FloatRegisterGetFloatValue(dlx::FloatRegisterID::F1).unsafe() == 1.5f);
+        CHECK(proc.GetMemory().LoadWord(1000u).value() == 42);
+        CHECK(proc.GetMemory().LoadWord(1996u).value() == 42);
+        CHECK(proc.GetMemory().GetNumberOfDirtyPages() == 1u);
+
+        proc.Restore(snapshot);
+
+        CHECK_FALSE(proc.IsHalted());
+        CHECK(proc.GetProgramCounter() == 0u);
+        CHECK(proc.GetCurrentStepCount() == 0u);
+        CHECK(proc.GetLastRaisedException() == dlx::Exception::None);
+        CHECK(proc.IntRegisterGetSignedValue(dlx::IntRegisterID::R1) == 7);
+        CHECK(proc.IntRegisterGetSignedValue(dlx::IntRegisterID::R2) == 0);
+        CHECK(proc.FloatRegisterGetFloatValue(dlx::FloatRegisterID::F1).unsafe() == 0.0f);
+        CHECK(proc.FloatRegisterGetFloatValue(dlx::FloatRegisterID::F2).unsafe() == 1.5f);
+        CHECK(proc.GetMemory().LoadWord(1000u).value() == 41);
+        CHECK(proc.GetMemory().LoadWord(1996u).value() == 0);
+        CHECK(proc.GetMemory().GetNumberOfDirtyPages() == 0u);
+    }
+
+    // Restoring into another processor copies the whole memory
+    dlx::Processor other;
+    other.LoadProgram(res);
+    other.GetMemory().StoreWord(1500u, 5);
+    other.Restore(snapshot);
+
+    CHECK(other.GetMemory().GetSize() == 1000u);
+    CHECK(other.GetMemory().LoadWord(1000u).value() == 41);
+    CHECK(other.GetMemory().LoadWord(1500u).value() == 0);
+    CHECK(other.IntRegisterGetSignedValue(dlx::IntRegisterID::R1) == 7);
+
+    other.ExecuteCurrentProgram();
+    CHECK(other.GetMemory().LoadWord(1000u).value() == 42);
+
+    // Resizing the memory after the snapshot was taken
+    proc.GetMemory().Resize(2000u);
+    proc.Restore(snapshot);
+
+    CHECK(proc.GetMemory().GetSize() == 1000u);
+    CHECK(proc.GetMemory().LoadWord(1000u).value() == 41);
+}
+
+TEST_CASE("Paged memory")
+{
+    res = dlx::Parser::Parse(R"(
+        LHI R30 #-1
+        SW -4(R30) R1
+        LW R2 -4(R30)
+        SW 0(R0) R1
+        LW R3 8192(R0)
+        SB 30000(R0) R1
+        HALT
+    )");
+    REQUIRE(res.m_ParseErrors.empty());
+
+    dlx::Processor processor;
+    processor.GetMemory().SetPaged(true);
+    processor.LoadProgram(res);
+    processor.IntRegisterSetSignedValue(dlx::IntRegisterID::R1, 1234);
+    processor.IntRegisterSetSignedValue(dlx::IntRegisterID::R3, 99);
+
+    const dlx::ProcessorSnapshot snapshot = processor.Snapshot();
+
+    processor.ExecuteCurrentProgram();
+
+    CHECK(processor.GetLastRaisedException() == dlx::Exception::Halt);
+    CHECK(processor.IntRegisterGetSignedValue(dlx::IntRegisterID::R2) == 1234);
+    CHECK(processor.IntRegisterGetSignedValue(dlx::IntRegisterID::R3) == 0);
+    CHECK(processor.GetMemory().LoadWord(0xFFFF0000u - 4u).value() == 1234);
+    CHECK(processor.GetMemory().LoadWord(0u).value() == 1234);
+    CHECK(processor.GetMemory().LoadUnsignedByte(30000u).value() == 1234u % 256u);
+
+    // Only the touched pages are allocated
+    CHECK(processor.GetMemory().GetNumberOfPages() == 3u);
+
+    processor.Restore(snapshot);
+
+    CHECK(processor.GetMemory().GetNumberOfPages() == 0u);
+    CHECK(processor.GetMemory().LoadWord(0u).value() == 0);
+    CHECK(processor.IntRegisterGetSignedValue(dlx::IntRegisterID::R3) == 99);
+
+    // Addresses past the end of the address space are still out of bounds
+    res = dlx::Parser::Parse(R"(
+        SUBI R30 R0 #4
+        LW R1 4(R30)
+    )");
+    REQUIRE(res.m_ParseErrors.empty());
+
+    processor.LoadProgram(res);
+    processor.ExecuteCurrentProgram();
+
+    CHECK(processor.GetLastRaisedException() == dlx::Exception::AddressOutOfBounds);
+}
+
+TEST_CASE("Guarded memory")
+{
+    dlx::Processor processor;
+    if (!processor.GetMemory().SetGuarded(true))
+    {
+        CHECK_FALSE(dlx::GuardedRegion::IsSupported());
+        return;
+    }
+
+    CHECK(processor.GetMemory().IsGuarded());
+
+    res = dlx::Parser::Parse(R"(
+        ADDI R1 R0 #1234
+        SW 1000(R0) R1
+        LW R2 1000(R0)
+        SB 1999(R0) R1
+        LBU R3 1999(R0)
+        LW R4 2000(R0)
+        ADDI R5 R0 #1
+    )");
+    REQUIRE(res.m_ParseErrors.empty());
+
+    processor.LoadProgram(res);
+    processor.ExecuteCurrentProgram();
+
+    CHECK(processor.GetLastRaisedException() == dlx::Exception::AddressOutOfBounds);
+    CHECK(processor.GetProgramCounter() == 5u);
+    CHECK(processor.GetCurrentStepCount() == 5u);
+    CHECK(processor.IntRegisterGetSignedValue(dlx::IntRegisterID::R2) == 1234);
+    CHECK(processor.IntRegisterGetUnsignedValue(dlx::IntRegisterID::R3) == 1234u % 256u);
+    CHECK(processor.IntRegisterGetSignedValue(dlx::IntRegisterID::R4) == 0);
+    CHECK(processor.IntRegisterGetSignedValue(dlx::IntRegisterID::R5) == 0);
+
+    // Accessing the memory directly is still bounds checked
+    CHECK(processor.GetMemory().LoadWord(1000u).value() == 1234);
+    CHECK_FALSE(processor.GetMemory().LoadWord(2000u).has_value());
+    CHECK_FALSE(processor.GetMemory().StoreWord(999u, 1));
+
+    // Executing a single instruction
+    processor.Reset();
+    processor.GetMemory().SetGuarded(true);
+    processor.IntRegisterSetSignedValue(dlx::IntRegisterID::R1, 4000);
+    processor.ExecuteInstruction(dlx::Parser::Parse("SW 0(R1) R1").m_Instructions.at(0u));
+
+    CHECK(processor.GetLastRaisedException() == dlx::Exception::AddressOutOfBounds);
+
+    // Faults are delivered to the processor running on the same thread
+    std::vector<std::thread> threads;
+    std::array<phi::usize, 4u> step_counts{};
+
+    for (phi::size_t index{0u}; index < step_counts.size(); ++index)
+    {
+        threads.emplace_back([index, &step_counts]() {
+            dlx::ParsedProgram program = dlx::Parser::Parse(R"(
+                ADDI R1 R0 #1000
+            loop:
+                SW 0(R1) R1
+                ADDI R1 R1 #4
+                J loop
+            )");
+
+            dlx::Processor thread_processor;
+            thread_processor.GetMemory().SetGuarded(true);
+            thread_processor.GetMemory().Resize(1000u + index * 400u);
+            thread_processor.SetMaxNumberOfSteps(0u);
+            thread_processor.LoadProgram(program);
+            thread_processor.ExecuteCurrentProgram();
+
+            step_counts[index] = thread_processor.GetCurrentStepCount();
+        });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Every thread writes until the end of its own memory
+    for (phi::size_t index{0u}; index < step_counts.size(); ++index)
+    {
+        CHECK(step_counts[index] == 1u + (250u + index * 100u) * 3u);
+    }
+}
+
+TEST_CASE("Breakpoints")
+{
+    res = dlx::Parser::Parse(R"(
+        ADDI R3 R0 #5
+    loop:
+        ADDI R1 R1 #1
+        SLT R2 R1 R3
+        BNEZ R2 loop
+        HALT
+    )");
+    REQUIRE(res.m_ParseErrors.empty());
+
+    dlx::Processor processor;
+    processor.LoadProgram(res);
+
+    CHECK_FALSE(processor.HasBreakpoint(0u));
+    CHECK_FALSE(processor.HasBreakpoint(5u));
+
+    // Source line 4 is the first instruction of the loop
+    processor.SetBreakpointsFromSourceLines({4u});
+    CHECK_FALSE(processor.HasBreakpoint(0u));
+    CHECK(processor.HasBreakpoint(1u));
+
+    CHECK(processor.RunUntilBreak(100u) == dlx::StopReason::Breakpoint);
+    CHECK(processor.GetProgramCounter() == 1u);
+    CHECK(processor.GetCurrentStepCount() == 1u);
+
+    // Continuing executes the instruction with the breakpoint
+    for (phi::int32_t iteration{1}; iteration < 5; ++iteration)
+    {
+        CHECK(processor.RunUntilBreak(100u) == dlx::StopReason::Breakpoint);
+        CHECK(processor.GetProgramCounter() == 1u);
+        CHECK(processor.IntRegisterGetSignedValue(dlx::IntRegisterID::R1) == iteration);
+    }
+
+    CHECK(processor.RunUntilBreak(100u) == dlx::StopReason::Halted);
+    CHECK(processor.GetProgramCounter() == 4u);
+    CHECK(processor.GetCurrentStepCount() == 16u);
+    CHECK(processor.IntRegisterGetSignedValue(dlx::IntRegisterID::R1) == 5);
+    CHECK(processor.RunUntilBreak(100u) == dlx::StopReason::Halted);
+
+    // Loading a program clears the breakpoints
+    processor.LoadProgram(res);
+    CHECK_FALSE(processor.HasBreakpoint(1u));
+
+    processor.SetBreakpoint(3u, true);
+    CHECK(processor.HasBreakpoint(3u));
+    processor.SetBreakpoint(3u, false);
+    CHECK_FALSE(processor.HasBreakpoint(3u));
+    processor.SetBreakpoint(5u, true);
+    CHECK_FALSE(processor.HasBreakpoint(5u));
+
+    CHECK(processor.RunUntilBreak(3u) == dlx::StopReason::StepLimit);
+    CHECK(processor.GetCurrentStepCount() == 3u);
+
+    processor.SetBreakpoint(2u, true);
+    processor.ClearBreakpoints();
+    CHECK_FALSE(processor.HasBreakpoint(2u));
+
+    // Nothing to do without a program
+    dlx::Processor empty;
+    CHECK(empty.RunUntilBreak(10u) == dlx::StopReason::Halted);
+}
+
+template <typename ProcessorT>
+[[nodiscard]] static std::string GetStateDump(const ProcessorT& processor)
+{
+    static constexpr const char hex_digits[] = "0123456789ABCDEF";
+
+    std::string memory;
+    for (const phi::uint8_t byte : GetMemoryBytes(processor.GetMemory()))
+    {
+        memory += hex_digits[byte >> 4u];
+        memory += hex_digits[byte & 0xFu];
+    }
+
+    return processor.GetRegisterDump() + memory + processor.GetProcessorDump() +
+           fmt::format("SC: {}, E: {}", processor.GetCurrentStepCount().unsafe(),
+                       static_cast<int>(processor.GetLastRaisedException()));
+}
+
+template <typename ProcessorT>
+static void CheckReverseExecution()
+{
+    // Runs for more than one checkpoint interval and modifies every kind of state
+    res = dlx::Parser::Parse(R"(
+        ADDI R3 R0 #900
+    loop:
+        ADDI R1 R1 #1
+        SW 1000(R0) R1
+        SB 1006(R0) R1
+        MOVI2FP F1 R1
+        CVTI2D F2 F1
+        SD 1008(R0) F2
+        EQF F1 F0
+        SLT R2 R1 R3
+        BNEZ R2 loop
+        SW 5000(R0) R1
+    )");
+    REQUIRE(res.m_ParseErrors.empty());
+
+    ProcessorT processor;
+    processor.SetReverseExecutionEnabled(true);
+    processor.LoadProgram(res);
+    CHECK(processor.IsReverseExecutionEnabled());
+    CHECK(processor.GetNumberOfUndoableSteps() == 0u);
+
+    // Nothing to undo
+    CHECK(processor.StepBack(1u) == 0u);
+    CHECK(processor.RunBackwardsUntilBreak(10u) == dlx::StopReason::StartOfHistory);
+
+    std::vector<std::string> states;
+    while (!processor.IsHalted())
+    {
+        states.emplace_back(GetStateDump(processor));
+        processor.ExecuteStep();
+    }
+    const std::string final_state = GetStateDump(processor);
+
+    // The last instruction is out of bounds
+    CHECK(processor.GetLastRaisedException() == dlx::Exception::AddressOutOfBounds);
+    CHECK(processor.GetNumberOfUndoableSteps() == states.size());
+    REQUIRE(states.size() > dlx::UndoCheckpoint::Interval);
+
+    // Step back one by one
+    for (phi::size_t index{0u}; index < 20u; ++index)
+    {
+        CHECK(processor.StepBack(1u) == 1u);
+        CHECK(GetStateDump(processor) == states[states.size() - 1u - index]);
+    }
+
+    // Running forward again reproduces the same states
+    while (!processor.IsHalted())
+    {
+        processor.ExecuteStep();
+    }
+    CHECK(GetStateDump(processor) == final_state);
+    CHECK(processor.GetNumberOfUndoableSteps() == states.size());
+
+    // Long jumps replay from a checkpoint
+    CHECK(processor.StepBack(5000u) == 5000u);
+    CHECK(GetStateDump(processor) == states[states.size() - 5000u]);
+    CHECK(processor.StepBack(1u) == 1u);
+    CHECK(GetStateDump(processor) == states[states.size() - 5001u]);
+
+    CHECK(processor.RunUntilBreak(10'000u) == dlx::StopReason::Halted);
+    CHECK(GetStateDump(processor) == final_state);
+
+    // Back to the start
+    CHECK(processor.StepBack(states.size() + 10u) == states.size());
+    CHECK(GetStateDump(processor) == states.front());
+    CHECK(processor.GetNumberOfUndoableSteps() == 0u);
+
+    // Run backwards to the breakpoint on the SW instruction
+    CHECK(processor.RunUntilBreak(10'000u) == dlx::StopReason::Halted);
+    processor.SetBreakpoint(2u, true);
+    CHECK(processor.RunBackwardsUntilBreak(10'000u) == dlx::StopReason::Breakpoint);
+    CHECK(processor.GetProgramCounter() == 2u);
+    CHECK(processor.IntRegisterGetSignedValue(dlx::IntRegisterID::R1) == 900);
+
+    // Steps back at least once so it continues past the breakpoint
+    CHECK(processor.RunBackwardsUntilBreak(10'000u) == dlx::StopReason::Breakpoint);
+    CHECK(processor.GetProgramCounter() == 2u);
+    CHECK(processor.IntRegisterGetSignedValue(dlx::IntRegisterID::R1) == 899);
+
+    CHECK(processor.RunBackwardsUntilBreak(3u) == dlx::StopReason::StepLimit);
+
+    processor.ClearBreakpoints();
+    CHECK(processor.RunBackwardsUntilBreak(10'000u) == dlx::StopReason::StartOfHistory);
+    CHECK(GetStateDump(processor) == states.front());
+
+    // A small log drops the oldest steps
+    processor.SetReverseExecutionEnabled(true, 64u);
+    processor.LoadProgram(res);
+    CHECK(processor.RunUntilBreak(100u) == dlx::StopReason::StepLimit);
+    CHECK(processor.GetNumberOfUndoableSteps() > 0u);
+    CHECK(processor.GetNumberOfUndoableSteps() < 64u);
+    const phi::usize undoable = processor.GetNumberOfUndoableSteps();
+    CHECK(processor.StepBack(100u) == undoable);
+    CHECK(GetStateDump(processor) == states[100u - undoable.unsafe()]);
+
+    // Running the whole program clears the history
+    processor.ExecuteCurrentProgram();
+    CHECK(processor.GetNumberOfUndoableSteps() == 0u);
+
+    processor.LoadProgram(res);
+    processor.ExecuteStep();
+    CHECK(processor.GetNumberOfUndoableSteps() == 1u);
+    processor.LoadProgram(res);
+    CHECK(processor.GetNumberOfUndoableSteps() == 0u);
+
+    // Disabled
+    processor.SetReverseExecutionEnabled(false);
+    processor.ExecuteStep();
+    CHECK_FALSE(processor.IsReverseExecutionEnabled());
+    CHECK(processor.GetNumberOfUndoableSteps() == 0u);
+    CHECK(processor.StepBack(1u) == 0u);
+}
+
+template <typename ProcessorT>
+static void CheckReverseExecutionRestoresMemory()
+{
+    res = dlx::Parser::Parse(R"(
+        LHI R1 #4660
+        ORI R1 R1 #22136
+        SW 1000(R0) R1
+        SUBI R2 R0 #1
+        SB 1001(R0) R2
+        SW 1000(R0) R2
+        SB 1004(R0) R1
+        SH 1006(R0) R2
+        HALT
+    )");
+    REQUIRE(res.m_ParseErrors.empty());
+
+    ProcessorT processor;
+    processor.SetReverseExecutionEnabled(true);
+    processor.LoadProgram(res);
+
+    std::vector<std::vector<phi::uint8_t>> memory_states;
+    while (!processor.IsHalted())
+    {
+        memory_states.emplace_back(GetMemoryBytes(processor.GetMemory()));
+        processor.ExecuteStep();
+    }
+
+    CHECK(processor.GetMemory().LoadWord(1000u).value() == -1);
+    CHECK(processor.GetMemory().LoadUnsignedByte(1004u).value() == 0x78u);
+    CHECK(processor.GetMemory().LoadHalfWord(1006u).value() == -1);
+
+    // Undo the HALT and SH
+    CHECK(processor.StepBack(2u) == 2u);
+    CHECK(processor.GetMemory().LoadHalfWord(1006u).value() == 0);
+    CHECK(processor.GetMemory().LoadUnsignedByte(1004u).value() == 0x78u);
+
+    // Undo the SB
+    CHECK(processor.StepBack(1u) == 1u);
+    CHECK(processor.GetMemory().LoadUnsignedByte(1004u).value() == 0u);
+    CHECK(processor.GetMemory().LoadWord(1000u).value() == -1);
+
+    // Undo the SW overwriting the earlier stores
+    CHECK(processor.StepBack(1u) == 1u);
+    CHECK(GetMemoryBytes(processor.GetMemory()) == memory_states[5u]);
+    CHECK(processor.GetMemory().LoadWord(1000u).value() != -1);
+
+    // Undo the SB inside of the first stored word
+    CHECK(processor.StepBack(2u) == 2u);
+    CHECK(GetMemoryBytes(processor.GetMemory()) == memory_states[3u]);
+    CHECK(processor.GetMemory().LoadWord(1000u).value() == 0x12345678);
+
+    // Undo the first SW
+    CHECK(processor.StepBack(1u) == 1u);
+    CHECK(GetMemoryBytes(processor.GetMemory()) == memory_states[2u]);
+    CHECK(processor.GetMemory().LoadWord(1000u).value() == 0);
+    CHECK(GetMemoryBytes(processor.GetMemory()) == memory_states.front());
+}
+
+TEST_CASE("Reverse execution")
+{
+    CheckReverseExecution<dlx::Processor>();
+    CheckReverseExecution<dlx::FastProcessor>();
+}
+
+TEST_CASE("Reverse execution restores memory")
+{
+    CheckReverseExecutionRestoresMemory<dlx::Processor>();
+    CheckReverseExecutionRestoresMemory<dlx::FastProcessor>();
+}
+
 TEST_CASE("Processor::ClearRegisters")
 {
     // Set all registers to non zero
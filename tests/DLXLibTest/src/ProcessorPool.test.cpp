@@ -0,0 +1,127 @@
+#include <phi/test/test_macros.hpp>
+
+#include <DLX/BatchRunner.hpp>
+#include <DLX/Parser.hpp>
+#include <DLX/ProcessorPool.hpp>
+#include <phi/core/types.hpp>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+TEST_CASE("ProcessorPool")
+{
+    const dlx::SharedParsedProgram add = dlx::Parser::ParseShared(R"(
+        ADD R3 R1 R2
+        HALT
+    )");
+    const dlx::SharedParsedProgram mul = dlx::Parser::ParseShared(R"(
+        MULT R3 R1 R2
+        HALT
+    )");
+    REQUIRE(add->m_ParseErrors.empty());
+    REQUIRE(mul->m_ParseErrors.empty());
+
+    SECTION("Results")
+    {
+        constexpr const phi::size_t NumberOfJobs{300u};
+
+        std::vector<phi::int32_t> values(NumberOfJobs, 0);
+        phi::size_t               finished{0u};
+        std::mutex                mutex;
+
+        {
+            dlx::ProcessorPool pool{3u, 8u};
+            CHECK(pool.GetNumberOfThreads() == 3u);
+            CHECK(pool.GetQueueCapacity() == 8u);
+
+            // Alternate the programs so workers have to reload them
+            for (phi::size_t index{0u}; index < NumberOfJobs; ++index)
+            {
+                dlx::BatchJob job;
+                job.int_registers[1u] = static_cast<phi::int32_t>(index);
+                job.int_registers[2u] = 3;
+
+                const phi::boolean submitted =
+                        pool.Submit(index % 3u == 0u ? mul : add, job,
+                                    [&, index](const dlx::BatchResult& result) {
+                                        std::lock_guard<std::mutex> lock{mutex};
+                                        values[index] = result.int_registers[3u];
+                                        ++finished;
+                                    });
+                CHECK(submitted);
+            }
+
+            // Destroying the pool finishes the queued jobs
+        }
+
+        CHECK(finished == NumberOfJobs);
+        for (phi::size_t index{0u}; index < NumberOfJobs; ++index)
+        {
+            const phi::int32_t value = static_cast<phi::int32_t>(index);
+            CHECK(values[index] == (index % 3u == 0u ? value * 3 : value + 3));
+        }
+    }
+
+    SECTION("TrySubmit with a full queue")
+    {
+        dlx::ProcessorPool pool{1u, 1u};
+
+        // Keep the only worker busy until released
+        std::mutex              mutex;
+        std::condition_variable changed;
+        phi::boolean            started{false};
+        phi::boolean            released{false};
+
+        CHECK(pool.Submit(add, {}, [&](const dlx::BatchResult&) {
+            std::unique_lock<std::mutex> lock{mutex};
+            started = true;
+            changed.notify_all();
+            changed.wait(lock, [&] { return released; });
+        }));
+
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            changed.wait(lock, [&] { return started; });
+        }
+
+        CHECK(pool.TrySubmit(add, {}, {}));
+        CHECK(pool.GetQueueSize() == 1u);
+        CHECK_FALSE(pool.TrySubmit(add, {}, {}));
+
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            released = true;
+        }
+        changed.notify_all();
+
+        pool.Shutdown();
+        CHECK(pool.GetQueueSize() == 0u);
+    }
+
+    SECTION("Invalid jobs")
+    {
+        dlx::ProcessorPool pool{1u};
+
+        CHECK_FALSE(pool.Submit(nullptr, {}, {}));
+        CHECK_FALSE(pool.TrySubmit(dlx::Parser::ParseShared("ADDI R1"), {}, {}));
+
+        // The memory image has to fit into the memory
+        dlx::BatchJob job;
+        job.memory_size  = 2u;
+        job.memory_image = {1u, 2u, 3u};
+        CHECK_FALSE(pool.Submit(add, job, {}));
+        CHECK_FALSE(pool.TrySubmit(add, job, {}));
+    }
+
+    SECTION("Shutdown")
+    {
+        dlx::ProcessorPool pool{2u};
+        pool.Shutdown();
+
+        CHECK_FALSE(pool.Submit(add, {}, {}));
+        CHECK_FALSE(pool.TrySubmit(add, {}, {}));
+
+        // Shutting down again does nothing
+        pool.Shutdown();
+    }
+}
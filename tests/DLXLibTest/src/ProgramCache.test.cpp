@@ -0,0 +1,116 @@
+#include <phi/test/test_macros.hpp>
+
+#include <DLX/ProgramCache.hpp>
+#include <phi/core/types.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ProgramCache")
+{
+    SECTION("Hits and misses")
+    {
+        dlx::ProgramCache cache{4u};
+        CHECK(cache.GetCapacity() == 4u);
+        CHECK(cache.GetSize() == 0u);
+
+        const dlx::SharedParsedProgram first = cache.Get("ADDI R1 R0 #1\nHALT");
+        REQUIRE(first);
+        CHECK(first->m_ParseErrors.empty());
+        CHECK(first->m_Instructions.size() == 2u);
+        CHECK(cache.GetMisses() == 1u);
+        CHECK(cache.GetHits() == 0u);
+
+        // Same source returns the same program
+        const dlx::SharedParsedProgram second = cache.Get("ADDI R1 R0 #1\nHALT");
+        CHECK(second.get() == first.get());
+        CHECK(cache.GetMisses() == 1u);
+        CHECK(cache.GetHits() == 1u);
+
+        const dlx::SharedParsedProgram other = cache.Get("ADDI R1 R0 #2\nHALT");
+        CHECK(other.get() != first.get());
+        CHECK(cache.GetSize() == 2u);
+        CHECK(cache.GetMisses() == 2u);
+
+        cache.Clear();
+        CHECK(cache.GetSize() == 0u);
+
+        // Programs handed out stay valid
+        CHECK(first->m_Instructions.size() == 2u);
+        CHECK(cache.Get("ADDI R1 R0 #1\nHALT").get() != first.get());
+    }
+
+    SECTION("Least recently used is evicted")
+    {
+        dlx::ProgramCache cache{2u};
+
+        const dlx::SharedParsedProgram a = cache.Get("ADDI R1 R0 #1");
+        const dlx::SharedParsedProgram b = cache.Get("ADDI R1 R0 #2");
+
+        // Use a so b is the least recently used
+        CHECK(cache.Get("ADDI R1 R0 #1").get() == a.get());
+
+        const dlx::SharedParsedProgram c = cache.Get("ADDI R1 R0 #3");
+        CHECK(cache.GetSize() == 2u);
+
+        CHECK(cache.Get("ADDI R1 R0 #1").get() == a.get());
+        CHECK(cache.Get("ADDI R1 R0 #3").get() == c.get());
+        CHECK(cache.Get("ADDI R1 R0 #2").get() != b.get());
+        CHECK(cache.GetSize() == 2u);
+    }
+
+    SECTION("Parse errors are cached")
+    {
+        dlx::ProgramCache cache;
+
+        const dlx::SharedParsedProgram program = cache.Get("ADDI R1");
+        REQUIRE(program);
+        CHECK_FALSE(program->m_ParseErrors.empty());
+        CHECK(cache.Get("ADDI R1").get() == program.get());
+        CHECK(cache.GetHits() == 1u);
+    }
+
+    SECTION("Zero capacity")
+    {
+        dlx::ProgramCache cache{0u};
+        CHECK(cache.GetCapacity() == 1u);
+
+        const dlx::SharedParsedProgram program = cache.Get("HALT");
+        CHECK(cache.Get("HALT").get() == program.get());
+    }
+
+    SECTION("Threads")
+    {
+        dlx::ProgramCache cache{8u};
+
+        // Assertions aren't thread safe so only count the valid programs
+        std::atomic<phi::size_t> valid_programs{0u};
+
+        std::vector<std::thread> threads;
+        for (phi::size_t thread{0u}; thread < 4u; ++thread)
+        {
+            threads.emplace_back([&cache, &valid_programs] {
+                for (phi::size_t index{0u}; index < 200u; ++index)
+                {
+                    const std::string source = "ADDI R1 R0 #" + std::to_string(index % 16u);
+
+                    const dlx::SharedParsedProgram program = cache.Get(source);
+                    if (program->m_Instructions.size() == 1u)
+                    {
+                        ++valid_programs;
+                    }
+                }
+            });
+        }
+
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        CHECK(valid_programs.load() == 800u);
+        CHECK(cache.GetSize() == 8u);
+        CHECK(cache.GetHits() + cache.GetMisses() == 800u);
+    }
+}
@@ -0,0 +1,185 @@
+#include <phi/test/test_macros.hpp>
+
+#include <DLX/Parser.hpp>
+#include <DLX/TraceDiff.hpp>
+#include <DLX/TraceRecorder.hpp>
+#include <phi/core/types.hpp>
+#include <string>
+#include <vector>
+
+[[nodiscard]] static dlx::TraceRecord MakeIntWrite(phi::uint8_t id, phi::uint32_t value)
+{
+    dlx::TraceRecord record;
+    record.destination_type = dlx::TraceDestination::IntRegister;
+    record.destination      = id;
+    record.value            = value;
+
+    return record;
+}
+
+[[nodiscard]] static dlx::TraceRecord MakeStore(phi::uint32_t address, phi::uint8_t size,
+                                                phi::uint64_t value)
+{
+    dlx::TraceRecord record;
+    record.destination_type = dlx::TraceDestination::Memory;
+    record.destination      = size;
+    record.memory_address   = address;
+    record.value            = value;
+    record.flags            = dlx::TraceRecord::FlagMemoryAccess;
+
+    return record;
+}
+
+TEST_CASE("TraceState")
+{
+    dlx::TraceState state;
+    CHECK(state.GetHash() == 0u);
+
+    state.Apply(MakeIntWrite(1u, 5u));
+    CHECK(state.GetIntRegister(1u) == 5u);
+    CHECK(state.GetHash() != 0u);
+
+    // Writing back the initial value restores the hash
+    state.Apply(MakeIntWrite(1u, 0u));
+    CHECK(state.GetHash() == 0u);
+
+    // The hash only depends on the state, not on the order of the writes
+    dlx::TraceState other;
+    state.Apply(MakeIntWrite(2u, 7u));
+    state.Apply(MakeStore(1000u, 4u, 0x04030201u));
+    other.Apply(MakeStore(1000u, 4u, 0x04030201u));
+    other.Apply(MakeIntWrite(2u, 7u));
+    CHECK(state.GetHash() == other.GetHash());
+    CHECK(state.GetMemoryByte(1000u) == 0x01u);
+    CHECK(state.GetMemoryByte(1003u) == 0x04u);
+    CHECK(state.GetMemoryByte(1004u) == 0u);
+
+    // Stores spanning two pages
+    state.Apply(MakeStore(4094u, 4u, 0xFFFFFFFFu));
+    CHECK(state.GetMemoryByte(4095u) == 0xFFu);
+    CHECK(state.GetMemoryByte(4096u) == 0xFFu);
+    CHECK(state.GetPages().size() == 2u);
+
+    state.Reset();
+    CHECK(state.GetHash() == 0u);
+    CHECK(state.GetIntRegister(2u) == 0u);
+    CHECK(state.GetPages().empty());
+}
+
+TEST_CASE("CompareTraces")
+{
+    std::vector<dlx::TraceRecord> trace_a{MakeIntWrite(1u, 1u), MakeIntWrite(2u, 2u),
+                                          MakeStore(1000u, 4u, 3u), MakeIntWrite(3u, 4u)};
+    std::vector<dlx::TraceRecord> trace_b = trace_a;
+
+    dlx::TraceDiffResult result = dlx::CompareTraces(trace_a, trace_b);
+    CHECK_FALSE(result.diverged);
+    CHECK(result.number_of_steps_a == 4u);
+    CHECK(result.number_of_steps_b == 4u);
+
+    // A different store
+    trace_b[2] = MakeStore(1000u, 4u, 0x0300u);
+    result     = dlx::CompareTraces(trace_a, trace_b);
+    REQUIRE(result.diverged);
+    CHECK(result.step == 2u);
+    CHECK(result.has_record_a);
+    CHECK(result.has_record_b);
+    CHECK(result.registers.empty());
+    REQUIRE(result.memory.size() == 1u);
+    CHECK(result.memory[0].address == 1000u);
+    CHECK(result.memory[0].bytes_a == std::vector<phi::uint8_t>{3u, 0u});
+    CHECK(result.memory[0].bytes_b == std::vector<phi::uint8_t>{0u, 3u});
+    CHECK(result.number_of_differing_bytes == 2u);
+    CHECK_FALSE(result.GetSummary().empty());
+
+    // Different orders of the writes diverge and may converge again but the first divergence
+    // is reported
+    trace_b = {MakeIntWrite(2u, 2u), MakeIntWrite(1u, 1u)};
+    result  = dlx::CompareTraces(trace_a, trace_b);
+    REQUIRE(result.diverged);
+    CHECK(result.step == 0u);
+    REQUIRE(result.registers.size() == 2u);
+    CHECK(result.registers[0].index == 1u);
+    CHECK(result.registers[0].value_a == 1u);
+    CHECK(result.registers[0].value_b == 0u);
+    CHECK(result.registers[1].index == 2u);
+
+    // A shorter trace only diverges once the longer one changes the state
+    trace_b = {trace_a[0], trace_a[1], trace_a[2]};
+    result  = dlx::CompareTraces(trace_a, trace_b);
+    REQUIRE(result.diverged);
+    CHECK(result.step == 3u);
+    CHECK(result.has_record_a);
+    CHECK_FALSE(result.has_record_b);
+
+    trace_a[3] = MakeIntWrite(3u, 0u);
+    result     = dlx::CompareTraces(trace_a, trace_b);
+    CHECK_FALSE(result.diverged);
+    CHECK(result.number_of_steps_a == 4u);
+    CHECK(result.number_of_steps_b == 3u);
+
+    // Program counters are only compared on request
+    trace_b = trace_a;
+    trace_b[1].program_counter = 7u;
+    CHECK_FALSE(dlx::CompareTraces(trace_a, trace_b).diverged);
+    result = dlx::CompareTraces(trace_a, trace_b, true);
+    REQUIRE(result.diverged);
+    CHECK(result.step == 1u);
+}
+
+TEST_CASE("ComparePrograms")
+{
+    const dlx::ParsedProgram reference = dlx::Parser::Parse(R"(
+        ADDI R1 R0 #10
+    loop:
+        ADD R2 R2 R1
+        SUBI R1 R1 #1
+        BNEZ R1 loop
+        SW 1000(R0) R2
+        HALT
+    )");
+
+    // Computes the same sum counting upwards
+    const dlx::ParsedProgram upwards = dlx::Parser::Parse(R"(
+        ADDI R3 R0 #10
+    loop:
+        ADDI R1 R1 #1
+        ADD R2 R2 R1
+        SLT R4 R1 R3
+        BNEZ R4 loop
+        SW 1000(R0) R2
+        HALT
+    )");
+
+    // Stores the sum to the wrong address
+    const dlx::ParsedProgram wrong = dlx::Parser::Parse(R"(
+        ADDI R1 R0 #10
+    loop:
+        ADD R2 R2 R1
+        SUBI R1 R1 #1
+        BNEZ R1 loop
+        SW 1004(R0) R2
+        HALT
+    )");
+
+    dlx::TraceDiffResult result = dlx::ComparePrograms(reference, reference, 10'000u);
+    CHECK_FALSE(result.diverged);
+    CHECK(result.number_of_steps_a == 33u);
+    CHECK(result.number_of_steps_b == 33u);
+
+    result = dlx::ComparePrograms(reference, upwards, 10'000u);
+    REQUIRE(result.diverged);
+    CHECK(result.step == 0u);
+
+    result = dlx::ComparePrograms(reference, wrong, 10'000u);
+    REQUIRE(result.diverged);
+    CHECK(result.step == 31u);
+    CHECK(result.record_a.memory_address == 1000u);
+    CHECK(result.record_b.memory_address == 1004u);
+    CHECK(result.registers.empty());
+    REQUIRE(result.memory.size() == 2u);
+    CHECK(result.memory[0].address == 1000u);
+    CHECK(result.memory[0].bytes_a == std::vector<phi::uint8_t>{55u});
+    CHECK(result.memory[1].address == 1004u);
+    CHECK(result.memory[1].bytes_b == std::vector<phi::uint8_t>{55u});
+}
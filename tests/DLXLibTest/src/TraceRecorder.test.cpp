@@ -0,0 +1,185 @@
+#include <phi/test/test_macros.hpp>
+
+#include <DLX/OpCode.hpp>
+#include <DLX/Parser.hpp>
+#include <DLX/Processor.hpp>
+#include <DLX/TraceRecorder.hpp>
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/types.hpp>
+#include <filesystem>
+#include <string>
+
+static constexpr const char trace_file_name[]{"dlxlib_trace_test_file_ignore_me"};
+
+[[nodiscard]] static std::string get_trace_file_path() noexcept
+{
+    return std::filesystem::temp_directory_path().string() + '/' + trace_file_name;
+}
+
+TEST_CASE("TraceWriter and TraceReader")
+{
+    const std::string path = get_trace_file_path();
+
+    dlx::TraceWriter writer;
+    CHECK_FALSE(writer.IsOpen());
+
+    // A small buffer forces the writer to move through many windows
+    REQUIRE(writer.Open(path, 64u));
+    CHECK(writer.IsOpen());
+    CHECK(writer.GetNumberOfRecords() == 0u);
+
+    for (phi::uint64_t index{0u}; index < 5000u; ++index)
+    {
+        dlx::TraceRecord record;
+        record.step            = index;
+        record.value           = index * 3u;
+        record.program_counter = static_cast<phi::uint32_t>(index % 17u);
+
+        writer.Append(record);
+    }
+
+    CHECK(writer.GetNumberOfRecords() == 5000u);
+
+    // Flushed records can be read while the writer is still open
+    writer.Flush();
+
+    dlx::TraceReader reader;
+    REQUIRE(reader.Open(path));
+    CHECK(reader.GetNumberOfRecords() == 5000u);
+
+    dlx::TraceRecord record;
+    record.step = 5000u;
+    writer.Append(record);
+    writer.Close();
+    CHECK_FALSE(writer.IsOpen());
+    CHECK(writer.GetNumberOfRecords() == 5001u);
+
+    REQUIRE(reader.Open(path));
+    REQUIRE(reader.GetNumberOfRecords() == 5001u);
+    CHECK(std::filesystem::file_size(path) ==
+          sizeof(dlx::TraceFileHeader) + 5001u * sizeof(dlx::TraceRecord));
+
+    for (phi::size_t index{0u}; index < 5000u; ++index)
+    {
+        const dlx::TraceRecord& read_record = reader.GetRecord(index);
+
+        CHECK(read_record.step == index);
+        CHECK(read_record.value == index * 3u);
+        CHECK(read_record.program_counter == index % 17u);
+    }
+    CHECK(reader.GetRecords().back().step == 5000u);
+
+    // Reopening truncates the file
+    REQUIRE(writer.Open(path));
+    writer.Close();
+    REQUIRE(reader.Open(path));
+    CHECK(reader.GetNumberOfRecords() == 0u);
+
+    std::filesystem::remove(path);
+
+    CHECK_FALSE(reader.Open(path));
+    CHECK(reader.GetNumberOfRecords() == 0u);
+}
+
+TEST_CASE("Processor tracing")
+{
+    const std::string path = get_trace_file_path();
+
+    dlx::ParsedProgram program = dlx::Parser::Parse(R"(
+        ADDI R1 R0 #5
+        SW 1000(R0) R1
+        LW R2 1000(R0)
+        MOVI2FP F1 R1
+        CVTI2D F2 F1
+        HALT
+    )");
+
+    dlx::Processor processor;
+    processor.LoadProgram(program);
+
+    dlx::TraceWriter writer;
+    REQUIRE(writer.Open(path));
+    processor.SetTraceWriter(phi::observer_ptr<dlx::TraceWriter>{&writer});
+    CHECK(processor.GetTraceWriter());
+
+    processor.ExecuteCurrentProgram();
+    CHECK(processor.IsHalted());
+    writer.Close();
+
+    dlx::TraceReader reader;
+    REQUIRE(reader.Open(path));
+    REQUIRE(reader.GetNumberOfRecords() == 6u);
+
+    const dlx::TraceRecord& addi = reader.GetRecord(0u);
+    CHECK(addi.step == 0u);
+    CHECK(addi.program_counter == 0u);
+    CHECK(addi.opcode == static_cast<phi::uint16_t>(dlx::OpCode::ADDI));
+    CHECK(addi.destination_type == dlx::TraceDestination::IntRegister);
+    CHECK(addi.destination == 1u);
+    CHECK(addi.value == 5u);
+    CHECK(addi.flags == 0u);
+
+    const dlx::TraceRecord& store = reader.GetRecord(1u);
+    CHECK(store.step == 1u);
+    CHECK(store.program_counter == 1u);
+    CHECK(store.opcode == static_cast<phi::uint16_t>(dlx::OpCode::SW));
+    CHECK(store.destination_type == dlx::TraceDestination::Memory);
+    CHECK(store.destination == 4u);
+    CHECK(store.value == 5u);
+    CHECK(store.memory_address == 1000u);
+    CHECK(store.flags == dlx::TraceRecord::FlagMemoryAccess);
+
+    const dlx::TraceRecord& load = reader.GetRecord(2u);
+    CHECK(load.destination_type == dlx::TraceDestination::IntRegister);
+    CHECK(load.destination == 2u);
+    CHECK(load.value == 5u);
+    CHECK(load.memory_address == 1000u);
+    CHECK(load.flags == dlx::TraceRecord::FlagMemoryAccess);
+
+    const dlx::TraceRecord& move = reader.GetRecord(3u);
+    CHECK(move.destination_type == dlx::TraceDestination::FloatRegister);
+    CHECK(move.destination == 1u);
+    CHECK(move.value == 5u);
+
+    // 5.0 as a double
+    const dlx::TraceRecord& convert = reader.GetRecord(4u);
+    CHECK(convert.destination_type == dlx::TraceDestination::DoubleRegister);
+    CHECK(convert.destination == 2u);
+    CHECK(convert.value == 0x4014000000000000u);
+
+    const dlx::TraceRecord& halt = reader.GetRecord(5u);
+    CHECK(halt.opcode == static_cast<phi::uint16_t>(dlx::OpCode::HALT));
+    CHECK(halt.destination_type == dlx::TraceDestination::None);
+    CHECK(halt.exception == static_cast<phi::uint8_t>(dlx::Exception::Halt));
+    CHECK(halt.flags == dlx::TraceRecord::FlagHalted);
+
+    // Faulting accesses are traced without the access which never happened
+    program = dlx::Parser::Parse(R"(
+        ADDI R1 R0 #5
+        SW 5000(R0) R1
+    )");
+    processor.LoadProgram(program);
+
+    REQUIRE(writer.Open(path));
+    processor.ExecuteStep();
+    processor.ExecuteStep();
+    processor.ExecuteStep();
+    writer.Close();
+
+    REQUIRE(reader.Open(path));
+    REQUIRE(reader.GetNumberOfRecords() == 2u);
+    CHECK(reader.GetRecord(1u).destination_type == dlx::TraceDestination::None);
+    CHECK(reader.GetRecord(1u).exception ==
+          static_cast<phi::uint8_t>(dlx::Exception::AddressOutOfBounds));
+    CHECK(reader.GetRecord(1u).flags == dlx::TraceRecord::FlagHalted);
+
+    // Nothing is written without a trace writer
+    processor.SetTraceWriter(phi::observer_ptr<dlx::TraceWriter>{});
+    REQUIRE(writer.Open(path));
+    processor.LoadProgram(program);
+    processor.ExecuteCurrentProgram();
+    CHECK(writer.GetNumberOfRecords() == 0u);
+    writer.Close();
+
+    std::filesystem::remove(path);
+}
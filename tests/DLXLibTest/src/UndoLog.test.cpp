@@ -0,0 +1,88 @@
+#include <phi/test/test_macros.hpp>
+
+#include <DLX/UndoLog.hpp>
+#include <phi/core/types.hpp>
+
+[[nodiscard]] static dlx::UndoRecord MakeStep(phi::uint64_t value)
+{
+    dlx::UndoRecord record;
+    record.type  = dlx::UndoRecordType::Step;
+    record.value = value;
+
+    return record;
+}
+
+[[nodiscard]] static dlx::UndoRecord MakeRegister(phi::uint64_t value)
+{
+    dlx::UndoRecord record;
+    record.type  = dlx::UndoRecordType::IntRegister;
+    record.value = value;
+
+    return record;
+}
+
+TEST_CASE("UndoLog")
+{
+    dlx::UndoLog log;
+    log.SetCapacity(16u);
+
+    CHECK(log.GetCapacity() == 16u);
+    CHECK(log.IsEmpty());
+    CHECK(log.GetNumberOfSteps() == 0u);
+
+    // Three records per step
+    for (phi::uint64_t step{0u}; step < 6u; ++step)
+    {
+        log.BeginStep(MakeStep(step));
+        log.Push(MakeRegister(step * 10u));
+        log.Push(MakeRegister(step * 10u + 1u));
+    }
+
+    // Only 16 records fit so the first step was dropped as a whole
+    CHECK(log.GetFirstStep() == 1u);
+    CHECK(log.GetEndStep() == 6u);
+    CHECK(log.GetNumberOfSteps() == 5u);
+    CHECK(log.GetEndPosition() == 18u);
+
+    // Records come back in reverse order
+    CHECK(log.Pop().value == 51u);
+    CHECK(log.Pop().value == 50u);
+    CHECK(log.GetEndStep() == 6u);
+
+    const dlx::UndoRecord step = log.Pop();
+    CHECK(step.type == dlx::UndoRecordType::Step);
+    CHECK(step.value == 5u);
+    CHECK(log.GetEndStep() == 5u);
+    CHECK(log.GetEndPosition() == 15u);
+
+    // Pushing into a full log again drops the oldest step
+    log.BeginStep(MakeStep(5u));
+    log.Push(MakeRegister(50u));
+    log.Push(MakeRegister(51u));
+    log.BeginStep(MakeStep(6u));
+    CHECK(log.GetFirstStep() == 1u);
+
+    log.Push(MakeRegister(60u));
+    CHECK(log.GetFirstStep() == 2u);
+    CHECK(log.GetEndStep() == 7u);
+
+    // Truncate back to the start of step 3
+    log.Truncate(9u, 3u);
+    CHECK(log.GetEndStep() == 3u);
+    CHECK(log.GetNumberOfSteps() == 1u);
+    CHECK(log.Pop().value == 21u);
+    CHECK(log.Pop().value == 20u);
+    CHECK(log.Pop().value == 2u);
+    CHECK(log.IsEmpty());
+
+    // Clearing keeps counting
+    log.BeginStep(MakeStep(0u));
+    log.Clear();
+    CHECK(log.IsEmpty());
+    CHECK(log.GetFirstStep() == 3u);
+    CHECK(log.GetEndStep() == 3u);
+
+    // Too small capacities are raised
+    log.SetCapacity(1u);
+    CHECK(log.GetCapacity() == dlx::UndoLog::MinimumCapacity);
+}